@@ -0,0 +1,716 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SlotPatternDictionary.cc
+ *
+ * Implementation of move slot pattern dictionary compressor. Warning!
+ * This compressor works correctly only when there is one instruction per
+ * MAU in the final program image. That is, the MAU of the address space
+ * should be the same as the width of the compressed instructions or
+ * wider. Otherwise jump and call addresses are invalid in the code.
+ *
+ * The compressor uses two levels of dictionaries. The first level has a
+ * dictionary for each move slot, like the move slot dictionary
+ * compressor, except that the most common contents of the slot, usually
+ * a NOP, is not stored in it. The second level dictionary holds the
+ * combinations of the slots that differ from their most common contents.
+ * A compressed instruction consists of the long immediate fields, the
+ * index of the slot combination and the first level indices of the
+ * slots in the combination only, so the runs of NOP slots of wide
+ * instructions take no space.
+ *
+ * @note rating: red
+ */
+
+#include <vector>
+#include <string>
+#include <map>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <boost/format.hpp>
+
+#include "CodeCompressor.hh"
+#include "CodeCompressorPlugin.hh"
+#include "Program.hh"
+#include "BinaryEncoding.hh"
+#include "InstructionBitVector.hh"
+#include "NullInstruction.hh"
+#include "AsciiImageWriter.hh"
+#include "MathTools.hh"
+#include "Conversion.hh"
+#include "Application.hh"
+
+using std::vector;
+using std::string;
+using std::endl;
+
+using TTAProgram::Program;
+using TTAProgram::Instruction;
+using TTAProgram::NullInstruction;
+using namespace TPEF;
+
+const string VERIFY = "verify";
+const string YES = "yes";
+
+class SlotPatternDictionary : public CodeCompressorPlugin {
+public:
+
+    /**
+     * The constructor
+     */
+    SlotPatternDictionary() :
+        CodeCompressorPlugin(), dictionaryCreated_(false),
+        patternIndexWidth_(0), compressedWidth_(0) {
+    }
+
+    /**
+     * The destructor
+     */
+    virtual ~SlotPatternDictionary() {
+    }
+
+    /**
+     * Creates compressed code of the program and returns it in bit vector.
+     *
+     * If the parameter verify=yes is given, the compressed program is
+     * decompressed and compared to the uncompressed program.
+     *
+     * @exception InvalidData If the verification fails.
+     */
+    virtual InstructionBitVector*
+    compress(const string& programName) {
+        if (!dictionaryCreated_) {
+            createDictionary();
+            setImemWidth(compressedWidth_);
+
+            if (Application::verboseLevel() > 0) {
+                printDetails();
+            }
+        }
+        startNewProgram(programName);
+        setAllInstructionsToStartAtBeginningOfMAU();
+        int instructionCount = addInstructions();
+
+        if (hasParameter(VERIFY) && parameterValue(VERIFY) == YES) {
+            verifyProgram(programName);
+        }
+        if (Application::verboseLevel() > 0 ||
+            (hasParameter(VERIFY) && parameterValue(VERIFY) == YES)) {
+            printCompressionRatio(programName, instructionCount);
+        }
+        return programBits();
+    }
+
+    /**
+     * Generates the decompressor in VHDL.
+     *
+     * Note! The programs must be compressed by compress method before
+     * calling this method.
+     *
+     * @param stream The stream to write.
+     */
+    virtual void
+    generateDecompressor(std::ostream& stream, TCEString entityStr) {
+        generateDictionaryVhdl(stream, entityStr);
+        generateDecompressorEntity(stream, entityStr);
+        generateDecompressorArchitecture(stream, entityStr);
+    }
+
+    /**
+     * Prints the description of the plugin to the given stream.
+     *
+     * @param stream The stream.
+     */
+    virtual void
+    printDescription(std::ostream& stream) {
+        stream  << "Generates the program image using a dictionary of move "
+                << "slot combinations on top of move slot dictionaries. "
+                << "The most common contents of each move slot, usually a "
+                << "NOP, is not encoded in the compressed instructions."
+                << endl << endl
+                << "Warning! This compressor works correctly only when "
+                << "there is one instruction per MAU in the final program "
+                << "image. That is, the MAU of the address space should be "
+                << "the same as the width of the compressed instructions or "
+                << "wider. Otherwise jump and call addresses are invalid in "
+                << "the code." << endl << endl
+                << "Parameters:" << endl
+                << "  verify=yes  Decompresses the compressed programs, "
+                << "compares them to the uncompressed programs and prints "
+                << "the compression ratio of each program." << endl << endl;
+    }
+
+private:
+
+    /// Map type for counting the occurrences of move slot contents.
+    typedef std::map<BitVector, unsigned int> PatternCountMap;
+    /// Map type for the first level dictionary of a move slot.
+    typedef std::map<BitVector, unsigned int> SlotDictionary;
+    /// Tells for each move slot whether it differs from its default.
+    typedef vector<bool> SlotCombination;
+    /// Map type for the second level dictionary.
+    typedef std::map<SlotCombination, unsigned int> CombinationDictionary;
+
+    /**
+     * Returns the bits of the given move slot of an uncompressed
+     * instruction.
+     *
+     * @param instructionBits The uncompressed instruction.
+     * @param slot Index of the move slot.
+     * @return The bits of the move slot.
+     */
+    BitVector
+    slotBits(const BitVector& instructionBits, int slot) {
+        unsigned int begin = firstMoveSlotIndex();
+        for (int i = 0; i < slot; i++) {
+            begin += moveSlotWidth(i);
+        }
+        return BitVector(
+            instructionBits, begin, begin + moveSlotWidth(slot) - 1);
+    }
+
+    /**
+     * Returns the number of bits needed for the indices of a dictionary
+     * of the given size.
+     */
+    static int
+    indexWidth(unsigned int entries) {
+        if (entries < 2) {
+            return 0;
+        }
+        return MathTools::requiredBits(entries - 1);
+    }
+
+    /**
+     * Creates the dictionaries of all the programs.
+     *
+     * The first pass counts the occurrences of the contents of each move
+     * slot to pick the default contents and to build the move slot
+     * dictionaries, the second pass collects the combinations of
+     * non-default slots.
+     */
+    void
+    createDictionary() {
+        vector<PatternCountMap> counts(moveSlotCount());
+        for (int i = 0; i < numberOfPrograms(); i++) {
+            startNewProgram(programElement(i)->first);
+            setAllInstructionsToStartAtBeginningOfMAU();
+            const Program& program = currentProgram();
+            Instruction* instruction = &program.firstInstruction();
+            while (instruction != &NullInstruction::instance()) {
+                InstructionBitVector* bits = bemInstructionBits(*instruction);
+                for (int slot = 0; slot < moveSlotCount(); slot++) {
+                    counts.at(slot)[slotBits(*bits, slot)]++;
+                }
+                delete bits;
+                instruction = &program.nextInstruction(*instruction);
+            }
+        }
+
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            BitVector defaultBits;
+            unsigned int defaultCount = 0;
+            for (PatternCountMap::const_iterator iter =
+                     counts.at(slot).begin();
+                 iter != counts.at(slot).end(); iter++) {
+                if (iter->second > defaultCount) {
+                    defaultBits = iter->first;
+                    defaultCount = iter->second;
+                }
+            }
+            if (defaultCount == 0) {
+                // no instructions, use the all-zero contents
+                defaultBits.pushBack(0, moveSlotWidth(slot));
+            }
+            defaults_.push_back(defaultBits);
+
+            slotDictionaries_.push_back(SlotDictionary());
+            slotEntries_.push_back(vector<BitVector>());
+            for (PatternCountMap::const_iterator iter =
+                     counts.at(slot).begin();
+                 iter != counts.at(slot).end(); iter++) {
+                if (iter->first != defaultBits) {
+                    slotDictionaries_.back()[iter->first] =
+                        slotEntries_.back().size();
+                    slotEntries_.back().push_back(iter->first);
+                }
+            }
+        }
+
+        for (int i = 0; i < numberOfPrograms(); i++) {
+            startNewProgram(programElement(i)->first);
+            setAllInstructionsToStartAtBeginningOfMAU();
+            const Program& program = currentProgram();
+            Instruction* instruction = &program.firstInstruction();
+            while (instruction != &NullInstruction::instance()) {
+                InstructionBitVector* bits = bemInstructionBits(*instruction);
+                SlotCombination combination = slotCombination(*bits);
+                if (combinations_.find(combination) == combinations_.end()) {
+                    unsigned int index = combinationEntries_.size();
+                    combinations_[combination] = index;
+                    combinationEntries_.push_back(combination);
+                }
+                delete bits;
+                instruction = &program.nextInstruction(*instruction);
+            }
+        }
+        if (combinationEntries_.empty()) {
+            combinationEntries_.push_back(
+                SlotCombination(moveSlotCount(), false));
+            combinations_[combinationEntries_.back()] = 0;
+        }
+
+        patternIndexWidth_ = indexWidth(combinationEntries_.size());
+        int payloadWidth = 0;
+        for (unsigned int i = 0; i < combinationEntries_.size(); i++) {
+            payloadWidth = std::max(
+                payloadWidth, combinationWidth(combinationEntries_.at(i)));
+        }
+        compressedWidth_ =
+            firstMoveSlotIndex() + patternIndexWidth_ + payloadWidth;
+        if (compressedWidth_ == 0) {
+            // every instruction is the same, the image still needs a bit
+            compressedWidth_ = 1;
+        }
+        dictionaryCreated_ = true;
+    }
+
+    /**
+     * Returns the combination of the non-default move slots of the given
+     * uncompressed instruction.
+     */
+    SlotCombination
+    slotCombination(const BitVector& instructionBits) {
+        SlotCombination combination(moveSlotCount(), false);
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            combination.at(slot) =
+                slotBits(instructionBits, slot) != defaults_.at(slot);
+        }
+        return combination;
+    }
+
+    /**
+     * Returns the width of the move slot indices of the given combination.
+     */
+    int
+    combinationWidth(const SlotCombination& combination) const {
+        int width = 0;
+        for (unsigned int slot = 0; slot < combination.size(); slot++) {
+            if (combination.at(slot)) {
+                width += indexWidth(slotEntries_.at(slot).size());
+            }
+        }
+        return width;
+    }
+
+    /**
+     * Adds the compressed instructions of the current program.
+     *
+     * @return The number of instructions in the program.
+     */
+    int
+    addInstructions() {
+        int instructionCount = 0;
+        Instruction* instruction = &currentProgram().firstInstruction();
+        while (instruction != &NullInstruction::instance()) {
+            InstructionBitVector* bemBits = bemInstructionBits(*instruction);
+            InstructionBitVector* compressedInstruction =
+                new InstructionBitVector();
+            // Take a BitVector pointer to the compressed instruction because
+            // we _need_ to use BitVector pushBack-methods!
+            BitVector* compressPtr =
+                static_cast<BitVector*>(compressedInstruction);
+
+            // limm fields are not compressed
+            for (int i = 0; i < firstMoveSlotIndex(); i++) {
+                compressPtr->pushBack(bemBits->at(i) != 0);
+            }
+
+            SlotCombination combination = slotCombination(*bemBits);
+            compressPtr->pushBack(
+                combinations_[combination], patternIndexWidth_);
+            for (int slot = 0; slot < moveSlotCount(); slot++) {
+                if (combination.at(slot)) {
+                    compressPtr->pushBack(
+                        slotDictionaries_.at(slot)[slotBits(*bemBits, slot)],
+                        indexWidth(slotEntries_.at(slot).size()));
+                }
+            }
+            while (compressPtr->size() < compressedWidth_) {
+                compressPtr->pushBack(false);
+            }
+
+            addInstruction(*instruction, compressedInstruction);
+            instruction = &currentProgram().nextInstruction(*instruction);
+            delete bemBits;
+            instructionCount++;
+        }
+        return instructionCount;
+    }
+
+    /**
+     * Reads an unsigned integer from the given bits, MSB first.
+     */
+    static unsigned int
+    readIndex(const BitVector& bits, unsigned int& position, int width) {
+        unsigned int value = 0;
+        for (int i = 0; i < width; i++) {
+            value = (value << 1) | (bits.at(position) ? 1 : 0);
+            position++;
+        }
+        return value;
+    }
+
+    /**
+     * Decompresses an instruction the same way the decompressor does.
+     *
+     * @param compressed The compressed instruction.
+     * @return The uncompressed instruction.
+     * @exception InvalidData If the compressed instruction is invalid.
+     */
+    BitVector
+    decompress(const BitVector& compressed) {
+        BitVector instruction;
+        unsigned int position = 0;
+        for (int i = 0; i < firstMoveSlotIndex(); i++) {
+            instruction.pushBack(compressed.at(position++) != 0);
+        }
+        unsigned int index =
+            readIndex(compressed, position, patternIndexWidth_);
+        if (index >= combinationEntries_.size()) {
+            throw InvalidData(
+                __FILE__, __LINE__, __func__,
+                "Invalid slot combination index.");
+        }
+        const SlotCombination& combination = combinationEntries_.at(index);
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            if (!combination.at(slot)) {
+                instruction.pushBack(defaults_.at(slot));
+                continue;
+            }
+            const vector<BitVector>& entries = slotEntries_.at(slot);
+            unsigned int entry = readIndex(
+                compressed, position, indexWidth(entries.size()));
+            if (entry >= entries.size()) {
+                throw InvalidData(
+                    __FILE__, __LINE__, __func__,
+                    "Invalid move slot dictionary index.");
+            }
+            instruction.pushBack(entries.at(entry));
+        }
+        return instruction;
+    }
+
+    /**
+     * Decompresses the compressed image of the current program and
+     * compares it to the uncompressed instructions.
+     *
+     * @param programName Name of the program, for the error message.
+     * @exception InvalidData If an instruction does not match.
+     */
+    void
+    verifyProgram(const string& programName) {
+        const InstructionBitVector& image = *programBits();
+        unsigned int begin = 0;
+        Instruction* instruction = &currentProgram().firstInstruction();
+        while (instruction != &NullInstruction::instance()) {
+            BitVector compressed(
+                image, begin, begin + compressedWidth_ - 1);
+            InstructionBitVector* bemBits = bemInstructionBits(*instruction);
+            BitVector uncompressed(*bemBits, 0, bemBits->size() - 1);
+            delete bemBits;
+            if (decompress(compressed) != uncompressed) {
+                string errorMsg =
+                    "Verification of the compressed program '" +
+                    programName + "' failed at instruction " +
+                    Conversion::toString(memoryAddress(*instruction)) + ".";
+                throw InvalidData(__FILE__, __LINE__, __func__, errorMsg);
+            }
+            begin += compressedWidth_;
+            instruction = &currentProgram().nextInstruction(*instruction);
+        }
+    }
+
+    /**
+     * Returns the size of the dictionaries in the decompressor in bits.
+     */
+    std::size_t
+    dictionarySize() const {
+        std::size_t size = 0;
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            size += (slotEntries_.at(slot).size() + 1) * moveSlotWidth(slot);
+        }
+        return size + combinationEntries_.size() * moveSlotCount();
+    }
+
+    /**
+     * Prints the compression ratio of the given program.
+     *
+     * @param programName Name of the program.
+     * @param instructionCount Number of instructions in the program.
+     */
+    void
+    printCompressionRatio(const string& programName, int instructionCount) {
+        std::size_t uncompressed =
+            std::size_t(instructionCount) * binaryEncoding().width();
+        std::size_t compressed =
+            std::size_t(instructionCount) * compressedWidth_;
+        double ratio = uncompressed == 0 ?
+            1.0 : double(compressed) / double(uncompressed);
+        double ratioWithDictionary = uncompressed == 0 ?
+            1.0 : double(compressed + dictionarySize()) /
+            double(uncompressed);
+        Application::logStream()
+            << (boost::format(
+                    "%s: %d instructions, %d bits compressed, %d bits "
+                    "uncompressed, ratio %.3f (%.3f with the "
+                    "dictionaries)\n")
+                % programName % instructionCount % compressed % uncompressed
+                % ratio % ratioWithDictionary).str();
+    }
+
+    void
+    printDetails() {
+        Application::logStream()
+            << (boost::format(
+                    "compressed instruction width: %d (%d bytes), "
+                    "uncompressed: %d\n")
+                % compressedWidth_
+                % int(std::ceil(compressedWidth_ / 8.0))
+                % binaryEncoding().width()).str();
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            Application::logStream()
+                << (boost::format(
+                        "Move slot %d dictionary: %d entries, index width "
+                        "%d bits\n")
+                    % slot % slotEntries_.at(slot).size()
+                    % indexWidth(slotEntries_.at(slot).size())).str();
+        }
+        Application::logStream()
+            << (boost::format(
+                    "Slot combination dictionary: %d entries, index width "
+                    "%d bits\n"
+                    "Total dictionary size: %d bits (%d bytes)\n\n")
+                % combinationEntries_.size() % patternIndexWidth_
+                % dictionarySize()
+                % std::size_t(std::ceil(dictionarySize() / 8.0))).str();
+    }
+
+    /**
+     * Writes a bit vector as a VHDL bit string literal.
+     */
+    static void
+    writeBits(std::ostream& stream, const BitVector& bits) {
+        AsciiImageWriter writer(bits, bits.size());
+        stream << "\"";
+        writer.writeImage(stream);
+        stream << "\"";
+    }
+
+    /**
+     * Returns the VHDL slice of the fetch block that holds the given bits
+     * of the compressed instruction, the first bit being the MSB.
+     */
+    static string
+    fetchBlockSlice(int firstBit, int width) {
+        return (boost::format(
+                    "fetchblock(fetchblock'length-%d downto "
+                    "fetchblock'length-%d)")
+                % (firstBit + 1) % (firstBit + width)).str();
+    }
+
+    void
+    generateDictionaryVhdl(std::ostream& stream, TCEString entityStr) {
+        stream << "library ieee;" << endl;
+        stream << "use ieee.std_logic_1164.all;" << endl;
+        stream << "use ieee.std_logic_arith.all;" << endl << endl;
+
+        TCEString packageName = entityStr + "_dict_init";
+
+        stream << "package " << packageName << " is" << endl << endl;
+
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            stream << indentation(1)
+                   << "constant slot_default_" << slot
+                   << " : std_logic_vector(" << moveSlotWidth(slot)
+                   << "-1 downto 0) := ";
+            writeBits(stream, defaults_.at(slot));
+            stream << ";" << endl;
+
+            const vector<BitVector>& entries = slotEntries_.at(slot);
+            if (entries.empty()) {
+                stream << endl;
+                continue;
+            }
+            stream << indentation(1)
+                   << "type std_logic_dict_matrix_" << slot
+                   << " is array (natural range <>) "
+                   << "of std_logic_vector(" << moveSlotWidth(slot) - 1
+                   << " downto 0);" << endl;
+            stream << indentation(1)
+                   << "constant dict_init_slot_" << slot
+                   << " : std_logic_dict_matrix_" << slot
+                   << "(0 to " << entries.size() - 1 << ") := (" << endl;
+            for (unsigned int i = 0; i < entries.size(); i++) {
+                stream << indentation(2) << i << " => ";
+                writeBits(stream, entries.at(i));
+                if (i + 1 < entries.size()) {
+                    stream << "," << endl;
+                } else {
+                    stream << ");" << endl;
+                }
+            }
+            stream << endl;
+        }
+        stream << "end " << packageName << ";" << endl << endl;
+    }
+
+    void
+    generateDecompressorEntity(std::ostream& stream, TCEString entityStr) {
+        stream << "library ieee;" << endl;
+        stream << "use ieee.std_logic_1164.all;" << endl;
+        stream << "use ieee.std_logic_arith.all;" << endl;
+        stream << "use work." << entityStr << "_globals.all;" << endl;
+        stream << "use work." << entityStr << "_dict_init.all;" << endl;
+        stream << "use work." << entityStr << "_imem_mau.all;" << endl << endl;
+
+        stream << "entity " << entityStr << "_decompressor is" << endl;
+        stream << indentation(1) << "port (" << endl;
+        stream << indentation(2) << "fetch_en : out std_logic;" << endl;
+        stream << indentation(2) << "lock : in std_logic;" << endl;
+        stream << indentation(2)
+               << "fetchblock : in std_logic_vector("
+               << "IMEMWIDTHINMAUS*IMEMMAUWIDTH-1 downto 0);" << endl;
+        stream << indentation(2)
+               << "instructionword : out std_logic_vector("
+               << "INSTRUCTIONWIDTH-1 downto 0);" << endl;
+        stream << indentation(2) << "glock : out std_logic;" << endl;
+        stream << indentation(2) << "lock_r : in std_logic;" << endl;
+        stream << indentation(2) << "clk : in std_logic;" << endl;
+        stream << indentation(2) << "rstx : in std_logic);" << endl << endl;
+        stream << "end " << entityStr << "_decompressor;" << endl << endl;
+    }
+
+    void
+    generateDecompressorArchitecture(
+        std::ostream& stream, TCEString entityStr) {
+        stream << "architecture slot_pattern_dict of " << entityStr
+               << "_decompressor is" << endl << endl;
+
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            stream << indentation(1)
+                   << "signal slot_" << slot << " : std_logic_vector("
+                   << moveSlotWidth(slot) << "-1 downto 0);" << endl;
+        }
+        stream << endl;
+
+        stream << "begin" << endl << endl;
+        stream << indentation(1) << "glock <= lock;" << endl;
+        stream << indentation(1) << "fetch_en <= not lock_r;" << endl << endl;
+
+        stream << indentation(1) << "process (fetchblock)" << endl
+               << indentation(2) << "variable combination : integer;" << endl
+               << indentation(1) << "begin" << endl;
+        if (patternIndexWidth_ > 0) {
+            stream << indentation(2)
+                   << "combination := conv_integer(unsigned("
+                   << fetchBlockSlice(
+                       firstMoveSlotIndex(), patternIndexWidth_)
+                   << "));" << endl;
+        } else {
+            stream << indentation(2) << "combination := 0;" << endl;
+        }
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            stream << indentation(2) << "slot_" << slot
+                   << " <= slot_default_" << slot << ";" << endl;
+        }
+        stream << indentation(2) << "case combination is" << endl;
+        for (unsigned int i = 0; i < combinationEntries_.size(); i++) {
+            const SlotCombination& combination = combinationEntries_.at(i);
+            stream << indentation(3) << "when " << i << " =>" << endl;
+            int position = firstMoveSlotIndex() + patternIndexWidth_;
+            bool anySlot = false;
+            for (int slot = 0; slot < moveSlotCount(); slot++) {
+                if (!combination.at(slot)) {
+                    continue;
+                }
+                anySlot = true;
+                int width = indexWidth(slotEntries_.at(slot).size());
+                stream << indentation(4) << "slot_" << slot
+                       << " <= dict_init_slot_" << slot << "(";
+                if (width > 0) {
+                    stream << "conv_integer(unsigned("
+                           << fetchBlockSlice(position, width) << "))";
+                } else {
+                    stream << "0";
+                }
+                stream << ");" << endl;
+                position += width;
+            }
+            if (!anySlot) {
+                stream << indentation(4) << "null;" << endl;
+            }
+        }
+        stream << indentation(3) << "when others =>" << endl
+               << indentation(4) << "null;" << endl
+               << indentation(2) << "end case;" << endl
+               << indentation(1) << "end process;" << endl << endl;
+
+        stream << indentation(1) << "instructionword <= ";
+        if (firstMoveSlotIndex() > 0) {
+            stream << fetchBlockSlice(0, firstMoveSlotIndex());
+            if (moveSlotCount() > 0) {
+                stream << "&";
+            }
+        }
+        for (int slot = 0; slot < moveSlotCount(); slot++) {
+            stream << "slot_" << slot;
+            if (slot + 1 < moveSlotCount()) {
+                stream << "&";
+            }
+        }
+        stream << ";" << endl << endl;
+        stream << "end slot_pattern_dict;" << endl;
+    }
+
+    /// Most common contents of each move slot.
+    vector<BitVector> defaults_;
+    /// Move slot dictionaries, the default contents excluded.
+    vector<SlotDictionary> slotDictionaries_;
+    /// Contents of the move slot dictionaries by index.
+    vector<vector<BitVector> > slotEntries_;
+    /// The slot combination dictionary.
+    CombinationDictionary combinations_;
+    /// Contents of the slot combination dictionary by index.
+    vector<SlotCombination> combinationEntries_;
+    /// Indicates whether the dictionaries have been created.
+    bool dictionaryCreated_;
+    /// Width of the slot combination index.
+    int patternIndexWidth_;
+    /// Total width of compressed instruction.
+    unsigned int compressedWidth_;
+};
+
+EXPORT_CODE_COMPRESSOR(SlotPatternDictionary)
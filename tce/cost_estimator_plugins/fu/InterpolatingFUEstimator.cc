@@ -64,6 +64,7 @@ public:
     InterpolatingFUEstimator(const std::string& name) :
         FUCostEstimationPlugin(name) {
         costDatabaseRegistry_ = &CostDatabaseRegistry::instance();
+        costdb_ = NULL;
     }
 
     virtual ~InterpolatingFUEstimator() {
@@ -399,8 +400,6 @@ private:
     CostDatabaseRegistry* costDatabaseRegistry_;
     /// Cost database being used.
     CostDatabase* costdb_;
-    /// Search strategy to be used with the cost database.
-    SearchStrategy* strategy_;
     /// Entry key property of function unit.
     EntryKeyProperty* unitProperty_;
     /// Search type for each entry type.
@@ -419,12 +418,23 @@ private:
  */
 void
 initializeEstimator(const HDBManager& hdb) {
-    
-    costdb_ = &costDatabaseRegistry_->costDatabase(hdb);
-    strategy_ = new FilterSearch();
-    costdb_->setSearchStrategy(strategy_);
+
+    CostDatabase* costdb = &costDatabaseRegistry_->costDatabase(hdb);
+    if (costdb == costdb_) {
+        // already initialized for this HDB
+        return;
+    }
+    costdb_ = costdb;
+    if (!costdb_->hasSearchStrategy()) {
+        // the strategy and its cache of results are shared by all the
+        // estimators using the cost database
+        FilterSearch strategy;
+        costdb_->setSearchStrategy(&strategy);
+    }
     unitProperty_ = EntryKeyProperty::find(CostDBTypes::EK_UNIT);
-    createSearchTypes();
+    if (unitMatchType_.empty()) {
+        createSearchTypes();
+    }
 }
 
 /**
@@ -57,6 +57,7 @@ public:
     InterpolatingRFEstimator(const std::string& name) :
         RFCostEstimationPlugin(name) {
         costDatabaseRegistry_ = &CostDatabaseRegistry::instance();
+        costdb_ = NULL;
     }
 
     virtual ~InterpolatingRFEstimator() {
@@ -405,8 +406,6 @@ private:
     CostDatabaseRegistry* costDatabaseRegistry_;
     /// Cost database being used.
     CostDatabase* costdb_;
-    /// Search strategy to be used with the cost database.
-    SearchStrategy* strategy_;
     /// Entry key property of register file.
     EntryKeyProperty* rfileProperty_;
     /// Search type for each entry type.
@@ -426,11 +425,22 @@ private:
 void 
 initializeEstimator(const HDBManager& hdb) {
 
-    costdb_ = &costDatabaseRegistry_->costDatabase(hdb);
-    strategy_ = new FilterSearch();
-    costdb_->setSearchStrategy(strategy_);
+    CostDatabase* costdb = &costDatabaseRegistry_->costDatabase(hdb);
+    if (costdb == costdb_) {
+        // already initialized for this HDB
+        return;
+    }
+    costdb_ = costdb;
+    if (!costdb_->hasSearchStrategy()) {
+        // the strategy and its cache of results are shared by all the
+        // estimators using the cost database
+        FilterSearch strategy;
+        costdb_->setSearchStrategy(&strategy);
+    }
     rfileProperty_ = EntryKeyProperty::find(CostDBTypes::EK_RFILE);
-    createSearchTypes();
+    if (interpMatchType_.empty()) {
+        createSearchTypes();
+    }
 }
 
 /**
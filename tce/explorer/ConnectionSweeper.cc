@@ -498,22 +498,31 @@ private:
             RowID bestConfInThisIteration = -1;
             std::vector<const TTAMachine::Connection*>::iterator unneededPos = 
                 connections.end();
-            // find the least affecting connection removal for this stage
+            // create a candidate with each of the connections removed
+            std::vector<DSDBManager::MachineConfiguration> candidates;
+            std::vector<RowID> candidateIds;
             for (std::vector<const TTAMachine::Connection*>::iterator 
                      connI = connections.begin(); connI != connections.end();
                  ++connI) {
-                const TTAMachine::Connection* conn = *connI;
-
-                // compute the avgccWorsening
-                // check if it's the best found and if it's above the
-                // threshold               
                 TTAMachine::Machine mach = *currentMachine;
-                removeConnection(mach, *conn);
+                removeConnection(mach, **connI);
 
                 DSDBManager::MachineConfiguration conf;
                 conf.architectureID = db().addArchitecture(mach);
                 RowID confId = db().addConfiguration(conf);
-                bool success = evaluate(db().configuration(confId));
+                candidates.push_back(db().configuration(confId));
+                candidateIds.push_back(confId);
+            }
+
+            // find the least affecting connection removal for this stage,
+            // the candidates are independent so they are evaluated together
+            std::vector<bool> evaluated = evaluateAll(candidates);
+            for (std::size_t c = 0; c < candidates.size(); ++c) {
+                std::vector<const TTAMachine::Connection*>::iterator connI =
+                    connections.begin() + c;
+                const TTAMachine::Connection* conn = *connI;
+                RowID confId = candidateIds[c];
+                bool success = evaluated[c];
 
                 if (success) {
                     unsigned int avgWorsening = 
@@ -63,6 +63,15 @@
 #include "Application.hh"
 #include "ComponentImplementationSelector.hh"
 #include "Exception.hh"
+#include "LLVMBackend.hh"
+#include "LLVMTCECmdLineOptions.hh"
+#include "InterPassData.hh"
+#include "Environment.hh"
+#include "FileSystem.hh"
+#include "Conversion.hh"
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 
 using std::set;
 using std::vector;
@@ -75,11 +84,15 @@ DesignSpaceExplorer::pluginTool_;
 CostEstimates 
 DesignSpaceExplorer::dummyEstimate_;
 
+thread_local std::ostringstream*
+DesignSpaceExplorer::threadOutputStream_ = NULL;
+
 
 /**
  * The constructor.
  */
-DesignSpaceExplorer::DesignSpaceExplorer() {
+DesignSpaceExplorer::DesignSpaceExplorer() :
+    compiler_(NULL), compilerOptions_(NULL), jobCount_(0) {
     
     //schedulingPlan_ = 
     //    SchedulingPlan::loadFromFile(Environment::oldGccSchedulerConf());
@@ -96,6 +109,13 @@ DesignSpaceExplorer::~DesignSpaceExplorer() {
     //schedulingPlan_ = NULL;
     delete oStream_;
     oStream_ = NULL;
+    delete compiler_;
+    compiler_ = NULL;
+    delete compilerOptions_;
+    compilerOptions_ = NULL;
+    if (compilerTempDir_ != "") {
+        FileSystem::removeFileOrDirectory(compilerTempDir_);
+    }
 }
 
 /**
@@ -136,11 +156,17 @@ DesignSpaceExplorer::evaluate(
 
     TTAMachine::Machine* adf = NULL;
     IDF::MachineImplementation* idf = NULL;
-    if (configuration.hasImplementation) {
-        adf = dsdb_->architecture(configuration.architectureID);
-        idf = dsdb_->implementation(configuration.implementationID);
-    } else {
-        adf = dsdb_->architecture(configuration.architectureID);
+    set<RowID> applicationIDs;
+    {
+        // the DSDB is shared by the evaluations of evaluateAll()
+        boost::recursive_mutex::scoped_lock lock(dsdbLock_);
+        if (configuration.hasImplementation) {
+            adf = dsdb_->architecture(configuration.architectureID);
+            idf = dsdb_->implementation(configuration.implementationID);
+        } else {
+            adf = dsdb_->architecture(configuration.architectureID);
+        }
+        applicationIDs = dsdb_->applicationIDs();
     }
 
     try {
@@ -150,8 +176,12 @@ DesignSpaceExplorer::evaluate(
             // estimate total area and longest path delay
             CostEstimator::AreaInGates totalArea = 0;
             CostEstimator::DelayInNanoSeconds longestPathDelay = 0;
-            createEstimateData(*adf, *idf, totalArea, longestPathDelay);
+            {
+                boost::mutex::scoped_lock lock(estimatorLock_);
+                createEstimateData(*adf, *idf, totalArea, longestPathDelay);
+            }
 
+            boost::recursive_mutex::scoped_lock lock(dsdbLock_);
             dsdb_->setAreaEstimate(configuration.implementationID, totalArea);
             result.setArea(totalArea);
 
@@ -160,23 +190,28 @@ DesignSpaceExplorer::evaluate(
             result.setLongestPathDelay(longestPathDelay);
         }
        
-        // get all programs from the dsdb
-        set<RowID> applicationIDs = dsdb_->applicationIDs();
+        // go through all programs from the dsdb
         for (set<RowID>::const_iterator i = applicationIDs.begin();
              i != applicationIDs.end(); i++) {
 
-            if (dsdb_->isUnschedulable((*i), configuration.architectureID)) {
-                return false;
-            }
+            string applicationPath;
+            {
+                boost::recursive_mutex::scoped_lock lock(dsdbLock_);
+                if (dsdb_->isUnschedulable(
+                        (*i), configuration.architectureID)) {
+                    return false;
+                }
 
-            if (!estimate && 
-                dsdb_->hasCycleCount(*i, configuration.architectureID)) {
-                // this configuration has been compiled+simulated previously,
-                // the old cycle count can be reused for this app
-                continue; 
-            }
+                if (!estimate && 
+                    dsdb_->hasCycleCount(*i, configuration.architectureID)) {
+                    // this configuration has been compiled+simulated
+                    // previously, the old cycle count can be reused for
+                    // this app
+                    continue; 
+                }
 
-            string applicationPath = dsdb_->applicationPath(*i);
+                applicationPath = dsdb_->applicationPath(*i);
+            }
             TestApplication testApplication(applicationPath);
             
             std::string applicationFile = testApplication.applicationPath();
@@ -204,6 +239,7 @@ DesignSpaceExplorer::evaluate(
 #endif
 
             if (scheduledProgram.get() == NULL) {
+                boost::recursive_mutex::scoped_lock lock(dsdbLock_);
                 dsdb_->setUnschedulable((*i), configuration.architectureID);
                 delete adf;
                 adf = NULL;
@@ -229,7 +265,7 @@ DesignSpaceExplorer::evaluate(
             // verify the simulation
             if (testApplication.hasCorrectOutput()) {
                 string correctResult = testApplication.correctOutput();
-                string resultString = oStream_->str();
+                string resultString = outputStream().str();
                 if (resultString != correctResult) {
                     std::cerr << "Simulation FAILED, possible bug in scheduler!"
                               << std::endl;
@@ -254,20 +290,27 @@ DesignSpaceExplorer::evaluate(
                 //std::cerr << "DEBUG: simulation OK" << std::endl;
                 // reset the stream pointer in to the beginning and empty the
                 // stream
-                oStream_->str("");
-                oStream_->seekp(0);
+                outputStream().str("");
+                outputStream().seekp(0);
             }
 
             // add simulated cycle count to dsdb
-            dsdb_->addCycleCount(
+            {
+                boost::recursive_mutex::scoped_lock lock(dsdbLock_);
+                dsdb_->addCycleCount(
                     (*i), configuration.architectureID,
                     runnedCycles);
+            }
 
             if (configuration.hasImplementation && estimate) {
                 // energy estimate the simulated program
-                EnergyInMilliJoules programEnergy =
-                    estimator_.totalEnergy(
+                EnergyInMilliJoules programEnergy = 0;
+                {
+                    boost::mutex::scoped_lock lock(estimatorLock_);
+                    programEnergy = estimator_.totalEnergy(
                         *adf, *idf, *scheduledProgram, *traceDB);
+                }
+                boost::recursive_mutex::scoped_lock lock(dsdbLock_);
                 dsdb_->addEnergyEstimate(
                     (*i), configuration.implementationID, programEnergy);
                 result.setEnergy(*scheduledProgram, programEnergy);
@@ -290,6 +333,142 @@ DesignSpaceExplorer::evaluate(
     return true;
 }
 
+/**
+ * Evaluates a batch of processor configurations.
+ *
+ * Does the same as evaluate() for each of the configurations, but evaluates
+ * up to jobCount() configurations in parallel threads. The results are
+ * stored to the DSDB in the order the evaluations finish. Scheduling,
+ * simulation and estimation of the configurations overlap. The compilations
+ * done in the explorer process and the DSDB accesses are serialized.
+ *
+ * @param configurations The configurations to evaluate.
+ * @param estimate Flag indicating that the configurations are also
+ *                 estimated.
+ * @param results If given, the cost estimates of the configurations are
+ *                stored here in the order of the configurations.
+ * @return Evaluation result of each configuration, true for success.
+ */
+std::vector<bool>
+DesignSpaceExplorer::evaluateAll(
+    const std::vector<DSDBManager::MachineConfiguration>& configurations,
+    bool estimate, std::vector<CostEstimates>* results) {
+
+    std::vector<CostEstimates> estimates(configurations.size());
+    EvaluationBatch batch;
+    batch.configurations = &configurations;
+    batch.results = &estimates;
+    batch.succeeded.resize(configurations.size(), 0);
+    batch.estimate = estimate;
+    batch.next = 0;
+
+    int threadCount = std::min(
+        jobCount(), static_cast<int>(configurations.size()));
+    if (threadCount <= 1) {
+        for (std::size_t i = 0; i < configurations.size(); ++i) {
+            batch.succeeded[i] = 
+                evaluate(configurations[i], estimates[i], estimate);
+        }
+    } else {
+        boost::thread_group workers;
+        for (int i = 0; i < threadCount; ++i) {
+            workers.create_thread(
+                boost::bind(
+                    &DesignSpaceExplorer::runEvaluationWorker, this,
+                    boost::ref(batch)));
+        }
+        workers.join_all();
+    }
+
+    if (results != NULL) {
+        *results = estimates;
+    }
+    return std::vector<bool>(batch.succeeded.begin(), batch.succeeded.end());
+}
+
+/**
+ * Evaluates configurations of the batch until all have been taken.
+ *
+ * Run by the threads of evaluateAll(). The simulation outputs of the
+ * thread are collected to a stream of its own.
+ *
+ * @param batch The batch the configurations are taken from.
+ */
+void
+DesignSpaceExplorer::runEvaluationWorker(EvaluationBatch& batch) {
+
+    std::ostringstream output;
+    threadOutputStream_ = &output;
+    OperationGlobals::setThreadOutputStream(&output);
+
+    while (true) {
+        std::size_t index = 0;
+        {
+            boost::mutex::scoped_lock lock(batch.lock);
+            if (batch.next == batch.configurations->size()) {
+                break;
+            }
+            index = batch.next++;
+        }
+        try {
+            batch.succeeded[index] = evaluate(
+                (*batch.configurations)[index], (*batch.results)[index],
+                batch.estimate);
+        } catch (const Exception& e) {
+            debugLog(e.errorMessageStack());
+            batch.succeeded[index] = false;
+        }
+    }
+
+    OperationGlobals::setThreadOutputStream(NULL);
+    threadOutputStream_ = NULL;
+}
+
+/**
+ * Sets the number of configurations evaluateAll() evaluates in parallel.
+ *
+ * @param jobs The number of evaluation threads, zero to use the value
+ *             given with the -j option of explore.
+ */
+void
+DesignSpaceExplorer::setJobCount(int jobs) {
+    jobCount_ = jobs;
+}
+
+/**
+ * Returns the number of configurations evaluateAll() evaluates in parallel.
+ *
+ * @return The job count set with setJobCount() or, if it is not set,
+ *         the job count given in the command line options.
+ */
+int
+DesignSpaceExplorer::jobCount() const {
+
+    if (jobCount_ > 0) {
+        return jobCount_;
+    }
+    ExplorerCmdLineOptions* options = 
+        dynamic_cast<ExplorerCmdLineOptions*>(Application::cmdLineOptions());
+    if (options != NULL) {
+        return options->jobCount();
+    }
+    return 1;
+}
+
+/**
+ * Returns the stream the simulation outputs are collected to.
+ *
+ * @return The stream of the calling evaluation thread, or the shared
+ *         stream of the explorer outside evaluateAll().
+ */
+std::ostringstream&
+DesignSpaceExplorer::outputStream() {
+
+    if (threadOutputStream_ != NULL) {
+        return *threadOutputStream_;
+    }
+    return *oStream_;
+}
 
 /**
  * Returns the DSDBManager of the current exploration process.
@@ -306,6 +485,11 @@ DesignSpaceExplorer::db() {
 /**
  * Compiles the given application bytecode file on the given target machine.
  *
+ * If the compiler options only set the optimization level, the program is
+ * compiled in-process with compileInProcess(). Otherwise tcecc is called.
+ * The tcecc runs of parallel evaluations overlap, the in-process
+ * compilations are done one at a time.
+ *
  * @param bytecodeFile Bytecode filename with path.
  * @param target The machine to compile the sequential program against.
  * @param paramOptions Compiler options (if cmdline options are not given)
@@ -318,6 +502,10 @@ DesignSpaceExplorer::schedule(
     TCEString paramOptions) {
 
     TCEString compilerOptions;
+
+    // LLVM has global state, only the tcecc runs of the evaluation threads
+    // are not serialized
+    boost::mutex::scoped_lock compilerLock(compilerLock_);
     
     ExplorerCmdLineOptions* options = 
         dynamic_cast<ExplorerCmdLineOptions*>(Application::cmdLineOptions());
@@ -333,6 +521,24 @@ DesignSpaceExplorer::schedule(
     if (compilerOptions.find("-O") == std::string::npos) {
         compilerOptions += " -O3";        
     }
+
+    int optLevel = -1;
+    std::vector<TCEString> switches = 
+        StringTools::chopString(compilerOptions, " ");
+    for (std::size_t i = 0; i < switches.size(); ++i) {
+        if (switches[i].size() == 3 && switches[i].startsWith("-O") &&
+            isdigit(switches[i][2])) {
+            optLevel = switches[i][2] - '0';
+        } else {
+            optLevel = -1;
+            break;
+        }
+    }
+    if (optLevel != -1) {
+        compilerLock.unlock();
+        return compileInProcess(bytecodeFile, target, optLevel);
+    }
+
     static const std::string DS = FileSystem::DIRECTORY_SEPARATOR;
     
     // create temp directory for the target machine
@@ -350,6 +556,8 @@ DesignSpaceExplorer::schedule(
         throw IOException(
             __FILE__, __LINE__, __func__, exception.errorMessage());
     }     
+    compilerLock.unlock();
+
     // call tcecc to compile, link and schedule the program
     std::vector<std::string> tceccOutputLines;
     std::string tceccPath = Environment::tceCompiler();
@@ -380,6 +588,7 @@ DesignSpaceExplorer::schedule(
     } 
     
     TTAProgram::Program* prog = NULL;
+    compilerLock.lock();
     try {
         prog = TTAProgram::Program::loadFromTPEF(tpef, target);
     } catch (const Exception& e) {
@@ -392,6 +601,92 @@ DesignSpaceExplorer::schedule(
     return prog;        
 }
 
+/**
+ * Compiles and schedules the given bytecode file in the explorer process.
+ *
+ * Does what tcecc does for a linked bytecode file without starting any
+ * processes or writing the machine and the program to files. The bytecode
+ * is parsed only once and each compilation works on a copy of it. The
+ * backend plugins are kept in a temporary directory for the lifetime of
+ * the explorer, thus a machine evaluated with several applications gets
+ * its plugin built only once.
+ *
+ * @param bytecodeFile Bytecode filename with path.
+ * @param target The machine to compile the program for.
+ * @param optLevel The optimization level of the code generator.
+ * @return Scheduled parallel program or NULL if the compilation failed.
+ * @exception FileNotFound If the standard emulation library is missing.
+ */
+TTAProgram::Program*
+DesignSpaceExplorer::compileInProcess(
+    const std::string& bytecodeFile,
+    TTAMachine::Machine& target,
+    int optLevel) {
+
+    const bool debug = Application::verboseLevel() > 0;
+
+    // tcecc -e fails the same way, without the library the operations the
+    // machine lacks would be left unimplemented
+    const std::string emulationLib = Environment::standardEmulationLib(
+        target.isLittleEndian(), target.is64bit());
+    if (emulationLib == "") {
+        std::string errorMessage =
+            "Standard emulation library not found for the target.";
+        Application::errorStream()
+            << "Error: " << errorMessage << std::endl;
+        throw FileNotFound(__FILE__, __LINE__, __func__, errorMessage);
+    }
+
+    // LLVM has global state, so the parallel evaluations compile one at
+    // a time
+    boost::mutex::scoped_lock lock(compilerLock_);
+
+    if (compilerOptions_ != NULL && compilerOptions_->optLevel() != optLevel) {
+        // the compiler passes read the optimization level from the options
+        delete compiler_;
+        compiler_ = NULL;
+        delete compilerOptions_;
+        compilerOptions_ = NULL;
+    }
+
+    if (compilerTempDir_ == "") {
+        compilerTempDir_ = FileSystem::createTempDirectory();
+    }
+
+    if (compilerOptions_ == NULL) {
+        compilerOptions_ = new LLVMTCECmdLineOptions();
+        std::vector<std::string> args;
+        args.push_back("llvm-tce");
+        args.push_back("--temp-dir=" + compilerTempDir_);
+        args.push_back("--backend-cache-dir=" + compilerTempDir_);
+        args.push_back("-O" + Conversion::toString(optLevel));
+        compilerOptions_->parse(args);
+    }
+
+    TTAProgram::Program* program = NULL;
+    InterPassData ipData;
+    try {
+        if (compiler_ == NULL) {
+            LLVMBackend::initializeLLVMOptions();
+            // the backend makes the options those of the compiling thread
+            // only, the other threads keep reading the explorer's options
+            compiler_ = new LLVMBackend(
+                Application::isInstalled(), compilerTempDir_,
+                compilerOptions_);
+            compiler_->setBytecodeCaching(true);
+        }
+        program = compiler_->compile(
+            bytecodeFile, emulationLib, target, optLevel, false, &ipData);
+    } catch (const Exception& e) {
+        if (debug) {
+            std::cout << "in-process compilation of " << bytecodeFile
+                      << " failed: " << e.errorMessageStack() << std::endl;
+        }
+        program = NULL;
+    }
+    return program;
+}
+
 /**
  * Simulates the parallel program.
  *
@@ -446,7 +741,7 @@ DesignSpaceExplorer::simulate(
     if (testApplication.hasSimulateTTASim()) {
         std::string command = "";
         std::istream* input = testApplication.simulateTTASim();
-        BaseLineReader reader(*input, *oStream_);
+        BaseLineReader reader(*input, outputStream());
         reader.initialize();
         reader.setPromptPrinting(false);
         SimulatorInterpreterContext interpreterContext(simulator);
@@ -457,7 +752,7 @@ DesignSpaceExplorer::simulate(
             } catch (const EndOfFile&) {
                 interpreter.interpret(SIM_INTERP_QUIT_COMMAND);
                 if (interpreter.result().size() > 0) {
-                    *oStream_ << interpreter.result() << std::endl;
+                    outputStream() << interpreter.result() << std::endl;
                 }
                 break;
             }
@@ -467,20 +762,20 @@ DesignSpaceExplorer::simulate(
             }
             interpreter.interpret(command);
             if (interpreter.result().size() > 0) {
-                *oStream_ << interpreter.result() << std::endl;
+                outputStream() << interpreter.result() << std::endl;
             }
         }
         delete input;
         input = NULL;
     } else {
         // no 'simulate.ttasim' file
-        BaseLineReader reader(std::cin, *oStream_);
+        BaseLineReader reader(std::cin, outputStream());
         reader.initialize();
         SimulatorInterpreterContext interpreterContext(simulator);
         SimulatorInterpreter interpreter(0, NULL, interpreterContext, reader);
         simulator.run();
         if (interpreter.result().size() > 0) {
-            *oStream_ << interpreter.result() << std::endl;
+            outputStream() << interpreter.result() << std::endl;
         }
     }
 
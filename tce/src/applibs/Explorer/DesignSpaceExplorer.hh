@@ -36,6 +36,8 @@
 #include <set>
 #include <vector>
 #include <istream>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 #include "Application.hh"
 #include "Exception.hh"
 #include "SimulatorConstants.hh"
@@ -48,6 +50,8 @@
 class CostEstimates;
 class ExecutionTrace;
 class DesignSpaceExplorerPlugin;
+class LLVMBackend;
+class LLVMTCECmdLineOptions;
 
 namespace TTAMachine {
     class Machine;
@@ -78,6 +82,13 @@ public:
         const DSDBManager::MachineConfiguration& configuration,
         CostEstimates& results=dummyEstimate_, bool estimate=false);
 
+    virtual std::vector<bool> evaluateAll(
+        const std::vector<DSDBManager::MachineConfiguration>& configurations,
+        bool estimate=false, std::vector<CostEstimates>* results=NULL);
+
+    void setJobCount(int jobs);
+    int jobCount() const;
+
     virtual DSDBManager& db();
     static DesignSpaceExplorerPlugin* loadExplorerPlugin(
         const std::string& pluginName, DSDBManager* dsdb = NULL);
@@ -119,6 +130,11 @@ protected:
         TTAMachine::Machine& machine,
         TCEString paramOptions = "-O3");
 
+    TTAProgram::Program* compileInProcess(
+        const std::string& bytecodeFile,
+        TTAMachine::Machine& target,
+        int optLevel);
+
     const ExecutionTrace* simulate(
         const TTAProgram::Program& program, const TTAMachine::Machine& machine,
         const TestApplication& testApplication,
@@ -127,6 +143,26 @@ protected:
         std::vector<ClockCycleCount>* executionCounts = NULL);
 
 private:
+    /// The configurations of one evaluateAll() call, shared by the
+    /// evaluation threads.
+    struct EvaluationBatch {
+        /// The configurations to evaluate.
+        const std::vector<DSDBManager::MachineConfiguration>* configurations;
+        /// The cost estimates of the configurations.
+        std::vector<CostEstimates>* results;
+        /// Evaluation results of the configurations, nonzero for success.
+        std::vector<int> succeeded;
+        /// Whether the configurations are estimated.
+        bool estimate;
+        /// Index of the next configuration to evaluate.
+        std::size_t next;
+        /// Serializes taking configurations from the batch.
+        boost::mutex lock;
+    };
+
+    void runEvaluationWorker(EvaluationBatch& batch);
+    std::ostringstream& outputStream();
+
     /// Design space database where results are stored.
     DSDBManager* dsdb_;
     /// The plugin tool.
@@ -135,9 +171,27 @@ private:
     CostEstimator::Estimator estimator_;
     /// Output stream.
     std::ostringstream* oStream_;
+    /// Output stream of the evaluation thread, overrides oStream_.
+    static thread_local std::ostringstream* threadOutputStream_;
     /// Used for the default evaluate() argument.
     static CostEstimates dummyEstimate_;
-
+    /// The in-process compiler, created at the first compilation.
+    LLVMBackend* compiler_;
+    /// The llvm-tce options the in-process compiler passes read.
+    LLVMTCECmdLineOptions* compilerOptions_;
+    /// Directory for the backend plugins and the temporary files of
+    /// the in-process compiler.
+    std::string compilerTempDir_;
+    /// Number of configurations evaluateAll() evaluates in parallel,
+    /// zero to use the value of the command line option.
+    int jobCount_;
+    /// Serializes the accesses to the DSDB of parallel evaluations.
+    boost::recursive_mutex dsdbLock_;
+    /// Serializes the cost estimations of parallel evaluations.
+    boost::mutex estimatorLock_;
+    /// Serializes the compilations and the program loading of parallel
+    /// evaluations, the compiler and the TPEF reader have global state.
+    boost::mutex compilerLock_;
 };
 
 #endif
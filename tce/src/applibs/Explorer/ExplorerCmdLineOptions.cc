@@ -108,6 +108,10 @@ const std::string SWL_IDF_FILE = "idf";
 const std::string SWS_COMPILER_OPTIONS = "f";
 /// Long switch string of options to pass to compiler
 const std::string SWL_COMPILER_OPTIONS = "compiler_options";
+/// Short switch string for the number of parallel evaluations.
+const std::string SWS_JOBS = "j";
+/// Long switch string for the number of parallel evaluations.
+const std::string SWL_JOBS = "jobs";
 
 /**
  * Constructor.
@@ -206,6 +210,12 @@ ExplorerCmdLineOptions::ExplorerCmdLineOptions() : CmdLineOptions("") {
             SWL_COMPILER_OPTIONS,
             "Options to pass to the compiler.",
             SWS_COMPILER_OPTIONS));
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_JOBS,
+            "Number of machine configurations the explorer plugins may "
+            "evaluate in parallel. The default is 1.",
+            SWS_JOBS));
     addOption(
         new StringCmdLineOptionParser(
             SWL_ADF_OUT_FILE,
@@ -623,3 +633,19 @@ ExplorerCmdLineOptions::compilerOptionsString() const {
     }
     return optsString;
 }
+
+/**
+ * Returns the number of configurations that may be evaluated in parallel.
+ *
+ * @return The number of evaluation jobs, one if the option was not given.
+ */
+int
+ExplorerCmdLineOptions::jobCount() const {
+
+    if (findOption(SWL_JOBS)->isDefined() &&
+        findOption(SWL_JOBS)->integer() > 1) {
+        return findOption(SWL_JOBS)->integer();
+    } else {
+        return 1;
+    }
+}
@@ -85,6 +85,8 @@ public:
     bool compilerOptions() const;
     std::string compilerOptionsString() const;
 
+    int jobCount() const;
+
 private:
     /// Copying not allowed.
     ExplorerCmdLineOptions(const ExplorerCmdLineOptions&);
@@ -59,6 +59,7 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/Scalar.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/FormattedStream.h>
@@ -84,6 +85,7 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 
 #include <llvm/Support/TargetRegistry.h>
 #include "llvm/Support/FileSystem.h"
+#include <llvm/Support/LockFileManager.h>
 
 #include <llvm/InitializePasses.h>
 
@@ -92,6 +94,8 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 
 #include <cstdlib> // system()
 #include <fstream>
+#include <sstream>
+#include <boost/functional/hash.hpp>
 
 #include "LLVMBackend.hh"
 #include "LLVMTCECmdLineOptions.hh"
@@ -118,6 +122,7 @@ IGNORE_COMPILER_WARNING("-Wcomment")
 #include "Machine.hh"
 #include "MachineInfo.hh"
 #include "ConstantTransformer.hh"
+#include "MapTools.hh"
 //#define DEBUG_TDGEN
 
 #define DS TCEString(FileSystem::DIRECTORY_SEPARATOR)
@@ -134,6 +139,8 @@ POP_COMPILER_DIAGS
 const std::string LLVMBackend::TBLGEN_INCLUDES = "";
 const std::string LLVMBackend::PLUGIN_PREFIX = "tcecc-";
 const std::string LLVMBackend::PLUGIN_SUFFIX = ".so";
+/// Seconds to wait for another process to build the same plugin.
+const unsigned LLVMBackend::PLUGIN_BUILD_TIMEOUT = 600;
 const TCEString LLVMBackend::CXX0X_FLAG = "-std=c++0x";
 const TCEString LLVMBackend::CXX11_FLAG = "-std=c++11";
 const TCEString LLVMBackend::CXX14_FLAG = "-std=c++14";
@@ -319,14 +326,21 @@ LLVMBackend::llvmRequiredOpset(bool includeFloatOps, bool littleEndian, bool bit
  * installed TCE (not from the source/build tree).
  * @param tempDir An existing directory where to store temporary files.
  *                The directory should be removed by the caller after use.
+ * @param options The compiler options, not owned by the backend. If NULL,
+ *                the command line options of the application are used.
  */
-LLVMBackend::LLVMBackend(bool useInstalledVersion, TCEString tempDir) : 
-    useInstalledVersion_(useInstalledVersion), tempDir_(tempDir) {
+LLVMBackend::LLVMBackend(
+    bool useInstalledVersion, TCEString tempDir,
+    LLVMTCECmdLineOptions* options) :
+    useInstalledVersion_(useInstalledVersion), tempDir_(tempDir),
+    options_(options), cacheBytecode_(false), cacheContext_(NULL) {
 
     cachePath_ = Environment::llvmtceCachePath();
 
-    options_ =
-        dynamic_cast<LLVMTCECmdLineOptions*>(Application::cmdLineOptions());
+    if (options_ == NULL) {
+        options_ = dynamic_cast<LLVMTCECmdLineOptions*>(
+            Application::cmdLineOptions());
+    }
 
     if (options_ != NULL)
         cachePath_ = options_->backendCacheDir();
@@ -345,6 +359,122 @@ LLVMBackend::LLVMBackend(bool useInstalledVersion, TCEString tempDir) :
  * Destructor.
  */
 LLVMBackend::~LLVMBackend() {
+    MapTools::deleteAllValues(cachedModules_);
+    delete cacheContext_;
+}
+
+/**
+ * Sets whether the parsed bytecode files are kept for later compilations.
+ *
+ * Tools which compile the same program for many machines, such as the
+ * design space explorer, can avoid parsing the bytecode again for each
+ * machine. Each compilation works on a copy of the cached module. The
+ * cached program modules get their intrinsics lowered once after parsing,
+ * like tcecc does before calling llvm-tce. The files must not change
+ * while they are cached.
+ *
+ * @param cache True to enable caching.
+ */
+void
+LLVMBackend::setBytecodeCaching(bool cache) {
+    cacheBytecode_ = cache;
+    if (!cache) {
+        MapTools::deleteAllValues(cachedModules_);
+        cachedModules_.clear();
+    }
+}
+
+/**
+ * Sets the LLVM command line options llvm-tce uses for code generation.
+ *
+ * Has to be called once before the first compilation in a process.
+ * Calling it again does nothing.
+ */
+void
+LLVMBackend::initializeLLVMOptions() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+    const char* argv[] = {"llvm-tce", "--no-stack-coloring"};
+    llvm::cl::ParseCommandLineOptions(2, argv, "llvm linker\n");
+    initialized = true;
+}
+
+/**
+ * Parses a bytecode file to a module.
+ *
+ * @param bytecodeFile The file to parse.
+ * @param context The context to own the module.
+ * @return The parsed module.
+ * @exception CompileError If the file cannot be read or parsed.
+ */
+std::unique_ptr<llvm::Module>
+LLVMBackend::loadModule(
+    const std::string& bytecodeFile, llvm::LLVMContext& context) {
+
+    ErrorOr<std::unique_ptr<MemoryBuffer>> bufferPtr =
+        MemoryBuffer::getFileOrSTDIN(bytecodeFile.c_str());
+
+    if (std::error_code ec = bufferPtr.getError()) {
+        std::string msg = "Error reading bytecode file: " + bytecodeFile +
+            "\n" + ec.message();
+        throw CompileError(__FILE__, __LINE__, __func__, msg);
+    } 
+
+    std::unique_ptr<MemoryBuffer> buffer = std::move(bufferPtr.get());
+    Expected<std::unique_ptr<llvm::Module> > module =
+        parseBitcodeFile(buffer.get()->getMemBufferRef(), context);
+    if (Error E = module.takeError()) {
+        THROW_EXCEPTION(CompileError, "Error parsing bytecode file: "
+            + bytecodeFile);
+    }
+
+    std::unique_ptr<llvm::Module> m = std::move(module.get());
+    if (m.get() == 0) {
+        std::string msg = "Error parsing bytecode file: " + bytecodeFile;
+        throw CompileError(__FILE__, __LINE__, __func__, msg);
+    }
+    return m;
+}
+
+/**
+ * Returns the cached module of the given bytecode file, parsing it first
+ * if needed.
+ *
+ * @param bytecodeFile The file to parse.
+ * @param lowerIntrinsics True to lower the intrinsics the code generator
+ *                        does not support after parsing.
+ * @return The cached module, which must not be modified.
+ * @exception CompileError If the file cannot be read or parsed.
+ */
+llvm::Module&
+LLVMBackend::cachedModule(
+    const std::string& bytecodeFile, bool lowerIntrinsics) {
+
+    std::map<std::string, llvm::Module*>::iterator cached =
+        cachedModules_.find(bytecodeFile);
+    if (cached != cachedModules_.end()) {
+        return *cached->second;
+    }
+
+    if (cacheContext_ == NULL) {
+        cacheContext_ = new LLVMContext();
+    }
+    std::unique_ptr<llvm::Module> m = loadModule(bytecodeFile, *cacheContext_);
+
+    if (lowerIntrinsics) {
+        const PassInfo* lowering =
+            PassRegistry::getPassRegistry()->getPassInfo("lowerintrinsics");
+        assert(lowering != NULL && "LowerIntrinsics pass not registered.");
+        llvm::legacy::PassManager passes;
+        passes.add(lowering->createPass());
+        passes.run(*m);
+    }
+
+    llvm::Module* module = m.release();
+    cachedModules_[bytecodeFile] = module;
+    return *module;
 }
 
 /**
@@ -360,6 +490,9 @@ LLVMBackend::compile(
     const std::string& bytecodeFile, const std::string& emulationBytecodeFile,
     TTAMachine::Machine& target, int optLevel, bool debug,
     InterPassData* ipData) {
+    // the passes and the plugin read the options through Application
+    Application::ThreadCmdLineOptions threadOptions(options_);
+
     // Check target machine
     MachineValidator validator(target);
     std::set<MachineValidator::ErrorCode> checks;
@@ -380,68 +513,20 @@ LLVMBackend::compile(
     }
 
     // Load bytecode file.
-    std::string errMsgParse;
     LLVMContext context;
 
     std::unique_ptr<llvm::Module> m;
-
-    ErrorOr<std::unique_ptr<MemoryBuffer>> bufferPtr =
-        MemoryBuffer::getFileOrSTDIN(bytecodeFile.c_str());
-
-    if (std::error_code ec = bufferPtr.getError()) {
-        std::string msg = "Error reading bytecode file: " + bytecodeFile +
-            "\n" + ec.message();
-        throw CompileError(__FILE__, __LINE__, __func__, msg);
-    } 
-
-    // todo: what are these buffers..
-    std::unique_ptr<MemoryBuffer> buffer = std::move(bufferPtr.get());
-    Expected<std::unique_ptr<llvm::Module> > module =
-        parseBitcodeFile(buffer.get()->getMemBufferRef(), context);
-    if (Error E = module.takeError()) {
-        THROW_EXCEPTION(CompileError, "Error parsing bytecode file: "
-            + bytecodeFile);
-    }
-
-    // TODO: why does this work? it should not?
-//    m.reset(module.get().get());
-    m = std::move(module.get());
-
-    if (m.get() == 0) {
-        std::string msg = "Error parsing bytecode file: " + bytecodeFile +
-            "\n" + errMsgParse;
-        throw CompileError(__FILE__, __LINE__, __func__, msg);
-    }
-
     std::unique_ptr<Module> emuM;
-   
-    if (!emulationBytecodeFile.empty()) {
-        ErrorOr<std::unique_ptr<MemoryBuffer>> emuBufferPtr =
-            MemoryBuffer::getFileOrSTDIN(emulationBytecodeFile.c_str());
-
-        if (std::error_code ec = emuBufferPtr.getError()) {
-            std::string msg = "Error reading bytecode file: " + 
-                emulationBytecodeFile +
-                " of emulation library:\n" + ec.message();
-            throw CompileError(__FILE__, __LINE__, __func__, msg);
-        }
 
-        std::unique_ptr<MemoryBuffer> emuBuffer = 
-            std::move(emuBufferPtr.get());
-        Expected<std::unique_ptr<Module> > module =
-            parseBitcodeFile(emuBuffer.get()->getMemBufferRef(), context);
-        if (Error E = module.takeError()) {
-            THROW_EXCEPTION(CompileError, "Error parsing bytecode file: " +
-                emulationBytecodeFile + " of emulation library \n"
-                + errMsgParse);
+    if (cacheBytecode_) {
+        m = CloneModule(cachedModule(bytecodeFile, true));
+        if (!emulationBytecodeFile.empty()) {
+            emuM = CloneModule(cachedModule(emulationBytecodeFile, false));
         }
-
-        emuM = std::move(module.get());
-        if (emuM.get() == 0) {
-            std::string msg = "Error parsing bytecode file: " + 
-                emulationBytecodeFile + " of emulation library \n" 
-                + errMsgParse;
-            throw CompileError(__FILE__, __LINE__, __func__, msg);
+    } else {
+        m = loadModule(bytecodeFile, context);
+        if (!emulationBytecodeFile.empty()) {
+            emuM = loadModule(emulationBytecodeFile, context);
         }
     }
 
@@ -452,32 +537,40 @@ LLVMBackend::compile(
     std::unique_ptr<TCETargetMachinePlugin> plugin(createPlugin(target));
 #endif
 
+    // The module of a cached compilation lives in the cache context,
+    // thus it has to be deleted explicitly. The emulation module is
+    // consumed by linking it to the program.
+    llvm::Module* module = m.release();
     TTAProgram::Program* result = NULL;
     try {
         // Compile.
         result =
-            compile(*m.release(), emuM.release(), *plugin, target, optLevel,
+            compile(*module, emuM.release(), *plugin, target, optLevel,
                     debug, ipData);
     } catch (...) {
+        if (cacheBytecode_) {
+            delete module;
+        }
         // delete the backend plugin if we don't want to save it
         // Let's hope this doesn't crash as the plugin is loaded to the
         // current process. TCETargetMachinePlugin dtor should unload it.
         if (!options_->saveBackendPlugin()) {
-            TCEString pluginPath = 
-                cachePath_ + DS + pluginFilename(target);
+            TCEString pluginPath = cachePath_ + DS + pluginFile_;
             FileSystem::removeFileOrDirectory(pluginPath);
         }
         delete res; res = NULL;
         
         throw;
     }
+    if (cacheBytecode_) {
+        delete module;
+    }
 
     // delete the backend plugin if we don't want to save it
     // Let's hope this doesn't crash as the plugin is loaded to the
     // current process. TCETargetMachinePlugin dtor should unload it.
     if (!options_->saveBackendPlugin()) {
-        TCEString pluginPath = 
-            cachePath_ + DS + pluginFilename(target);
+        TCEString pluginPath = cachePath_ + DS + pluginFile_;
         FileSystem::removeFileOrDirectory(pluginPath);
     }
     delete res; res = NULL;
@@ -568,6 +661,7 @@ LLVMBackend::compile(
     llvm::Module& module, llvm::Module* emulationModule,
     TCETargetMachinePlugin& plugin, TTAMachine::Machine& target, int optLevel,
     bool /*debug*/, InterPassData* ipData) {
+    Application::ThreadCmdLineOptions threadOptions(options_);
     ipData_ = ipData;
     // TODO: fixme
     std::string targetStr = "tce-llvm";
@@ -791,13 +885,20 @@ LLVMBackend::compile(
 /**
  * Creates TCETargetMachinePlugin for target architecture.
  *
+ * The plugin is loaded from the plugin cache if a plugin with the same
+ * signature has been built before, see pluginFilename(). Compilations
+ * running in parallel build a missing plugin only once: the first one
+ * builds it while the others wait for it to appear in the cache.
+ *
  * @param target Target machine to build plugin for.
  */
 TCETargetMachinePlugin*
 LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
+    // also generates the backend sources to the temp dir
     std::string pluginFile = pluginFilename(target);
     std::string pluginFileName;
     std::string tempPluginFileName;
+    pluginFile_ = pluginFile;
 
     // Create cache directory if it doesn't exist.
     if (!FileSystem::fileIsDirectory(cachePath_)) {
@@ -805,8 +906,29 @@ LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
     }
 
     pluginFileName = cachePath_ + DS + pluginFile;
-    tempPluginFileName = cachePath_ + DS + pluginFile + ".%%_%%_%%_%%";
 
+    TCETargetMachinePlugin* cachedPlugin = loadCachedPlugin(pluginFile);
+    if (cachedPlugin != NULL) {
+        return cachedPlugin;
+    }
+
+    // The lock is held until the plugin has been moved to the cache. If
+    // the lock cannot be created, the plugin is built without it.
+    llvm::LockFileManager pluginLock(pluginFileName);
+    if (pluginLock == llvm::LockFileManager::LFS_Shared) {
+        if (Application::verboseLevel() > 0) {
+            Application::logStream()
+                << "LLVMBackend: waiting for another process to build "
+                << pluginFileName << std::endl;
+        }
+        pluginLock.waitForUnlock(PLUGIN_BUILD_TIMEOUT);
+        cachedPlugin = loadCachedPlugin(pluginFile);
+        if (cachedPlugin != NULL) {
+            return cachedPlugin;
+        }
+    }
+
+    tempPluginFileName = cachePath_ + DS + pluginFile + ".%%_%%_%%_%%";
     llvm::SmallString<128> ResultPath;
     llvm::sys::fs::createUniqueFile(llvm::Twine(tempPluginFileName), ResultPath);
     tempPluginFileName = ResultPath.str().str();
@@ -844,44 +966,6 @@ LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
 
     }
 
-
-    if (FileSystem::fileExists(pluginFileName) &&
-        FileSystem::fileIsReadable(pluginFileName)) {
-
-        try {
-            pluginTool_.addSearchPath(cachePath_);
-            pluginTool_.registerModule(pluginFile);
-            TCETargetMachinePlugin* (*creator)();
-            pluginTool_.importSymbol(
-                "create_tce_backend_plugin", creator, pluginFile);
-
-            return creator();
-        } catch(Exception& e) {
-            if (Application::verboseLevel() > 0) {
-                Application::logStream()
-                    << "Unable to load plugin file " << pluginFileName 
-                    << ": " << e.errorMessage() << ", "
-                    << "regenerating..." << std::endl;
-            }
-        }
-    }
-
-    if (!options_->useOldBackendSources()) {
-        // Create target instruction and register definitions in .td files.
-        TDGen* pluginGenPtr = new TDGen(target);
-
-        try {
-            pluginGenPtr->generateBackend(tempDir_);
-            delete pluginGenPtr;
-        } catch(Exception& e) {
-            std::string msg =
-                "Failed to build compiler plugin for target architecture: ";
-            msg += e.errorMessage();
-            CompileError ne(__FILE__, __LINE__, __func__, msg);
-            ne.setCause(e);
-            throw ne;
-        }
-    }
     std::string tblgenbin = "llvm-tblgen";
 
     // Generate TCEGenRegisterNames.inc
@@ -1078,15 +1162,106 @@ LLVMBackend::createPlugin(const TTAMachine::Machine& target) {
  * incompatible backend plugins between TCE revisions.
  *  The filename is used for cached plugins.
  *
+ * The name is based on the signature of the machine, see
+ * machineSignature(), thus machines that get the same backend share the
+ * cached plugin. Computing the signature generates the backend sources
+ * to the temporary directory.
+ *
  * @param target Target architecture.
  * @return Filename for the target architecture.
  */
 std::string
 LLVMBackend::pluginFilename(
     const TTAMachine::Machine& target) {
-    TCEString fileName = target.hash();
+    TCEString fileName;
+    if (options_ != NULL && options_->useOldBackendSources()) {
+        // the sources are not generated from the machine
+        fileName = target.hash();
+    } else {
+        fileName = machineSignature(target);
+    }
     fileName += "-" + Application::TCEVersionString();
     fileName += PLUGIN_SUFFIX;
 
     return fileName;
 }
+
+/**
+ * Returns a signature of the machine properties the backend plugin uses.
+ *
+ * The plugin is built only from the sources TDGen generates and the
+ * endianness and the bitness of the machine. The signature is a hash of
+ * those, thus it changes only when something TDGen reads changes, e.g.,
+ * the operation set, the register files, the guards or the address
+ * spaces. Adding a bus to a fully connected machine does not change it.
+ *
+ * @param target Target architecture.
+ * @return The signature as a string usable in a file name.
+ * @exception CompileError If TDGen fails to generate the sources.
+ */
+std::string
+LLVMBackend::machineSignature(const TTAMachine::Machine& target) {
+
+    TDGen generator(target);
+    try {
+        generator.generateBackend(tempDir_);
+    } catch(Exception& e) {
+        std::string msg =
+            "Failed to build compiler plugin for target architecture: ";
+        msg += e.errorMessage();
+        CompileError ne(__FILE__, __LINE__, __func__, msg);
+        ne.setCause(e);
+        throw ne;
+    }
+
+    std::ostringstream contents;
+    contents << (target.isLittleEndian() ? "little" : "big") << " "
+             << (target.is64bit() ? "64" : "32") << std::endl;
+    const std::vector<std::string>& files = generator.generatedFiles();
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        std::ifstream file((tempDir_ + DS + files[i]).c_str());
+        contents << files[i] << std::endl << file.rdbuf() << std::endl;
+    }
+
+    boost::hash<std::string> stringHasher;
+    std::string data = contents.str();
+    TCEString signature = Conversion::toHexString(data.length()).substr(2);
+    signature += "_";
+    signature += Conversion::toHexString(stringHasher(data)).substr(2);
+    return signature;
+}
+
+/**
+ * Loads the plugin with the given name from the plugin cache.
+ *
+ * @param pluginFile File name of the plugin in the cache directory.
+ * @return The plugin, or NULL if it is not in the cache or cannot be
+ * loaded.
+ */
+TCETargetMachinePlugin*
+LLVMBackend::loadCachedPlugin(const std::string& pluginFile) {
+
+    std::string pluginFileName = cachePath_ + DS + pluginFile;
+    if (!FileSystem::fileExists(pluginFileName) ||
+        !FileSystem::fileIsReadable(pluginFileName)) {
+        return NULL;
+    }
+
+    try {
+        pluginTool_.addSearchPath(cachePath_);
+        pluginTool_.registerModule(pluginFile);
+        TCETargetMachinePlugin* (*creator)();
+        pluginTool_.importSymbol(
+            "create_tce_backend_plugin", creator, pluginFile);
+
+        return creator();
+    } catch(Exception& e) {
+        if (Application::verboseLevel() > 0) {
+            Application::logStream()
+                << "Unable to load plugin file " << pluginFileName 
+                << ": " << e.errorMessage() << ", "
+                << "regenerating..." << std::endl;
+        }
+    }
+    return NULL;
+}
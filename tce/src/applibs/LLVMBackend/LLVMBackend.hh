@@ -35,6 +35,8 @@
 #define LLVM_TCE_HH
 
 #include <string>
+#include <map>
+#include <memory>
 
 #include "Exception.hh"
 #include "PluginTools.hh"
@@ -50,6 +52,7 @@ namespace TTAMachine {
 
 namespace llvm {
     class Module;
+    class LLVMContext;
     class TCETargetMachinePlugin;
 }
 
@@ -65,7 +68,9 @@ public:
     static OperationDAGSelector::OperationSet 
     llvmRequiredOpset(bool includeFloatOps, bool isLittleEndian, bool bits64);
 
-    LLVMBackend(bool useInstalledVersion, TCEString tempDir);
+    LLVMBackend(
+        bool useInstalledVersion, TCEString tempDir,
+        LLVMTCECmdLineOptions* options = NULL);
     virtual ~LLVMBackend();
 
     TTAProgram::Program* compile(
@@ -87,11 +92,26 @@ public:
         const TTAMachine::Machine& target);
 
     std::string pluginFilename(const TTAMachine::Machine& target);
+    /// Returns the file name of the plugin created last by createPlugin().
+    const std::string& createdPluginFilename() const { return pluginFile_; }
+
+    void setBytecodeCaching(bool cache);
+
+    static void initializeLLVMOptions();
 
 private:
 
+    std::unique_ptr<llvm::Module> loadModule(
+        const std::string& bytecodeFile, llvm::LLVMContext& context);
+    llvm::Module& cachedModule(
+        const std::string& bytecodeFile, bool lowerIntrinsics);
+
     unsigned maxAllocaAlignment(const llvm::Module& mod) const;
 
+    std::string machineSignature(const TTAMachine::Machine& target);
+    llvm::TCETargetMachinePlugin* loadCachedPlugin(
+        const std::string& pluginFile);
+
     /// Assume we are running an installed TCE version.
     bool useInstalledVersion_;
 
@@ -101,14 +121,25 @@ private:
     TCEString cachePath_;
     /// Directory to store temporary files.
     TCEString tempDir_;
+    /// File name of the plugin created last by createPlugin().
+    std::string pluginFile_;
 
+    /// The compiler options, set as the options of the compiling thread.
     LLVMTCECmdLineOptions* options_;
 
     InterPassData* ipData_;
 
+    /// True if the parsed bytecode files are kept for later compilations.
+    bool cacheBytecode_;
+    /// The context owning the cached modules.
+    llvm::LLVMContext* cacheContext_;
+    /// The parsed bytecode files indexed by file name.
+    std::map<std::string, llvm::Module*> cachedModules_;
+
     static const std::string TBLGEN_INCLUDES;
     static const std::string PLUGIN_PREFIX;
     static const std::string PLUGIN_SUFFIX;
+    static const unsigned PLUGIN_BUILD_TIMEOUT;
     static const TCEString CXX0X_FLAG;
     static const TCEString CXX11_FLAG;
     static const TCEString CXX14_FLAG;
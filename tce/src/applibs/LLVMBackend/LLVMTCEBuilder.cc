@@ -2537,7 +2537,8 @@ LLVMTCEBuilder::emitReturn(
         *UniversalMachine::instance().controlUnit()->operation("jump");
 
     OperationPool pool;
-    const Operation& operation = pool.operation("jump");    
+    static const OperationPool::OpId jumpID = pool.operationID("jump");
+    const Operation& operation = pool.operation(jumpID);
 
     TTAProgram::TerminalFUPort* dst = new TTAProgram::TerminalFUPort(jump, 1);
     auto move = createMove(src, dst, bus);
@@ -3552,11 +3553,13 @@ LLVMTCEBuilder::emitGlobalXXtructorCalls(
                             UniversalMachine::instance().universalBus());
 
                     OperationPool opPool;
+                    static const OperationPool::OpId callID =
+                        opPool.operationID("call");
                     
                     // Create ProgramOperation also for return so DDGBuilder does not have
                     // to do that.
                     ProgramOperationPtr po(
-                        new ProgramOperation(opPool.operation("call")));
+                        new ProgramOperation(opPool.operation(callID)));
                     createMoveNode(po, ctrCall, true);
 
                     TTAProgram::Instruction* newInstr =
@@ -85,6 +85,9 @@ const std::string LLVMTCECmdLineOptions::SWL_GEN_PLUGIN_ONLY =
 
 const std::string LLVMTCECmdLineOptions::SWL_ASSUME_ADF_STACKALIGNMENT =
     "assume-adf-stackalignment";
+
+const std::string LLVMTCECmdLineOptions::SWL_SCHEDULER_THREADS =
+    "scheduler-threads";
 /**
  * Constructor.
  */
@@ -220,6 +223,12 @@ LLVMTCECmdLineOptions::LLVMTCECmdLineOptions() {
 	new BoolCmdLineOptionParser(
             SWL_ASSUME_ADF_STACKALIGNMENT,
             "Assume size of stackalignment based on biggest memory operations in the adf."));
+
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_SCHEDULER_THREADS,
+            "Count of threads scheduling the procedures concurrently. "
+            "0 uses one thread per hardware thread. Default is 1."));
 }
 
 /**
@@ -433,3 +442,17 @@ bool
 LLVMTCECmdLineOptions::assumeADFStackAlignment() const {
     return findOption(SWL_ASSUME_ADF_STACKALIGNMENT)->isDefined();
 }
+
+/**
+ * Returns the count of threads to schedule procedures in.
+ *
+ * @return The thread count, 0 for one thread per hardware thread, 1 if
+ *         the switch was not given.
+ */
+int
+LLVMTCECmdLineOptions::schedulerThreads() const {
+    if (!findOption(SWL_SCHEDULER_THREADS)->isDefined()) {
+        return 1;
+    }
+    return findOption(SWL_SCHEDULER_THREADS)->integer();
+}
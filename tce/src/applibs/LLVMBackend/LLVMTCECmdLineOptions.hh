@@ -99,6 +99,7 @@ public:
     bool generatePluginOnly() const;
     bool disableAddressSpaceAA() const;
     bool assumeADFStackAlignment() const;
+    int schedulerThreads() const;
 
     virtual void printVersion() const {
         std::cout
@@ -141,6 +142,7 @@ private:
     static const std::string SWL_PRINT_INLINE_ASM_WARNINGS;
     static const std::string SWL_GEN_PLUGIN_ONLY;
     static const std::string SWL_ASSUME_ADF_STACKALIGNMENT;
+    static const std::string SWL_SCHEDULER_THREADS;
 };
 
 #endif
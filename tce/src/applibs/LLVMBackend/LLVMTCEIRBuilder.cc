@@ -60,6 +60,7 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 #include "Program.hh"
 #include "RegisterCopyAdder.hh"
 #include "LLVMTCECmdLineOptions.hh"
+#include "Application.hh"
 #include "Instruction.hh"
 #include "FunctionUnit.hh"
 #include "HWOperation.hh"
@@ -71,8 +72,11 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 #include "PostpassOperandSharer.hh"
 #include "CallsToJumps.hh"
 #include "AbsoluteToRelativeJumps.hh"
+#include "UniversalMachine.hh"
 
 #include <stdlib.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/MC/MCSymbol.h>
@@ -107,9 +111,22 @@ LLVMTCEIRBuilder::LLVMTCEIRBuilder(
     LLVMTCEBuilder(tm, mach, ID, functionAtATime), ipData_(&ipd), 
     ddgBuilder_(ipd), AA_(AA), modifyMF_(modifyMF),
     scheduler_(NULL), dsf_(NULL),
-    bypasser_(NULL), loopFinder_(NULL) {
+    bypasser_(NULL), loopFinder_(NULL), schedulerThreadCount_(1),
+    nextSchedulingJob_(0), schedulingJobsClosed_(false) {
     RegisterCopyAdder::findTempRegisters(*mach, ipd);
 
+    // procedures compiled one at a time or written back to the machine
+    // functions are always scheduled in the pass
+    if (options_ != NULL && !functionAtATime_ && !modifyMF_) {
+        int threads = options_->schedulerThreads();
+        if (threads == 0) {
+            threads = boost::thread::hardware_concurrency();
+        }
+        if (threads > 1) {
+            schedulerThreadCount_ = threads;
+        }
+    }
+
     if (functionAtATime_) {
         const TTAMachine::Machine::FunctionUnitNavigator fuNav =
             mach->functionUnitNavigator();
@@ -164,25 +181,34 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
     TTAProgram::Procedure* procedure = 
         new TTAProgram::Procedure(fnName, *as);   
 
-    if (!functionAtATime_) {
+    if (schedulerThreadCount_ > 1) {
+        // the procedures are added to the program in module order once
+        // they all have their code, so filling them does not relocate
+        // the procedures after them over and over
+        pendingProcedures_.push_back(procedure);
+    } else if (!functionAtATime_) {
         prog_->addProcedure(procedure);
     } 
     
+    bool fastCompilation = options_ != NULL && options_->optLevel() == 0;
+    bool optimized = !fastCompilation && isHotFunction(mf);
+    // the optimized procedures are scheduled in the scheduler threads if
+    // there are any, with instruction references of their own
+    bool scheduleInThread = optimized && schedulerThreadCount_ > 1;
+
     TTAProgram::InstructionReferenceManager* irm = NULL;
-    if (functionAtATime_) {
+    if (functionAtATime_ || scheduleInThread) {
         irm = new TTAProgram::InstructionReferenceManager();
     } else {        
         irm = &prog_->instructionReferenceManager();
     }
 
-    ControlFlowGraph* cfg = buildTCECFG(mf);
+    ControlFlowGraph* cfg = buildTCECFG(mf, *irm);
     cfg->setInstructionReferenceManager(*irm);
 #ifdef WRITE_CFG_DOTS
     cfg->writeToDotFile(fnName + "_cfg1.dot");
 #endif
 
-    bool fastCompilation = options_ != NULL && options_->optLevel() == 0;
-
     markJumpTableDestinations(mf, *cfg);
 
     if (!mach_->controlUnit()->hasOperation("call")) {
@@ -190,7 +216,7 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
         ctj.handleControlFlowGraph(*cfg, *mach_);
     }
 
-    if (fastCompilation || !isHotFunction(mf)) {
+    if (!optimized) {
         verboseLog(TCEString("###      compiling (fast): ") + fnName);
         EXIT_IF_THROWS(compileFast(*cfg));
     } else {
@@ -210,6 +236,25 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
             // got them for us and passed through.        
             AA = AA_;
         }
+        if (scheduleInThread) {
+            // the alias analysis results are valid only while this
+            // function is processed, build the DDG here and leave the
+            // rest to the scheduler threads
+            SchedulingJob* job = new SchedulingJob;
+            EXIT_IF_THROWS(job->ddg = prepareOptimized(*cfg, AA));
+            job->cfg = cfg;
+            job->procedure = procedure;
+            job->irm = irm;
+            addSchedulingJob(job);
+
+            if (Application::verboseLevel() > 0 && spillMoveCount_ > 0) {
+                Application::logStream() 
+                    << "spill moves in " << 
+                    (std::string)(mf.getFunction().getName()) << ": "
+                    << spillMoveCount_ << std::endl;
+            }
+            return false;
+        }
         EXIT_IF_THROWS(compileOptimized(*cfg, AA));
     }
 
@@ -231,8 +276,12 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
         return true;
     }
 
-    AbsoluteToRelativeJumps jumpConv(*ipData_);
-    jumpConv.handleProcedure(*procedure, *mach_);
+    // the jumps of the pending procedures are converted when their
+    // addresses are known
+    if (schedulerThreadCount_ == 1) {
+        AbsoluteToRelativeJumps jumpConv(*ipData_);
+        jumpConv.handleProcedure(*procedure, *mach_);
+    }
 
     if (Application::verboseLevel() > 0 && spillMoveCount_ > 0) {
         Application::logStream() 
@@ -270,7 +319,9 @@ LLVMTCEIRBuilder::isHotFunction(llvm::MachineFunction& mf) const {
 }
 
 ControlFlowGraph*
-LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
+LLVMTCEIRBuilder::buildTCECFG(
+    llvm::MachineFunction& mf,
+    TTAProgram::InstructionReferenceManager& irm) {
 
     SmallString<256> Buffer;
     mang_->getNameWithPrefix(Buffer, &mf.getFunction(), false);
@@ -314,7 +365,8 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
         // the program first and the BBs added in their program
         // order
         bool firstBBofTheProgram = 
-            !functionAtATime_ && prog_->procedureCount() == 1 && 
+            !functionAtATime_ &&
+            prog_->procedureCount() + pendingProcedures_.size() == 1 && 
             cfg->nodeCount() == 1;
         // first BB of the program
         if (firstBBofTheProgram) {
@@ -517,13 +569,6 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
         }
     }
 
-    TTAProgram::InstructionReferenceManager* irm = NULL;
-    if (functionAtATime_) {
-        irm = new TTAProgram::InstructionReferenceManager();
-    } else {
-        irm = &prog_->instructionReferenceManager();
-    }
-
     // 2nd loop: create all instructions inside BB's.
     // this can only come after the first loop so that BB's have
     // already been generated.
@@ -565,7 +610,7 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
                     bbn = ftSuccsToInlineAsm[bbn];
                     bb = &bbn->basicBlock();
                 }
-                emitInlineAsm(mf, &*j, bb, *irm);
+                emitInlineAsm(mf, &*j, bb, irm);
                 bbn->setScheduled(true);
                 if (AssocTools::containsKey(inlineAsmSuccs, bbn)) {
                     bbn = inlineAsmSuccs[bbn];
@@ -793,7 +838,7 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
         }
     }
 
-    cfg->setInstructionReferenceManager(*irm);
+    cfg->setInstructionReferenceManager(irm);
     // add back edge properties.
     cfg->detectBackEdges();
 
@@ -881,6 +926,27 @@ LLVMTCEIRBuilder::compileOptimized(
     ControlFlowGraph& cfg, 
     llvm::AliasAnalysis* llvmAA) {
 
+    DataDependenceGraph* ddg = prepareOptimized(cfg, llvmAA);
+    scheduleOptimized(
+        cfg, ddg, scheduler(), 
+        delaySlotFilling_ ? &delaySlotFiller() : NULL);
+}
+
+/**
+ * Runs the optimizations preceding the scheduling of a procedure.
+ *
+ * Uses the LLVM alias analysis results, thus must be called while the
+ * machine function of the procedure is processed.
+ *
+ * @param cfg The CFG of the procedure.
+ * @param llvmAA The LLVM alias analysis, or NULL.
+ * @return The DDG of the procedure, owned by the caller.
+ */
+DataDependenceGraph*
+LLVMTCEIRBuilder::prepareOptimized(
+    ControlFlowGraph& cfg,
+    llvm::AliasAnalysis* llvmAA) {
+
     SimpleIfConverter ifConverter(*ipData_, *mach_);
     ifConverter.handleControlFlowGraph(cfg, *mach_);
     Peel2BBLoops peel2bbLoops(*ipData_, *mach_);
@@ -912,6 +978,30 @@ LLVMTCEIRBuilder::compileOptimized(
 #ifdef WRITE_DDG_DOTS
     ddg->writeToDotFile(cfg.name() + "_ddg2.dot");
 #endif
+    return ddg;
+}
+
+/**
+ * Schedules a procedure prepared with prepareOptimized().
+ *
+ * Touches only the CFG, the DDG and the instruction reference manager of
+ * the procedure, and the given scheduler, so procedures can be scheduled
+ * in several threads with schedulers of their own.
+ *
+ * @param cfg The CFG of the procedure.
+ * @param ddg The DDG of the procedure, deleted after scheduling.
+ * @param scheduler The scheduler to use.
+ * @param delaySlotFiller The delay slot filler of the scheduler, NULL if
+ *                        delay slot filling is disabled.
+ */
+void
+LLVMTCEIRBuilder::scheduleOptimized(
+    ControlFlowGraph& cfg,
+    DataDependenceGraph* ddg,
+    BBSchedulerController& scheduler,
+    CopyingDelaySlotFiller* delaySlotFiller) {
+
+    TCEString fnName = cfg.name();
 
     if (!modifyMF_) {
         // BBReferences converted to Inst references
@@ -920,9 +1010,9 @@ LLVMTCEIRBuilder::compileOptimized(
         cfg.convertBBRefsToInstRefs();
     }
 
-    if (delaySlotFilling_)
-        delaySlotFiller().initialize(cfg, *ddg, *mach_);
-    scheduler().handleCFGDDG(cfg, ddg, *mach_ );
+    if (delaySlotFiller != NULL)
+        delaySlotFiller->initialize(cfg, *ddg, *mach_);
+    scheduler.handleCFGDDG(cfg, ddg, *mach_ );
 
 #ifdef WRITE_CFG_DOTS
     fnName = cfg.name();
@@ -936,8 +1026,8 @@ LLVMTCEIRBuilder::compileOptimized(
         // TODO: make DS filler work with FAAT
         // sched yield emitter does not work with the delay slot filler
 
-        if (delaySlotFilling_) {
-            delaySlotFiller().fillDelaySlots(cfg, *ddg, *mach_);
+        if (delaySlotFiller != NULL) {
+            delaySlotFiller->fillDelaySlots(cfg, *ddg, *mach_);
         } 
     }
 
@@ -958,6 +1048,141 @@ LLVMTCEIRBuilder::compileOptimized(
     delete ddg;    
 }
 
+/**
+ * Queues a prepared procedure for the scheduler threads.
+ *
+ * The threads are started when the first procedure is added.
+ *
+ * @param job The procedure to schedule, owned by the builder.
+ */
+void
+LLVMTCEIRBuilder::addSchedulingJob(SchedulingJob* job) {
+    if (schedulerThreads_.empty()) {
+        // the delay slot filler uses the universal machine, create it
+        // before the threads race to do it
+        UniversalMachine::instance();
+        for (unsigned i = 0; i < schedulerThreadCount_; ++i) {
+            schedulerThreads_.push_back(
+                new boost::thread(
+                    boost::bind(&LLVMTCEIRBuilder::runSchedulerThread, this)));
+        }
+    }
+    {
+        boost::mutex::scoped_lock lock(schedulingLock_);
+        schedulingJobs_.push_back(job);
+    }
+    schedulingCondition_.notify_one();
+}
+
+/**
+ * The body of a scheduler thread.
+ *
+ * Schedules the queued procedures with a scheduler of its own until the
+ * queue has been closed and emptied. Errors are stored in the jobs and
+ * reported by finishSchedulingJobs() in module order.
+ */
+void
+LLVMTCEIRBuilder::runSchedulerThread() {
+    // the scheduler passes read the options of the compiling thread
+    Application::ThreadCmdLineOptions threadOptions(options_);
+    CycleLookBackSoftwareBypasser bypasser;
+    CopyingDelaySlotFiller delaySlotFiller;
+    CopyingDelaySlotFiller* dsf = 
+        delaySlotFilling_ ? &delaySlotFiller : NULL;
+    BBSchedulerController scheduler(*mach_, *ipData_, &bypasser, dsf);
+
+    while (true) {
+        SchedulingJob* job = NULL;
+        {
+            boost::mutex::scoped_lock lock(schedulingLock_);
+            while (nextSchedulingJob_ == schedulingJobs_.size() &&
+                   !schedulingJobsClosed_) {
+                schedulingCondition_.wait(lock);
+            }
+            if (nextSchedulingJob_ == schedulingJobs_.size()) {
+                return;
+            }
+            job = schedulingJobs_[nextSchedulingJob_++];
+        }
+        try {
+            scheduleOptimized(*job->cfg, job->ddg, scheduler, dsf);
+        } catch (const Exception& e) {
+            job->error = e.errorMessage();
+        }
+        job->ddg = NULL;
+    }
+}
+
+/**
+ * Closes the job queue and waits for the scheduler threads to finish.
+ */
+void
+LLVMTCEIRBuilder::joinSchedulerThreads() {
+    {
+        boost::mutex::scoped_lock lock(schedulingLock_);
+        schedulingJobsClosed_ = true;
+    }
+    schedulingCondition_.notify_all();
+    for (std::size_t i = 0; i < schedulerThreads_.size(); ++i) {
+        schedulerThreads_[i]->join();
+        delete schedulerThreads_[i];
+    }
+    schedulerThreads_.clear();
+}
+
+/**
+ * Waits for the scheduler threads and moves the scheduled procedures to
+ * the program.
+ *
+ * The procedures are finished in module order, so the program and its
+ * instruction references are the same regardless of the order the threads
+ * scheduled them in. Each procedure is added to the program only after
+ * all of them have been filled, thus gets its final address at once.
+ */
+void
+LLVMTCEIRBuilder::finishSchedulingJobs() {
+
+    joinSchedulerThreads();
+
+    TTAProgram::InstructionReferenceManager& programIrm =
+        prog_->instructionReferenceManager();
+    for (std::size_t i = 0; i < schedulingJobs_.size(); ++i) {
+        SchedulingJob* job = schedulingJobs_[i];
+        if (!job->error.empty()) {
+            Application::errorStream()
+                << "Error: " << job->error << std::endl;
+            exit(1);
+        }
+        ControlFlowGraph& cfg = *job->cfg;
+        TTAProgram::Procedure& procedure = *job->procedure;
+
+        cfg.convertBBRefsToInstRefs();
+        cfg.copyToProcedure(procedure, job->irm);
+#ifdef WRITE_CFG_DOTS
+        cfg.writeToDotFile(procedure.name() + "_cfg4.dot");
+#endif
+        programIrm.takeReferences(*job->irm);
+        if (procedure.instructionCount() > 0) {
+            codeLabels_[procedure.name()] = &procedure.firstInstruction();
+        }
+
+        delete job->cfg;
+        delete job->irm;
+        delete job;
+    }
+    schedulingJobs_.clear();
+
+    AbsoluteToRelativeJumps jumpConv(*ipData_);
+    for (std::size_t i = 0; i < pendingProcedures_.size(); ++i) {
+        TTAProgram::Procedure& procedure = *pendingProcedures_[i];
+        prog_->addProcedure(&procedure);
+        jumpConv.handleProcedure(procedure, *mach_);
+    }
+    pendingProcedures_.clear();
+    nextSchedulingJob_ = 0;
+    schedulingJobsClosed_ = false;
+}
+
 
 TTAProgram::Terminal*
 LLVMTCEIRBuilder::createMBBReference(const MachineOperand& mo) {
@@ -1096,6 +1321,7 @@ LLVMTCEIRBuilder::doFinalization(Module& m) {
     // through library boundaries is flaky. It crashes 
     // on x86-32 Linux at least. See:
     // https://bugs.launchpad.net/tce/+bug/894816
+    finishSchedulingJobs();
     EXIT_IF_THROWS(LLVMTCEBuilder::doFinalization(m));
     EXIT_IF_THROWS(prog_->convertSymbolRefsToInsRefs());
 
@@ -1263,6 +1489,11 @@ LLVMTCEIRBuilder::~LLVMTCEIRBuilder() {
         }
     }
 
+    joinSchedulerThreads();
+    for (std::size_t i = 0; i < pendingProcedures_.size(); ++i) {
+        delete pendingProcedures_[i];
+    }
+
     delete scheduler_;
     delete bypasser_;
     delete dsf_;
@@ -41,17 +41,31 @@
 #include "DataDependenceGraphBuilder.hh"
 #include "CopyingDelaySlotFiller.hh"
 
+#include <vector>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace boost {
+    class thread;
+}
+
 class InterPassData;
 class LLVMTCECmdLineOptions;
 class BBSchedulerController;
 class CopyingDelaySlotFiller;
 class CycleLookBackSoftwareBypasser;
+class DataDependenceGraph;
 struct InnerLoopFinder;
 
 namespace TTAMachine {
     class Machine;
 }
 
+namespace TTAProgram {
+    class Procedure;
+    class InstructionReferenceManager;
+}
+
 namespace llvm {
 
     FunctionPass* createLLVMTCECFGBuilderPass(
@@ -129,6 +143,20 @@ namespace llvm {
             bool isDestination) override;
 
     private:
+        /// A procedure scheduled in a scheduler thread.
+        struct SchedulingJob {
+            /// the CFG of the procedure, scheduled by the thread
+            ControlFlowGraph* cfg;
+            /// the DDG of the procedure, deleted by the thread
+            DataDependenceGraph* ddg;
+            /// the procedure to copy the scheduled code to
+            TTAProgram::Procedure* procedure;
+            /// the references of the procedure, merged to the program's
+            /// when the scheduling is finished
+            TTAProgram::InstructionReferenceManager* irm;
+            /// error message if the scheduling failed
+            std::string error;
+        };
 
         bool isHotFunction(llvm::MachineFunction& mf) const;
         bool isRealInstruction(const MachineInstr& instr) const;
@@ -144,13 +172,28 @@ namespace llvm {
         void compileOptimized(
             ControlFlowGraph& cfg, 
             llvm::AliasAnalysis* llvmAA);
+        DataDependenceGraph* prepareOptimized(
+            ControlFlowGraph& cfg,
+            llvm::AliasAnalysis* llvmAA);
+        void scheduleOptimized(
+            ControlFlowGraph& cfg,
+            DataDependenceGraph* ddg,
+            BBSchedulerController& scheduler,
+            CopyingDelaySlotFiller* delaySlotFiller);
+
+        void addSchedulingJob(SchedulingJob* job);
+        void runSchedulerThread();
+        void joinSchedulerThreads();
+        void finishSchedulingJobs();
 
         bool isExplicitReturn(const llvm::MachineInstr& mi) const;
 
         CopyingDelaySlotFiller& delaySlotFiller();
         BBSchedulerController& scheduler();
 
-        ControlFlowGraph* buildTCECFG(llvm::MachineFunction& mf);
+        ControlFlowGraph* buildTCECFG(
+            llvm::MachineFunction& mf,
+            TTAProgram::InstructionReferenceManager& irm);
         void markJumpTableDestinations(
             llvm::MachineFunction& mf, 
             ControlFlowGraph& cfg);
@@ -183,6 +226,23 @@ namespace llvm {
         CycleLookBackSoftwareBypasser* bypasser_;
 
         InnerLoopFinder* loopFinder_;
+
+        /// count of threads to schedule the optimized procedures in,
+        /// 1 schedules them in the pass itself
+        unsigned schedulerThreadCount_;
+        /// procedures to schedule in the scheduler threads, in module order
+        std::vector<SchedulingJob*> schedulingJobs_;
+        /// index of the next job to pick by a scheduler thread
+        std::size_t nextSchedulingJob_;
+        /// true after all the procedures of the module have been added
+        bool schedulingJobsClosed_;
+        /// procedures not yet added to the program, in module order
+        std::vector<TTAProgram::Procedure*> pendingProcedures_;
+        std::vector<boost::thread*> schedulerThreads_;
+        /// guards the job queue
+        boost::mutex schedulingLock_;
+        /// signaled when jobs are added or the queue is closed
+        boost::condition_variable schedulingCondition_;
     };
 }
 
@@ -386,23 +386,25 @@ TDGen::~TDGen() {
  */
 void
 TDGen::generateBackend(std::string& path) {
+    generatedFiles_.clear();
+
     std::ofstream regTD;
-    regTD.open((path + "/GenRegisterInfo.td").c_str());
+    regTD.open(outputFile(path, "GenRegisterInfo.td").c_str());
     writeRegisterInfo(regTD);
     regTD.close();
 
     std::ofstream instrTD0;
-    instrTD0.open((path + "/GenInstrInfo0.td").c_str());
+    instrTD0.open(outputFile(path, "GenInstrInfo0.td").c_str());
     writeAddressingModeDefs(instrTD0);
     instrTD0.close();
 
     std::ofstream operandTD;
-    operandTD.open((path + "/GenOperandInfo.td").c_str());
+    operandTD.open(outputFile(path, "GenOperandInfo.td").c_str());
     writeOperandDefs(operandTD);
     operandTD.close();
 
     std::ofstream instrTD;
-    instrTD.open((path + "/GenInstrInfo.td").c_str());
+    instrTD.open(outputFile(path, "GenInstrInfo.td").c_str());
     writeInstrInfo(instrTD);
 #ifdef DEBUG_TDGEN
     writeInstrInfo(std::cerr);
@@ -410,31 +412,57 @@ TDGen::generateBackend(std::string& path) {
     instrTD.close();
 
     std::ofstream formatTD;
-    formatTD.open((path + "/GenTCEInstrFormats.td").c_str());
+    formatTD.open(outputFile(path, "GenTCEInstrFormats.td").c_str());
     writeInstrFormats(formatTD);
     formatTD.close();
 
     std::ofstream ccTD;
-    ccTD.open((path + "/GenCallingConv.td").c_str());
+    ccTD.open(outputFile(path, "GenCallingConv.td").c_str());
     writeCallingConv(ccTD);
     ccTD.close();
 
     std::ofstream argArr;
-    argArr.open((path + "/ArgRegs.hh").c_str());
+    argArr.open(outputFile(path, "ArgRegs.hh").c_str());
     writeArgRegsArray(argArr);
     argArr.close();
 
     std::ofstream pluginInc;
-    pluginInc.open((path + "/Backend.inc").c_str());
+    pluginInc.open(outputFile(path, "Backend.inc").c_str());
     writeBackendCode(pluginInc);
     pluginInc.close();
 
     std::ofstream topLevelTD;
-    topLevelTD.open((path + "/TCE.td").c_str());
+    topLevelTD.open(outputFile(path, "TCE.td").c_str());
     writeTopLevelTD(topLevelTD);
     topLevelTD.close();
 }
 
+/**
+ * Returns the names of the files the last generateBackend() call wrote.
+ *
+ * The backend plugin is built from these files only, thus their contents
+ * identify the plugin.
+ *
+ * @return The file names without the directory.
+ */
+const std::vector<std::string>&
+TDGen::generatedFiles() const {
+    return generatedFiles_;
+}
+
+/**
+ * Records a file written by generateBackend() and returns its path.
+ *
+ * @param path The directory the backend files are written to.
+ * @param name The name of the file.
+ * @return Path of the file in the directory.
+ */
+std::string
+TDGen::outputFile(const std::string& path, const std::string& name) {
+    generatedFiles_.push_back(name);
+    return path + "/" + name;
+}
+
 /**
  * Writes .td definition of a single register to the output stream.
  *
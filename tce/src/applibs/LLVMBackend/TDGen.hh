@@ -79,9 +79,12 @@ public:
     TDGen(const TTAMachine::Machine& mach);
     virtual ~TDGen();
     void generateBackend(std::string& path);
+    const std::vector<std::string>& generatedFiles() const;
     // todo clear out virtual functions. they are a remaind of removed
     // TDGenSIMD.
 protected:
+    std::string outputFile(const std::string& path, const std::string& name);
+
     bool writeRegisterInfo(std::ostream& o);
     void writeStartOfRegisterInfo(std::ostream& o);
     void writeOperandDefs(std::ostream& o);
@@ -631,6 +634,8 @@ protected:
     RegClassMap regsInRFClasses_;
     /// All predicates used in constant materialization patterns.
     std::vector<std::string> constantMaterializationPredicates_;
+    /// Names of the files written by generateBackend().
+    std::vector<std::string> generatedFiles_;
 
     static const std::string guardRegTemplateName;
 };
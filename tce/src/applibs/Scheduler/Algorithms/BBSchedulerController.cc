@@ -476,8 +476,6 @@ BBSchedulerController::executeDDGPass(
     int minCycle = 0;
     DataDependenceGraph* ddg = NULL;
     SimpleResourceManager* rm = NULL;
-    // Used for live info dumping.
-    static int bbNumber = 0;
     int min = INT_MAX;
     int fastest = 0;
     if (ddgPasses.size() > 1) {
@@ -512,7 +510,7 @@ BBSchedulerController::executeDDGPass(
         if (bbn != NULL)
             ddgName << bbn->nodeID(); 
         else
-            ddgName << bbNumber;
+            ddgName << bbNumber_;
         ResourceConstraintAnalyzer rcAnalyzer(*ddg, *rm, ddgName);
         rcAnalyzer.analyzePreSchedule();
     }
@@ -537,7 +535,7 @@ BBSchedulerController::executeDDGPass(
 
     copyRMToBB(*rm, bb, targetMachine, irm);
 
-    bbNumber++;
+    bbNumber_++;
 
     if (options_ != NULL && options_->printResourceConstraints()) {
         TCEString ddgName = ddg->name();
@@ -546,7 +544,7 @@ BBSchedulerController::executeDDGPass(
         if (bbn != NULL)
             ddgName << bbn->nodeID(); 
         else
-            ddgName << bbNumber;
+            ddgName << bbNumber_;
         ResourceConstraintAnalyzer rcAnalyzer(*ddg, *rm, ddgName);
         rcAnalyzer.analyze();
     }
@@ -97,7 +97,8 @@ BF2Scheduler::BF2Scheduler(
     killDeadResults_(true),
     jumpNode_(NULL),
     llResult_(NULL),
-    duplicator_(NULL) {
+    duplicator_(NULL),
+    iaCounter_(0) {
     options_ =
         dynamic_cast<LLVMTCECmdLineOptions*>(Application::cmdLineOptions());
     if (options_ != NULL) {
@@ -114,7 +115,8 @@ BF2Scheduler::BF2Scheduler(
     killDeadResults_(killDeadResults),
     jumpNode_(NULL),
     llResult_(NULL),
-    duplicator_(NULL) {
+    duplicator_(NULL),
+    iaCounter_(0) {
     options_ =
         dynamic_cast<LLVMTCECmdLineOptions*>(Application::cmdLineOptions());
 }
@@ -1159,7 +1161,6 @@ void BF2Scheduler::countLoopInvariantValueUsages() {
     invariants_.clear();
     invariantsOfCount_.clear();
 
-    static int iaCounter= 0;
     for (int i = 0; i < ddg().programOperationCount(); i++) {
         ProgramOperation& po = ddg().programOperation(i);
         const Operation& op = po.operation();
@@ -1181,7 +1182,7 @@ void BF2Scheduler::countLoopInvariantValueUsages() {
             } else {
                 if (inputNode.isSourceConstant()) {
                     if (inputNode.move().source().isInstructionAddress()) {
-                        inputVal << "IADDR" << iaCounter++;
+                        inputVal << "IADDR" << iaCounter_++;
                     } else {
                         // todo: imms longer than 32 bits?
                         inputVal <<
@@ -316,6 +316,8 @@ private:
 
     std::multimap<TCEString, MoveNode*> invariants_;
     std::multimap<int, TCEString> invariantsOfCount_;
+    /// Number of the next instruction address key of the invariants.
+    int iaCounter_;
 
     // NULL as movenode means no operand share, FU used mutliple times
     std::multimap<TTAMachine::FUPort*, MoveNode*> preSharedOperandPorts_;
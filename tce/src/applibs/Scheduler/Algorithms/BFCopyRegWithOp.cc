@@ -15,7 +15,8 @@ using TTAProgram::CodeGenerator;
 bool BFCopyRegWithOp::splitMove(BasicBlockNode&) {
     CodeGenerator cGen(targetMachine());
     OperationPool opPool;
-    auto& op = opPool.operation("COPY");
+    static const OperationPool::OpId copyID = opPool.operationID("COPY");
+    auto& op = opPool.operation(copyID);
     pop_ = std::make_shared<ProgramOperation>(op);
 
     mn_.move().setSource(cGen.createTerminalFUPort("COPY",2));
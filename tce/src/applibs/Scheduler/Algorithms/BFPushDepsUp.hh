@@ -42,7 +42,8 @@ class MoveNode;
 
 class BFPushDepsUp : public BFOptimization {
 public:
-    static int recurseCounter_;
+    /// recursion depth of the scheduler thread, for debug output
+    static thread_local int recurseCounter_;
     BFPushDepsUp(
 	BF2Scheduler& sched, MoveNode &mn, int prefCycle) :
 	BFOptimization(sched),
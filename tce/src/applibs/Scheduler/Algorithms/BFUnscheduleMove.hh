@@ -68,7 +68,8 @@ protected:
     const TTAMachine::FunctionUnit *srcFU_;
     const TTAMachine::ImmediateUnit* immu_;
     int immRegIndex_;
-    static int recurseCounter_;
+    /// recursion depth of the scheduler thread, for debug output
+    static thread_local int recurseCounter_;
 };
 
 #endif
@@ -49,7 +49,8 @@
  * Constructor.
  */
 BasicBlockPass::BasicBlockPass(InterPassData& data) : 
-    SchedulerPass(data), ddgBuilder_(data) {
+    SchedulerPass(data), bbNumber_(0), snapshotCounter_(0),
+    ddgBuilder_(data) {
 }
 
 /**
@@ -106,9 +107,6 @@ BasicBlockPass::executeDDGPass(
 
     DataDependenceGraph* ddg = createDDGFromBB(bb, targetMachine);
 
-    // Used for live info dumping.
-    static int bbNumber = 0;
-
 #ifdef DDG_SNAPSHOTS
     std::string name = "scheduling";
     ddgSnapshot(ddg, name, false);
@@ -131,14 +129,14 @@ BasicBlockPass::executeDDGPass(
         for (int index = 0; index < bb.instructionCount(); ++index) {
             if (bb.liveRangeData_ != NULL) {
                 Application::logStream() 
-                    << "liveinfo:" << bbNumber << ":" << index + rm->smallestCycle() << ":" 
+                    << "liveinfo:" << bbNumber_ << ":" << index + rm->smallestCycle() << ":" 
                 << bb.liveRangeData_->registersAlive(
                     rm->smallestCycle()+index, targetMachine.controlUnit()->delaySlots(), *ddg).
                 size()
                 << std::endl;
             }
         }
-        bbNumber++;
+        bbNumber_++;
     }
 
     delete ddg;
@@ -174,26 +172,25 @@ BasicBlockPass::ddgSnapshot(
     std::string& name,
     DataDependenceGraph::DumpFileFormat format,
     bool final) {
-    static int bbCounter = 0;
 
     if (final) {
 	if (format == DataDependenceGraph::DUMP_DOT) {
 	    ddg->writeToDotFile(
-		(boost::format("bb_%.4d_1_after_%2%.dot") % bbCounter % name).str());
+		(boost::format("bb_%.4d_1_after_%2%.dot") % snapshotCounter_ % name).str());
 	} else {
 	    ddg->writeToXMLFile(
-		(boost::format("bb_%.4d_1_after_%2%.xml") % bbCounter % name).str());
+		(boost::format("bb_%.4d_1_after_%2%.xml") % snapshotCounter_ % name).str());
 	}
-        ++bbCounter;
+        ++snapshotCounter_;
     } else {
 	if (format == DataDependenceGraph::DUMP_DOT) {
 	    ddg->writeToDotFile(
-		(boost::format("bb_%.4d_0_before_%2%.dot") % bbCounter % name).str());
+		(boost::format("bb_%.4d_0_before_%2%.dot") % snapshotCounter_ % name).str());
 	} else {
 	    ddg->writeToXMLFile(
-		(boost::format("bb_%.4d_0_before_%2%.xml") % bbCounter % name).str());
+		(boost::format("bb_%.4d_0_before_%2%.xml") % snapshotCounter_ % name).str());
 	}
-	Application::logStream() << "\nBB " << bbCounter << std::endl;
+	Application::logStream() << "\nBB " << snapshotCounter_ << std::endl;
     }
 }
 
@@ -96,7 +96,13 @@ protected:
     virtual DataDependenceGraph* createDDGFromBB(
         TTAProgram::BasicBlock& bb, const TTAMachine::Machine& mach);
 
+    /// Number of basic blocks handled by this pass, used in the live info
+    /// dumps and the DDG names.
+    int bbNumber_;
+
 private:
+    /// Number of the next DDG snapshot of this pass.
+    int snapshotCounter_;
     DataDependenceGraphBuilder ddgBuilder_;
 };
 #endif
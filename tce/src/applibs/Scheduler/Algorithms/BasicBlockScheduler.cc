@@ -1637,7 +1637,7 @@ BasicBlockScheduler::ddgSnapshot(
         bool final,
         bool resetCounter) const {
 
-    static int bbCounter = 0;
+    static thread_local int bbCounter = 0;
 
     if (resetCounter) {
         bbCounter = 0;
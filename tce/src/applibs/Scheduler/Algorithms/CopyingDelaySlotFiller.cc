@@ -126,8 +126,7 @@ CopyingDelaySlotFiller::fillDelaySlots(
     
     ControlFlowGraph::EdgeSet outEdges = cfg_->outEdges(jumpingBB);
 
-    InstructionReferenceManager& irm =
-        cfg_->program()->instructionReferenceManager();
+    InstructionReferenceManager& irm = cfg_->instructionReferenceManager();
 
     TTAProgram::BasicBlock& thisBB = jumpingBB.basicBlock();
     std::pair<int, TTAProgram::Move*> jumpData = findJump(thisBB);
@@ -333,8 +332,7 @@ bool CopyingDelaySlotFiller::updateFTBBAndCfg(
     BasicBlockNode& jumpingBB, BasicBlockNode& nextBBN,
     ControlFlowEdge& edge, int slotsFilled) {
 
-    InstructionReferenceManager& irm =
-        cfg_->program()->instructionReferenceManager();
+    InstructionReferenceManager& irm = cfg_->instructionReferenceManager();
 
     for (int i = 0; i < slotsFilled; i++) {
         assert(!irm.hasReference(
@@ -1806,8 +1804,7 @@ CopyingDelaySlotFiller::updateJumpsAndCfg(
             &jumpAddressImmediate->value());
 
     BasicBlock& nextBB = fillingBBN.basicBlock();
-    InstructionReferenceManager& irm = cfg_->program()->
-        instructionReferenceManager();
+    InstructionReferenceManager& irm = cfg_->instructionReferenceManager();
     // TODO: only the correct jump one, nto both
     assert(slotsFilled <= nextBB.instructionCount());
 
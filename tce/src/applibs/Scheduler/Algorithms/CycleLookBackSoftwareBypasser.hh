@@ -35,6 +35,7 @@
 
 #include <map>
 #include <set>
+#include <atomic>
 
 #include "SoftwareBypasser.hh"
 #include "DataDependenceGraph.hh"
@@ -122,9 +123,10 @@ private:
 
     MoveNodeSelector* selector_;
 
-    static int bypassCount_;
-    static int deadResultCount_;
-    static int triggerAbortCount_;
+    // statistics shared by the bypassers of concurrent scheduler threads
+    static std::atomic<int> bypassCount_;
+    static std::atomic<int> deadResultCount_;
+    static std::atomic<int> triggerAbortCount_;
 };
 
 #endif
@@ -515,7 +515,7 @@ PreOptimizer::handleCFGDDG(
     TTAProgram::Program* program = cfg.program();
     TTAProgram::InstructionReferenceManager* irm =
         program == NULL ? NULL :
-        &program->instructionReferenceManager();
+        &cfg.instructionReferenceManager();
 
     // Loop over all programoperations. find XOR's by 1.
     for (int i = ddg.programOperationCount() - 1; i >= 0; i--) {
@@ -87,14 +87,17 @@ void
 RegisterRenamer::initialize() {
     auto regNav = machine_.registerFileNavigator();
 
+    {
+        boost::mutex::scoped_lock lock(tempRegFileCacheLock_);
         auto trCacheIter = tempRegFileCache_.find(&machine_);
 
-    if (trCacheIter == tempRegFileCache_.end()) {
-        tempRegFiles_ = MachineConnectivityCheck::tempRegisterFiles(machine_);
-        tempRegFileCache_[&machine_] = 
-            tempRegFiles_;
-    } else {
-        tempRegFiles_ = trCacheIter->second;
+        if (trCacheIter == tempRegFileCache_.end()) {
+            tempRegFiles_ =
+                MachineConnectivityCheck::tempRegisterFiles(machine_);
+            tempRegFileCache_[&machine_] = tempRegFiles_;
+        } else {
+            tempRegFiles_ = trCacheIter->second;
+        }
     }
 
     for (int i = 0; i < regNav.count(); i++) {
@@ -1346,3 +1349,4 @@ std::map<const TTAMachine::Machine*,
          std::set <const TTAMachine::RegisterFile*,
                    TTAMachine::MachinePart::Comparator> >
 RegisterRenamer::tempRegFileCache_;
+boost::mutex RegisterRenamer::tempRegFileCacheLock_;
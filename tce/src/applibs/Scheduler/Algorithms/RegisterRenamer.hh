@@ -37,6 +37,7 @@
 
 #include "TCEString.hh"
 #include <set>
+#include <boost/thread/mutex.hpp>
 #include "MachinePart.hh"
 #include "DataDependenceGraph.hh"
 
@@ -155,6 +156,8 @@ private:
                     std::set <const TTAMachine::RegisterFile*,
                               TTAMachine::MachinePart::Comparator> >
     tempRegFileCache_;
+    /// Serializes the accesses to the cache from scheduler threads.
+    static boost::mutex tempRegFileCacheLock_;
     std::set <const TTAMachine::RegisterFile*,
               TTAMachine::MachinePart::Comparator> tempRegFiles_;
 
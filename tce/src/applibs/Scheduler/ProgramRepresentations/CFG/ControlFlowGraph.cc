@@ -149,7 +149,7 @@ ControlFlowGraph::ControlFlowGraph(
     program_(program),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(NULL) {
+    passData_(NULL), irm_(NULL) {
     procedureName_ = name;
 }
 
@@ -167,7 +167,7 @@ ControlFlowGraph::ControlFlowGraph(
     procedure_(&procedure),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(NULL) {
+    passData_(NULL), irm_(NULL) {
     buildFrom(procedure);
 }
 
@@ -189,7 +189,7 @@ ControlFlowGraph::ControlFlowGraph(
     procedure_(&procedure),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(&passData) {
+    passData_(&passData), irm_(NULL) {
     buildFrom(procedure);
 }
 
@@ -2399,8 +2399,12 @@ ControlFlowGraph::deleteNodeAndRefs(BasicBlockNode& node) {
 
 TTAProgram::InstructionReferenceManager&
 ControlFlowGraph::instructionReferenceManager() {
-    if (program_ == NULL) {
+    // a manager set explicitly overrides the one of the program, the
+    // procedures scheduled in parallel have managers of their own
+    if (irm_ != NULL) {
         return *irm_;
+    }
+    if (program_ == NULL) {
         throw NotAvailable(__FILE__,__LINE__,__func__,
             "cfg does not have program");
     }
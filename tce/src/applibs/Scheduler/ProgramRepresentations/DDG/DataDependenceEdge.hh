@@ -33,6 +33,8 @@
 #ifndef TTA_DATA_DEPENDENCE_EDGE_HH
 #define TTA_DATA_DEPENDENCE_EDGE_HH
 
+#include <atomic>
+
 #include "TCEString.hh"
 #include "GraphEdge.hh"
 
@@ -150,8 +152,9 @@ public:
 
     static void printStats(std::ostream& out);
 
-    // statistic counters for different types of edges created
-    static int regAntidepCount_;
+    // statistic counters for different types of edges created,
+    // atomic as graphs are built in concurrent scheduler threads
+    static std::atomic<int> regAntidepCount_;
 
     void setData(const TCEString& newData);
 
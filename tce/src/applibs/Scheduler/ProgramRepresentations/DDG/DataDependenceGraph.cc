@@ -4240,16 +4240,17 @@ DataDependenceGraph::regWarSuccessors(const MoveNode& node) const {
     
     NodeSet succ;
 
-    NodeDescriptor nd = descriptor(node);
-    EdgeSet out = outEdges(node);
-    typedef EdgeSet::iterator EdgeIterator;
+    // walk the out edges of the boost graph directly instead of
+    // collecting them into an EdgeSet first
+    std::pair<OutEdgeIter, OutEdgeIter> edges =
+        boost::out_edges(descriptor(node), graph_);
 
-    for (EdgeIterator i = out.begin(); i != out.end(); ++i) {
-        DataDependenceEdge& e = **i;
+    for (OutEdgeIter ei = edges.first; ei != edges.second; ++ei) {
+        DataDependenceEdge& e = *graph_[*ei];
         if (e.dependenceType() == DataDependenceEdge::DEP_WAR &&
             (e.edgeReason() == DataDependenceEdge::EDGE_REGISTER ||
              e.edgeReason() == DataDependenceEdge::EDGE_RA)) {
-            succ.insert(&headNode(**i, nd));
+            succ.insert(graph_[boost::target(*ei, graph_)]);
         }
     }
     
@@ -4273,16 +4274,15 @@ DataDependenceGraph::regRawSuccessors(const MoveNode& node) const {
     
     NodeSet succ;
 
-    NodeDescriptor nd = descriptor(node);
-    EdgeSet out = outEdges(node);
-    typedef EdgeSet::iterator EdgeIterator;
+    std::pair<OutEdgeIter, OutEdgeIter> edges =
+        boost::out_edges(descriptor(node), graph_);
 
-    for (EdgeIterator i = out.begin(); i != out.end(); ++i) {
-        DataDependenceEdge& e = **i;
+    for (OutEdgeIter ei = edges.first; ei != edges.second; ++ei) {
+        DataDependenceEdge& e = *graph_[*ei];
         if (e.dependenceType() == DataDependenceEdge::DEP_RAW &&
             (e.edgeReason() == DataDependenceEdge::EDGE_REGISTER ||
              e.edgeReason() == DataDependenceEdge::EDGE_RA)) {
-            succ.insert(&headNode(**i, nd));
+            succ.insert(graph_[boost::target(*ei, graph_)]);
         }
     }
     
@@ -4311,12 +4311,11 @@ DataDependenceGraph::regRawPredecessors(const MoveNode& node, int backedges) con
     
     NodeSet pred;
 
-    NodeDescriptor nd = descriptor(node);
-    EdgeSet in = inEdges(node);
-    typedef EdgeSet::iterator EdgeIterator;
+    std::pair<InEdgeIter, InEdgeIter> edges =
+        boost::in_edges(descriptor(node), graph_);
 
-    for (EdgeIterator i = in.begin(); i != in.end(); ++i) {
-        DataDependenceEdge& e = **i;
+    for (InEdgeIter ei = edges.first; ei != edges.second; ++ei) {
+        DataDependenceEdge& e = *graph_[*ei];
         if (backedges == 1 && !e.isBackEdge()) {
             continue;
         } else if (backedges == 2 && e.isBackEdge()) {
@@ -4325,7 +4324,7 @@ DataDependenceGraph::regRawPredecessors(const MoveNode& node, int backedges) con
         if (e.dependenceType() == DataDependenceEdge::DEP_RAW &&
             (e.edgeReason() == DataDependenceEdge::EDGE_REGISTER ||
              e.edgeReason() == DataDependenceEdge::EDGE_RA)) {
-            pred.insert(&tailNode(**i, nd));
+            pred.insert(graph_[boost::source(*ei, graph_)]);
         }
     }
     return pred;
@@ -4348,17 +4347,16 @@ DataDependenceGraph::regWawSuccessors(const MoveNode& node) const {
     
     NodeSet succ;
 
-    NodeDescriptor nd = descriptor(node);
-    EdgeSet out = outEdges(node);
-    typedef EdgeSet::iterator EdgeIterator;
+    std::pair<OutEdgeIter, OutEdgeIter> edges =
+        boost::out_edges(descriptor(node), graph_);
 
-    for (EdgeIterator i = out.begin(); i != out.end(); ++i) {
-        DataDependenceEdge& e = **i;
+    for (OutEdgeIter ei = edges.first; ei != edges.second; ++ei) {
+        DataDependenceEdge& e = *graph_[*ei];
 
         // if we would bypass also over ra, then allow also ra in following
         if (e.dependenceType() == DataDependenceEdge::DEP_WAW &&
             e.edgeReason() == DataDependenceEdge::EDGE_REGISTER) {
-            succ.insert(&headNode(**i, nd));
+            succ.insert(graph_[boost::target(*ei, graph_)]);
         }
     }
     
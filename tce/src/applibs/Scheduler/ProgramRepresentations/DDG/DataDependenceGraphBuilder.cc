@@ -104,6 +104,10 @@ static const int REG_IPARAM = 2;
 static const int REG_VRV = -3;
 static const int REG_FP = -2;
 
+/// Memory accesses larger than this (in MAUs) are not put into the
+/// address buckets but compared against all other accesses.
+static const int MAX_BUCKETED_ACCESS_SIZE = 128;
+
 POP_COMPILER_DIAGS
 
 //#define USE_FALSE_AA
@@ -116,6 +120,8 @@ POP_COMPILER_DIAGS
  * code annotations. Used with old frontend.
  */
 DataDependenceGraphBuilder::DataDependenceGraphBuilder() :
+    constantAA_(false), stackAA_(false), globalVsStackAA_(false),
+    offsetAA_(NULL),
     interPassData_(NULL), cfg_(NULL), rvIsParamReg_(false) {
 
     /// constant alias AA check aa between global variables.
@@ -143,6 +149,8 @@ DataDependenceGraphBuilder::DataDependenceGraphBuilder() :
  * interpass data.
  */
 DataDependenceGraphBuilder::DataDependenceGraphBuilder(InterPassData& ipd) :
+    constantAA_(false), stackAA_(false), globalVsStackAA_(false),
+    offsetAA_(NULL),
     // TODO: when param reg thing works, rvIsParamReg becomes true here
     interPassData_(&ipd), cfg_(NULL), rvIsParamReg_(true) {
 
@@ -292,6 +300,17 @@ DataDependenceGraphBuilder::~DataDependenceGraphBuilder() {
 void
 DataDependenceGraphBuilder::addAliasAnalyzer(MemoryAliasAnalyzer* analyzer) {
     aliasAnalyzers_.push_back(analyzer);
+
+    // the address buckets rule out the same pairs as these analyzers
+    if (dynamic_cast<ConstantAliasAnalyzer*>(analyzer) != NULL) {
+        constantAA_ = true;
+    } else if (dynamic_cast<StackAliasAnalyzer*>(analyzer) != NULL) {
+        stackAA_ = true;
+    } else if (dynamic_cast<GlobalVsStackAA*>(analyzer) != NULL) {
+        globalVsStackAA_ = true;
+    } else if (dynamic_cast<OffsetAliasAnalyzer*>(analyzer) != NULL) {
+        offsetAA_ = dynamic_cast<OffsetAliasAnalyzer*>(analyzer);
+    }
 }
 
 /**
@@ -495,10 +514,13 @@ DataDependenceGraphBuilder::build(
             REGISTERS_AND_PROGRAM_OPERATIONS);
         if (createMemAndFUDeps) {
             //second phase. mem and fu state deps
+            clearMemoryAnalysisCaches();
             constructIndividualBB(
                 MEMORY_AND_SIDE_EFFECTS);
+            clearMemoryAnalysisCaches();
         }
     } catch (Exception&) {
+        clearMemoryAnalysisCaches();
         delete currentDDG_; currentDDG_ = NULL;
         delete currentData_; currentData_ = NULL;
         delete currentBB_; currentBB_ = NULL;
@@ -560,6 +582,10 @@ void
 DataDependenceGraphBuilder::constructIndividualBB(
     ConstructionPhase phase) {
 
+    if (phase == MEMORY_AND_SIDE_EFFECTS) {
+        initializeMemoryBuckets();
+    }
+
     for (int ia = 0; ia < currentBB_->basicBlock().instructionCount(); ia++) {
         Instruction& ins = currentBB_->basicBlock().instructionAtIndex(ia);
 
@@ -1706,14 +1732,14 @@ DataDependenceGraphBuilder::createSideEffectEdges(
  * Checks if there is an earlier write to same address or with same guard.
  *
  * @param mnd the current node dictating guard and mem address to check.
- * @param defines set of earlier writes to check for the write.
+ * @param defines set of earlier writes which may alias the current node.
  */
 bool
 DataDependenceGraphBuilder::hasEarlierMemWriteToSameAddressWithSameGuard(
-    MoveNodeUse& mnd, std::set<MoveNodeUse>& defines) {
+    MoveNodeUse& mnd, const std::set<MoveNodeUse>& defines) {
     // first just check if there is earlier write to this mem address
     // with same guard.
-    for (std::set<MoveNodeUse>::iterator i = defines.begin();
+    for (std::set<MoveNodeUse>::const_iterator i = defines.begin();
          i != defines.end(); i++) {
         // if earlier write to this reg with same guard..
         if (currentDDG_->sameGuards(*(i->mn()), *(mnd.mn()))) {
@@ -1737,22 +1763,26 @@ DataDependenceGraphBuilder::hasEarlierMemWriteToSameAddressWithSameGuard(
  * Does not create if gaurds of aliasing dictate edge not needed.
  * If both guard and aliasing indicate fully transitive case for some 
  * prev nodes, then remove these previous nodes from the bookkeeping.
+ *
+ * @param prevNodes the bookkeeping set of the previous nodes.
+ * @param aliasingNodes the nodes of prevNodes which may alias mnd,
+ *        may be prevNodes itself.
  */
 void
 DataDependenceGraphBuilder::checkAndCreateMemAntideps(
     MoveNodeUse& mnd, std::set<MoveNodeUse>& prevNodes, 
+    const std::set<MoveNodeUse>& aliasingNodes,
     DataDependenceEdge::DependenceType depType,
     bool traceable) {
     // create WaW to another in own bb
-    for (MoveNodeUseSet::iterator iter =
-             prevNodes.begin(); iter != prevNodes.end();) {
-        if ((checkAndCreateMemDep(*iter, mnd, depType) || !traceable) &&
+    for (MoveNodeUseSet::const_iterator iter =
+             aliasingNodes.begin(); iter != aliasingNodes.end();) {
+        // advanced before the erase, which may be from aliasingNodes
+        const MoveNodeUse prev = *iter++;
+        if ((checkAndCreateMemDep(prev, mnd, depType) || !traceable) &&
             (mnd.mn()->move().isUnconditional() ||
-             currentDDG_->sameGuards(*(iter->mn()), *(mnd.mn())))) {
-            // remove current element and update iterator to next.
-            prevNodes.erase(iter++);
-        } else { // just take next from the set
-            iter++;
+             currentDDG_->sameGuards(*(prev.mn()), *(mnd.mn())))) {
+            prevNodes.erase(prev);
         }
     }
 }
@@ -1775,6 +1805,11 @@ DataDependenceGraphBuilder::processMemWrite(MoveNodeUse mnd) {
     std::set<MoveNodeUse>& lastUses =
         currentBB_->basicBlock().liveRangeData_->memLastUses_[category];
 
+    // only the earlier accesses which may alias this one are compared
+    MoveNodeUseSet definesBuffer;
+    const MoveNodeUseSet& aliasingDefines = memoryAliasCandidates(
+        mnd, defines, memDefineBuckets_[category], definesBuffer);
+
     // check if no earlier barriers/kills to this one in this bb?
     if (currentBB_->basicBlock().liveRangeData_->memKills_[category].mn() == NULL) {
 
@@ -1786,7 +1821,8 @@ DataDependenceGraphBuilder::processMemWrite(MoveNodeUse mnd) {
 
         // check if there is "guarded kill" to this mem address
         bool guardedKillFound = 
-            hasEarlierMemWriteToSameAddressWithSameGuard(mnd, defines);
+            hasEarlierMemWriteToSameAddressWithSameGuard(
+                mnd, aliasingDefines);
         
         if (!guardedKillFound) {
             // may have incoming WaW's / WaRs to this
@@ -1797,20 +1833,28 @@ DataDependenceGraphBuilder::processMemWrite(MoveNodeUse mnd) {
 
     bool traceable = isAddressTraceable(mnd.mn()->destinationOperation());
 
+    MoveNodeUseSet usesBuffer;
+    const MoveNodeUseSet& aliasingUses = memoryAliasCandidates(
+        mnd, lastUses, memUseBuckets_[category], usesBuffer);
+
     checkAndCreateMemAntideps(
-        mnd, defines, DataDependenceEdge::DEP_WAW, traceable);
+        mnd, defines, aliasingDefines, DataDependenceEdge::DEP_WAW,
+        traceable);
 
     checkAndCreateMemAntideps(
-        mnd, lastUses, DataDependenceEdge::DEP_WAR, traceable);
+        mnd, lastUses, aliasingUses, DataDependenceEdge::DEP_WAR, traceable);
 
     // does this kill previous deps?
     if (mnd.mn()->move().isUnconditional() && !traceable) {
         currentBB_->basicBlock().liveRangeData_->memLastKill_[category] = mnd;
         defines.clear();
         lastUses.clear();
+        memDefineBuckets_[category].clear();
+        memUseBuckets_[category].clear();
     }
 
     defines.insert(mnd);
+    addToMemoryBuckets(memDefineBuckets_[category], mnd);
 }
 
 /**
@@ -1829,12 +1873,18 @@ DataDependenceGraphBuilder::processMemUse(MoveNodeUse mnd) {
     std::set<MoveNodeUse>& defines =
         currentBB_->basicBlock().liveRangeData_->memDefines_[category];
 
+    // only the earlier writes which may alias this one are compared
+    MoveNodeUseSet definesBuffer;
+    const MoveNodeUseSet& aliasingDefines = memoryAliasCandidates(
+        mnd, defines, memDefineBuckets_[category], definesBuffer);
+
     // no kills/barriers to this one in this basic block.
     if (currentBB_->basicBlock().liveRangeData_->memKills_[category].mn() == NULL) {
 
         // check if there is "guarded kill" to this mem address
         bool guardedKillFound = 
-            hasEarlierMemWriteToSameAddressWithSameGuard(mnd, defines);
+            hasEarlierMemWriteToSameAddressWithSameGuard(
+                mnd, aliasingDefines);
 
         if (!guardedKillFound) {
             currentBB_->basicBlock().liveRangeData_->memFirstUses_[category].insert(mnd);
@@ -1843,13 +1893,14 @@ DataDependenceGraphBuilder::processMemUse(MoveNodeUse mnd) {
         }
     }
 
-    // create deps from writes in this BB.LIVERANGEDATA_->
-    for (MoveNodeUseSet::iterator iter =
-             defines.begin(); iter != defines.end(); iter++) {
+    // create deps from writes in this BB.
+    for (MoveNodeUseSet::const_iterator iter =
+             aliasingDefines.begin(); iter != aliasingDefines.end(); iter++) {
         checkAndCreateMemDep(*iter, mnd, DataDependenceEdge::DEP_RAW);
     }
     // update bookkeeping.
     currentBB_->basicBlock().liveRangeData_->memLastUses_[category].insert(mnd);
+    addToMemoryBuckets(memUseBuckets_[category], mnd);
 }
 
 /**
@@ -1971,15 +2022,28 @@ DataDependenceGraphBuilder::analyzeMemoryAlias(
     const ProgramOperation& pop1, const ProgramOperation& pop2, 
     MoveNodeUse::BBRelation bbInfo) {
 
+    // the register dependencies the analyzers follow do not change
+    // during the memory phase, so each pair needs to be analyzed once.
+    AliasQuery query(std::make_pair(pop1.poId(), pop2.poId()), bbInfo);
+    std::map<AliasQuery, MemoryAliasAnalyzer::AliasingResult>::iterator
+        cached = aliasResults_.find(query);
+    if (cached != aliasResults_.end()) {
+        return cached->second;
+    }
+
+    MemoryAliasAnalyzer::AliasingResult result =
+        MemoryAliasAnalyzer::ALIAS_UNKNOWN;
     for (unsigned int i = 0; i < aliasAnalyzers_.size(); i++) {
         MemoryAliasAnalyzer* analyzer = aliasAnalyzers_[i];
         MemoryAliasAnalyzer::AliasingResult res =
             analyzer->analyze(*currentDDG_, pop1, pop2, bbInfo);
         if (res != MemoryAliasAnalyzer::ALIAS_UNKNOWN) {
-            return res;
+            result = res;
+            break;
         }
     }
-    return MemoryAliasAnalyzer::ALIAS_UNKNOWN;
+    aliasResults_[query] = result;
+    return result;
 }
 
 /**
@@ -2113,6 +2177,315 @@ DataDependenceGraphBuilder::memoryCategory(const MoveNodeUse& mnd) {
     return category;
 }
 
+/**
+ * Returns the address of a memory access as the constant, stack and
+ * offset alias analyzers see it.
+ *
+ * The address is unknown for pseudo accesses, volatile accesses, accesses
+ * of unknown or large size and addresses which change in loops.
+ *
+ * @param mnd MoveNodeUse of the trigger of the memory operation.
+ * @return The address of the access, cached by the ProgramOperation.
+ */
+const DataDependenceGraphBuilder::MemoryAccessKey&
+DataDependenceGraphBuilder::memoryAccessKey(const MoveNodeUse& mnd) {
+
+    static const MemoryAccessKey unknownAddress;
+    if (mnd.pseudo() || !mnd.mn()->isDestinationOperation()) {
+        return unknownAddress;
+    }
+
+    const ProgramOperation& pop = mnd.mn()->destinationOperation();
+    std::map<unsigned int, MemoryAccessKey>::iterator i =
+        memoryAccessKeys_.find(pop.poId());
+    if (i != memoryAccessKeys_.end()) {
+        return i->second;
+    }
+    MemoryAccessKey& key = memoryAccessKeys_[pop.poId()];
+
+    // checkAndCreateMemDep() keeps volatile accesses in order
+    // whatever their addresses are.
+    const llvm::MachineInstr* instr = pop.machineInstr();
+    if (instr != NULL) {
+        for (llvm::MachineInstr::mmo_iterator mmo =
+                 instr->memoperands_begin();
+             mmo != instr->memoperands_end(); mmo++) {
+            if ((*mmo)->isVolatile()) {
+                return key;
+            }
+        }
+    }
+
+    // compareIndeces() handles the accessed memory as blocks of the
+    // access size aligned to the size.
+    int size = MemoryAliasAnalyzer::mausOfOperation(pop.operation());
+    if (size <= 0 || size > MAX_BUCKETED_ACCESS_SIZE ||
+        (size & (size - 1)) != 0) {
+        return key;
+    }
+
+    long address = 0;
+    long increment = 0;
+    const MoveNode* base = NULL;
+    if (constantAA_ &&
+        ConstantAliasAnalyzer::getConstantAddress(
+            *currentDDG_, pop, address, increment)) {
+        key.kind = ADDRESS_ABSOLUTE;
+    } else if ((stackAA_ || globalVsStackAA_) &&
+               StackAliasAnalyzer::getStackOffset(
+                   *currentDDG_, pop, address, increment,
+                   specialRegisters_[REG_SP])) {
+        key.kind = ADDRESS_STACK;
+    } else if (offsetAA_ != NULL &&
+               offsetAA_->baseAndOffset(*currentDDG_, pop, base, address)) {
+        // the offsets of the same base are compared as they are
+        // between the accesses of a basic block.
+        key.kind = ADDRESS_OFFSET;
+        increment = 0;
+    }
+    if (increment != 0) {
+        key.kind = ADDRESS_UNKNOWN;
+    }
+    if (key.kind != ADDRESS_UNKNOWN) {
+        key.address = static_cast<int>(address);
+        key.size = size;
+        if (key.kind == ADDRESS_OFFSET) {
+            key.base = base;
+        }
+    }
+    return key;
+}
+
+/**
+ * Removes all accesses from the buckets.
+ */
+void
+DataDependenceGraphBuilder::MemoryAccessBuckets::clear() {
+    unknown_.clear();
+    absolute_.clear();
+    stack_.clear();
+    offset_.clear();
+    absoluteMaxSize_ = 1;
+    stackMaxSize_ = 1;
+}
+
+/**
+ * Adds a memory access into the bucket of its address.
+ */
+void
+DataDependenceGraphBuilder::addToMemoryBuckets(
+    MemoryAccessBuckets& buckets, const MoveNodeUse& mnd) {
+
+    const MemoryAccessKey& key = memoryAccessKey(mnd);
+    switch (key.kind) {
+    case ADDRESS_ABSOLUTE:
+        buckets.absolute_.insert(std::make_pair(key.address, mnd));
+        buckets.absoluteMaxSize_ =
+            std::max(buckets.absoluteMaxSize_, key.size);
+        break;
+    case ADDRESS_STACK:
+        buckets.stack_.insert(std::make_pair(key.address, mnd));
+        buckets.stackMaxSize_ = std::max(buckets.stackMaxSize_, key.size);
+        break;
+    case ADDRESS_OFFSET:
+        // the offset analyzer adjusts the offsets of loop carried
+        // accesses, so only the ones of the same BB are compared as is.
+        if (!mnd.interBB()) {
+            MemoryAccessOffsetBucket& bucket = buckets.offset_[key.base];
+            bucket.accesses_.insert(std::make_pair(key.address, mnd));
+            bucket.maxSize_ = std::max(bucket.maxSize_, key.size);
+            break;
+        }
+        buckets.unknown_.push_back(mnd);
+        break;
+    default:
+        buckets.unknown_.push_back(mnd);
+        break;
+    }
+}
+
+/**
+ * Fills the memory access buckets from the memory bookkeeping of the
+ * current basic block before its memory accesses are processed.
+ */
+void
+DataDependenceGraphBuilder::initializeMemoryBuckets() {
+
+    memDefineBuckets_.clear();
+    memUseBuckets_.clear();
+
+    LiveRangeData& liveRangeData = *currentBB_->basicBlock().liveRangeData_;
+    for (MoveNodeUseMapSet::iterator i = liveRangeData.memDefines_.begin();
+         i != liveRangeData.memDefines_.end(); i++) {
+        for (MoveNodeUseSet::iterator j = i->second.begin();
+             j != i->second.end(); j++) {
+            addToMemoryBuckets(memDefineBuckets_[i->first], *j);
+        }
+    }
+    for (MoveNodeUseMapSet::iterator i = liveRangeData.memLastUses_.begin();
+         i != liveRangeData.memLastUses_.end(); i++) {
+        for (MoveNodeUseSet::iterator j = i->second.begin();
+             j != i->second.end(); j++) {
+            addToMemoryBuckets(memUseBuckets_[i->first], *j);
+        }
+    }
+}
+
+/**
+ * Collects the accesses of an address map which may alias a memory access.
+ *
+ * The accesses no more in the bookkeeping set are removed from the map.
+ *
+ * @param key Address of the access, or NULL to collect all the accesses.
+ * @param accesses The accesses by their addresses.
+ * @param maxSize Size of the largest access in the map.
+ * @param prevNodes The bookkeeping set the accesses belong to.
+ * @param candidates Set where the collected accesses are added.
+ */
+void
+DataDependenceGraphBuilder::collectMemoryAliasCandidates(
+    const MemoryAccessKey* key,
+    MemoryAccessAddressMap& accesses,
+    int maxSize,
+    const MoveNodeUseSet& prevNodes,
+    MoveNodeUseSet& candidates) {
+
+    MemoryAccessAddressMap::iterator iter = accesses.begin();
+    long rangeStart = 0;
+    long rangeSize = 0;
+    if (key != NULL) {
+        // accesses outside the aligned block of the largest access
+        // size cannot be in the same block of any smaller size.
+        rangeSize = std::max(key->size, maxSize);
+        rangeStart = key->address & ~(rangeSize - 1);
+        iter = accesses.lower_bound(rangeStart);
+    }
+
+    while (iter != accesses.end()) {
+        if (key != NULL && iter->first - rangeStart >= rangeSize) {
+            break;
+        }
+        MoveNodeUseSet::const_iterator prev = prevNodes.find(iter->second);
+        if (prev == prevNodes.end()) {
+            accesses.erase(iter++);
+            continue;
+        }
+        if (key != NULL) {
+            const MemoryAccessKey& prevKey = memoryAccessKey(*prev);
+            int blockSize = std::max(key->size, prevKey.size);
+            if ((key->address & ~(blockSize - 1)) !=
+                (prevKey.address & ~(blockSize - 1))) {
+                iter++;
+                continue;
+            }
+        }
+        candidates.insert(*prev);
+        iter++;
+    }
+}
+
+/**
+ * Finds the earlier memory accesses which may alias a memory access.
+ *
+ * Leaves out the accesses for which the alias analyzers would return
+ * ALIAS_FALSE based on the constant addresses and stack offsets alone,
+ * so the analyzers need not be run on every pair of accesses of a
+ * basic block.
+ *
+ * @param mnd The memory access being processed.
+ * @param prevNodes The earlier accesses.
+ * @param buckets The earlier accesses grouped by their addresses.
+ * @param candidates Set where the accesses which may alias are put.
+ * @return prevNodes if mnd may alias all of them, otherwise candidates.
+ */
+const DataDependenceGraphBuilder::MoveNodeUseSet&
+DataDependenceGraphBuilder::memoryAliasCandidates(
+    const MoveNodeUse& mnd,
+    const MoveNodeUseSet& prevNodes,
+    MemoryAccessBuckets& buckets,
+    MoveNodeUseSet& candidates) {
+
+    const MemoryAccessKey& key = memoryAccessKey(mnd);
+    if (key.kind == ADDRESS_UNKNOWN) {
+        return prevNodes;
+    }
+    if (prevNodes.empty()) {
+        buckets.clear();
+        return candidates;
+    }
+
+    // accesses without a known address may alias anything
+    std::vector<MoveNodeUse>& unknown = buckets.unknown_;
+    for (unsigned int i = 0; i < unknown.size();) {
+        MoveNodeUseSet::const_iterator prev = prevNodes.find(unknown[i]);
+        if (prev == prevNodes.end()) {
+            unknown[i] = unknown.back();
+            unknown.pop_back();
+        } else {
+            candidates.insert(*prev);
+            i++;
+        }
+    }
+
+    // the offset analyzer tells apart only the accesses to different
+    // offsets of the same base.
+    std::map<const MoveNode*, MemoryAccessOffsetBucket>::iterator iter =
+        buckets.offset_.begin();
+    while (iter != buckets.offset_.end()) {
+        MemoryAccessOffsetBucket& bucket = iter->second;
+        collectMemoryAliasCandidates(
+            iter->first == key.base ? &key : NULL, bucket.accesses_,
+            bucket.maxSize_, prevNodes, candidates);
+        if (bucket.accesses_.empty()) {
+            buckets.offset_.erase(iter++);
+        } else {
+            iter++;
+        }
+    }
+
+    if (key.kind == ADDRESS_OFFSET) {
+        collectMemoryAliasCandidates(
+            NULL, buckets.absolute_, 0, prevNodes, candidates);
+        collectMemoryAliasCandidates(
+            NULL, buckets.stack_, 0, prevNodes, candidates);
+        return candidates;
+    }
+
+    bool absolute = key.kind == ADDRESS_ABSOLUTE;
+    MemoryAccessAddressMap& sameKind =
+        absolute ? buckets.absolute_ : buckets.stack_;
+    MemoryAccessAddressMap& otherKind =
+        absolute ? buckets.stack_ : buckets.absolute_;
+    int maxSize = absolute ? buckets.absoluteMaxSize_ : buckets.stackMaxSize_;
+
+    // only the constant and stack alias analyzers tell accesses to
+    // different addresses apart.
+    bool apartDisjoint = absolute ? constantAA_ : stackAA_;
+    collectMemoryAliasCandidates(
+        apartDisjoint ? &key : NULL, sameKind, maxSize, prevNodes,
+        candidates);
+
+    if (!globalVsStackAA_) {
+        collectMemoryAliasCandidates(
+            NULL, otherKind, 0, prevNodes, candidates);
+    }
+    return candidates;
+}
+
+/**
+ * Drops the memoized alias analysis results and memory access addresses.
+ *
+ * They are valid only while the register dependencies of the DDG being
+ * built do not change.
+ */
+void
+DataDependenceGraphBuilder::clearMemoryAnalysisCaches() {
+    memDefineBuckets_.clear();
+    memUseBuckets_.clear();
+    memoryAccessKeys_.clear();
+    aliasResults_.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Multi-BB DDG construction
 ///////////////////////////////////////////////////////////////////////////////
@@ -2176,7 +2549,9 @@ DataDependenceGraphBuilder::build(
 
         // then do the second phase - mem and fu deps.
         if (createMemAndFUDeps) {
+            clearMemoryAnalysisCaches();
             createMemAndFUstateDeps();
+            clearMemoryAnalysisCaches();
         }
 
         // search when registers are used for last time.
@@ -2192,9 +2567,11 @@ DataDependenceGraphBuilder::build(
         Application::logStream()
             << e.fileName() << ": " << e.lineNum() << ": " << e.errorMessageStack()
             << std::endl;
+        clearMemoryAnalysisCaches();
         delete ddg;
         throw;
     } catch (...) {
+        clearMemoryAnalysisCaches();
         delete ddg;
         throw;
     }
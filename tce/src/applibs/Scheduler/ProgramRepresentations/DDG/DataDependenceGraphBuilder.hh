@@ -61,6 +61,7 @@ namespace TTAMachine {
 
 class UniversalMachine;
 class InterPassData;
+class OffsetAliasAnalyzer;
 
 
 /**
@@ -143,6 +144,69 @@ protected:
     typedef std::map <BasicBlockNode*, BBData*> BBDataMap;
     typedef std::list<BBData*> BBDataList;
 
+    /// Kinds of memory addresses the memory access buckets know about.
+    enum MemoryAddressKind {
+        ADDRESS_UNKNOWN = 0, /// Not analyzable, may alias anything.
+        ADDRESS_ABSOLUTE, /// Constant address.
+        ADDRESS_STACK, /// Constant offset from the stack pointer.
+        ADDRESS_OFFSET /// Constant offset from the value of a move.
+    };
+
+    /**
+     * Address of a memory access as seen by the constant, stack and
+     * offset alias analyzers.
+     */
+    struct MemoryAccessKey {
+        MemoryAccessKey() :
+            kind(ADDRESS_UNKNOWN), base(NULL), address(0), size(0) {}
+        MemoryAddressKind kind;
+        /// The move giving the base address of an ADDRESS_OFFSET access.
+        const MoveNode* base;
+        /// The address, the stack offset or the offset from the base.
+        int address;
+        /// Size of the access in MAUs, a power of two.
+        int size;
+    };
+
+    typedef std::multimap<int, MoveNodeUse> MemoryAccessAddressMap;
+
+    /// Accesses at constant offsets from the same base address.
+    struct MemoryAccessOffsetBucket {
+        MemoryAccessOffsetBucket() : maxSize_(1) {}
+        /// The accesses by their offsets.
+        MemoryAccessAddressMap accesses_;
+        /// Size of the largest access in the map.
+        int maxSize_;
+    };
+
+    /**
+     * The memory accesses of a bookkeeping set grouped by their addresses.
+     *
+     * Used for finding the accesses of the set that may alias a new
+     * access without running the alias analyzers on all of them. May
+     * contain accesses which have already been removed from the set,
+     * those are dropped when encountered.
+     */
+    struct MemoryAccessBuckets {
+        MemoryAccessBuckets() : absoluteMaxSize_(1), stackMaxSize_(1) {}
+        void clear();
+        /// Accesses without a known address.
+        std::vector<MoveNodeUse> unknown_;
+        /// Accesses to constant addresses, by address.
+        MemoryAccessAddressMap absolute_;
+        /// Accesses to constant stack offsets, by offset.
+        MemoryAccessAddressMap stack_;
+        /// Accesses to constant offsets from a base address, by base.
+        std::map<const MoveNode*, MemoryAccessOffsetBucket> offset_;
+        /// Sizes of the largest accesses in the maps.
+        int absoluteMaxSize_;
+        int stackMaxSize_;
+    };
+
+    typedef std::map<TCEString, MemoryAccessBuckets> MemoryAccessBucketMap;
+    /// The ids of the compared POs and their BB relation.
+    typedef std::pair<std::pair<unsigned int, unsigned int>, int> AliasQuery;
+
     void updatePreceedingRegistersUsedAfter(
         BBData& bbd, 
         bool firstTime);
@@ -246,6 +310,23 @@ protected:
     bool isAddressTraceable(const ProgramOperation& pop);
     TCEString memoryCategory(const MoveNodeUse& mnd);
 
+    const MemoryAccessKey& memoryAccessKey(const MoveNodeUse& mnd);
+    void addToMemoryBuckets(
+        MemoryAccessBuckets& buckets, const MoveNodeUse& mnd);
+    void initializeMemoryBuckets();
+    void collectMemoryAliasCandidates(
+        const MemoryAccessKey* key,
+        MemoryAccessAddressMap& accesses,
+        int maxSize,
+        const MoveNodeUseSet& prevNodes,
+        MoveNodeUseSet& candidates);
+    const MoveNodeUseSet& memoryAliasCandidates(
+        const MoveNodeUse& mnd,
+        const MoveNodeUseSet& prevNodes,
+        MemoryAccessBuckets& buckets,
+        MoveNodeUseSet& candidates);
+    void clearMemoryAnalysisCaches();
+
     bool checkAndCreateMemDep(
         MoveNodeUse prev, 
         MoveNodeUse mnd, 
@@ -253,11 +334,12 @@ protected:
     void checkAndCreateMemAntideps(
         MoveNodeUse& mnd,
         std::set<MoveNodeUse>& prevNodes,
+        const std::set<MoveNodeUse>& aliasingNodes,
         DataDependenceEdge::DependenceType depType,
         bool traceable);
     bool hasEarlierMemWriteToSameAddressWithSameGuard(
         MoveNodeUse& mnd,
-        std::set<MoveNodeUse>& defines);
+        const std::set<MoveNodeUse>& defines);
 
     std::set<MoveNodeUse> earlierWritesWithSameGuard(
         MoveNodeUse& mnd, std::set<MoveNodeUse>& defines);
@@ -311,6 +393,20 @@ protected:
     BBData* currentData_;
     DataDependenceGraph* currentDDG_;
     AliasAnalyzerVector aliasAnalyzers_;
+    /// Whether constant and stack addresses may be used to rule out
+    /// aliasing, ie. the analyzers that tell so are in use.
+    bool constantAA_;
+    bool stackAA_;
+    bool globalVsStackAA_;
+    /// The offset alias analyzer in use, if any.
+    OffsetAliasAnalyzer* offsetAA_;
+    /// Memory writes and reads of the BB being constructed, by category.
+    MemoryAccessBucketMap memDefineBuckets_;
+    MemoryAccessBucketMap memUseBuckets_;
+    /// Addresses of the memory operations, by PO id.
+    std::map<unsigned int, MemoryAccessKey> memoryAccessKeys_;
+    /// Results of the alias analyzer queries of the memory phase.
+    std::map<AliasQuery, MemoryAliasAnalyzer::AliasingResult> aliasResults_;
     /// contains stack pointer, RV and parameter registers.
     SpecialRegisters specialRegisters_;
     static const TCEString RA_NAME;
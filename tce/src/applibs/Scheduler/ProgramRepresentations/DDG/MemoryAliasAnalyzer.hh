@@ -73,6 +73,8 @@ public:
         const ProgramOperation& pop) = 0;
 
     virtual ~MemoryAliasAnalyzer() {}
+
+    static unsigned int mausOfOperation(const Operation& op);
 protected:
     AliasingResult compareIndeces(
         int index1, 
@@ -105,8 +107,6 @@ protected:
     static const MoveNode* findIncrement(const MoveNode& mn, long& increment);
 
     static const MoveNode* detectConstantScale(const MoveNode& mn, int &shiftAmount);
-private:
-    unsigned int mausOfOperation(const Operation& op);
 };
 
 #endif
@@ -151,43 +151,39 @@ OffsetAliasAnalyzer::isAddressTraceable(
     return true;
 }
 
-/** 
- * Analyzes aliasing of two memory adderesses.
- * 
- * Checks if they are stack offsets and compares the offsets.
- * 
- * @param ddg ddg where they belong.
- * @param node1 first node to compare
- * @param another anpther node to compare
- * @return ALIAS_TRUE if they alias, ALIAS_FALSE if they don't or
- *         ALIAS_UNKNOWN if cannot analyze.
+/**
+ * Finds the base address node and the constant offset of a memory access.
+ *
+ * The results are cached by the ProgramOperation.
+ *
+ * @param ddg DDG where to analyze from
+ * @param pop the memory operation
+ * @param base the move that defines the base address is put here
+ * @param offset the offset from the base address is put here
+ * @return true if the address is a constant offset from a base node.
  */
-MemoryAliasAnalyzer::AliasingResult
-OffsetAliasAnalyzer::analyze(
-    DataDependenceGraph& ddg, const ProgramOperation& pop1, 
-    const ProgramOperation& pop2, MoveNodeUse::BBRelation bbRel) {
-    const MoveNode* anc1 = NULL;
-    const MoveNode* anc2 = NULL;
-    long offsetVal1 = 0;
-    long offsetVal2 = 0;
+bool
+OffsetAliasAnalyzer::baseAndOffset(
+    DataDependenceGraph& ddg, const ProgramOperation& pop,
+    const MoveNode*& base, long& offset) {
 
-    std::map<int,OffsetData>::const_iterator i = 
-        offsetData_.find(pop1.poId());
+    std::map<int,OffsetData>::const_iterator i =
+        offsetData_.find(pop.poId());
     if (i != offsetData_.end()) {
         if (i->second.baseNode == NULL) {
-            return ALIAS_UNKNOWN;
+            return false;
         } else {
-            anc1 = i->second.baseNode;
-            offsetVal1 = i->second.offset;
+            base = i->second.baseNode;
+            offset = i->second.offset;
         }
     } else {
 
-        const MoveNode* addrMove1 = addressOperandMove(pop1);
-        if (addrMove1 == NULL) {
+        const MoveNode* addrMove = addressOperandMove(pop);
+        if (addrMove == NULL) {
 
             int offsetMul = 0;
             TwoPartAddressOperandDetection addressParts =
-                findTwoPartAddressOperands(pop1);
+                findTwoPartAddressOperands(pop);
             switch(addressParts.offsetOperation) {
             case TwoPartAddressOperandDetection::ADD:
                 offsetMul = 1;
@@ -198,267 +194,150 @@ OffsetAliasAnalyzer::analyze(
             case TwoPartAddressOperandDetection::NOT_FOUND:
                 offsetData_.insert(
                     std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
+                        pop.poId(),OffsetData(NULL, INT_MAX)));
+                return false;
             }
             
-            MoveNodeSet& addr1Set = pop1.inputNode(addressParts.operand1);
-            MoveNodeSet& addr2Set = pop1.inputNode(addressParts.operand2);
+            MoveNodeSet& addr1Set = pop.inputNode(addressParts.operand1);
+            MoveNodeSet& addr2Set = pop.inputNode(addressParts.operand2);
             if (addr1Set.count() != 1) {
                 offsetData_.insert(
                     std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
+                        pop.poId(),OffsetData(NULL, INT_MAX)));
+                return false;
             } 
             if (addr2Set.count() != 1) {
                 offsetData_.insert(
                     std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
+                        pop.poId(),OffsetData(NULL, INT_MAX)));
+                return false;
             }
             MoveNode& addr1 = addr1Set.at(0);
             MoveNode& addr2 = addr2Set.at(0);
             
             if (addr1.isSourceConstant() &&
                 addr2.move().source().isGPR()) {
-                anc1 = ddg.onlyRegisterRawAncestor(addr2, sp_);
-                offsetVal1 = addr1.move().source().value().intValue() *
+                base = ddg.onlyRegisterRawAncestor(addr2, sp_);
+                offset = addr1.move().source().value().intValue() *
                     offsetMul;
             } else {
                 if (addr2.isSourceConstant() &&
                     addr1.move().source().isGPR()) {
-                    anc1 = ddg.onlyRegisterRawAncestor(addr1, sp_);
-                    offsetVal1 = addr2.move().source().value().intValue() *
+                    base = ddg.onlyRegisterRawAncestor(addr1, sp_);
+                    offset = addr2.move().source().value().intValue() *
                         offsetMul;
                 } else {
                     offsetData_.insert(
                         std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
+                        pop.poId(),OffsetData(NULL, INT_MAX)));
+                    return false;
                 }
             }
 
             offsetData_.insert(
                 std::pair<int,OffsetData>(
-                    pop1.poId(),OffsetData(anc1, offsetVal1)));
+                    pop.poId(),OffsetData(base, offset)));
 
         } else {
             // direct memory op. have to search for the add.
 
-            // first find base and index of the first node.
-            const MoveNode* rawSrc1 = 
-                ddg.onlyRegisterRawAncestor(*addrMove1, sp_);
+            // first find base and index of the address.
+            const MoveNode* rawSrc = 
+                ddg.onlyRegisterRawAncestor(*addrMove, sp_);
             
-            if (!rawSrc1->isSourceOperation()) {
+            if (!rawSrc->isSourceOperation()) {
                 offsetData_.insert(
                     std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(rawSrc1, 0)));
+                        pop.poId(),OffsetData(rawSrc, 0)));
+                base = rawSrc;
+                offset = 0;
             } else {
             
-            ProgramOperation& po1 = rawSrc1->sourceOperation();
+            ProgramOperation& po = rawSrc->sourceOperation();
             
-            if (po1.operation().name() == "ADD" ||
-                po1.operation().name() == "SUB") {
+            if (po.operation().name() == "ADD" ||
+                po.operation().name() == "SUB") {
                 
                 
                 // offset calc, add or sub. check for node2
-                MoveNodeSet& baseSet1 = po1.inputNode(1);
-                MoveNodeSet& offsetSet1 = po1.inputNode(2);
+                MoveNodeSet& baseSet = po.inputNode(1);
+                MoveNodeSet& offsetSet = po.inputNode(2);
                 
-                if (baseSet1.count() != 1 || offsetSet1.count() != 1) {
+                if (baseSet.count() != 1 || offsetSet.count() != 1) {
                     offsetData_.insert(
                         std::pair<int,OffsetData>(
-                            pop1.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
+                            pop.poId(),OffsetData(NULL, INT_MAX)));
+                    return false;
                 }
                 
-                MoveNode& offsetNode1 = offsetSet1.at(0);
-                MoveNode& base1 = baseSet1.at(0);
+                MoveNode& offsetNode = offsetSet.at(0);
+                MoveNode& baseMove = baseSet.at(0);
                 
-                if (!base1.move().source().isGPR() ||
-                    !offsetNode1.move().source().isImmediate()) {
+                if (!baseMove.move().source().isGPR() ||
+                    !offsetNode.move().source().isImmediate()) {
                     offsetData_.insert(
                         std::pair<int,OffsetData>(
-                            pop1.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
+                            pop.poId(),OffsetData(NULL, INT_MAX)));
+                    return false;
                 }
                 
-                offsetVal1 = offsetNode1.move().source().value().intValue();
-                if (po1.operation().name() == "SUB") {
-                    offsetVal1 = -offsetVal1;
+                offset = offsetNode.move().source().value().intValue();
+                if (po.operation().name() == "SUB") {
+                    offset = -offset;
                 }
                 
-                anc1 = ddg.onlyRegisterRawAncestor(base1, sp_);
+                base = ddg.onlyRegisterRawAncestor(baseMove, sp_);
                 // update cache.
                 offsetData_.insert(
                     std::pair<int,OffsetData>(
-                        pop1.poId(),OffsetData(anc1, offsetVal1)));
+                        pop.poId(),OffsetData(base, offset)));
             } else {
                 // comes directly from some untraceable op.
-                if (ddg.regRawSuccessorCount(*rawSrc1, false) > 1) {
+                if (ddg.regRawSuccessorCount(*rawSrc, false) > 1) {
                     offsetData_.insert(
                         std::pair<int,OffsetData>(
-                            pop1.poId(),OffsetData(rawSrc1, 0)));
-                    anc1 = rawSrc1;
-                    offsetVal1 = 0;
+                            pop.poId(),OffsetData(rawSrc, 0)));
+                    base = rawSrc;
+                    offset = 0;
                 } else {
                     offsetData_.insert(
                         std::pair<int,OffsetData>(
-                            pop1.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
+                            pop.poId(),OffsetData(NULL, INT_MAX)));
+                    return false;
                 }
             }
             }
         }
     }
-    // then find base and index for second node.
-
-    //first search cache.
-    i = offsetData_.find(pop2.poId());
-    if (i != offsetData_.end()) {
-        if (i->second.baseNode == NULL) {
-            return ALIAS_UNKNOWN;
-        } else {
-            anc2 = i->second.baseNode;
-            offsetVal2 = i->second.offset;
-        }
-    } else {
-        const MoveNode* addrMove2 = addressOperandMove(pop2);
-        if (addrMove2 == NULL) {
-
-            int offsetMul = 0;
-            TwoPartAddressOperandDetection addressParts =
-                findTwoPartAddressOperands(pop2);
-            switch(addressParts.offsetOperation) {
-            case TwoPartAddressOperandDetection::ADD:
-                offsetMul = 1;
-                break;
-            case TwoPartAddressOperandDetection::SUB:
-                offsetMul = -1;
-                break;
-            case TwoPartAddressOperandDetection::NOT_FOUND:
-                offsetData_.insert(
-                    std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
-            }
-            
-            MoveNodeSet& addr1Set = pop2.inputNode(addressParts.operand1);
-            MoveNodeSet& addr2Set = pop2.inputNode(addressParts.operand2);
-            if (addr1Set.count() != 1) {
-                offsetData_.insert(
-                    std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
-            } 
-            if (addr2Set.count() != 1) {
-                offsetData_.insert(
-                    std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(NULL, INT_MAX)));
-                return ALIAS_UNKNOWN;
-            }
-            MoveNode& addr1 = addr1Set.at(0);
-            MoveNode& addr2 = addr2Set.at(0);
-            
-            if (addr1.isSourceConstant() &&
-                addr2.move().source().isGPR()) {
-                anc2 = ddg.onlyRegisterRawAncestor(addr2, sp_);
-                offsetVal2 = addr1.move().source().value().intValue() *
-                    offsetMul;
-            } else {
-                if (addr2.isSourceConstant() &&
-                    addr1.move().source().isGPR()) {
-                    anc2 = ddg.onlyRegisterRawAncestor(addr1, sp_);
-                    offsetVal2 = addr2.move().source().value().intValue() *
-                        offsetMul;
-                } else {
-                    offsetData_.insert(
-                        std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
-                }
-            }
-
-            offsetData_.insert(
-                std::pair<int,OffsetData>(
-                    pop2.poId(),OffsetData(anc2, offsetVal2)));
-        } else {
-            // direct memory op. have to search for the add.
-
-            // first find base and index of the first node.
-            const MoveNode* rawSrc2 = 
-                ddg.onlyRegisterRawAncestor(*addrMove2, sp_);
-            
-            if (!rawSrc2->isSourceOperation()) {
-                offsetData_.insert(
-                    std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(rawSrc2, 0)));
+    return base != NULL;
+}
 
-            } else {
-            
-            ProgramOperation& po2 = rawSrc2->sourceOperation();
-            
-            if (po2.operation().name() == "ADD" ||
-                po2.operation().name() == "SUB") {
-                
-                // offset calc, add or sub. check for node2
-                MoveNodeSet& baseSet2 = po2.inputNode(1);
-                MoveNodeSet& offsetSet2 = po2.inputNode(2);
-                
-                if (baseSet2.count() != 1 || offsetSet2.count() != 1) {
-                    offsetData_.insert(
-                        std::pair<int,OffsetData>(
-                            pop2.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
-                } 
-                
-                MoveNode& offsetNode2 = offsetSet2.at(0);
-                MoveNode& base2 = baseSet2.at(0);
-                
-                // check that base is register coming from same place.
-                
-                if (!base2.move().source().isGPR() ||
-                    !offsetNode2.move().source().isImmediate()) {
-                    offsetData_.insert(
-                        std::pair<int,OffsetData>(
-                            pop2.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
-                }
-                
-                offsetVal2 = offsetNode2.move().source().value().intValue();
-                if (po2.operation().name() == "SUB") {
-                    offsetVal2 = -offsetVal2;
-                }
-                
-                anc2 = ddg.onlyRegisterRawAncestor(base2, sp_);
-                // update cache.
-                offsetData_.insert(
-                    std::pair<int,OffsetData>(
-                        pop2.poId(),OffsetData(anc2, offsetVal2)));
-            } else {
-                // comes directly from some untraceable op.
-                if (ddg.regRawSuccessorCount(*rawSrc2, false) > 1) {
-                    offsetData_.insert(
-                        std::pair<int,OffsetData>(
-                            pop2.poId(),OffsetData(rawSrc2, 0)));
-                    anc2 = rawSrc2;
-                    offsetVal2 = 0;
-                } else {
-                    offsetData_.insert(
-                        std::pair<int,OffsetData>(
-                            pop2.poId(),OffsetData(NULL, INT_MAX)));
-                    return ALIAS_UNKNOWN;
-                }
-            }
-            }
-        }
-    }
-    // now we have the defining move for base and offset. compare them
+/** 
+ * Analyzes aliasing of two memory adderesses.
+ * 
+ * Checks if they are stack offsets and compares the offsets.
+ * 
+ * @param ddg ddg where they belong.
+ * @param node1 first node to compare
+ * @param another anpther node to compare
+ * @return ALIAS_TRUE if they alias, ALIAS_FALSE if they don't or
+ *         ALIAS_UNKNOWN if cannot analyze.
+ */
+MemoryAliasAnalyzer::AliasingResult
+OffsetAliasAnalyzer::analyze(
+    DataDependenceGraph& ddg, const ProgramOperation& pop1, 
+    const ProgramOperation& pop2, MoveNodeUse::BBRelation bbRel) {
+    const MoveNode* anc1 = NULL;
+    const MoveNode* anc2 = NULL;
+    long offsetVal1 = 0;
+    long offsetVal2 = 0;
 
-    if (anc1 == NULL || anc2 == NULL) {
+    if (!baseAndOffset(ddg, pop1, anc1, offsetVal1) ||
+        !baseAndOffset(ddg, pop2, anc2, offsetVal2)) {
         return ALIAS_UNKNOWN;
     }
 
+    // now we have the defining move for base and offset. compare them
     if (anc1 == anc2 || sameLoopAndPrevSources(ddg, *anc1, *anc2)) {
 
         if (bbRel == MoveNodeUse::LOOP) {
@@ -50,6 +50,9 @@ public:
     virtual AliasingResult analyze(
         DataDependenceGraph& ddg, const ProgramOperation& pop1, 
         const ProgramOperation& pop2, MoveNodeUse::BBRelation bbRelation);
+    bool baseAndOffset(
+        DataDependenceGraph& ddg, const ProgramOperation& pop,
+        const MoveNode*& base, long& offset);
 
     OffsetAliasAnalyzer(const TCEString& sp);
     ~OffsetAliasAnalyzer();
@@ -540,20 +540,35 @@ BusBroker::unassign(MoveNode& node) {
  * resource of the type managed by this broker can be assigned to the
  * given node.
  *
+ * Only the reservations of the buses are checked, not the connectivity
+ * or the immediate widths, so the node is not guaranteed to be
+ * assignable in the returned cycle. No earlier cycle can be assigned,
+ * though, as all the buses the node could use are in use before it.
+ *
  * @param cycle Cycle.
  * @param node Node.
+ * @param bus If not NULL, the bus that has to be used.
  * @return The earliest cycle, starting from given cycle, where a
  * resource of the type managed by this broker can be assigned to the
- * given node.
+ * given node, -1 if all the buses are in use in every cycle of the
+ * initiation interval.
  */
 int
-BusBroker::earliestCycle(int, const MoveNode&, const TTAMachine::Bus*,
+BusBroker::earliestCycle(int cycle, const MoveNode& node,
+                         const TTAMachine::Bus* bus,
                          const TTAMachine::FunctionUnit*,
                          const TTAMachine::FunctionUnit*, int,
                          const TTAMachine::ImmediateUnit*,
                          int) const {
-    abortWithError("Not implemented.");
-    return -1;
+    if (!node.isMove()) {
+        // does not use a bus
+        return cycle;
+    }
+    std::vector<const ReservationBitVector*> tables;
+    candidateReservations(node, bus, tables);
+    int found = ReservationBitVector::firstFreeCycle(
+        tables, cycle, initiationInterval_);
+    return (found == ReservationBitVector::NOT_FOUND) ? -1 : found;
 }
 
 /**
@@ -561,20 +576,65 @@ BusBroker::earliestCycle(int, const MoveNode&, const TTAMachine::Bus*,
  * resource of the type managed by this broker can be assigned to the
  * given node.
  *
+ * Like earliestCycle(), checks only the reservations of the buses.
+ *
  * @param cycle Cycle.
  * @param node Node.
+ * @param bus If not NULL, the bus that has to be used.
  * @return The latest cycle, starting from given cycle, where a
  * resource of the type managed by this broker can be assigned to the
- * given node.
+ * given node, -1 if all the buses are in use down to cycle 0.
  */
 int
-BusBroker::latestCycle(int, const MoveNode&, const TTAMachine::Bus*,
+BusBroker::latestCycle(int cycle, const MoveNode& node,
+                       const TTAMachine::Bus* bus,
                        const TTAMachine::FunctionUnit*,
                        const TTAMachine::FunctionUnit*, int,
                        const TTAMachine::ImmediateUnit*,
                        int) const {
-    abortWithError("Not implemented.");
-    return -1;
+    if (!node.isMove()) {
+        // does not use a bus
+        return cycle;
+    }
+    std::vector<const ReservationBitVector*> tables;
+    candidateReservations(node, bus, tables);
+    int found = ReservationBitVector::lastFreeCycle(
+        tables, cycle, initiationInterval_);
+    return (found == ReservationBitVector::NOT_FOUND) ? -1 : found;
+}
+
+/**
+ * Collects the reservation tables of the buses the given node could be
+ * assigned to.
+ *
+ * @param node Node.
+ * @param bus If not NULL, the bus that has to be used.
+ * @param tables The tables are appended here, none if the bus has no
+ * resource.
+ */
+void
+BusBroker::candidateReservations(
+    const MoveNode& node, const TTAMachine::Bus* bus,
+    std::vector<const ReservationBitVector*>& tables) const {
+
+    if (bus == NULL) {
+        const Bus& moveBus = node.move().bus();
+        if (&moveBus != &UniversalMachine::instance().universalBus()) {
+            bus = &moveBus;
+        }
+    }
+    if (bus != NULL) {
+        BusResource* busRes = static_cast<BusResource*>(resourceOf(*bus));
+        if (busRes != NULL) {
+            tables.push_back(&busRes->reservations());
+        }
+        return;
+    }
+    for (ResourceMap::const_iterator i = resMap_.begin();
+         i != resMap_.end(); i++) {
+        tables.push_back(
+            &static_cast<BusResource*>(i->second)->reservations());
+    }
 }
 
 /**
@@ -36,6 +36,7 @@
 #include "ResourceBroker.hh"
 
 #include <list>
+#include <vector>
 
 namespace TTAMachine {
     class Machine;
@@ -53,6 +54,7 @@ class BusResource;
 class ShortImmPSocketResource;
 class ControlFlowGraph;
 class BasicBlockNode;
+class ReservationBitVector;
 
 /**
  * Bus broker.
@@ -137,6 +139,9 @@ public:
 private:
     bool jumpToBBN(const MoveNode& mn, BasicBlockNode& bbn) const;
     bool canPerformSIMMJump(const MoveNode& mn, ShortImmPSocketResource& immRes) const;
+    void candidateReservations(
+        const MoveNode& node, const TTAMachine::Bus* bus,
+        std::vector<const ReservationBitVector*>& tables) const;
 
     virtual bool canTransportImmediate(
         const MoveNode& node,
@@ -453,7 +453,7 @@ InputFUBroker::assign(
     const FunctionUnit& unit =
         static_cast<const FunctionUnit&>(machinePartOf(fuRes));
     HWOperation* hwOp = unit.operation(op.name());
-    TerminalFUPort* newDst = new TerminalFUPort(*hwOp, opIndex);
+    TerminalFUPort* newDst = new TerminalFUPort(*hwOp, opIndex, op);
     newDst->setProgramOperation(dst.programOperation());
     move.setDestination(newDst);
     fuRes.assign(cycle, node);
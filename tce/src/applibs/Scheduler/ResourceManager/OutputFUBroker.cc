@@ -310,7 +310,8 @@ OutputFUBroker::assign(
         const FunctionUnit& unit =
             static_cast<const FunctionUnit&>(machinePartOf(res));
         HWOperation* hwOp = unit.operation(op->name());
-        TerminalFUPort* newSrc = new TerminalFUPort(*hwOp, opIndex);
+        TerminalFUPort* newSrc = new TerminalFUPort(
+            *hwOp, opIndex, src->hintOperation());
         move.setSource(newSrc);
         fuRes.assign(cycle, node);
         assignedResources_.insert(
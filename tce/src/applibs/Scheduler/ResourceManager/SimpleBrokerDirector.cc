@@ -516,8 +516,21 @@ SimpleBrokerDirector::earliestCycle(int cycle, MoveNode& node,
         lastCycleToTest = largestCycle();
     }
 
-    while (!canAssign(minCycle, node, bus, srcFU, dstFU, immWriteCycle, immu,
-		      immRegIndex)) {
+    while (true) {
+        // skip the cycles where all the buses the move could use are
+        // reserved without testing the other resources on them
+        int busCycle = busBroker().earliestCycle(
+            minCycle, node, bus, srcFU, dstFU, immWriteCycle, immu,
+            immRegIndex);
+        if (busCycle == -1) {
+            debugLogRM("No assignment possible due to busBroker.");
+            return -1;
+        }
+        if (busCycle == minCycle &&
+            canAssign(minCycle, node, bus, srcFU, dstFU, immWriteCycle, immu,
+                      immRegIndex)) {
+            return minCycle;
+        }
         if (minCycle > lastCycleToTest + 1) {
             // Even on empty instruction it is not possible to assign
             debugLogRM(
@@ -528,14 +541,13 @@ SimpleBrokerDirector::earliestCycle(int cycle, MoveNode& node,
         // find next cycle where exec pipeline could be free,
         // do not test every cycle with canassign.
         minCycle = executionPipelineBroker().earliestCycle(
-            minCycle + 1, node, bus, srcFU, dstFU, immWriteCycle, immu,
-	    immRegIndex);
+            std::max(minCycle + 1, busCycle), node, bus, srcFU, dstFU,
+            immWriteCycle, immu, immRegIndex);
         if (minCycle == -1) {
             debugLogRM("No assignment possible due to executionPipelineBroker.");
             return -1;
         }
     }
-    return minCycle;
 }
 
 /**
@@ -644,6 +656,12 @@ SimpleBrokerDirector::latestCycle(int cycle, MoveNode& node,
 
     if (maxCycle <= lastCycleToTest) {
         for (int i = maxCycle; i >= earliestCycleLimit; i--) {
+            // skip the cycles where all the usable buses are reserved
+            i = busBroker().latestCycle(
+                i, node, bus, srcFU, dstFU, immWriteCycle, immu, immRegIndex);
+            if (i < earliestCycleLimit) {
+                break;
+            }
             if (canAssign(i, node, bus, srcFU, dstFU, immWriteCycle, immu,
 			  immRegIndex)) {
                 return i;
@@ -657,6 +675,12 @@ SimpleBrokerDirector::latestCycle(int cycle, MoveNode& node,
             }
         }        
         for (int i = lastCycleToTest; i >= earliestCycleLimit; i--) {
+            // skip the cycles where all the usable buses are reserved
+            i = busBroker().latestCycle(
+                i, node, bus, srcFU, dstFU, immWriteCycle, immu, immRegIndex);
+            if (i < earliestCycleLimit) {
+                break;
+            }
             if (canAssign(i, node, bus, srcFU, dstFU, immWriteCycle, immu,
 			  immRegIndex)) {
                 return i;
@@ -72,6 +72,7 @@ SimpleResourceManager::SimpleResourceManager(
 SimpleResourceManager* 
 SimpleResourceManager::createRM(
     const TTAMachine::Machine& machine, unsigned int ii) {
+    boost::mutex::scoped_lock lock(rmPoolLock_);
     std::map<int, std::list< SimpleResourceManager*> >& pool =
         rmPool_[&machine];
     std::list<SimpleResourceManager*>& iipool = pool[ii];
@@ -93,6 +94,7 @@ void SimpleResourceManager::disposeRM(
     SimpleResourceManager* rm, bool allowReuse) {
     if (rm == NULL) return;
     if (allowReuse) {
+        boost::mutex::scoped_lock lock(rmPoolLock_);
         std::map<int, std::list< SimpleResourceManager*> >& pool =
             rmPool_[&rm->machine()];
         pool[rm->initiationInterval()].push_back(rm);
@@ -643,6 +645,7 @@ SimpleResourceManager::setBBN(const BasicBlockNode* bbn) {
 std::map<const TTAMachine::Machine*, 
          std::map<int, std::list< SimpleResourceManager*> > >
 SimpleResourceManager::rmPool_;
+boost::mutex SimpleResourceManager::rmPoolLock_;
 
 void SimpleResourceManager::setMaxCycle(unsigned int maxCycle) {
     director_->setMaxCycle(maxCycle);
@@ -37,6 +37,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <boost/thread/mutex.hpp>
 
 #include "ResourceManager.hh"
 #include "AssignmentPlan.hh"
@@ -167,6 +168,9 @@ private:
     static std::map<const TTAMachine::Machine*, 
                     std::map<int, std::list< SimpleResourceManager*> > >
     rmPool_;
+    /// Serializes the accesses to the pool, procedures can be scheduled
+    /// in several threads at the same time.
+    static boost::mutex rmPoolLock_;
 };
 
 #endif
@@ -73,12 +73,7 @@ BusResource::~BusResource() {}
  */
 bool
 BusResource::isInUse(const int cycle) const {
-    ResourceRecordType::const_iterator i = 
-        resourceRecord_.find(instructionIndex(cycle));
-    if (i != resourceRecord_.end() && i->second != 0) {
-        return true;
-    }
-    return false;
+    return reservations_.isReserved(instructionIndex(cycle));
 }
 
 /**
@@ -124,7 +119,7 @@ void
 BusResource::assign(const int cycle, MoveNode& node)
 {
    if (canAssign(cycle, node)) {
-        resourceRecord_[instructionIndex(cycle)] = 1;
+        reservations_.reserve(instructionIndex(cycle));
         increaseUseCount();
         return;
     }
@@ -142,7 +137,7 @@ void
 BusResource::unassign(const int cycle, MoveNode&) {
 
     if (isInUse(cycle)) {
-        resourceRecord_[instructionIndex(cycle)] = 0;
+        reservations_.release(instructionIndex(cycle));
         return;
     } else{
         std::string msg = "Bus ";
@@ -333,5 +328,5 @@ BusResource::operator< (const SchedulingResource& other) const {
 void
 BusResource::clear() {
     SchedulingResource::clear();
-    resourceRecord_.clear();
+    reservations_.clear();
 }
@@ -35,8 +35,8 @@
 #define TTA_BUSRESOURCE_HH
 
 #include<string>
-#include <map>
 #include "SchedulingResource.hh"
+#include "ReservationBitVector.hh"
 
 /**
  * An interface for scheduling resources of Resource Model
@@ -70,6 +70,9 @@ public:
     virtual bool operator < (const SchedulingResource& other) const override;
 
     int nopSlotCount() { return nopSlotCount_; }
+    const ReservationBitVector& reservations() const {
+        return reservations_;
+    }
     void clear() override;
 protected:
     virtual bool validateDependentGroups() override;
@@ -93,9 +96,8 @@ private:
     // number of connected sockets
     int socketCount_;
 
-    // map contains <Cycle : testCounter>
-    typedef std::map<int, int> ResourceRecordType;
-    ResourceRecordType resourceRecord_;
+    // reserved instruction indices of the bus
+    ReservationBitVector reservations_;
 
 };
 
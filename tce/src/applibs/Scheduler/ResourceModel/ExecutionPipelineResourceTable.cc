@@ -164,6 +164,7 @@ const ExecutionPipelineResourceTable&
 ExecutionPipelineResourceTable::resourceTable(
     const TTAMachine::FunctionUnit& fu) {
     
+    boost::mutex::scoped_lock lock(allResourceTablesLock_);
     ResourceTableMap::iterator i = allResourceTables_.find(&fu);
 
     if (i != allResourceTables_.end()) {
@@ -183,8 +184,10 @@ ExecutionPipelineResourceTable::resourceTable(
  */
 void
 ExecutionPipelineResourceTable::finalize() {
+    boost::mutex::scoped_lock lock(allResourceTablesLock_);
     MapTools::deleteAllValues(allResourceTables_);
 }
 
 ExecutionPipelineResourceTable::ResourceTableMap 
 ExecutionPipelineResourceTable::allResourceTables_;
+boost::mutex ExecutionPipelineResourceTable::allResourceTablesLock_;
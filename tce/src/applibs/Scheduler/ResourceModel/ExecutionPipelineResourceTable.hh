@@ -36,6 +36,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <boost/thread/mutex.hpp>
 
 namespace TTAMachine {
     class FunctionUnit;
@@ -98,6 +99,8 @@ private:
 
     /// Contains these tables for all FU's
     static ResourceTableMap allResourceTables_;
+    /// Serializes the accesses to the tables of all FUs.
+    static boost::mutex allResourceTablesLock_;
 };
 
 #include "ExecutionPipelineResourceTable.icc"
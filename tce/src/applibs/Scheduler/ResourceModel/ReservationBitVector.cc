@@ -0,0 +1,339 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReservationBitVector.cc
+ *
+ * Implementation of ReservationBitVector class.
+ *
+ * @note rating: red
+ */
+
+#include "ReservationBitVector.hh"
+
+#include <algorithm>
+
+const int ReservationBitVector::NOT_FOUND;
+const int ReservationBitVector::WORD_BITS;
+
+/**
+ * Constructor. Creates a table with no reservations.
+ */
+ReservationBitVector::ReservationBitVector() :
+    firstWord_(0), reservedCount_(0) {
+}
+
+/**
+ * Returns the index of the word that holds the bit of the given index.
+ *
+ * Rounds towards negative infinity so that negative indices get words
+ * of their own.
+ */
+long long
+ReservationBitVector::wordOf(int index) {
+    long long i = index;
+    return (i >= 0) ? i / WORD_BITS : -((-i + WORD_BITS - 1) / WORD_BITS);
+}
+
+/**
+ * Returns the position of the bit of the given index inside its word.
+ */
+int
+ReservationBitVector::bitOf(int index) {
+    return static_cast<int>(index - wordOf(index) * WORD_BITS);
+}
+
+/**
+ * Returns the reservation word of the given word index.
+ *
+ * Words outside of the stored range have no reservations.
+ */
+ReservationBitVector::Word
+ReservationBitVector::word(long long wordIndex) const {
+    if (wordIndex < firstWord_ ||
+        wordIndex >= firstWord_ + static_cast<long long>(words_.size())) {
+        return 0;
+    }
+    return words_[wordIndex - firstWord_];
+}
+
+/**
+ * Tells whether the given index is reserved.
+ *
+ * @param index The index to test.
+ * @return True if the index is reserved.
+ */
+bool
+ReservationBitVector::isReserved(int index) const {
+    return (word(wordOf(index)) >> bitOf(index)) & 1;
+}
+
+/**
+ * Reserves the given index.
+ *
+ * The stored range grows to cover the index. When it grows downwards
+ * the range is at least doubled so that schedulers which proceed
+ * towards smaller cycles do not move the words on every reservation.
+ *
+ * @param index The index to reserve.
+ */
+void
+ReservationBitVector::reserve(int index) {
+    long long w = wordOf(index);
+    if (words_.empty()) {
+        firstWord_ = w;
+        words_.assign(1, 0);
+    } else if (w < firstWord_) {
+        long long newFirst = std::min(
+            w, firstWord_ - static_cast<long long>(words_.size()));
+        words_.insert(words_.begin(), firstWord_ - newFirst, 0);
+        firstWord_ = newFirst;
+    } else if (w >= firstWord_ + static_cast<long long>(words_.size())) {
+        words_.resize(w - firstWord_ + 1, 0);
+    }
+    Word& bits = words_[w - firstWord_];
+    Word mask = Word(1) << bitOf(index);
+    if ((bits & mask) == 0) {
+        bits |= mask;
+        reservedCount_++;
+    }
+}
+
+/**
+ * Releases the reservation of the given index.
+ *
+ * Releasing an index that is not reserved does nothing.
+ *
+ * @param index The index to release.
+ */
+void
+ReservationBitVector::release(int index) {
+    long long w = wordOf(index);
+    if (!isReserved(index)) {
+        return;
+    }
+    words_[w - firstWord_] &= ~(Word(1) << bitOf(index));
+    if (--reservedCount_ == 0) {
+        // let the next reservation choose a new range
+        clear();
+    }
+}
+
+/**
+ * Releases all reservations.
+ */
+void
+ReservationBitVector::clear() {
+    words_.clear();
+    firstWord_ = 0;
+    reservedCount_ = 0;
+}
+
+/**
+ * Tells whether there are no reservations.
+ */
+bool
+ReservationBitVector::empty() const {
+    return reservedCount_ == 0;
+}
+
+/**
+ * Returns the smallest free index in the given range.
+ *
+ * @param first The first index of the range.
+ * @param last The last index of the range.
+ * @return The smallest free index, NOT_FOUND if all are reserved.
+ */
+int
+ReservationBitVector::firstFree(int first, int last) const {
+    return firstFreeInAny(
+        std::vector<const ReservationBitVector*>(1, this), first, last);
+}
+
+/**
+ * Returns the largest free index in the given range.
+ *
+ * @param last The last index of the range, where the search starts.
+ * @param first The first index of the range.
+ * @return The largest free index, NOT_FOUND if all are reserved.
+ */
+int
+ReservationBitVector::lastFree(int last, int first) const {
+    return lastFreeInAny(
+        std::vector<const ReservationBitVector*>(1, this), last, first);
+}
+
+/**
+ * Returns the smallest index in the given range that is free in at
+ * least one of the given tables.
+ *
+ * @param tables The reservation tables of the alternative resources.
+ * @param first The first index of the range.
+ * @param last The last index of the range.
+ * @return The smallest index free in some table, NOT_FOUND if there is
+ * none.
+ */
+int
+ReservationBitVector::firstFreeInAny(
+    const std::vector<const ReservationBitVector*>& tables,
+    int first, int last) {
+
+    if (tables.empty() || first > last) {
+        return NOT_FOUND;
+    }
+    long long firstWord = wordOf(first);
+    long long lastWord = wordOf(last);
+    for (long long w = firstWord; w <= lastWord; w++) {
+        Word busy = ~Word(0);
+        for (size_t i = 0; i < tables.size() && busy != 0; i++) {
+            busy &= tables[i]->word(w);
+        }
+        if (w == firstWord) {
+            busy |= (Word(1) << bitOf(first)) - 1;
+        }
+        if (w == lastWord && bitOf(last) != WORD_BITS - 1) {
+            busy |= ~((Word(2) << bitOf(last)) - 1);
+        }
+        if (busy != ~Word(0)) {
+            return static_cast<int>(
+                w * WORD_BITS + __builtin_ctzll(~busy));
+        }
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * Returns the largest index in the given range that is free in at
+ * least one of the given tables.
+ *
+ * @param tables The reservation tables of the alternative resources.
+ * @param last The last index of the range, where the search starts.
+ * @param first The first index of the range.
+ * @return The largest index free in some table, NOT_FOUND if there is
+ * none.
+ */
+int
+ReservationBitVector::lastFreeInAny(
+    const std::vector<const ReservationBitVector*>& tables,
+    int last, int first) {
+
+    if (tables.empty() || first > last) {
+        return NOT_FOUND;
+    }
+    long long firstWord = wordOf(first);
+    long long lastWord = wordOf(last);
+    for (long long w = lastWord; w >= firstWord; w--) {
+        Word busy = ~Word(0);
+        for (size_t i = 0; i < tables.size() && busy != 0; i++) {
+            busy &= tables[i]->word(w);
+        }
+        if (w == firstWord) {
+            busy |= (Word(1) << bitOf(first)) - 1;
+        }
+        if (w == lastWord && bitOf(last) != WORD_BITS - 1) {
+            busy |= ~((Word(2) << bitOf(last)) - 1);
+        }
+        if (busy != ~Word(0)) {
+            return static_cast<int>(
+                w * WORD_BITS + (WORD_BITS - 1) - __builtin_clzll(~busy));
+        }
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * Returns the earliest cycle starting from the given one in which at
+ * least one of the given tables is free.
+ *
+ * The tables are indexed by instruction index. With a non-zero
+ * initiation interval the search wraps around the end of the interval
+ * once, so the returned cycle is at most initiationInterval - 1 cycles
+ * after the given cycle. Negative cycles are returned as such.
+ *
+ * @param tables The reservation tables of the alternative resources.
+ * @param cycle The cycle to start from.
+ * @param initiationInterval The initiation interval, 0 if not modulo
+ * scheduling.
+ * @return The earliest cycle, NOT_FOUND if every index is reserved in
+ * every table.
+ */
+int
+ReservationBitVector::firstFreeCycle(
+    const std::vector<const ReservationBitVector*>& tables,
+    int cycle, unsigned int initiationInterval) {
+
+    if (cycle < 0) {
+        return cycle;
+    }
+    if (initiationInterval == 0) {
+        return firstFreeInAny(tables, cycle, INT_MAX);
+    }
+    int ii = static_cast<int>(initiationInterval);
+    int index = cycle % ii;
+    int found = firstFreeInAny(tables, index, ii - 1);
+    if (found != NOT_FOUND) {
+        return cycle + (found - index);
+    }
+    found = firstFreeInAny(tables, 0, index - 1);
+    if (found != NOT_FOUND) {
+        return cycle + (ii - index) + found;
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * Returns the latest cycle at or before the given one, but not before
+ * cycle 0, in which at least one of the given tables is free.
+ *
+ * With a non-zero initiation interval the search wraps around the start
+ * of the interval once. Negative cycles are returned as such.
+ *
+ * @param tables The reservation tables of the alternative resources.
+ * @param cycle The cycle to start from.
+ * @param initiationInterval The initiation interval, 0 if not modulo
+ * scheduling.
+ * @return The latest cycle, NOT_FOUND if there is none.
+ */
+int
+ReservationBitVector::lastFreeCycle(
+    const std::vector<const ReservationBitVector*>& tables,
+    int cycle, unsigned int initiationInterval) {
+
+    if (cycle < 0) {
+        return cycle;
+    }
+    if (initiationInterval == 0) {
+        return lastFreeInAny(tables, cycle, 0);
+    }
+    int ii = static_cast<int>(initiationInterval);
+    int index = cycle % ii;
+    int found = lastFreeInAny(tables, index, 0);
+    if (found != NOT_FOUND) {
+        return cycle - (index - found);
+    }
+    found = lastFreeInAny(tables, ii - 1, index + 1);
+    if (found != NOT_FOUND && cycle - index - ii + found >= 0) {
+        return cycle - index - ii + found;
+    }
+    return NOT_FOUND;
+}
@@ -0,0 +1,99 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReservationBitVector.hh
+ *
+ * Declaration of ReservationBitVector class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_RESERVATION_BIT_VECTOR_HH
+#define TTA_RESERVATION_BIT_VECTOR_HH
+
+#include <vector>
+#include <climits>
+
+/**
+ * Reservation table of a single scheduling resource, one bit per
+ * instruction index.
+ *
+ * The bits are stored in 64-bit words which cover only the range of
+ * indices reserved so far, so the large start cycles used by the
+ * bottom-up schedulers do not waste memory. Indices outside of the
+ * stored range are free.
+ *
+ * The static search functions combine the tables of several
+ * alternative resources with a bitwise AND one word at a time, which
+ * finds the first index where any of the resources is free without
+ * testing the indices one by one.
+ */
+class ReservationBitVector {
+public:
+    /// Returned by the searches when no free index is found.
+    static const int NOT_FOUND = INT_MIN;
+
+    ReservationBitVector();
+
+    bool isReserved(int index) const;
+    void reserve(int index);
+    void release(int index);
+    void clear();
+    bool empty() const;
+
+    int firstFree(int first, int last) const;
+    int lastFree(int last, int first) const;
+
+    static int firstFreeInAny(
+        const std::vector<const ReservationBitVector*>& tables,
+        int first, int last);
+    static int lastFreeInAny(
+        const std::vector<const ReservationBitVector*>& tables,
+        int last, int first);
+
+    static int firstFreeCycle(
+        const std::vector<const ReservationBitVector*>& tables,
+        int cycle, unsigned int initiationInterval);
+    static int lastFreeCycle(
+        const std::vector<const ReservationBitVector*>& tables,
+        int cycle, unsigned int initiationInterval);
+
+private:
+    typedef unsigned long long Word;
+    /// Number of reservation bits in one word.
+    static const int WORD_BITS = 64;
+
+    static long long wordOf(int index);
+    static int bitOf(int index);
+    Word word(long long wordIndex) const;
+
+    /// Word index of the first stored word.
+    long long firstWord_;
+    /// The stored reservation bits, words_[0] holds firstWord_.
+    std::vector<Word> words_;
+    /// Number of reserved indices.
+    unsigned int reservedCount_;
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ActiveUnitSet.hh
+ *
+ * Declaration of ActiveUnitSet class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_ACTIVE_UNIT_SET_HH
+#define TTA_ACTIVE_UNIT_SET_HH
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * The set of the units of a machine state that need clocking.
+ *
+ * The units are identified by the indices given by addUnit(). The set is
+ * a bit vector, so the active units are visited in the order they were
+ * added, and the cost of visiting them depends on the number of active
+ * units and not on the number of all the units, apart from one word per
+ * 64 units.
+ */
+class ActiveUnitSet {
+public:
+    ActiveUnitSet();
+
+    int addUnit();
+    void activate(int index);
+    void deactivate(int index);
+    bool isActive(int index) const;
+    int nextActive(int index) const;
+
+private:
+    typedef unsigned long long Word;
+    static const int WORD_BITS = 64;
+
+    /// The activity bits of the units.
+    std::vector<Word> words_;
+    /// The number of units.
+    int unitCount_;
+};
+
+#include "ActiveUnitSet.icc"
+
+#endif
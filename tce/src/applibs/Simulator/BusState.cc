@@ -69,16 +69,6 @@ BusState::setValue(const SimValue& value) {
     RegisterState::setValue(value);
 }
 
-/**
- * Sets whether the last executed move scheduled to this bus was squashed.
- *
- * @param isSquashed True in case this bus was squashed.
- */
-void 
-BusState::setSquashed(bool isSquashed) {
-    squashed_ = isSquashed;
-}
-
 /**
  * Returns true if the last executed move scheduled to this bus was squashed.
  *
@@ -41,6 +41,7 @@
 #include "Machine.hh"
 #include "MathTools.hh"
 #include "Conversion.hh"
+#include "BinaryBusTraceWriter.hh"
 
 #include <algorithm>
 #include <vector>
@@ -49,6 +50,7 @@
 #include <iomanip>
 #include <locale>
 #include <functional>
+#include <cstring>
 
 const std::string BusTracker::COLUMN_SEPARATOR = ",";
 
@@ -64,10 +66,8 @@ BusTracker::BusTracker(
     SimulatorFrontend& frontend,
     std::ostream* traceStream) :
     Listener(), frontend_(frontend),ownsTraceStream_(true),
-    traceStream_(traceStream) {
-    // write the trace data at the end of simulation clock cycle
-    frontend.eventHandler().registerListener(
-        SimulationEventHandler::SE_CYCLE_END, this);
+    traceStream_(traceStream), traceWriter_(NULL) {
+    initialize();
 }
 
 /**
@@ -81,9 +81,24 @@ BusTracker::BusTracker(
     SimulatorFrontend& frontend,
     std::ostream& traceStream)
     : Listener(), frontend_(frontend),ownsTraceStream_(false),
-      traceStream_(&traceStream) {
-    frontend.eventHandler().registerListener(
-            SimulationEventHandler::SE_CYCLE_END, this);
+      traceStream_(&traceStream), traceWriter_(NULL) {
+    initialize();
+}
+
+/**
+ * Constructor.
+ *
+ * @param frontend The SimulationFrontend which is used to access simulation
+ *                 data.
+ * @param traceWriter Writer of the binary bus trace file. Takes ownership
+ *                    of the writer.
+ */
+BusTracker::BusTracker(
+    SimulatorFrontend& frontend,
+    BinaryBusTraceWriter* traceWriter)
+    : Listener(), frontend_(frontend), ownsTraceStream_(false),
+      traceStream_(NULL), traceWriter_(traceWriter) {
+    initialize();
 }
 
 /**
@@ -92,10 +107,72 @@ BusTracker::BusTracker(
 BusTracker::~BusTracker() {
     frontend_.eventHandler().unregisterListener(
         SimulationEventHandler::SE_CYCLE_END, this);
-    traceStream_->flush();
+    if (traceStream_ != NULL) {
+        traceStream_->flush();
+    }
     if (ownsTraceStream_) {
         delete traceStream_;
     }
+    // flushes the buffered records to the file
+    delete traceWriter_;
+}
+
+/**
+ * Looks up the states of the buses and registers the tracker.
+ *
+ * The bus states stay the same for the lifetime of the simulation, thus
+ * they are not searched by name in every cycle.
+ */
+void
+BusTracker::initialize() {
+    TTAMachine::Machine::BusNavigator navigator =
+        frontend_.machine().busNavigator();
+
+    for (int i = 0; i < navigator.count(); ++i) {
+        BusState& bus =
+            frontend_.machineState(0).busState(navigator.item(i)->name());
+        buses_.push_back(&bus);
+        squashedColumns_.push_back(std::string((bus.width()+3)/4, '0'));
+        valueSizes_.push_back(BinaryBusTrace::valueSize(bus.width()));
+    }
+
+    // write the trace data at the end of simulation clock cycle
+    frontend_.eventHandler().registerListener(
+        SimulationEventHandler::SE_CYCLE_END, this);
+}
+
+/**
+ * Returns the names of the buses in the order they are traced.
+ *
+ * @param frontend The frontend of the simulated machine.
+ * @return The names of the buses.
+ */
+std::vector<std::string>
+BusTracker::busNames(SimulatorFrontend& frontend) {
+    TTAMachine::Machine::BusNavigator navigator =
+        frontend.machine().busNavigator();
+    std::vector<std::string> names;
+    for (int i = 0; i < navigator.count(); ++i) {
+        names.push_back(navigator.item(i)->name());
+    }
+    return names;
+}
+
+/**
+ * Returns the widths of the buses in the order they are traced.
+ *
+ * @param frontend The frontend of the simulated machine.
+ * @return The widths of the buses in bits.
+ */
+std::vector<int>
+BusTracker::busWidths(SimulatorFrontend& frontend) {
+    TTAMachine::Machine::BusNavigator navigator =
+        frontend.machine().busNavigator();
+    std::vector<int> widths;
+    for (int i = 0; i < navigator.count(); ++i) {
+        widths.push_back(navigator.item(i)->width());
+    }
+    return widths;
 }
 
 /**
@@ -107,23 +184,35 @@ BusTracker::~BusTracker() {
 void 
 BusTracker::handleEvent() {
 
-    TTAMachine::Machine::BusNavigator navigator =
-        frontend_.machine().busNavigator();
+    if (traceWriter_ != NULL) {
+        // the binary record is filled in place with the raw values
+        unsigned char* record = traceWriter_->nextRecord();
+        BinaryBusTrace::writeCycle(record, frontend_.cycleCount());
+        record += BinaryBusTrace::CYCLE_SIZE;
+        for (std::size_t i = 0; i < buses_.size(); ++i) {
+            const BusState& bus = *buses_[i];
+            if (!bus.isSquashed()) {
+                std::memcpy(record, bus.value().rawData_, valueSizes_[i]);
+            } else {
+                // Squashed values are stored as zeros.
+                std::memset(record, 0, valueSizes_[i]);
+            }
+            record += valueSizes_[i];
+        }
+        return;
+    }
 
     *traceStream_ << frontend_.cycleCount();
 
-    for (int i = 0; i < navigator.count(); ++i) {
-        const std::string busName = navigator.item(i)->name();
-
-        BusState& bus = frontend_.machineState(0).busState(busName);
-        int columnWidth = (bus.width()+3)/4;
+    for (std::size_t i = 0; i < buses_.size(); ++i) {
+        const BusState& bus = *buses_[i];
 
         *traceStream_ << COLUMN_SEPARATOR;
         if (!bus.isSquashed()) {
             *traceStream_ << bus.value().hexValue(true);
         } else {
             // Squashed values are displayed as zeros.
-            *traceStream_ << std::string(columnWidth, '0');
+            *traceStream_ << squashedColumns_[i];
         }
     }
     *traceStream_ << "\n";
@@ -44,11 +44,19 @@
 
 class SimulationController;
 class SimulatorFrontend;
+class BusState;
+class BinaryBusTraceWriter;
 
 /**
  * Tracks the bus activity.
  *
- * Stores bus data as hexadecimal numbers in a bus trace file in CSV format.
+ * Stores bus data as hexadecimal numbers in a bus trace file in CSV format,
+ * or as raw values in a binary bus trace file (see BinaryBusTrace).
+ *
+ * Unlike the statistics, the trace needs the bus values of every cycle in
+ * the order they were simulated, so the tracker listens to the cycle end
+ * event instead of using the instruction execution counters. The event
+ * is dispatched only while a bus trace is written.
  */
 class BusTracker : public Listener {
 public:
@@ -58,17 +66,33 @@ public:
     BusTracker(
         SimulatorFrontend& frontend,
         std::ostream& traceStream);
+    BusTracker(
+        SimulatorFrontend& frontend,
+        BinaryBusTraceWriter* traceWriter);
     virtual ~BusTracker();
 
     virtual void handleEvent();
 
+    static std::vector<std::string> busNames(SimulatorFrontend& frontend);
+    static std::vector<int> busWidths(SimulatorFrontend& frontend);
+
 private:
+    void initialize();
+
     static const int COLUMN_WIDTH;
     static const std::string COLUMN_SEPARATOR;
     /// the simulator frontend used to access simulation data
     SimulatorFrontend& frontend_;
     bool ownsTraceStream_;
     std::ostream* traceStream_;
+    /// the binary trace writer, NULL if the trace is written as text
+    BinaryBusTraceWriter* traceWriter_;
+    /// the states of the traced buses in the machine order
+    std::vector<BusState*> buses_;
+    /// the zero columns written for squashed moves in the text trace
+    std::vector<std::string> squashedColumns_;
+    /// the sizes of the bus values in the binary trace
+    std::vector<std::size_t> valueSizes_;
 };
 
 #endif
@@ -35,6 +35,7 @@
 #include "WritableState.hh"
 #include "BusState.hh"
 #include "SimValue.hh"
+#include "MoveMicroOp.hh"
 
 /**
  * Constructor.
@@ -146,3 +147,24 @@ BuslessExecutableMove::executeWrite() {
     dst_->setValue(src_->value());
     executionCount_++;
 }
+
+/**
+ * Translates the move to a single direct transport step.
+ *
+ * The step evaluates the guard and reads the source in the write phase of
+ * the instruction, like executeWrite().
+ *
+ * @param writes The writes of the instruction.
+ * @return Always true.
+ */
+bool
+BuslessExecutableMove::predecode(
+    std::vector<MoveMicroOp>&,
+    std::vector<MoveMicroOp>& writes) {
+
+    const ReadableState* guard = guarded_ ? guardReg_ : NULL;
+    writes.push_back(
+        MoveMicroOp::directTransport(
+            *src_, *dst_, guard, negated_, squashed_, executionCount_));
+    return true;
+}
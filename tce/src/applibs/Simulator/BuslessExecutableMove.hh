@@ -77,6 +77,10 @@ public:
     virtual void executeRead();
     virtual void executeWrite();
 
+    virtual bool predecode(
+        std::vector<MoveMicroOp>& reads,
+        std::vector<MoveMicroOp>& writes);
+
 private:
     /// Copying not allowed.
     BuslessExecutableMove(const BuslessExecutableMove&);
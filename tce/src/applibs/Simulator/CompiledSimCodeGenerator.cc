@@ -127,6 +127,8 @@ supportedMemoryOps{
         {AccessMode::read, 2, ExtensionMode::zero, MAUOrder::littleEndian}},
     {"ld32",
         {AccessMode::read, 4, ExtensionMode::sign, MAUOrder::littleEndian}},
+    {"ld64",
+        {AccessMode::read, 8, ExtensionMode::zero, MAUOrder::littleEndian}},
 
     {"st8",
         {AccessMode::write, 1, ExtensionMode::zero, MAUOrder::littleEndian}},
@@ -134,6 +136,8 @@ supportedMemoryOps{
         {AccessMode::write, 2, ExtensionMode::zero, MAUOrder::littleEndian}},
     {"st32",
         {AccessMode::write, 4, ExtensionMode::zero, MAUOrder::littleEndian}},
+    {"st64",
+        {AccessMode::write, 8, ExtensionMode::zero, MAUOrder::littleEndian}},
     {"stq",
         {AccessMode::write, 1, ExtensionMode::zero, MAUOrder::bigEndian}},
     {"sth",
@@ -267,16 +271,19 @@ CompiledSimCodeGenerator::generateMakefile() {
         << "cppflags = " << CompiledSimCompiler::COMPILED_SIM_CPP_FLAGS << endl
         << endl
         
-        << "all: CompiledSimulationEngine.so" << endl << endl
+        << "all: CompiledSimulationEngine.so $(dobjects)" << endl << endl
 
-        << "CompiledSimulationEngine.so: CompiledSimulationEngine.hh.gch "
-        << "$(dobjects) CompiledSimulationEngine.cc" << endl
+        // the objects are loaded separately, thus they do not depend on
+        // each other and the ones taken from the cache are not rebuilt
+        << "CompiledSimulationEngine.so: CompiledSimulationEngine.cc "
+        << "| CompiledSimulationEngine.hh.gch" << endl
         << "\t#@echo Compiling CompiledSimulationEngine.so" << endl
         << "\t$(CC) $(cppflags) -O0 $(includes) CompiledSimulationEngine.cc "
         << "-c -o CompiledSimulationEngine.o" << endl 
         << "\t$(CC) $(soflags) CompiledSimulationEngine.o -o CompiledSimulationEngine.so"
         << endl << endl
-        << "$(dobjects): %.so: %.cpp CompiledSimulationEngine.hh.gch" << endl
+        << "$(dobjects): %.so: %.cpp | CompiledSimulationEngine.hh.gch"
+        << endl
 
         // compile and link phases separately to allow distributed compilation
         // thru distcc
@@ -1587,8 +1594,9 @@ CompiledSimCodeGenerator::generateTriggerCode(
 string 
 CompiledSimCodeGenerator::generateStoreTrigger(
     const TTAMachine::HWOperation& op) {
-    string address = symbolGen_.portSymbol(*op.port(1)) + ".uIntWordValue()";
-    string dataToWrite = symbolGen_.portSymbol(*op.port(2)) + ".uIntWordValue()";
+    string address = symbolGen_.portSymbol(*op.port(1)) + ".uLongWordValue()";
+    string dataToWrite =
+        symbolGen_.portSymbol(*op.port(2)) + ".uLongWordValue()";
     string memory = symbolGen_.DAMemorySymbol(op.parentUnit()->name());
     string method;
 
@@ -0,0 +1,153 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CompiledSimCompilationScheduler.cc
+ *
+ * Definition of CompiledSimCompilationScheduler class.
+ *
+ * @note rating: red
+ */
+
+#include <boost/bind.hpp>
+
+#include "CompiledSimCompilationScheduler.hh"
+#include "CompiledSimCompiler.hh"
+
+/**
+ * The constructor.
+ *
+ * @param compiler The compiler used to compile the files to .so files.
+ * @param threadCount Number of background threads to compile with.
+ */
+CompiledSimCompilationScheduler::CompiledSimCompilationScheduler(
+    const CompiledSimCompiler& compiler, unsigned threadCount) :
+    compiler_(compiler), threadCount_(threadCount), stopping_(false) {
+}
+
+/**
+ * The destructor.
+ *
+ * Drops the files that have not been started and waits for the files
+ * being compiled.
+ */
+CompiledSimCompilationScheduler::~CompiledSimCompilationScheduler() {
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        stopping_ = true;
+    }
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->join();
+        delete workers_[i];
+    }
+}
+
+/**
+ * Appends a file to the compilation queue.
+ *
+ * Files that are already queued or compiled are ignored.
+ *
+ * @param file Path to the .cpp file.
+ */
+void
+CompiledSimCompilationScheduler::enqueue(const std::string& file) {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (states_.find(file) != states_.end()) {
+        return;
+    }
+    states_[file] = FS_QUEUED;
+    queue_.push_back(file);
+}
+
+/**
+ * Starts the background threads that compile the queued files.
+ */
+void
+CompiledSimCompilationScheduler::start() {
+    for (unsigned i = workers_.size(); i < threadCount_; ++i) {
+        workers_.push_back(
+            new boost::thread(
+                boost::bind(
+                    &CompiledSimCompilationScheduler::runWorker, this)));
+    }
+}
+
+/**
+ * Makes sure the given file has been compiled.
+ *
+ * A file no thread has started yet is compiled in the calling thread.
+ * If a background thread is compiling the file, waits for it to finish.
+ *
+ * @param file Path to the .cpp file.
+ * @return Return value of the compiler, 0 on success.
+ */
+int
+CompiledSimCompilationScheduler::compile(const std::string& file) {
+    boost::mutex::scoped_lock lock(mutex_);
+    std::map<std::string, FileState>::iterator state = states_.find(file);
+    if (state == states_.end() || state->second == FS_QUEUED) {
+        // the stale queue entry is skipped by the workers
+        compileFile(file, lock);
+    }
+    while (states_[file] != FS_DONE) {
+        compiled_.wait(lock);
+    }
+    return results_[file];
+}
+
+/**
+ * The main loop of a background thread.
+ *
+ * Compiles the queued files in order until the queue is empty or the
+ * scheduler is destroyed.
+ */
+void
+CompiledSimCompilationScheduler::runWorker() {
+    boost::mutex::scoped_lock lock(mutex_);
+    while (!stopping_ && !queue_.empty()) {
+        std::string file = queue_.front();
+        queue_.pop_front();
+        if (states_[file] == FS_QUEUED) {
+            compileFile(file, lock);
+        }
+    }
+}
+
+/**
+ * Compiles a file with the mutex released and records the result.
+ *
+ * @param file Path to the .cpp file.
+ * @param lock The held lock of mutex_.
+ */
+void
+CompiledSimCompilationScheduler::compileFile(
+    const std::string& file, boost::mutex::scoped_lock& lock) {
+
+    states_[file] = FS_COMPILING;
+    lock.unlock();
+    int result = compiler_.compileToSO(file);
+    lock.lock();
+    results_[file] = result;
+    states_[file] = FS_DONE;
+    compiled_.notify_all();
+}
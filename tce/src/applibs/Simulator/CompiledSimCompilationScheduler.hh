@@ -0,0 +1,101 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CompiledSimCompilationScheduler.hh
+ *
+ * Declaration of CompiledSimCompilationScheduler class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_COMPILED_SIM_COMPILATION_SCHEDULER_HH
+#define TTA_COMPILED_SIM_COMPILATION_SCHEDULER_HH
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+class CompiledSimCompiler;
+
+/**
+ * Compiles the simulation functions of a dynamically compiled simulation
+ * in background threads.
+ *
+ * The files are compiled in the order they are queued, thus the hottest
+ * code should be queued first. A file that is needed before a worker has
+ * reached it is compiled in the calling thread, so the simulation never
+ * waits for the rest of the queue.
+ */
+class CompiledSimCompilationScheduler {
+public:
+    CompiledSimCompilationScheduler(
+        const CompiledSimCompiler& compiler, unsigned threadCount);
+    virtual ~CompiledSimCompilationScheduler();
+
+    void enqueue(const std::string& file);
+    void start();
+    int compile(const std::string& file);
+
+private:
+    /// Copying not allowed.
+    CompiledSimCompilationScheduler(const CompiledSimCompilationScheduler&);
+    /// Assignment not allowed.
+    CompiledSimCompilationScheduler& operator=(
+        const CompiledSimCompilationScheduler&);
+
+    void runWorker();
+    void compileFile(
+        const std::string& file, boost::mutex::scoped_lock& lock);
+
+    /// Compilation states of the files.
+    enum FileState {
+        FS_QUEUED,   ///< Waiting in the queue.
+        FS_COMPILING,///< Being compiled by some thread.
+        FS_DONE      ///< Compiled, the result is in results_.
+    };
+
+    /// The compiler used for the files.
+    const CompiledSimCompiler& compiler_;
+    /// Number of background threads.
+    unsigned threadCount_;
+    /// Files in the order they should be compiled.
+    std::deque<std::string> queue_;
+    /// States of the queued and compiled files.
+    std::map<std::string, FileState> states_;
+    /// Return values of the compiler for the compiled files.
+    std::map<std::string, int> results_;
+    /// Guards the queue and the file states.
+    boost::mutex mutex_;
+    /// Signaled each time a file has been compiled.
+    boost::condition_variable compiled_;
+    /// The background threads.
+    std::vector<boost::thread*> workers_;
+    /// True when the workers should stop after their current file.
+    bool stopping_;
+};
+
+#endif
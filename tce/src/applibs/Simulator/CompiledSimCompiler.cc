@@ -31,8 +31,15 @@
  */
 
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread.hpp>
+#include <algorithm>
 #include <ctime>
 #include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
 
 #include "CompiledSimCompiler.hh"
 #include "Conversion.hh"
@@ -40,6 +47,7 @@
 #include "Application.hh"
 #include "Environment.hh"
 #include "FileSystem.hh"
+#include "Exception.hh"
 
 using std::string;
 using std::endl;
@@ -73,13 +81,16 @@ const char* CompiledSimCompiler::COMPILED_SIM_SO_FLAGS = SHARED_CXX_FLAGS;
 const char* CompiledSimCompiler::COMPILED_SIM_SO_FLAGS = " -shared -fpic ";
 #endif
 
+// Extension of the cache key files
+const char* CompiledSimCompiler::KEY_EXTENSION = ".key";
+
 /**
  * The constructor
  */
 CompiledSimCompiler::CompiledSimCompiler() {
     
-    // Get number of threads
-    threadCount_ = 3;
+    // Get number of threads, one per hardware thread by default
+    threadCount_ = std::max(1u, boost::thread::hardware_concurrency());
     std::string USER_THREAD_COUNT = 
         Environment::environmentVariable("TTASIM_COMPILER_THREADS");
     if (USER_THREAD_COUNT != "") {
@@ -114,7 +125,12 @@ CompiledSimCompiler::~CompiledSimCompiler() {
  * In case environment variable TTASIM_COMPILER is set, it is used
  * to compile the simulation code, otherwise 'gcc' is used. The
  * count of compiler threads is read from TTASIM_COMPILER_THREADS,
- * and defaults to 3.
+ * and defaults to the number of hardware threads.
+ *
+ * If a cache directory is set, the .so files of the sources that are
+ * found in the cache are copied to the directory before running make,
+ * thus only the changed sources get recompiled. The new .so files are
+ * added to the cache after a successful compilation.
  *
  * @param dirName a source directory containing the .cpp files and the Makefile
  * @param flags additional compile flags given by the user. for instance, "-O3"
@@ -127,6 +143,32 @@ CompiledSimCompiler::compileDirectory(
     const string& flags,
     bool verbose) const {
 
+    string cacheCommand = "make " + flags;
+    vector<string> missedSources;
+    if (cacheDirectory_ != "") {
+        vector<string> sources;
+        FileSystem::globPath(
+            dirName + FileSystem::DIRECTORY_SEPARATOR + "*.cpp", sources);
+        sources.push_back(
+            dirName + FileSystem::DIRECTORY_SEPARATOR +
+            "CompiledSimulationEngine.cc");
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            if (!fetchFromCache(sources[i], cacheCommand)) {
+                missedSources.push_back(sources[i]);
+            }
+        }
+
+        if (verbose) {
+            Application::logStream()
+                << sources.size() - missedSources.size() << " of "
+                << sources.size() << " simulation engine files found in "
+                << "the cache " << cacheDirectory_ << endl;
+        }
+        if (missedSources.empty()) {
+            return 0;
+        }
+    }
+
     string command = 
         "make -sC " + dirName + " CC=\"" + compiler_ + "\" opt_flags=\"" +
         globalCompileFlags_ + " " + flags + " \" -j" +
@@ -152,6 +194,12 @@ CompiledSimCompiler::compileDirectory(
             << endl;
     }
 
+    if (retval == 0) {
+        for (std::size_t i = 0; i < missedSources.size(); ++i) {
+            storeToCache(missedSources[i], cacheCommand);
+        }
+    }
+
     return retval;
 }
 
@@ -199,7 +247,9 @@ CompiledSimCompiler::compileFile(
 /**
  * Compiles a single C++ file to a shared library (.so)
  * 
- * Used for generating .so files in dynamic compiled simulation
+ * Used for generating .so files in dynamic compiled simulation. The .so
+ * file is taken from the cache instead if an identical source has been
+ * compiled before with the same flags.
  * 
  * @param path Path to the file
  * @param flags custom flags to be used for compiling
@@ -212,6 +262,191 @@ CompiledSimCompiler::compileToSO(
     const string& flags,
     bool verbose) const {
 
-    return compileFile(path, COMPILED_SIM_SO_FLAGS + flags, ".so", verbose);
+    string soFlags = COMPILED_SIM_SO_FLAGS + flags;
+    if (fetchFromCache(path, soFlags)) {
+        return 0;
+    }
+
+    int retval = compileFile(path, soFlags, ".so", verbose);
+    if (retval == 0) {
+        storeToCache(path, soFlags);
+    }
+    return retval;
+}
+
+/**
+ * Sets the directory of the compiled .so file cache.
+ *
+ * The cached files are shared by all the simulations that use the
+ * directory, thus it should be given per machine. An empty string
+ * disables the cache.
+ *
+ * @param directory The cache directory. Created when the first file is
+ * stored.
+ */
+void
+CompiledSimCompiler::setCacheDirectory(const std::string& directory) {
+    cacheDirectory_ = directory;
+}
+
+/**
+ * Returns the number of threads to compile with.
+ *
+ * @return The value of TTASIM_COMPILER_THREADS, or the number of hardware
+ *         threads if it is not set.
+ */
+int
+CompiledSimCompiler::threadCount() const {
+    return threadCount_;
+}
+
+/**
+ * Returns the inputs the compiled .so file of the given source depends on.
+ *
+ * The key consists of the TCE version, the compile command, the simulation
+ * engine header the source includes and the source itself.
+ *
+ * @param path Path to the source file.
+ * @param command Flags the source is compiled with.
+ * @return The cache key of the source.
+ */
+std::string
+CompiledSimCompiler::cacheKey(
+    const std::string& path,
+    const std::string& command) const {
+
+    const string DS = FileSystem::DIRECTORY_SEPARATOR;
+    std::ostringstream contents;
+    contents << Application::TCEVersionString() << endl
+             << compiler_ << COMPILED_SIM_CPP_FLAGS << globalCompileFlags_
+             << command << endl;
+
+    std::ifstream header(
+        (FileSystem::directoryOfPath(path) + DS +
+         "CompiledSimulationEngine.hh").c_str());
+    if (header.good() && header.peek() != EOF) {
+        contents << header.rdbuf();
+    }
+    std::ifstream source(path.c_str());
+    if (source.good() && source.peek() != EOF) {
+        contents << source.rdbuf();
+    }
+    return contents.str();
+}
+
+/**
+ * Returns the path of the cached .so file for the given source file.
+ *
+ * The file name is derived from the length and a hash of the cache key.
+ * The key itself is stored next to the .so file with the KEY_EXTENSION,
+ * fetchFromCache() compares it to tell a hash collision from a hit.
+ *
+ * @param path Path to the source file.
+ * @param key The cache key of the source.
+ * @return Path of the .so file in the cache directory.
+ */
+std::string
+CompiledSimCompiler::cacheFile(
+    const std::string& path,
+    const std::string& key) const {
+
+    boost::hash<std::string> stringHasher;
+    return cacheDirectory_ + FileSystem::DIRECTORY_SEPARATOR +
+        FileSystem::fileNameBody(path) + "_" +
+        Conversion::toHexString(key.length()).substr(2) + "_" +
+        Conversion::toHexString(stringHasher(key)).substr(2) + ".so";
+}
+
+/**
+ * Copies the cached .so file of the given source next to the source.
+ *
+ * @param path Path to the source file.
+ * @param command Flags the source is compiled with.
+ * @return True if the .so file was found in the cache and was compiled
+ * from the same inputs.
+ */
+bool
+CompiledSimCompiler::fetchFromCache(
+    const std::string& path,
+    const std::string& command) const {
+
+    if (cacheDirectory_ == "") {
+        return false;
+    }
+
+    std::string key = cacheKey(path, command);
+    std::string cached = cacheFile(path, key);
+    if (!FileSystem::fileExists(cached)) {
+        return false;
+    }
+
+    std::ifstream keyFile((cached + KEY_EXTENSION).c_str());
+    std::ostringstream cachedKey;
+    if (keyFile.good() && keyFile.peek() != EOF) {
+        cachedKey << keyFile.rdbuf();
+    }
+    if (cachedKey.str() != key) {
+        return false;
+    }
+
+    try {
+        FileSystem::copy(
+            cached, FileSystem::directoryOfPath(path) +
+            FileSystem::DIRECTORY_SEPARATOR +
+            FileSystem::fileNameBody(path) + ".so");
+    } catch (const IOException&) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Adds the compiled .so file of the given source to the cache.
+ *
+ * The file and its key are first written under temporary names and then
+ * renamed, thus simulators running in parallel never load a partially
+ * written file. Failures are ignored, the cache only speeds up the next
+ * compilation.
+ *
+ * @param path Path to the source file.
+ * @param command Flags the source was compiled with.
+ */
+void
+CompiledSimCompiler::storeToCache(
+    const std::string& path,
+    const std::string& command) const {
+
+    std::string object =
+        FileSystem::directoryOfPath(path) + FileSystem::DIRECTORY_SEPARATOR +
+        FileSystem::fileNameBody(path) + ".so";
+    if (cacheDirectory_ == "" || !FileSystem::fileExists(object) ||
+        !FileSystem::createDirectory(cacheDirectory_)) {
+        return;
+    }
+
+    std::string key = cacheKey(path, command);
+    std::string cached = cacheFile(path, key);
+    std::string suffix = "." + Conversion::toString(getpid());
+    std::string tempKeyFile = cached + KEY_EXTENSION + suffix;
+    std::string tempFile = cached + suffix;
+
+    std::ofstream keyFile(tempKeyFile.c_str());
+    keyFile << key;
+    keyFile.close();
+    if (keyFile.fail() ||
+        std::rename(
+            tempKeyFile.c_str(), (cached + KEY_EXTENSION).c_str()) != 0) {
+        FileSystem::removeFileOrDirectory(tempKeyFile);
+        return;
+    }
+
+    try {
+        FileSystem::copy(object, tempFile);
+    } catch (const IOException&) {
+        return;
+    }
+    if (std::rename(tempFile.c_str(), cached.c_str()) != 0) {
+        FileSystem::removeFileOrDirectory(tempFile);
+    }
 }
 
@@ -58,6 +58,9 @@ public:
         const std::string& path,
         const std::string& flags = "",
         bool verbose = false) const;
+
+    void setCacheDirectory(const std::string& directory);
+    int threadCount() const;
     
     /// cpp flags used for compiled simulation
     static const char* COMPILED_SIM_CPP_FLAGS;
@@ -70,6 +73,22 @@ private:
     CompiledSimCompiler(const CompiledSimCompiler&);
     /// Assignment not allowed.
     CompiledSimCompiler& operator=(const CompiledSimCompiler&);
+
+    /// extension of the key files stored next to the cached .so files
+    static const char* KEY_EXTENSION;
+
+    std::string cacheKey(
+        const std::string& path,
+        const std::string& command) const;
+    std::string cacheFile(
+        const std::string& path,
+        const std::string& key) const;
+    bool fetchFromCache(
+        const std::string& path,
+        const std::string& command) const;
+    void storeToCache(
+        const std::string& path,
+        const std::string& command) const;
     
     /// Number of threads to use while compiling through a Makefile
     int threadCount_;
@@ -77,6 +96,8 @@ private:
     std::string compiler_;
     /// Global compile flags (from env variable)
     std::string globalCompileFlags_;
+    /// Directory of the cached .so files, empty if caching is disabled
+    std::string cacheDirectory_;
 };
 
 #endif
@@ -49,6 +49,7 @@
 #include "SimulationEventHandler.hh"
 #include "Conversion.hh"
 #include "Machine.hh"
+#include "Environment.hh"
 
 using std::endl;
 using namespace TTAMachine;
@@ -92,6 +93,8 @@ CompiledSimController::CompiledSimController(
  * The destructor
  */
 CompiledSimController::~CompiledSimController() {
+    // stop the background compilations before removing their sources
+    simulation_.reset();
     deleteGeneratedFiles();
 }
 
@@ -246,6 +249,7 @@ CompiledSimController::reset() {
     stopRequested_ = false;
     clockCount_ = 0;
     
+    simulation_.reset();
     deleteGeneratedFiles();
         
     compiledSimulationPath_ = FileSystem::createTempDirectory();
@@ -274,6 +278,7 @@ CompiledSimController::reset() {
     procedureBBRelations_ = generator.procedureBBRelations();
 
     CompiledSimCompiler compiler;
+    compiler.setCacheDirectory(cacheDirectory());
     
     // Compile everything when using static compiled simulation
     if (frontend_.staticCompilation()) {
@@ -375,6 +380,20 @@ CompiledSimController::deleteGeneratedFiles() {
     }
 }
 
+/**
+ * Returns the directory of the cached simulation engine objects.
+ *
+ * The objects are compiled per basic block group, thus when the program
+ * changes only the objects of the changed code are recompiled.
+ *
+ * @return The cache directory of the simulated machine.
+ */
+std::string
+CompiledSimController::cacheDirectory() const {
+    return Environment::compiledSimCachePath() +
+        FileSystem::DIRECTORY_SEPARATOR + sourceMachine_.hash();
+}
+
 /**
  * Returns the start of the basic block containing address
  * 
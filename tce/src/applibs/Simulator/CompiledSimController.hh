@@ -103,6 +103,7 @@ public:
     
     InstructionAddress basicBlockStart(InstructionAddress address) const;
     const TTAProgram::Program& program() const;
+    std::string cacheDirectory() const;
         
 private:
     /// Copying not allowed.
@@ -82,6 +82,7 @@ CompiledSimSettingCommand::CompiledSimSettingCommand() :
     // Remove unsupported settings
     MapTools::deleteByKey(settings_, "rf_tracking");
     MapTools::deleteByKey(settings_, "bus_trace");
+    MapTools::deleteByKey(settings_, "bus_trace_binary");
     MapTools::deleteByKey(settings_, "profile_data_saving");
     MapTools::deleteByKey(settings_, "utilization_data_saving");
     
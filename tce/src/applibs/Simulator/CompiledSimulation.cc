@@ -32,6 +32,8 @@
  */
 
 #include <string>
+#include <fstream>
+#include <functional>
 #include "CompiledSimulation.hh"
 #include "Machine.hh"
 #include "Instruction.hh"
@@ -48,6 +50,10 @@
 #include "FileSystem.hh"
 #include "Program.hh"
 #include "Move.hh"
+#include "Procedure.hh"
+#include "Terminal.hh"
+#include "InstructionReference.hh"
+#include "CompiledSimCompilationScheduler.hh"
 #include "MemorySystem.hh"
 #include "Conversion.hh"
 
@@ -95,6 +101,7 @@ CompiledSimulation::CompiledSimulation(
     pimpl_->memorySystem_ = &memorySystem;
     pimpl_->frontend_ = &frontend;
     pimpl_->controller_ = &controller;
+    pimpl_->compiler_.setCacheDirectory(controller.cacheDirectory());
     
     // Allocate memory for calculating move and basic block execution counts
     int moveCount = pimpl_->controller_->program().moveCount();
@@ -112,6 +119,10 @@ CompiledSimulation::CompiledSimulation(
     // Find program exit points
     pimpl_->exitPoints_ = pimpl_->controller_->findProgramExitPoints(
         pimpl_->controller_->program(), machine_);
+
+    if (dynamicCompilation_) {
+        startBackgroundCompilation();
+    }
 }
 
 /**
@@ -553,7 +564,7 @@ CompiledSimulation::compileAndLoadFunction(InstructionAddress address) {
         
         // Compile the file if it hasn't been already
         if (compiledFiles.find(file) == compiledFiles.end()) {
-            pimpl_->compiler_.compileToSO(file);
+            pimpl_->compilationScheduler_->compile(file);
             std::string soPath = FileSystem::directoryOfPath(file) 
                 + FileSystem::DIRECTORY_SEPARATOR 
                 + FileSystem::fileNameBody(file) + ".so";
@@ -569,6 +580,115 @@ CompiledSimulation::compileAndLoadFunction(InstructionAddress address) {
     }
 }
 
+/**
+ * Estimates how often the procedures of the program are executed.
+ *
+ * Uses the instruction execution counts of an earlier simulation of the
+ * program if it saved profile data, otherwise the total length of the
+ * loops in each procedure.
+ *
+ * @param program The simulated program.
+ * @param programFileName File the program was loaded from.
+ * @param relations Procedures of the basic blocks.
+ * @param hotness The estimates per procedure start address.
+ */
+static void
+procedureHotness(
+    const Program& program,
+    const std::string& programFileName,
+    const ProcedureBBRelations& relations,
+    std::map<InstructionAddress, ClockCycleCount>& hotness) {
+
+    std::ifstream profile((programFileName + ".trace.profile").c_str());
+    InstructionAddress address = 0;
+    ClockCycleCount count = 0;
+    while (profile >> address >> count) {
+        std::map<InstructionAddress, InstructionAddress>::const_iterator bb =
+            relations.procedureStart.upper_bound(address);
+        if (bb != relations.procedureStart.begin()) {
+            --bb;
+            hotness[bb->second] += count;
+        }
+    }
+    if (!hotness.empty()) {
+        return;
+    }
+
+    for (int p = 0; p < program.procedureCount(); ++p) {
+        const Procedure& procedure = program.procedure(p);
+        InstructionAddress start = procedure.startAddress().location();
+        for (int i = 0; i < procedure.instructionCount(); ++i) {
+            const Instruction& instruction = procedure.instructionAtIndex(i);
+            address = instruction.address().location();
+            for (int m = 0; m < instruction.moveCount(); ++m) {
+                const Move& move = instruction.move(m);
+                if (!move.isJump() || !move.source().isInstructionAddress()) {
+                    continue;
+                }
+                InstructionAddress target = move.source().
+                    instructionReference().instruction().address().location();
+                // a backward jump inside the procedure closes a loop
+                if (target >= start && target <= address) {
+                    hotness[start] += address - target + 1;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Starts compiling the simulation functions in background threads.
+ *
+ * The procedure of the entry point is queued first, the rest from the
+ * hottest to the coldest. A procedure the simulation reaches before it
+ * has been compiled is compiled right away by compileAndLoadFunction().
+ */
+void
+CompiledSimulation::startBackgroundCompilation() {
+
+    std::map<InstructionAddress, ClockCycleCount> hotness;
+    procedureHotness(
+        pimpl_->controller_->program(), pimpl_->frontend_->programFileName(),
+        procedureBBRelations_, hotness);
+
+    typedef ProcedureBBRelations::BasicBlockStarts::const_iterator BBIterator;
+    const ProcedureBBRelations::BasicBlockStarts& bbStarts =
+        procedureBBRelations_.basicBlockStarts;
+
+    // equal hotness keeps the address order
+    typedef std::multimap<
+        ClockCycleCount, InstructionAddress, std::greater<ClockCycleCount> >
+        HotnessOrder;
+    HotnessOrder procedures;
+    for (BBIterator it = bbStarts.begin(); it != bbStarts.end();
+         it = bbStarts.upper_bound(it->first)) {
+        procedures.insert(std::make_pair(hotness[it->first], it->first));
+    }
+
+    std::vector<InstructionAddress> order;
+    std::map<InstructionAddress, InstructionAddress>::const_iterator entry =
+        procedureBBRelations_.procedureStart.find(entryAddress_);
+    if (entry != procedureBBRelations_.procedureStart.end()) {
+        order.push_back(entry->second);
+    }
+    for (HotnessOrder::const_iterator it = procedures.begin();
+         it != procedures.end(); ++it) {
+        order.push_back(it->second);
+    }
+
+    pimpl_->compilationScheduler_ = new CompiledSimCompilationScheduler(
+        pimpl_->compiler_, pimpl_->compiler_.threadCount());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        std::pair<BBIterator, BBIterator> blocks =
+            bbStarts.equal_range(order[i]);
+        for (BBIterator it = blocks.first; it != blocks.second; ++it) {
+            pimpl_->compilationScheduler_->enqueue(
+                procedureBBRelations_.basicBlockFiles[it->second]);
+        }
+    }
+    pimpl_->compilationScheduler_->start();
+}
+
 /**
  * Returns value of the given symbol (be it RF, FU, or IU)
  * 
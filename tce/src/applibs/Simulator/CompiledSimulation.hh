@@ -251,6 +251,8 @@ private:
     CompiledSimulation(const CompiledSimulation&);
     /// Assignment not allowed.
     CompiledSimulation& operator=(const CompiledSimulation&);
+
+    void startBackgroundCompilation();
     
     /// Private implementation in a separate source file
     CompiledSimulationPimpl* pimpl_;
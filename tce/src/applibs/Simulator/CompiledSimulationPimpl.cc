@@ -31,6 +31,7 @@
  */
 
 #include "CompiledSimulationPimpl.hh"
+#include "CompiledSimCompilationScheduler.hh"
 
 /**
  * Default constructor
@@ -42,11 +43,15 @@
  * 
  */
 CompiledSimulationPimpl::CompiledSimulationPimpl() : 
-    pluginTools_(true, false) {
+    compilationScheduler_(NULL), pluginTools_(true, false) {
 }
 
 /**
  * Default destructor
+ *
+ * Waits for the background compilations before the compiler is destroyed.
  */
 CompiledSimulationPimpl::~CompiledSimulationPimpl() {
+    delete compilationScheduler_;
+    compilationScheduler_ = NULL;
 }
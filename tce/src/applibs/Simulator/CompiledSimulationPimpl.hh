@@ -43,6 +43,7 @@
 #include "PluginTools.hh"
 
 class MemorySystem;
+class CompiledSimCompilationScheduler;
 class SimulatorFrontend;
 class CompiledSimController;
 
@@ -80,6 +81,9 @@ private:
     
     /// The Compiled Simulation compiler
     CompiledSimCompiler compiler_;
+    /// Compiles the simulation functions in the background, NULL if the
+    /// simulation is compiled statically
+    CompiledSimCompilationScheduler* compilationScheduler_;
     /// Plugintools used to load the compiled .so files
     PluginTools pluginTools_;
 };
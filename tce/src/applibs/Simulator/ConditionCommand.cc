@@ -41,6 +41,8 @@
 #include "SimValue.hh"
 #include "StopPointManager.hh"
 #include "TclConditionScript.hh"
+#include "StateConditionScript.hh"
+#include "StateExpression.hh"
 
 #include <iostream>
 
@@ -101,7 +103,16 @@ ConditionCommand::execute(const std::vector<DataObject>& arguments) {
             if (condition.script().at(0) == "1") {
                 stopPointManager.removeCondition(breakpointHandle);
             } else {
-                stopPointManager.setCondition(breakpointHandle, condition);
+                StateExpression* compiled = StateExpression::compileCondition(
+                    condition.script().at(0),
+                    condition.lastResult().stringValue(), *this);
+                if (compiled != NULL) {
+                    stopPointManager.setCondition(
+                        breakpointHandle,
+                        StateConditionScript(condition, compiled));
+                } else {
+                    stopPointManager.setCondition(breakpointHandle, condition);
+                }
             }
             printBreakpointInfo(breakpointHandle);
         } catch (const InstanceNotFound&) {
@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CoreCommand.cc
+ *
+ * Implementation of CoreCommand class
+ *
+ * @note rating: red
+ */
+
+#include "CoreCommand.hh"
+#include "SimulatorFrontend.hh"
+#include "Exception.hh"
+
+/**
+ * Constructor.
+ *
+ * Sets the name of the command to the base class.
+ */
+CoreCommand::CoreCommand() : 
+    SimControlLanguageCommand("core") {
+}
+
+/**
+ * Destructor.
+ *
+ * Does nothing.
+ */
+CoreCommand::~CoreCommand() {
+}
+
+/**
+ * Executes the "core" command.
+ *
+ * Selects the core the state queries, the debugging commands and the
+ * "prog" command refer to in a multi-core simulation. Without arguments
+ * returns the index of the selected core.
+ *
+ * @param arguments The index of the core to select, optional.
+ * @return True in case the arguments are ok.
+ */
+bool
+CoreCommand::execute(const std::vector<DataObject>& arguments) {
+    const int argumentCount = arguments.size() - 1;
+    if (!checkArgumentCount(argumentCount, 0, 1)) {
+        return false;
+    } 
+
+    if (argumentCount == 1) {
+        if (!checkIntegerArgument(arguments.at(1))) {
+            return false;
+        }
+        try {
+            simulatorFrontend().selectCore(arguments.at(1).integerValue());
+        } catch (const OutOfRange& e) {
+            interpreter()->setError(e.errorMessage());
+            return false;
+        }
+    }
+
+    interpreter()->setResult(simulatorFrontend().selectedCore());
+    return true;
+}
+
+/**
+ * Returns the help text for this command.
+ * 
+ * @return The help text.
+ */
+std::string 
+CoreCommand::helpText() const {
+    return 
+        "core [index]\n"
+        "Selects the core the other commands refer to in a multi-core "
+        "simulation and returns the index of the selected core. The number "
+        "of cores is set with the 'core_count' setting.";
+}
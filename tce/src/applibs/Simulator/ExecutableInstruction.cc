@@ -40,7 +40,7 @@
  * Constructor.
  */
 ExecutableInstruction::ExecutableInstruction() :
-    exitPoint_(false) {
+    predecoded_(false), exitPoint_(false) {
     resetExecutionCounts();
 }
 
@@ -63,6 +63,34 @@ ExecutableInstruction::~ExecutableInstruction() {
 void
 ExecutableInstruction::addExecutableMove(ExecutableMove* move) {
     moves_.push_back(move);
+    predecoded_ = false;
+}
+
+/**
+ * Translates the moves of the instruction to predecoded steps.
+ *
+ * Must be called after all the moves have been added. Afterwards, the
+ * instruction executes the steps instead of calling the ExecutableMoves.
+ * The simulated state, the squash flags and the execution counts of the
+ * moves are updated just the same.
+ *
+ * @return True if all the moves could be predecoded. Otherwise the
+ *         instruction keeps executing the moves directly.
+ */
+bool
+ExecutableInstruction::predecode() {
+    reads_.clear();
+    writes_.clear();
+    predecoded_ = true;
+    for (std::size_t i = 0; i < moves_.size(); ++i) {
+        if (!moves_[i]->predecode(reads_, writes_)) {
+            reads_.clear();
+            writes_.clear();
+            predecoded_ = false;
+            break;
+        }
+    }
+    return predecoded_;
 }
 
 /**
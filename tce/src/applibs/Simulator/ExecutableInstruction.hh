@@ -36,6 +36,7 @@
 
 #include <vector>
 #include "SimulatorConstants.hh"
+#include "MoveMicroOp.hh"
 
 class ExecutableMove;
 class LongImmUpdateAction;
@@ -54,6 +55,7 @@ public:
     void addExecutableMove(ExecutableMove* move);
     void addLongImmediateUpdateAction(LongImmUpdateAction* action);
 
+    bool predecode();
     void execute();
 
     ClockCycleCount executionCount() const;
@@ -74,10 +76,18 @@ private:
     typedef std::vector<ExecutableMove*> MoveContainer;
     /// Contains long immediate update actions.
     typedef std::vector<LongImmUpdateAction*> UpdateContainer;
+    /// Contains predecoded steps of the moves.
+    typedef std::vector<MoveMicroOp> MicroOpContainer;
     /// All moves of the instruction.
     MoveContainer moves_;
     /// All long immediate update actions.
     UpdateContainer updateActions_;
+    /// The bus reads of the moves, in the order of the moves.
+    MicroOpContainer reads_;
+    /// The writes of the moves, in the order of the moves.
+    MicroOpContainer writes_;
+    /// True if the moves are executed with the predecoded steps.
+    bool predecoded_;
     /// The count of times this instruction has been executed.
     ClockCycleCount executionCount_;
     /// True in case the instruction is considered a program exit point.
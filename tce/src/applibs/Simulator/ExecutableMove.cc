@@ -36,6 +36,7 @@
 #include "WritableState.hh"
 #include "BusState.hh"
 #include "SimValue.hh"
+#include "MoveMicroOp.hh"
 
 // This should be defined if guards block bus writes, that is, in case
 // guard definition evaluates to false, even the bus is not written.
@@ -187,6 +188,33 @@ ExecutableMove::executeWrite() {
     executionCount_++;
 }
 
+/**
+ * Translates the move to the predecoded steps ExecutableInstruction runs.
+ *
+ * The bus read evaluates the guard and is added to the reads executed
+ * before any of the writes of the instruction, like executeRead().
+ *
+ * @param reads The bus reads of the instruction.
+ * @param writes The writes of the instruction.
+ * @return False if the move cannot be predecoded.
+ */
+bool
+ExecutableMove::predecode(
+    std::vector<MoveMicroOp>& reads,
+    std::vector<MoveMicroOp>& writes) {
+
+    if (src_ == NULL || dst_ == NULL) {
+        return false;
+    }
+    const ReadableState* guard = guarded_ ? guardReg_ : NULL;
+    reads.push_back(
+        MoveMicroOp::busRead(*src_, *bus_, guard, negated_, squashed_));
+    writes.push_back(
+        MoveMicroOp::busWrite(
+            *bus_, *dst_, guarded_, squashed_, executionCount_));
+    return true;
+}
+
 /**
  * Resets the execution counter of this move.
  */
@@ -34,6 +34,8 @@
 #ifndef TTA_EXECUTABLE_MOVE_HH
 #define TTA_EXECUTABLE_MOVE_HH
 
+#include <vector>
+
 #include "InlineImmediateValue.hh"
 #include "SimulatorConstants.hh"
 
@@ -41,6 +43,7 @@ class ReadableState;
 class BusState;
 class WritableState;
 class SimValue;
+class MoveMicroOp;
 
 
 /**
@@ -82,6 +85,10 @@ public:
     virtual void evaluateGuard();
     virtual bool squashed() const;
 
+    virtual bool predecode(
+        std::vector<MoveMicroOp>& reads,
+        std::vector<MoveMicroOp>& writes);
+
     ClockCycleCount executionCount() const;
     void resetExecutionCount();
 
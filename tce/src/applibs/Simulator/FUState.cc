@@ -68,7 +68,8 @@ FUState::FUState() :
     ClockedState(), idle_(false), trigger_(false),
     nextOperation_(NULL), nextExecutor_(NULL),
     operationContext_(DEFAULT_FU_NAME),
-    activeExecutors_(0), detailedModel_(NULL) {
+    activeExecutors_(0), detailedModel_(NULL), activeSet_(NULL),
+    activeIndex_(-1) {
 }
 
 /**
@@ -79,7 +80,8 @@ FUState::FUState() :
 FUState::FUState(const TCEString& name) :
     ClockedState(), idle_(false), trigger_(false),
     nextOperation_(NULL), nextExecutor_(NULL), operationContext_(name),
-    activeExecutors_(0), detailedModel_(NULL) {
+    activeExecutors_(0), detailedModel_(NULL), activeSet_(NULL),
+    activeIndex_(-1) {
 }
 
 /**
@@ -110,6 +112,23 @@ FUState::reset() {
         // Reset the internal state of executor
         (*i).second->reset();
     }
+    // the recreated operation states may need clocking
+    activate();
+}
+
+/**
+ * Sets the set of units that need clocking the FU belongs to.
+ *
+ * The FU marks itself active in the set when it is triggered. The owner
+ * of the set is responsible for removing it once it is idle.
+ *
+ * @param set The set.
+ * @param index The index of the FU in the set.
+ */
+void
+FUState::setActiveUnitSet(ActiveUnitSet& set, int index) {
+    activeSet_ = &set;
+    activeIndex_ = index;
 }
 
 /**
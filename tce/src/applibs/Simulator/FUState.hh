@@ -42,6 +42,7 @@
 #include "ClockedState.hh"
 #include "PortState.hh"
 #include "OperationContext.hh"
+#include "ActiveUnitSet.hh"
 
 class Operation;
 class OperationExecutor;
@@ -88,6 +89,8 @@ public:
 
     virtual void reset();
 
+    void setActiveUnitSet(ActiveUnitSet& set, int index);
+
 protected:
     /// The idle status of the FU. The derived classes should
     /// alway set this to true when possible to avoid unnecessary
@@ -101,6 +104,7 @@ private:
     FUState& operator=(const FUState&);
 
     void clearPorts();
+    void activate();
     bool sameBindings(
         OperationExecutor& exec1, 
         OperationExecutor& exec2,
@@ -138,6 +142,10 @@ private:
     /// such model per FU or none at all for now (could be possible to
     /// be one model per Operation).
     DetailedOperationSimulator* detailedModel_;
+    /// The set of units to clock the FU is in, NULL if not in any.
+    ActiveUnitSet* activeSet_;
+    /// The index of the FU in the active unit set.
+    int activeIndex_;
 };
 
 #include "FUState.icc"
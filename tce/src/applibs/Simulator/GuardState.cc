@@ -174,3 +174,12 @@ DirectGuardState::value() const {
     return target_->value();
 }
 
+/**
+ * Returns the register watched by this guard.
+ *
+ * @return The target register.
+ */
+const ReadableState&
+DirectGuardState::target() const {
+    return *target_;
+}
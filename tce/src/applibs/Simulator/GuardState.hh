@@ -130,6 +130,8 @@ public:
 
     virtual void endClock();
     virtual void advanceClock();
+
+    const ReadableState& target() const;
     
 private:
     DirectGuardState();
@@ -35,6 +35,7 @@
 
 #include "LongImmediateUnitState.hh"
 #include "LongImmediateRegisterState.hh"
+#include "ActiveUnitSet.hh"
 #include "SequenceTools.hh"
 #include "Application.hh"
 #include "Exception.hh"
@@ -121,6 +122,9 @@ LongImmediateUnitState::setRegisterValue(int index, const SimValue& value) {
         values_[index] = value;
     } else {
         queue_.emplace(value, index, timer_ + latency_);
+        if (activeSet_ != NULL) {
+            activeSet_->activate(activeIndex_);
+        }
     }
 }
 
@@ -149,6 +153,35 @@ LongImmediateUnitState::advanceClock() {
     }
 }
 
+/**
+ * Returns true if there are no pending register value updates.
+ *
+ * An idle unit need not be clocked: the arrival times of the updates are
+ * relative to the internal timer, which only needs to run while some
+ * update is pending.
+ *
+ * @return True if the unit is idle.
+ */
+bool
+LongImmediateUnitState::isIdle() const {
+    return queue_.empty();
+}
+
+/**
+ * Sets the set of units that need clocking the unit belongs to.
+ *
+ * The unit marks itself active in the set when an update with latency
+ * is queued. The owner of the set removes it once it is idle.
+ *
+ * @param set The set.
+ * @param index The index of the unit in the set.
+ */
+void
+LongImmediateUnitState::setActiveUnitSet(ActiveUnitSet& set, int index) {
+    activeSet_ = &set;
+    activeIndex_ = index;
+}
+
 /**
  * Returns the register of the given index.
  *
@@ -44,6 +44,7 @@
 #include "SimValue.hh"
 
 class LongImmediateRegisterState;
+class ActiveUnitSet;
 
 //////////////////////////////////////////////////////////////////////////////
 // LongImmediateUnitState
@@ -71,6 +72,9 @@ public:
     virtual void endClock();
     virtual void advanceClock();
 
+    bool isIdle() const;
+    void setActiveUnitSet(ActiveUnitSet& set, int index);
+
 private:
     /// Copying not allowed.
     LongImmediateUnitState(const LongImmediateUnitState&);
@@ -115,7 +119,10 @@ private:
     /// Counter to time arrival of immediate values. Note: value is expected
     /// to wrap.
     unsigned timer_ = 0;
-
+    /// The set of units to clock the unit is in, NULL if not in any.
+    ActiveUnitSet* activeSet_ = NULL;
+    /// The index of the unit in the active unit set.
+    int activeIndex_ = -1;
 };
 
 //////////////////////////////////////////////////////////////////////////////
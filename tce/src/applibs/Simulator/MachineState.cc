@@ -84,6 +84,8 @@ MachineState::clear() {
     longImmediateCache_.clear();
     rfCache_.clear();
     guardCache_.clear();
+    activeFUs_ = ActiveUnitSet();
+    activeLongImmediateUnits_ = ActiveUnitSet();
 
     MapTools::deleteAllValues(busses_);
     MapTools::deleteAllValues(FUStates_);
@@ -267,6 +269,7 @@ void
 MachineState::addFUState(FUState* state, const std::string& name) {
     FUStates_[name] = state;
     fuCache_.push_back(state);
+    state->setActiveUnitSet(activeFUs_, activeFUs_.addUnit());
 }
 
 /**
@@ -298,6 +301,11 @@ MachineState::addLongImmediateUnitState(
 
     longImmediates_[name] = state;
     longImmediateCache_.push_back(state);
+    const int index = activeLongImmediateUnits_.addUnit();
+    state->setActiveUnitSet(activeLongImmediateUnits_, index);
+    if (state->isIdle()) {
+        activeLongImmediateUnits_.deactivate(index);
+    }
 }
 
 /**
@@ -327,7 +335,10 @@ MachineState::addGuardState(
     const TTAMachine::Guard& guard) {
 
     guards_[&guard] = state;
-    guardCache_.push_back(state);
+    // direct guards read the register as is, clocking them does nothing
+    if (dynamic_cast<DirectGuardState*>(state) == NULL) {
+        guardCache_.push_back(state);
+    }
 }
 
 /**
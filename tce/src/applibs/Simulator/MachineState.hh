@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "Exception.hh"
+#include "ActiveUnitSet.hh"
 
 class GCUState;
 class BusState;
@@ -162,6 +163,12 @@ private:
     RegisterFileCache rfCache_;
     GuardCache guardCache_;
 
+    /// The FUs that are not idle, indexed as in fuCache_.
+    ActiveUnitSet activeFUs_;
+    /// The long immediate units with pending updates, indexed as in
+    /// longImmediateCache_.
+    ActiveUnitSet activeLongImmediateUnits_;
+
     // This is set to true when the core has finished execution (reached
     // a known program exit point).
     bool finished_;
@@ -71,6 +71,12 @@ public:
 
     virtual void fillWithZeros() { memory_->fillWithZeros(); }
 
+    virtual void addWriteWatch(
+        ULongWord first, ULongWord last, bool& written) override
+        { memory_->addWriteWatch(first, last, written); }
+    virtual void removeWriteWatch(const bool& written) override
+        { memory_->removeWriteWatch(written); }
+
     unsigned int readAccessCount() const;
     unsigned int writeAccessCount() const;
 
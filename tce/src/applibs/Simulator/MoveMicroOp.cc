@@ -0,0 +1,340 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MoveMicroOp.cc
+ *
+ * Definition of MoveMicroOp class.
+ *
+ * @note rating: red
+ */
+
+#include <typeinfo>
+
+#include "MoveMicroOp.hh"
+#include "RegisterState.hh"
+#include "BusState.hh"
+#include "InputPortState.hh"
+#include "OutputPortState.hh"
+#include "TriggeringInputPortState.hh"
+#include "LongImmediateRegisterState.hh"
+#include "GuardState.hh"
+#include "FUState.hh"
+
+/**
+ * Constructor.
+ *
+ * Creates an empty step, the factory methods fill it.
+ */
+MoveMicroOp::MoveMicroOp() :
+    handler_(NULL), source_(NULL), sourceState_(NULL), bus_(NULL),
+    busState_(NULL), destination_(NULL), destinationState_(NULL),
+    triggered_(NULL), guard_(NULL), guardState_(NULL), negated_(false),
+    squashed_(NULL), executionCount_(NULL) {
+}
+
+/**
+ * Creates the step that copies the source of a move to its bus.
+ *
+ * This also evaluates the guard of the move, so it must be executed
+ * before any of the writes of the instruction.
+ *
+ * @param source The source of the move.
+ * @param bus The bus of the move.
+ * @param guard The guard of the move, NULL if the move is not guarded.
+ * @param negated True if the guard is inverted.
+ * @param squashed The squash flag of the move.
+ * @return The step.
+ */
+MoveMicroOp
+MoveMicroOp::busRead(
+    const ReadableState& source,
+    BusState& bus,
+    const ReadableState* guard,
+    bool negated,
+    bool& squashed) {
+
+    MoveMicroOp op;
+    op.setSource(source);
+    op.setGuard(guard, negated);
+    op.bus_ = storage(bus);
+    op.busState_ = &bus;
+    op.squashed_ = &squashed;
+
+    const bool stableSource = op.source_ != NULL;
+    if (guard != NULL) {
+        op.handler_ = stableSource ?
+            &readToBus<true, true> : &readToBus<true, false>;
+    } else {
+        op.handler_ = stableSource ?
+            &readToBus<false, true> : &readToBus<false, false>;
+    }
+    return op;
+}
+
+/**
+ * Creates the step that copies the bus of a move to its destination.
+ *
+ * @param bus The bus of the move.
+ * @param destination The destination of the move.
+ * @param guarded True if the move is guarded.
+ * @param squashed The squash flag of the move, set by the bus read.
+ * @param executionCount The execution count of the move.
+ * @return The step.
+ */
+MoveMicroOp
+MoveMicroOp::busWrite(
+    BusState& bus,
+    WritableState& destination,
+    bool guarded,
+    bool& squashed,
+    ClockCycleCount& executionCount) {
+
+    MoveMicroOp op;
+    op.setDestination(destination);
+    op.bus_ = storage(bus);
+    op.busState_ = &bus;
+    op.squashed_ = &squashed;
+    op.executionCount_ = &executionCount;
+
+    static const Handler handlers[2][3] = {
+        { &writeFromBus<false, DST_STORE>,
+          &writeFromBus<false, DST_TRIGGER>,
+          &writeFromBus<false, DST_GENERIC> },
+        { &writeFromBus<true, DST_STORE>,
+          &writeFromBus<true, DST_TRIGGER>,
+          &writeFromBus<true, DST_GENERIC> } };
+
+    const DestinationKind kind =
+        op.destination_ == NULL ? DST_GENERIC :
+        (op.triggered_ != NULL ? DST_TRIGGER : DST_STORE);
+    op.handler_ = handlers[guarded][kind];
+    return op;
+}
+
+/**
+ * Creates the step of a move that does not use a bus.
+ *
+ * The guard is evaluated and the source read when the step is executed,
+ * in the write phase of the instruction.
+ *
+ * @param source The source of the move.
+ * @param destination The destination of the move.
+ * @param guard The guard of the move, NULL if the move is not guarded.
+ * @param negated True if the guard is inverted.
+ * @param squashed The squash flag of the move.
+ * @param executionCount The execution count of the move.
+ * @return The step.
+ */
+MoveMicroOp
+MoveMicroOp::directTransport(
+    const ReadableState& source,
+    WritableState& destination,
+    const ReadableState* guard,
+    bool negated,
+    bool& squashed,
+    ClockCycleCount& executionCount) {
+
+    MoveMicroOp op;
+    op.setSource(source);
+    op.setDestination(destination);
+    op.setGuard(guard, negated);
+    op.squashed_ = &squashed;
+    op.executionCount_ = &executionCount;
+
+    static const Handler handlers[2][3] = {
+        { &transport<false, DST_STORE>,
+          &transport<false, DST_TRIGGER>,
+          &transport<false, DST_GENERIC> },
+        { &transport<true, DST_STORE>,
+          &transport<true, DST_TRIGGER>,
+          &transport<true, DST_GENERIC> } };
+
+    const DestinationKind kind =
+        op.destination_ == NULL ? DST_GENERIC :
+        (op.triggered_ != NULL ? DST_TRIGGER : DST_STORE);
+    op.handler_ = handlers[guard != NULL][kind];
+    return op;
+}
+
+/**
+ * Sets the source of the step.
+ *
+ * @param source The source state.
+ */
+void
+MoveMicroOp::setSource(const ReadableState& source) {
+    sourceState_ = &source;
+    source_ = stableValue(source);
+}
+
+/**
+ * Sets the destination of the step.
+ *
+ * @param destination The destination state.
+ */
+void
+MoveMicroOp::setDestination(WritableState& destination) {
+    destinationState_ = &destination;
+    destination_ = storage(destination);
+    if (destination_ != NULL &&
+        typeid(destination) == typeid(TriggeringInputPortState)) {
+        triggered_ = &dynamic_cast<PortState&>(destination).parent();
+    }
+}
+
+/**
+ * Sets the guard of the step.
+ *
+ * @param guard The guard state, NULL if the move is not guarded.
+ * @param negated True if the guard is inverted.
+ */
+void
+MoveMicroOp::setGuard(const ReadableState* guard, bool negated) {
+    guardState_ = guard;
+    negated_ = negated;
+    if (guard != NULL) {
+        guard_ = stableValue(*guard);
+    }
+}
+
+/**
+ * Writes a value to the destination.
+ *
+ * @param kind The kind of the destination.
+ * @param value The value.
+ */
+inline void
+MoveMicroOp::store(DestinationKind kind, const SimValue& value) const {
+    switch (kind) {
+    case DST_TRIGGER:
+        triggered_->setTriggered();
+        // fall through
+    case DST_STORE:
+        *destination_ = value;
+        break;
+    case DST_GENERIC:
+        destinationState_->setValue(value);
+        break;
+    }
+}
+
+/**
+ * Evaluates the guard and copies the source to the bus.
+ *
+ * @param op The step.
+ */
+template <bool guarded, bool stableSource>
+void
+MoveMicroOp::readToBus(const MoveMicroOp& op) {
+    if (guarded) {
+        const bool squashed = op.guardSquashes();
+        *op.squashed_ = squashed;
+        op.busState_->setSquashed(squashed);
+        if (squashed) {
+            return;
+        }
+    } else {
+        op.busState_->setSquashed(false);
+    }
+    *op.bus_ = stableSource ? *op.source_ : op.sourceState_->value();
+}
+
+/**
+ * Copies the bus to the destination unless the move was squashed.
+ *
+ * @param op The step.
+ */
+template <bool guarded, MoveMicroOp::DestinationKind kind>
+void
+MoveMicroOp::writeFromBus(const MoveMicroOp& op) {
+    if (guarded && *op.squashed_) {
+        return;
+    }
+    op.store(kind, *op.bus_);
+    ++*op.executionCount_;
+}
+
+/**
+ * Evaluates the guard and copies the source to the destination.
+ *
+ * @param op The step.
+ */
+template <bool guarded, MoveMicroOp::DestinationKind kind>
+void
+MoveMicroOp::transport(const MoveMicroOp& op) {
+    const bool squashed = guarded && op.guardSquashes();
+    *op.squashed_ = squashed;
+    if (squashed) {
+        return;
+    }
+    op.store(kind, op.sourceValue());
+    ++*op.executionCount_;
+}
+
+/**
+ * Returns the value object of a state that can be read directly.
+ *
+ * The value() of these states always returns the same object and has no
+ * side effects, so the object can be read in place of calling value().
+ *
+ * @param state The state.
+ * @return The value object, or NULL if value() must be called.
+ */
+const SimValue*
+MoveMicroOp::stableValue(const ReadableState& state) {
+    const std::type_info& type = typeid(state);
+    if (type == typeid(RegisterState) ||
+        type == typeid(BusState) ||
+        type == typeid(InputPortState) ||
+        type == typeid(TriggeringInputPortState) ||
+        type == typeid(OutputPortState) ||
+        type == typeid(LongImmediateRegisterState)) {
+        return &state.value();
+    } else if (type == typeid(DirectGuardState)) {
+        return stableValue(
+            dynamic_cast<const DirectGuardState&>(state).target());
+    }
+    return NULL;
+}
+
+/**
+ * Returns the register of a state whose setValue() only assigns it.
+ *
+ * @param state The state.
+ * @return The register, or NULL if setValue() must be called.
+ */
+SimValue*
+MoveMicroOp::storage(WritableState& state) {
+    const std::type_info& type = typeid(state);
+    if (type == typeid(RegisterState) ||
+        type == typeid(BusState) ||
+        type == typeid(InputPortState) ||
+        type == typeid(TriggeringInputPortState) ||
+        type == typeid(OutputPortState)) {
+        // RegisterState::setValue() assigns the object value() returns
+        return const_cast<SimValue*>(
+            &dynamic_cast<RegisterState&>(state).value());
+    }
+    return NULL;
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MoveMicroOp.hh
+ *
+ * Declaration of MoveMicroOp class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_MOVE_MICRO_OP_HH
+#define TTA_MOVE_MICRO_OP_HH
+
+#include "SimulatorConstants.hh"
+
+class ReadableState;
+class WritableState;
+class BusState;
+class FUState;
+class SimValue;
+
+/**
+ * A predecoded step of a data transport.
+ *
+ * A move is executed as a bus read and a bus write, or a single direct
+ * transport for the moves that do not use a bus. When the program is
+ * loaded, each step is specialized by the kind of its guard, source and
+ * destination and the storage of the values is resolved, so executing
+ * a step is one call through the handler pointer instead of several
+ * virtual calls through the state interfaces.
+ *
+ * The steps update the same state as the ExecutableMove they are decoded
+ * from, including its squash flag and execution count.
+ */
+class MoveMicroOp {
+public:
+    static MoveMicroOp busRead(
+        const ReadableState& source,
+        BusState& bus,
+        const ReadableState* guard,
+        bool negated,
+        bool& squashed);
+
+    static MoveMicroOp busWrite(
+        BusState& bus,
+        WritableState& destination,
+        bool guarded,
+        bool& squashed,
+        ClockCycleCount& executionCount);
+
+    static MoveMicroOp directTransport(
+        const ReadableState& source,
+        WritableState& destination,
+        const ReadableState* guard,
+        bool negated,
+        bool& squashed,
+        ClockCycleCount& executionCount);
+
+    void execute() const;
+
+private:
+    /// Executes the step.
+    typedef void (*Handler)(const MoveMicroOp& op);
+
+    /// How the value is written to the destination.
+    enum DestinationKind {
+        DST_STORE,   ///< Stored to the register.
+        DST_TRIGGER, ///< Stored to the register and the FU triggered.
+        DST_GENERIC  ///< Written with WritableState::setValue().
+    };
+
+    MoveMicroOp();
+
+    void setSource(const ReadableState& source);
+    void setDestination(WritableState& destination);
+    void setGuard(const ReadableState* guard, bool negated);
+    bool guardSquashes() const;
+    const SimValue& sourceValue() const;
+    void store(DestinationKind kind, const SimValue& value) const;
+
+    template <bool guarded, bool stableSource>
+    static void readToBus(const MoveMicroOp& op);
+    template <bool guarded, DestinationKind kind>
+    static void writeFromBus(const MoveMicroOp& op);
+    template <bool guarded, DestinationKind kind>
+    static void transport(const MoveMicroOp& op);
+
+    static const SimValue* stableValue(const ReadableState& state);
+    static SimValue* storage(WritableState& state);
+
+    /// The handler of the step.
+    Handler handler_;
+    /// The value of the source, NULL if it must be read with value().
+    const SimValue* source_;
+    /// The source state.
+    const ReadableState* sourceState_;
+    /// The value of the bus.
+    SimValue* bus_;
+    /// The bus state.
+    BusState* busState_;
+    /// The value of the destination register, NULL if not stored directly.
+    SimValue* destination_;
+    /// The destination state.
+    WritableState* destinationState_;
+    /// The FU triggered by writing the destination.
+    FUState* triggered_;
+    /// The value of the guard, NULL if it must be read with value().
+    const SimValue* guard_;
+    /// The guard state, NULL if the move is not guarded.
+    const ReadableState* guardState_;
+    /// True if the guard is inverted.
+    bool negated_;
+    /// The squash flag of the move.
+    bool* squashed_;
+    /// The execution count of the move.
+    ClockCycleCount* executionCount_;
+};
+
+#include "MoveMicroOp.icc"
+
+#endif
@@ -74,7 +74,7 @@ RFAccessTracker::RFAccessTracker(
  * Destructor.
  */
 RFAccessTracker::~RFAccessTracker() {
-    frontend_.eventHandler().registerListener(
+    frontend_.eventHandler().unregisterListener(
         SimulationEventHandler::SE_CYCLE_END, this);
     frontend_.eventHandler().unregisterListener(
         SimulationEventHandler::SE_SIMULATION_STOPPED, this);
@@ -82,6 +82,12 @@ RFAccessTracker::~RFAccessTracker() {
 
 /**
  * Counts the concurrent register file accesses of current clock cycle.
+ *
+ * Only the executed register accessing moves of instructions with
+ * conditional register file accesses are recorded during simulation, as
+ * a bit mask counter per instruction. The access statistics are computed
+ * from the counters and the instruction execution counts when the
+ * simulation stops.
  */
 void 
 RFAccessTracker::handleEvent(int event) {
@@ -110,80 +116,157 @@ RFAccessTracker::handleEvent(int event) {
                 continue;
             }           
 
-            accessesInInstruction_.clear();        
-
+            executedMoves_.clear();
             for (int i = 0; i < currentInstruction->moveCount(); ++i) {
-                const TTAProgram::Move& move = currentInstruction->move(i);
-                if (move.source().isGPR()) {
-                    ++accessesInInstruction_[
-                        move.source().registerFile().name().c_str()].get<1>();
-                }
-
-                if (move.destination().isGPR()) {
-                    ++accessesInInstruction_[
-                        move.destination().registerFile().name().c_str()].
-                        get<0>();
-                }
-            }
-
-            for (RFAccessIndex::iterator i = accessesInInstruction_.begin();
-                 i != accessesInInstruction_.end(); ++i) {
-
-                ConcurrentRFAccess key(
-                    (*i).first, (*i).second.get<0>(), (*i).second.get<1>());
-                totalAccesses_[key] += execInstruction.executionCount();
+                executedMoves_.push_back(i);
             }
+            addAccesses(
+                *currentInstruction, executedMoves_,
+                execInstruction.executionCount(), totalAccesses_);
                 
             currentInstruction = &program.nextInstruction(*currentInstruction);
         }
 
-        // add the access data of the instruction with the conditional accesses
+        // add the access data of the instructions with the conditional
+        // accesses
+        for (std::size_t a = 0; a < accessCounts_.size(); ++a) {
+            const InstructionAccessCounts& counts = accessCounts_[a];
+            if (counts.instruction == NULL) {
+                continue;
+            }
+            for (std::size_t p = 0; p < counts.patterns.size(); ++p) {
+                const boost::uint64_t mask = counts.patterns[p].first;
+                executedMoves_.clear();
+                for (std::size_t m = 0; m < counts.registerMoves.size(); ++m) {
+                    if (mask & (boost::uint64_t(1) << m)) {
+                        executedMoves_.push_back(counts.registerMoves[m]);
+                    }
+                }
+                addAccesses(
+                    *counts.instruction, executedMoves_,
+                    counts.patterns[p].second, totalAccesses_);
+            }
+        }
         ConcurrentRFAccessIndex::iterator i = conditionalAccesses_.begin();
         for (; i != conditionalAccesses_.end(); ++i) {
-            ConcurrentRFAccess key = (*i).first;
-            totalAccesses_[key] += conditionalAccesses_[key];
+            totalAccesses_[(*i).first] += (*i).second;
         }
 
     } else if (event == SimulationEventHandler::SE_CYCLE_END) {
 
-        const InstructionAddress& address = 
+        const InstructionAddress address = 
             frontend_.lastExecutedInstruction();
-        const TTAProgram::Instruction& instruction = 
-            frontend_.program().instructionAt(address);
-        if (!instruction.hasConditionalRegisterAccesses())
+        if (address >= accessCounts_.size()) {
+            accessCounts_.resize(address + 1);
+        }
+        InstructionAccessCounts& counts = accessCounts_[address];
+        if (!counts.initialized) {
+            initializeCounts(address, counts);
+        }
+        if (counts.instruction == NULL)
             return;
 
-        accessesInInstruction_.clear();
-
         const ExecutableInstruction& execInstruction = 
-            instructionExecutions_.instructionAtConst(address);
+            *counts.execInstruction;
+        const std::size_t moveCount = counts.registerMoves.size();
 
-        for (int i = 0; i < instruction.moveCount(); ++i) {
-            if (execInstruction.moveSquashed(i))
-                continue;
-            const TTAProgram::Move& move = instruction.move(i);
-            if (move.source().isGPR()) {
-                ++accessesInInstruction_[
-                    move.source().registerFile().name().c_str()].get<1>();
+        if (moveCount > 64) {
+            // does not fit in the mask, count the accesses directly
+            executedMoves_.clear();
+            for (std::size_t m = 0; m < moveCount; ++m) {
+                if (!execInstruction.moveSquashed(counts.registerMoves[m])) {
+                    executedMoves_.push_back(counts.registerMoves[m]);
+                }
             }
+            addAccesses(
+                *counts.instruction, executedMoves_, 1, conditionalAccesses_);
+            return;
+        }
 
-            if (move.destination().isGPR()) {
-                ++accessesInInstruction_[
-                    move.destination().registerFile().name().c_str()].get<0>();
+        boost::uint64_t mask = 0;
+        for (std::size_t m = 0; m < moveCount; ++m) {
+            if (!execInstruction.moveSquashed(counts.registerMoves[m])) {
+                mask |= boost::uint64_t(1) << m;
             }
         }
-
-        for (RFAccessIndex::iterator i = accessesInInstruction_.begin();
-             i != accessesInInstruction_.end(); ++i) {
-            ++conditionalAccesses_[boost::make_tuple(
-                                       (*i).first, (*i).second.get<0>(), 
-                                       (*i).second.get<1>())];
+        for (std::size_t p = 0; p < counts.patterns.size(); ++p) {
+            if (counts.patterns[p].first == mask) {
+                ++counts.patterns[p].second;
+                return;
+            }
         }
+        counts.patterns.push_back(std::make_pair(mask, ClockCycleCount(1)));
     } else {
         abortWithError("RFAccessTracker received an unknown event.");
     }
 }
 
+/**
+ * Looks up the instruction data needed for counting the register access
+ * patterns of the instruction at the given address.
+ *
+ * @param address The instruction address.
+ * @param counts The counters of the instruction to initialize.
+ */
+void
+RFAccessTracker::initializeCounts(
+    InstructionAddress address, InstructionAccessCounts& counts) {
+
+    counts.initialized = true;
+    const TTAProgram::Instruction& instruction = 
+        frontend_.program().instructionAt(address);
+    if (!instruction.hasConditionalRegisterAccesses())
+        return;
+
+    counts.instruction = &instruction;
+    counts.execInstruction = &instructionExecutions_.instructionAtConst(address);
+    for (int i = 0; i < instruction.moveCount(); ++i) {
+        const TTAProgram::Move& move = instruction.move(i);
+        if (move.source().isGPR() || move.destination().isGPR()) {
+            counts.registerMoves.push_back(i);
+        }
+    }
+}
+
+/**
+ * Adds the register file accesses of the given moves of an instruction to
+ * the given access index.
+ *
+ * @param instruction The instruction.
+ * @param executedMoves Indices of the executed moves of the instruction.
+ * @param count Count of the executions to add.
+ * @param index The access index to add the accesses to.
+ */
+void
+RFAccessTracker::addAccesses(
+    const TTAProgram::Instruction& instruction,
+    const std::vector<int>& executedMoves,
+    ClockCycleCount count,
+    ConcurrentRFAccessIndex& index) {
+
+    accessesInInstruction_.clear();
+
+    for (std::size_t i = 0; i < executedMoves.size(); ++i) {
+        const TTAProgram::Move& move = instruction.move(executedMoves[i]);
+        if (move.source().isGPR()) {
+            ++accessesInInstruction_[
+                move.source().registerFile().name().c_str()].get<1>();
+        }
+
+        if (move.destination().isGPR()) {
+            ++accessesInInstruction_[
+                move.destination().registerFile().name().c_str()].get<0>();
+        }
+    }
+
+    for (RFAccessIndex::iterator i = accessesInInstruction_.begin();
+         i != accessesInInstruction_.end(); ++i) {
+        index[boost::make_tuple(
+                  (*i).first, (*i).second.get<0>(), (*i).second.get<1>())] +=
+            count;
+    }
+}
+
 /**
  * Returns the count of clock cycles in which the given register file was
  * written and read concurrently the given times.
@@ -35,6 +35,9 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
+#include <boost/cstdint.hpp>
 
 #include "boost/tuple/tuple.hpp"
 
@@ -45,6 +48,11 @@
 
 class SimulatorFrontend;
 class InstructionMemory;
+class ExecutableInstruction;
+
+namespace TTAProgram {
+    class Instruction;
+}
 
 /**
  * Tracks concurrent register file accesses.
@@ -75,6 +83,35 @@ public:
     const ConcurrentRFAccessIndex& accessDataBase() const;
 
 private:
+    /// Execution counts of the register access patterns of an instruction.
+    ///
+    /// Filled in during simulation only for instructions with conditional
+    /// register file accesses; the counts are folded to register file
+    /// access statistics when the simulation stops.
+    struct InstructionAccessCounts {
+        InstructionAccessCounts() :
+            initialized(false), instruction(NULL), execInstruction(NULL) {}
+        /// true after the instruction data has been looked up
+        bool initialized;
+        /// the program instruction, NULL if it has no conditional accesses
+        const TTAProgram::Instruction* instruction;
+        /// the execution data of the instruction
+        const ExecutableInstruction* execInstruction;
+        /// indices of the moves accessing register files
+        std::vector<int> registerMoves;
+        /// bit masks of the executed register accessing moves and the
+        /// count of executions with the mask
+        std::vector<std::pair<boost::uint64_t, ClockCycleCount> > patterns;
+    };
+
+    void initializeCounts(
+        InstructionAddress address, InstructionAccessCounts& counts);
+    void addAccesses(
+        const TTAProgram::Instruction& instruction,
+        const std::vector<int>& executedMoves,
+        ClockCycleCount count,
+        ConcurrentRFAccessIndex& index);
+
     /// Index for RF accesses in an instruction.
     typedef hash_map<
         const char*, /* funame */
@@ -84,13 +121,18 @@ private:
     SimulatorFrontend& frontend_;
     /// used to access instruction execution data
     const InstructionMemory& instructionExecutions_;
-    /// conditional register file accesses are counted in this container
+    /// access pattern counts of the instructions, indexed by address
+    std::vector<InstructionAccessCounts> accessCounts_;
+    /// conditional accesses of instructions with too many register
+    /// accessing moves for the pattern masks are counted in this container
     ConcurrentRFAccessIndex conditionalAccesses_;  
     /// total (conditional + unconditional) register file accesses are counted
     /// in this container
     ConcurrentRFAccessIndex totalAccesses_;  
     /// container used in collecting register accesses in an instruction
     RFAccessIndex accessesInInstruction_;
+    /// container used in collecting the executed moves of an instruction
+    std::vector<int> executedMoves_;
 };
 
 #endif
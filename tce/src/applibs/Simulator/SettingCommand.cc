@@ -120,6 +120,45 @@ public:
     }
 };
 
+/**
+ * Setting action that sets the format of the bus trace.
+ */
+class SetBusTraceBinary {
+public:
+
+    /**
+     * Sets the format of the bus trace.
+     *
+     * @param simFront SimulatorFrontend to set the bus trace format for.
+     * @param newValue Value to set.
+     * @return True if setting was successful.
+     */
+    static bool execute(
+        SimulatorInterpreter&, SimulatorFrontend& simFront, bool newValue) {
+        simFront.setBusTraceBinary(newValue);
+        return true;
+    }
+
+    /**
+     * Returns the default value of this setting.
+     *
+     * @return The default value.
+     */
+    static const DataObject& defaultValue() {
+        static const DataObject defaultValue_("0");
+        return defaultValue_;
+    }
+    
+    /**
+     * Should the action warn if program & machine exist and value was changed
+     * 
+     * @return boolean value on whether or not to warn
+     */
+    static bool warnOnExistingProgramAndMachine() {
+        return true;
+    }
+};
+
 /**
  * Setting action that sets the register file access tracking of simulation.
  */
@@ -663,6 +702,53 @@ public:
         return false;
     }
 };
+
+/**
+ * Setting action that sets the number of simulated cores.
+ */
+class SetCoreCount {
+public:
+    static bool execute(
+        SimulatorInterpreter&, 
+        SimulatorFrontend& simFront, 
+        unsigned int newValue) {
+        simFront.setCoreCount(newValue);
+        return true;
+    }
+                            
+    static const DataObject& defaultValue() {
+        static const DataObject defaultValue_("1");
+        return defaultValue_;
+    }
+    
+    static bool warnOnExistingProgramAndMachine() {
+        return false;
+    }
+};
+
+/**
+ * Setting action that sets the number of threads simulating the cores.
+ */
+class SetSimulationThreads {
+public:
+    static bool execute(
+        SimulatorInterpreter&, 
+        SimulatorFrontend& simFront, 
+        unsigned int newValue) {
+        simFront.setSimulationThreadCount(newValue);
+        return true;
+    }
+                            
+    static const DataObject& defaultValue() {
+        static const DataObject defaultValue_("1");
+        return defaultValue_;
+    }
+    
+    static bool warnOnExistingProgramAndMachine() {
+        return false;
+    }
+};
+
 SettingCommand::SettingCommand() : 
     SimControlLanguageCommand("setting") {
 
@@ -676,6 +762,11 @@ SettingCommand::SettingCommand() :
             SimulatorToolbox::textGenerator().text(
                 Texts::TXT_INTERP_SETTING_BUSTRACE).str());
 
+    settings_["bus_trace_binary"] =
+        new TemplatedSimulatorSetting<BooleanSetting, SetBusTraceBinary>(
+            SimulatorToolbox::textGenerator().text(
+                Texts::TXT_INTERP_SETTING_BUSTRACE_BINARY).str());
+
     settings_["rf_tracking"] =
         new TemplatedSimulatorSetting<BooleanSetting, SetRFTracking>(
             SimulatorToolbox::textGenerator().text(
@@ -761,6 +852,19 @@ SettingCommand::SettingCommand() :
             PositiveIntegerSetting, SetCallHistoryLength>(
                 "Sets the length of last procedure transfers to save in\n"
                 "memory for call trace printing.");
+
+    settings_["core_count"] =
+        new TemplatedSimulatorSetting<
+            PositiveIntegerSetting, SetCoreCount>(
+                "Sets the number of instances of the loaded machine to\n"
+                "simulate in lockstep. Select the core to inspect or to\n"
+                "load a program for with the 'core' command.");
+
+    settings_["simulation_threads"] =
+        new TemplatedSimulatorSetting<
+            PositiveIntegerSetting, SetSimulationThreads>(
+                "Sets the number of host threads used to simulate the\n"
+                "cores of a multi-core simulation.");
 }
 
 /**
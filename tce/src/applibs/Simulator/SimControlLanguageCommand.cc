@@ -43,6 +43,8 @@
 #include "StopPointManager.hh"
 #include "Conversion.hh"
 #include "TclConditionScript.hh"
+#include "StateConditionScript.hh"
+#include "StateExpression.hh"
 #include "ExpressionScript.hh"
 #include "TclInterpreter.hh"
 #include "GlobalScope.hh"
@@ -623,7 +625,14 @@ SimControlLanguageCommand::parseBreakpoint(
         if (condition.script().at(0) == "1") {
             target.removeCondition();
         } else {
-            target.setCondition(condition);
+            StateExpression* compiled = StateExpression::compileCondition(
+                condition.script().at(0),
+                condition.lastResult().stringValue(), *this);
+            if (compiled != NULL) {
+                target.setCondition(StateConditionScript(condition, compiled));
+            } else {
+                target.setCondition(condition);
+            }
         }
     }
 
@@ -454,6 +454,7 @@ SimProgramBuilder::processInstruction(
             throw ip;
         }
     }
+    processedInstruction->predecode();
     return processedInstruction;
 }
 
@@ -32,6 +32,11 @@
  */
 
 #include <climits>
+#include <algorithm>
+
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
 
 #include "SimulationController.hh"
 #include "Machine.hh"
@@ -91,12 +96,19 @@ SimulationController::SimulationController(
     bool fuResourceConflictDetection,
     bool detailedSimulation) :
     TTASimulationController(frontend, machine, program),
-    tmpExecutedInstructions_(1) {
+    workerCount_(1), cycleStart_(NULL), cycleEnd_(NULL),
+    stopWorkers_(false) {
+
+    const int coreCount = frontend.coreCount();
+    const int selectedCore = frontend.selectedCore();
+    lastExecutedInstruction_.resize(coreCount, 0);
+    tmpExecutedInstructions_.resize(coreCount, 0);
+    coreErrors_.resize(coreCount);
 
     if (fuResourceConflictDetection)
         buildFUResourceConflictDetectors(machine);
 
-    for (int i = 0; i < 1; ++i) {
+    for (int i = 0; i < coreCount; ++i) {
         frontend_.selectCore(i);
         MachineStateBuilder builder(detailedSimulation);
         MachineState* machineState = NULL;
@@ -115,17 +127,30 @@ SimulationController::SimulationController(
         }   
         machineStates_.push_back(machineState);
     }
-    frontend_.selectCore(0);
+    frontend_.selectCore(selectedCore);
     
     SimProgramBuilder programBuilder;
-    for (int i = 0; i < 1; ++i) {
+    for (int i = 0; i < coreCount; ++i) {
+        const Program& coreProgram = 
+            (i == 0) ? program : frontend.program(i);
         InstructionMemory* instructionMemory = 
-            programBuilder.build(program, *machineStates_[i]);
+            programBuilder.build(coreProgram, *machineStates_[i]);
         instructionMemories_.push_back(instructionMemory);
+        corePrograms_.push_back(&coreProgram);
+        initialPCs_.push_back(coreProgram.entryAddress().location());
     }  
 
-    findExitPoints(program, machine);
+    findExitPoints(machine);
     reset();
+
+    // memory access tracking records the accesses in the shared proxies,
+    // thus it is not safe to run the cores concurrently with it
+    if (coreCount > 1 && !frontend.memoryAccessTracking()) {
+        startWorkers(
+            std::min(
+                frontend.simulationThreadCount(), 
+                static_cast<unsigned>(coreCount)));
+    }
 }
 
 /**
@@ -133,6 +158,8 @@ SimulationController::SimulationController(
  */
 SimulationController::~SimulationController() {
 
+    stopWorkers();
+
     SequenceTools::deleteAllItems(machineStates_);
     SequenceTools::deleteAllItems(instructionMemories_);
     SequenceTools::deleteAllItems(conflictDetectorVector_);
@@ -150,6 +177,11 @@ SimulationController::machineState(int core) {
 /**
  * Simulates a cycle.
  *
+ * The cores are advanced either in the calling thread or in the worker
+ * threads. The shared memories, the FU conflict detectors and the
+ * simulation events are handled only after all the cores have simulated
+ * the cycle.
+ *
  * @return false in case there are no more instructions to execute,
  * that is, the simulation ended sucessfully, true in case there are
  * more instructions to execute.
@@ -159,69 +191,33 @@ SimulationController::simulateCycle() {
 
     tmpExecutedInstructions_ = lastExecutedInstruction_;
 
+    if (workerCount_ > 1) {
+        cycleStart_->wait();
+        simulateCoresOfWorker(0);
+        cycleEnd_->wait();
+    } else {
+        simulateCoresOfWorker(0);
+    }
+
     // The number of cores that have reached the exit function,
     // use this to stop automatically after all of them have
     // called it.
-    unsigned finishedCoreCount = 0;
-    bool finished = false;
-    for (int core = 0; core < 1; ++core) {
-        MachineState* machineState = machineStates_[core];
-
-        if (machineState->isFinished()) {
-            ++finishedCoreCount;
-            continue;
-        }
-        
-        GCUState& gcu = machineState->gcuState();
-        const InstructionAddress& pc = gcu.programCounter();
-
-        MemorySystem* memorySystem = &frontend_.memorySystem(core);
-        try {
-            machineState->clearBuses();
-
-            ExecutableInstruction* instruction = 
-                &(instructionMemories_[core]->instructionAt(pc));
-
-            instruction->execute();
-
-            tmpExecutedInstructions_[core] = pc;
-        
-            machineState->endClockOfAllFUStates();
-
-            if (!gcu.isIdle()) {
-                gcu.endClock();
-            }
-            
-            memorySystem->advanceClockOfLocalMemories();
-            machineState->advanceClockOfAllFUStates();
-
-            ++gcu.programCounter();
-            if (!gcu.isIdle())
-                gcu.advanceClock();
-
-            machineState->advanceClockOfAllGuardStates();
-            machineState->advanceClockOfAllLongImmediateUnitStates();
-
-            // check if the instruction was a return point from the program or
-            // the next executed instruction would be sequentially over the
-            // instruction space (PC+1 would overflow out of the program)
-            if (instruction->isExitPoint() || 
-                gcu.programCounter() == firstIllegalInstructionIndex_) {
-                machineState->setFinished();
-                ++finishedCoreCount;
-            } 
-        } catch (const Exception& e) {
+    std::size_t finishedCoreCount = 0;
+    for (std::size_t core = 0; core < machineStates_.size(); ++core) {
+        if (!coreErrors_[core].empty()) {
+            const std::string errorMessage = coreErrors_[core];
+            std::fill(coreErrors_.begin(), coreErrors_.end(), "");
             frontend_.selectCore(core);
             frontend_.reportSimulatedProgramError(
-                SimulatorFrontend::RES_FATAL,
-                e.errorMessage());
+                SimulatorFrontend::RES_FATAL, errorMessage);
             prepareToStop(SRE_RUNTIME_ERROR);
             return false;
-        } 
+        }
+        if (machineStates_[core]->isFinished())
+            ++finishedCoreCount;
     }
     
-    if (finishedCoreCount == 1)
-        finished = true;
+    const bool finished = finishedCoreCount == machineStates_.size();
 
     // assume all cores have identical memory systems, thus it's enough
     // to advance the simulation clock only once for the first core's
@@ -254,6 +250,158 @@ SimulationController::simulateCycle() {
     return true;
 }
 
+/**
+ * Simulates a cycle of a single core.
+ *
+ * Touches only the state of the given core and the write queues of the
+ * shared memories, so the cores can be simulated concurrently. Runtime
+ * errors are stored to be reported by the calling thread.
+ *
+ * @param core The core to simulate.
+ * @return True if the core finished its program.
+ */
+bool
+SimulationController::simulateCoreCycle(int core) {
+
+    MachineState* machineState = machineStates_[core];
+    if (machineState->isFinished())
+        return true;
+
+    GCUState& gcu = machineState->gcuState();
+    const InstructionAddress& pc = gcu.programCounter();
+
+    MemorySystem* memorySystem = &frontend_.memorySystem(core);
+    try {
+        machineState->clearBuses();
+
+        ExecutableInstruction* instruction = 
+            &(instructionMemories_[core]->instructionAt(pc));
+
+        instruction->execute();
+
+        tmpExecutedInstructions_[core] = pc;
+        
+        machineState->endClockOfAllFUStates();
+
+        if (!gcu.isIdle()) {
+            gcu.endClock();
+        }
+            
+        memorySystem->advanceClockOfLocalMemories();
+        machineState->advanceClockOfAllFUStates();
+
+        ++gcu.programCounter();
+        if (!gcu.isIdle())
+            gcu.advanceClock();
+
+        machineState->advanceClockOfAllGuardStates();
+        machineState->advanceClockOfAllLongImmediateUnitStates();
+
+        // check if the instruction was a return point from the program or
+        // the next executed instruction would be sequentially over the
+        // instruction space (PC+1 would overflow out of the program)
+        if (instruction->isExitPoint() || 
+            gcu.programCounter() == firstIllegalInstructionIndices_[core]) {
+            machineState->setFinished();
+            return true;
+        } 
+    } catch (const Exception& e) {
+        coreErrors_[core] = e.errorMessage();
+    } 
+    return false;
+}
+
+/**
+ * Simulates a cycle of the cores assigned to the given worker.
+ *
+ * Core i is simulated by the worker i modulo the worker count.
+ *
+ * @param worker The index of the worker, 0 is the calling thread.
+ */
+void
+SimulationController::simulateCoresOfWorker(unsigned worker) {
+    const std::size_t coreCount = machineStates_.size();
+    for (std::size_t core = worker; core < coreCount; core += workerCount_) {
+        simulateCoreCycle(core);
+    }
+}
+
+/**
+ * The main loop of a worker thread.
+ *
+ * Simulates a cycle of its cores each time the calling thread enters
+ * simulateCycle().
+ *
+ * @param worker The index of the worker.
+ */
+void
+SimulationController::runWorker(unsigned worker) {
+    while (true) {
+        cycleStart_->wait();
+        if (stopWorkers_)
+            return;
+        simulateCoresOfWorker(worker);
+        cycleEnd_->wait();
+    }
+}
+
+/**
+ * Starts the worker threads used to simulate the cores.
+ *
+ * The shared memories are switched to accept writes from multiple threads.
+ *
+ * @param threadCount The number of threads simulating the cores,
+ *                    including the calling thread.
+ */
+void
+SimulationController::startWorkers(unsigned threadCount) {
+    if (threadCount < 2)
+        return;
+
+    MemorySystem& memorySystem = frontend_.memorySystem(0);
+    for (unsigned i = 0; i < memorySystem.memoryCount(); ++i) {
+        if (memorySystem.addressSpace(i).isShared())
+            memorySystem.memory(i)->setConcurrentWrites(true);
+    }
+
+    workerCount_ = threadCount;
+    stopWorkers_ = false;
+    cycleStart_ = new boost::barrier(workerCount_);
+    cycleEnd_ = new boost::barrier(workerCount_);
+    for (unsigned worker = 1; worker < workerCount_; ++worker) {
+        workers_.push_back(
+            new boost::thread(
+                boost::bind(&SimulationController::runWorker, this, worker)));
+    }
+}
+
+/**
+ * Stops and joins the worker threads.
+ */
+void
+SimulationController::stopWorkers() {
+    if (workerCount_ < 2)
+        return;
+
+    stopWorkers_ = true;
+    cycleStart_->wait();
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->join();
+    }
+    SequenceTools::deleteAllItems(workers_);
+    delete cycleStart_;
+    cycleStart_ = NULL;
+    delete cycleEnd_;
+    cycleEnd_ = NULL;
+    workerCount_ = 1;
+
+    MemorySystem& memorySystem = frontend_.memorySystem(0);
+    for (unsigned i = 0; i < memorySystem.memoryCount(); ++i) {
+        if (memorySystem.addressSpace(i).isShared())
+            memorySystem.memory(i)->setConcurrentWrites(false);
+    }
+}
+
 /**
  * Advance simulation by a given amout of cycles.
  *
@@ -300,9 +448,10 @@ SimulationController::next(int count) {
     state_ = STA_RUNNING;
 
     bool inCalledProcedure = false;
+    const Program& program = *corePrograms_.at(frontend_.selectedCore());
     const Procedure& procedureWhereStartedStepping = 
         dynamic_cast<const Procedure&>(
-            program_.instructionAt(programCounter()).parent());
+            program.instructionAt(programCounter()).parent());
 
     int counter = 0;
     while (!stopRequested_ && counter < count) {
@@ -317,7 +466,7 @@ SimulationController::next(int count) {
             } else {
                 const Procedure& currentProcedure =
                     dynamic_cast<const Procedure&>(
-                        program_.instructionAt(programCounter()).parent());
+                        program.instructionAt(programCounter()).parent());
                 inCalledProcedure = 
                     (&procedureWhereStartedStepping != &currentProcedure);
             }
@@ -394,20 +543,26 @@ SimulationController::runUntil(UIntWord address) {
         SimulationEventHandler::SE_SIMULATION_STOPPED);
 }
 
+/**
+ * Marks the exit points of the program of each core to its instruction
+ * memory.
+ */
 void
-SimulationController::findExitPoints(
-    const TTAProgram::Program& program,
-    const TTAMachine::Machine& machine) {
-
-    std::set<InstructionAddress> exitPoints_ =
-        findProgramExitPoints(program, machine);
-
-    for (std::set<InstructionAddress>::iterator it = exitPoints_.begin();
-         it != exitPoints_.end(); ++it) {
-        for (std::size_t i = 0; i < instructionMemories_.size(); ++i) {
-            instructionMemories_[i]->instructionAt(*it).setExitPoint(true);
+SimulationController::findExitPoints(const TTAMachine::Machine& machine) {
+
+    firstIllegalInstructionIndices_.clear();
+    for (std::size_t core = 0; core < instructionMemories_.size(); ++core) {
+        std::set<InstructionAddress> exitPoints_ =
+            findProgramExitPoints(*corePrograms_[core], machine);
+        firstIllegalInstructionIndices_.push_back(
+            firstIllegalInstructionIndex_);
+
+        for (std::set<InstructionAddress>::iterator it = exitPoints_.begin();
+             it != exitPoints_.end(); ++it) {
+            instructionMemories_[core]->instructionAt(*it).setExitPoint(true);
         }
     }
+    firstIllegalInstructionIndex_ = firstIllegalInstructionIndices_.at(0);
 }
 
 /**
@@ -425,8 +580,9 @@ SimulationController::reset() {
     clockCount_ = 0;
     state_ = STA_INITIALIZED;
 
-    for (int core = 0; core < 1; ++core) {
-        machineStates_.at(core)->gcuState().programCounter() = initialPC_;
+    for (std::size_t core = 0; core < machineStates_.size(); ++core) {
+        machineStates_.at(core)->gcuState().programCounter() = 
+            initialPCs_.at(core);
         machineStates_.at(core)->setFinished(false);
         machineStates_.at(core)->resetAllFUs();
         instructionMemories_.at(core)->resetExecutionCounts();
@@ -523,7 +679,7 @@ SimulationController::buildFUResourceConflictDetectors(
     const TTAMachine::Machine& machine) {
 
 
-    for (int core = 0; core < 1; ++core) {
+    for (int core = 0; core < frontend_.coreCount(); ++core) {
         const TTAMachine::Machine::FunctionUnitNavigator nav = 
             machine.functionUnitNavigator();
 
@@ -34,12 +34,23 @@
 #ifndef SIMULATION_CONTROLLER_HH
 #define SIMULATION_CONTROLLER_HH
 
+#include <string>
+#include <vector>
+
 #include "TTASimulationController.hh"
 
+namespace boost {
+    class thread;
+    class barrier;
+}
+
 /**
  * Controls the simulation running in stand-alone mode.
  *
- * Supports also homogeneous multicore simulation when ADF's core-count > 1.
+ * Supports also homogeneous multicore simulation when the frontend's core
+ * count is larger than one. The cores are simulated in lockstep, optionally
+ * divided between a set of host threads which synchronize at the end of
+ * each simulated cycle.
  *
  * Owns and is the main client of the machine state model.
  */
@@ -83,6 +94,7 @@ public:
 
 protected:
     virtual bool simulateCycle();
+    bool simulateCoreCycle(int core);
 
     typedef std::vector<MachineState*> MachineStateContainer;
 
@@ -98,9 +110,12 @@ private:
     SimulationController& operator=(const SimulationController&);
 
     void buildFUResourceConflictDetectors(const TTAMachine::Machine& machine);
-    void findExitPoints(
-        const TTAProgram::Program& program,
-        const TTAMachine::Machine& machine);
+    void findExitPoints(const TTAMachine::Machine& machine);
+
+    void startWorkers(unsigned threadCount);
+    void stopWorkers();
+    void runWorker(unsigned worker);
+    void simulateCoresOfWorker(unsigned worker);
 
     MachineState& selectedMachineState();
     InstructionMemory& selectedInstructionMemory();
@@ -112,6 +127,26 @@ private:
     std::vector<FUResourceConflictDetector*> conflictDetectorVector_;
     /// Temporary place for lastExecuted Instruction.
     std::vector<InstructionAddress> tmpExecutedInstructions_;
+    /// The programs the cores execute.
+    std::vector<const TTAProgram::Program*> corePrograms_;
+    /// The entry addresses of the programs of the cores.
+    std::vector<InstructionAddress> initialPCs_;
+    /// The first illegal instruction index of the program of each core.
+    std::vector<InstructionAddress> firstIllegalInstructionIndices_;
+    /// Runtime errors the cores produced in the simulated cycle, empty
+    /// string if none.
+    std::vector<std::string> coreErrors_;
+    /// The host threads simulating the cores, the calling thread is not
+    /// included.
+    std::vector<boost::thread*> workers_;
+    /// Number of threads simulating the cores, including the calling one.
+    unsigned workerCount_;
+    /// Releases the workers to simulate the next cycle.
+    boost::barrier* cycleStart_;
+    /// Waits until all the workers have simulated the cycle.
+    boost::barrier* cycleEnd_;
+    /// Set to make the workers exit at the next cycle start.
+    bool stopWorkers_;
 
 };
 
@@ -31,6 +31,7 @@
  * @note rating: red
  */
 
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -45,6 +46,7 @@ POP_CLANG_DIAGS
 #include <boost/thread.hpp>
 #include <boost/bind.hpp>
 #include <boost/version.hpp>
+#include <boost/format.hpp>
 
 #include "Binary.hh"
 #include "BinaryReader.hh"
@@ -89,6 +91,7 @@ POP_CLANG_DIAGS
 #include "SimulationStatistics.hh"
 #include "RFAccessTracker.hh"
 #include "BusTracker.hh"
+#include "BinaryBusTraceWriter.hh"
 #include "InstructionMemory.hh"
 #include "ExecutableInstruction.hh"
 #include "ProcedureTransferTracker.hh"
@@ -123,7 +126,7 @@ SimulatorFrontend::SimulatorFrontend(SimulationType backendType) :
     programFileName_(""), programOwnedByFrontend_(false), 
     currentBackend_(backendType),
     disassembler_(NULL), executionTracing_(false),
-    busTracing_(false), 
+    busTracing_(false), busTraceBinary_(false),
     rfAccessTracing_(false), procedureTransferTracing_(false), 
     saveProfileData_(false), saveUtilizationData_(false),
     stopPointManager_(NULL), tpef_(NULL),
@@ -132,7 +135,9 @@ SimulatorFrontend::SimulatorFrontend(SimulationType backendType) :
     staticCompilation_(true), traceFileNameSetByUser_(false), outputStream_(0),
     memoryAccessTracking_(false), eventHandler_(NULL), lastRunCycleCount_(0),
     lastRunTime_(0.0), simulationTimeout_(0), leaveCompiledDirty_(false),
-    callHistoryLength_(0), zeroFillMemoriesOnReset_(true) {
+    callHistoryLength_(0), zeroFillMemoriesOnReset_(true),
+    detailedSimulation_(false), coreCount_(1), selectedCore_(0),
+    simulationThreadCount_(1) {
 
     if (backendType == SIM_COMPILED) {
         setCompiledSimulation(true);
@@ -160,6 +165,7 @@ SimulatorFrontend::~SimulatorFrontend() {
         currentProgram_ = NULL;
         programFileName_ = "";
     }
+    deleteCorePrograms();
 
     delete disassembler_;
     disassembler_ = NULL;
@@ -237,6 +243,7 @@ SimulatorFrontend::loadMachine(const Machine& machine) {
         delete currentProgram_;
         currentProgram_ = NULL;
     }
+    deleteCorePrograms();
     delete simCon_;
     simCon_ = NULL;
 
@@ -269,16 +276,36 @@ SimulatorFrontend::machine() const {
 /**
  * Returns a read-only reference to the currently loaded program.
  *
+ * @param core The core of which program to return, -1 for the selected one.
+ *             Cores without a program of their own run the program of
+ *             the first core.
  * @return A read-only reference to the currently loaded program, if none,
  *         returns a NullProgram instance.
  */
 const Program&
-SimulatorFrontend::program() const {
+SimulatorFrontend::program(int core) const {
+    if (core == -1) 
+        core = selectedCore_;
+    if (core > 0 && static_cast<std::size_t>(core) < corePrograms_.size() &&
+        corePrograms_[core] != NULL) {
+        return *corePrograms_[core];
+    }
     if (currentProgram_ == NULL) 
         return NullProgram::instance();
     return *currentProgram_;
 }
 
+/**
+ * Returns the name of the loaded program file.
+ *
+ * @return The file name, an empty string if the program was not loaded
+ *         from a file.
+ */
+const std::string&
+SimulatorFrontend::programFileName() const {
+    return programFileName_;
+}
+
 /**
  * Loads a new program to be simulated from a TPEF file.
  *
@@ -303,6 +330,11 @@ SimulatorFrontend::loadProgram(const std::string& fileName) {
             __FILE__, __LINE__, __func__,
             "Cannot load a program without loading a machine first.");
 
+    if (selectedCore_ != 0) {
+        loadCoreProgram(fileName);
+        return;
+    }
+
     SimulatorTextGenerator& textGen = SimulatorToolbox::textGenerator();
     
     if (!FileSystem::fileExists(fileName)) {
@@ -429,6 +461,197 @@ SimulatorFrontend::loadProgram(const std::string& fileName) {
     initializeTracing();
 }
 
+/**
+ * Loads a program for the currently selected, other than the first, core.
+ *
+ * The program of the first core must have been loaded before. Cores which
+ * do not get a program of their own run the program of the first core.
+ * Reloading a core program restarts the simulation of all cores.
+ *
+ * @param fileName The name of the TPEF file to be loaded.
+ * @exception FileNotFound If the file cannot be found.
+ * @exception IllegalProgram If the TPEF was erroneus or the program invalid.
+ */
+void
+SimulatorFrontend::loadCoreProgram(const std::string& fileName) {
+
+    assert(selectedCore_ > 0 && selectedCore_ < coreCount_);
+
+    SimulatorTextGenerator& textGen = SimulatorToolbox::textGenerator();
+
+    if (currentProgram_ == NULL) {
+        throw Exception(
+            __FILE__, __LINE__, __func__,
+            "Load the program of core 0 before the other cores.");
+    }
+
+    if (!FileSystem::fileExists(fileName)) {
+        throw FileNotFound(
+            __FILE__, __LINE__, __func__, 
+            textGen.text(Texts::TXT_FILE_NOT_FOUND).str());
+    }
+
+    if (!FileSystem::fileIsReadable(fileName)) {
+        throw IOException(__FILE__, __LINE__, __func__, "File not readable.");
+    }
+
+    BinaryStream binaryStream(fileName);
+    TPEF::Binary* tpef = NULL;
+    TTAProgram::Program* program = NULL;
+
+    try {
+        tpef = BinaryReader::readBinary(binaryStream);
+        TPEFProgramFactory factory(*tpef, *currentMachine_);
+        program = factory.build();
+        program->finalize();
+        delete tpef;
+        tpef = NULL;
+    } catch (const Exception& e) {
+        delete tpef;
+        std::string errorMsg = textGen.text(
+            Texts::TXT_UNABLE_TO_LOAD_PROGRAM).str();
+
+        if (e.errorMessage() != "")
+            errorMsg += " " + e.errorMessage();
+
+        IllegalProgram illegp(__FILE__, __LINE__, __func__, errorMsg);
+        illegp.setCause(e);
+        throw illegp;
+    }
+
+    POMValidator validator(*program);
+    std::set<POMValidator::ErrorCode> checks;
+    checks.insert(POMValidator::CONNECTION_MISSING);
+    checks.insert(POMValidator::LONG_IMMEDIATE_NOT_SUPPORTED);
+    checks.insert(POMValidator::SIMULATION_NOT_POSSIBLE);
+
+    std::unique_ptr<POMValidatorResults> results(validator.validate(checks));
+    if (results->errorCount() > 0) {
+        std::string errorMsg = textGen.text(
+            Texts::TXT_UNABLE_TO_LOAD_PROGRAM).str();
+        for (int i = 0; i < results->errorCount(); i++) {
+            errorMsg += "\n" + results->error(i).second;
+        }
+        delete program;
+        throw IllegalProgram(__FILE__, __LINE__, __func__, errorMsg);
+    }
+
+    delete corePrograms_.at(selectedCore_);
+    corePrograms_.at(selectedCore_) = program;
+
+    delete disassembler_;
+    disassembler_ = NULL;
+
+    initializeSimulation();
+    initializeDataMemories();
+    initializeTracing();
+}
+
+/**
+ * Deletes the programs loaded for the other than the first core.
+ */
+void
+SimulatorFrontend::deleteCorePrograms() {
+    for (std::size_t i = 0; i < corePrograms_.size(); ++i) {
+        delete corePrograms_[i];
+        corePrograms_[i] = NULL;
+    }
+}
+
+/**
+ * Selects the core the state queries and debugger commands refer to.
+ *
+ * @param core The index of the core.
+ * @exception OutOfRange If there is no such core.
+ */
+void
+SimulatorFrontend::selectCore(int core) {
+    if (core < 0 || core >= coreCount_) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format("No core %d, the simulated machine has %d "
+                           "core(s).") % core % coreCount_).str());
+    }
+    if (core == selectedCore_)
+        return;
+
+    selectedCore_ = core;
+    delete disassembler_;
+    disassembler_ = NULL;
+}
+
+/**
+ * Sets the number of simulated cores.
+ *
+ * All the cores are instances of the loaded machine which are simulated
+ * in lockstep. Address spaces marked as shared in the machine are shared
+ * by all the cores, the rest are private to each core. Changing the count
+ * restarts the simulation of an already loaded program.
+ *
+ * @param count The number of cores, at least 1.
+ * @exception OutOfRange If the count is less than 1.
+ */
+void
+SimulatorFrontend::setCoreCount(int count) {
+    if (count < 1) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "The core count must be at least 1.");
+    }
+    if (count == coreCount_)
+        return;
+
+    if (count < coreCount_) {
+        for (std::size_t i = count; i < corePrograms_.size(); ++i) {
+            delete corePrograms_[i];
+        }
+    }
+    corePrograms_.resize(count, NULL);
+    coreCount_ = count;
+    if (selectedCore_ >= coreCount_)
+        selectCore(0);
+
+    if (currentMachine_ == NULL)
+        return;
+
+    finishSimulation();
+    delete simCon_;
+    simCon_ = NULL;
+    SequenceTools::deleteAllItems(memorySystems_);
+    initializeMemorySystem();
+    setupCallHistoryTracking();
+
+    if (currentProgram_ != NULL) {
+        initializeSimulation();
+        initializeDataMemories();
+        initializeTracing();
+    }
+}
+
+/**
+ * Sets the number of host threads used to simulate the cores.
+ *
+ * Threads are used only when more than one core is simulated. Each thread
+ * advances a fixed subset of the cores, the threads synchronize once per
+ * simulated cycle. Changing the count restarts a loaded multi-core
+ * simulation.
+ *
+ * @param threads The number of threads, 1 simulates all the cores in
+ *                the calling thread.
+ */
+void
+SimulatorFrontend::setSimulationThreadCount(unsigned threads) {
+    simulationThreadCount_ = std::max(1u, threads);
+    if (currentMachine_ != NULL && currentProgram_ != NULL &&
+        coreCount_ > 1) {
+        // the trackers refer to the state of the old simulation
+        finishSimulation();
+        initializeSimulation();
+        initializeDataMemories();
+        initializeTracing();
+    }
+}
+
 /**
  * Resets and writes initial data to the memory system stored in simulation 
  * controller from loaded TPEF.
@@ -445,21 +668,21 @@ SimulatorFrontend::initializeDataMemories(
     if (currentProgram_ == NULL || simCon_ == NULL)
         return;
 
-    memorySystem().resetAllMemories();
-    if (zeroFillMemoriesOnReset_)
-        memorySystem().fillAllMemoriesWithZero();
+    for (int core = 0; core < coreCount_; ++core) {
+        memorySystem(core).resetAllMemories();
+        if (zeroFillMemoriesOnReset_)
+            memorySystem(core).fillAllMemoriesWithZero();
+    }
 
-    const int dataSections = currentProgram_->dataMemoryCount();
+    for (int core = 0; core < coreCount_; ++core) {
+        const Program& coreProgram = program(core);
+        const int dataSections = coreProgram.dataMemoryCount();
 
-    if (dataSections < 0) 
-        return;
-
-    for (int core = 0; core < 1; ++core) {
         // data memory initialization
         for (int i = 0; i < dataSections; ++i) {
 
             // initialize the data memory
-            const DataMemory& data = currentProgram_->dataMemory(i);
+            const DataMemory& data = coreProgram.dataMemory(i);
             const std::string addressSpaceName = 
                 data.addressSpace().name();
 
@@ -568,6 +791,7 @@ SimulatorFrontend::loadMachine(const std::string& fileName) {
         delete currentProgram_;
         currentProgram_ = NULL;
     }
+    deleteCorePrograms();
     delete simCon_;
     simCon_ = NULL;
 
@@ -658,6 +882,13 @@ SimulatorFrontend::initializeSimulation() {
 
     delete simCon_;
     simCon_ = NULL;
+
+    if (coreCount_ > 1 && currentBackend_ != SIM_NORMAL) {
+        throw Exception(
+            __FILE__, __LINE__, __func__,
+            "Multi-core simulation is supported only by the interpretive "
+            "simulation engine.");
+    }
     switch(currentBackend_) {
     case SIM_REMOTE:    
         simCon_ = 
@@ -1073,7 +1304,7 @@ std::string
 SimulatorFrontend::disassembleInstruction(UIntWord instructionAddress) const {
 
     const Instruction& theInstruction =
-        currentProgram_->instructionAt(instructionAddress);
+        program().instructionAt(instructionAddress);
     const Procedure& currentProc = dynamic_cast<const Procedure&>(
         theInstruction.parent());
 
@@ -1114,14 +1345,14 @@ SimulatorFrontend::programLocationDescription() const {
     InstructionAddress instructionAddress = programCounter();
 
     const InstructionAddress programLastAddress =
-        currentProgram_->lastProcedure().endAddress().location();
+        program().lastProcedure().endAddress().location();
 
     if (instructionAddress >= programLastAddress) {
         return "";
     }
 
     const Instruction& theInstruction =
-        currentProgram_->instructionAt(instructionAddress);
+        program().instructionAt(instructionAddress);
     const Procedure& currentProc =
         dynamic_cast<const Procedure&>(theInstruction.parent());
 
@@ -1145,8 +1376,8 @@ SimulatorFrontend::programLocationDescription() const {
 /**
  * Initializes the disassembler.
  *
- * Creates a new POMDisassembler for the loaded program if it was not
- * loaded already.
+ * Creates a new POMDisassembler for the program of the selected core if
+ * it was not loaded already.
  */
 void
 SimulatorFrontend::initializeDisassembler() const {
@@ -1156,7 +1387,7 @@ SimulatorFrontend::initializeDisassembler() const {
         return;
     }
     disassembler_ =
-        POMDisassembler::disassembler(*currentMachine_, *currentProgram_);
+        POMDisassembler::disassembler(*currentMachine_, program());
 }
 
 /**
@@ -1211,11 +1442,12 @@ SimulatorFrontend::currentProcedure() const {
     assert(simCon_ != NULL);
     assert(currentProgram_ != NULL);  
     InstructionAddress address = programCounter();
-    if (address > currentProgram_->lastInstruction().address().location()) {
-        return currentProgram_->lastProcedure();
+    const Program& coreProgram = program();
+    if (address > coreProgram.lastInstruction().address().location()) {
+        return coreProgram.lastProcedure();
     } else {
         return dynamic_cast<const Procedure&>(
-            currentProgram_->instructionAt(programCounter()).parent());
+            coreProgram.instructionAt(programCounter()).parent());
     }
 }
 
@@ -1416,6 +1648,7 @@ SimulatorFrontend::initializeTracing() {
         procedureTransferTracing_ || saveProfileData_ || 
         saveUtilizationData_ || busTracing_) {
 
+        // Traces are collected from the first core only.
         int coreCount = 1;
         
         traceDBs_.resize(coreCount, NULL);
@@ -1495,6 +1728,8 @@ SimulatorFrontend::initializeTracing() {
                     busTraceFileName << ".core" << core;
 
                 busTraceFileName << ".bustrace";
+                if (busTraceBinary_)
+                    busTraceFileName << ".bin";
 
                 int runningNumber = 1;
                 while (FileSystem::fileExists(busTraceFileName)) {
@@ -1506,21 +1741,36 @@ SimulatorFrontend::initializeTracing() {
                         busTraceFileName << ".core" << core;
 
                     busTraceFileName << ".bustrace";
+                    if (busTraceBinary_)
+                        busTraceFileName << ".bin";
                     busTraceFileName << "." << runningNumber;
                     ++runningNumber;
                 } 
-        
-                std::ostream* busTraceStream =
-                    new std::ofstream(busTraceFileName.c_str(), std::ios::out);
-                if (!busTraceStream) {
-                    std::string errorMessage =
-                        "Unable to open bus trace file " + busTraceFileName +
-                        " for writing.";
-                    throw IOException(
-                        __FILE__, __LINE__, __func__, errorMessage);
+
+                if (busTraceBinary_) {
+                    // the writer throws IOException if the file cannot
+                    // be created
+                    busTrackers_[core] =
+                        new BusTracker(
+                            *this,
+                            new BinaryBusTraceWriter(
+                                busTraceFileName,
+                                BusTracker::busNames(*this),
+                                BusTracker::busWidths(*this)));
+                } else {
+                    std::ostream* busTraceStream =
+                        new std::ofstream(
+                            busTraceFileName.c_str(), std::ios::out);
+                    if (!busTraceStream) {
+                        std::string errorMessage =
+                            "Unable to open bus trace file " +
+                            busTraceFileName + " for writing.";
+                        throw IOException(
+                            __FILE__, __LINE__, __func__, errorMessage);
+                    }
+                    busTrackers_[core] = 
+                        new BusTracker(*this, busTraceStream);
                 }
-                busTrackers_[core] = 
-                    new BusTracker(*this, busTraceStream);
             }
         }
     }
@@ -1702,7 +1952,7 @@ SimulatorFrontend::initializeMemorySystem() {
     const Machine& machine = *currentMachine_;
     MemorySystem* firstMemorySystem = NULL;
 
-    for (int core = 0; core < 1; ++core) {
+    for (int core = 0; core < coreCount_; ++core) {
 
         MemorySystem* memorySystem_ = new MemorySystem(machine);
 
@@ -1809,6 +2059,16 @@ SimulatorFrontend::busTracing() const {
     return busTracing_;
 }
 
+/**
+ * Returns true in case the bus trace is written in the binary format.
+ *
+ * @return True in case the bus trace is binary.
+ */
+bool
+SimulatorFrontend::busTraceBinary() const {
+    return busTraceBinary_;
+}
+
 /**
  * Returns true in case register file access tracing is enabled.
  *
@@ -1911,6 +2171,19 @@ SimulatorFrontend::setBusTracing(bool value) {
     busTracing_ = value;
 }
 
+/**
+ * Sets the format of the bus trace.
+ *
+ * The binary trace is written without formatting the values, and can be
+ * converted to the text format with ttasim-bustrace.
+ *
+ * @param value Is the bus trace written in the binary format.
+ */
+void
+SimulatorFrontend::setBusTraceBinary(bool value) {
+    busTraceBinary_ = value;
+}
+
 /**
  * Sets the register file access tracing on or off.
  *
@@ -2156,7 +2429,7 @@ SimulatorFrontend::utilizationStatistics(int core) {
     if (core == -1) 
         core = selectedCore();
 
-    utilizationStats_.resize(1);
+    utilizationStats_.resize(coreCount_, NULL);
 
     UtilizationStats* utilizationStats = utilizationStats_.at(core);
 
@@ -2165,7 +2438,7 @@ SimulatorFrontend::utilizationStatistics(int core) {
         if (!isCompiledSimulation()) {
             utilizationStats = new UtilizationStats();
             SimulationStatistics stats(
-                *currentProgram_, 
+                program(core), 
                 dynamic_cast<SimulationController*>(
                     simCon_)->instructionMemory(core));
             stats.addStatistics(*utilizationStats);
@@ -2380,8 +2653,8 @@ SimulatorFrontend::setupCallHistoryTracking() {
         SequenceTools::deleteAllItems(callPathTrackers_);
         return;
     } else {
-        for (int core = 0; core < 1; 
-             ++core) {
+        SequenceTools::deleteAllItems(callPathTrackers_);
+        for (int core = 0; core < coreCount_; ++core) {
             CallPathTracker* tracker = 
                 new CallPathTracker(*this, core, callHistoryLength_);
             callPathTrackers_.push_back(tracker);
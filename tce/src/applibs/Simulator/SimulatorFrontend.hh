@@ -121,7 +121,8 @@ public:
     void loadProcessorConfiguration(const std::string& fileName);
 
     const TTAMachine::Machine& machine() const;
-    const TTAProgram::Program& program() const;
+    const TTAProgram::Program& program(int core=-1) const;
+    const std::string& programFileName() const;
 
     const SimValue& stateValue(std::string searchString);
 
@@ -160,6 +161,7 @@ public:
 
     bool executionTracing() const;
     bool busTracing() const;
+    bool busTraceBinary() const;
     bool rfAccessTracing() const;
     bool procedureTransferTracing() const;
     bool profileDataSaving() const;
@@ -171,6 +173,7 @@ public:
     void setCompiledSimulation(bool value);
     void setExecutionTracing(bool value);
     void setBusTracing(bool value);
+    void setBusTraceBinary(bool value);
     void setRFAccessTracing(bool value);
     void setProcedureTransferTracing(bool value);
     void setProfileDataSaving(bool value);
@@ -255,13 +258,17 @@ public:
     friend void timeoutThread(unsigned int timeout, SimulatorFrontend* simFE);
 
     int selectedCore() const {
-        return 0;
+        return selectedCore_;
     }
-    void selectCore(int core) {
-        if (core != 0) {
-            abortWithError("WiP.");
-        }
+    void selectCore(int core);
+
+    int coreCount() const { return coreCount_; }
+    void setCoreCount(int count);
+
+    unsigned simulationThreadCount() const {
+        return simulationThreadCount_;
     }
+    void setSimulationThreadCount(unsigned threads);
     bool compareState(SimulatorFrontend& other, std::ostream* differences=NULL);
 
     std::size_t callHistoryLength() const { return callHistoryLength_; }
@@ -276,6 +283,8 @@ protected:
     void initializeDisassembler() const;
     void initializeMemorySystem();
     void setControllerForMemories(RemoteController* con);
+    void loadCoreProgram(const std::string& fileName);
+    void deleteCorePrograms();
     bool hasStopReason(StopReason reason) const;
 
     void startTimer();
@@ -314,6 +323,8 @@ protected:
     /// Is bus tracing, i.e., storing the values of buses in each
     /// clock cycle enabled.
     bool busTracing_;
+    /// Is the bus trace written in the binary format instead of text.
+    bool busTraceBinary_;
     /// Is register file (concurrent) access tracking enabled.
     bool rfAccessTracing_;
     /// Is procedure transfer access tracking enabled.
@@ -401,5 +412,14 @@ protected:
     /// Set to true in case should build a detailed model which simulates
     /// FU stages, possibly with an external system-level model.
     bool detailedSimulation_;
+    /// The number of simulated cores, all instances of the loaded machine.
+    int coreCount_;
+    /// The core the state queries and the debugger commands refer to.
+    int selectedCore_;
+    /// The number of host threads used to advance the cores.
+    unsigned simulationThreadCount_;
+    /// Programs loaded for other than the first core. NULL if the core
+    /// runs the program of the first core.
+    std::vector<TTAProgram::Program*> corePrograms_;
 };
 #endif
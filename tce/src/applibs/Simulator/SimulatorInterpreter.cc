@@ -55,6 +55,7 @@
 #include "DisableBPCommand.hh"
 #include "NextiCommand.hh"
 #include "KillCommand.hh"
+#include "CoreCommand.hh"
 #include "MemDumpCommand.hh"
 #include "WatchCommand.hh"
 #include "CommandsCommand.hh"
@@ -104,6 +105,7 @@ SimulatorInterpreter::SimulatorInterpreter(
     addCustomCommand(new DisableBPCommand());    
     addCustomCommand(new NextiCommand());
     addCustomCommand(new KillCommand());
+    addCustomCommand(new CoreCommand());
     addCustomCommand(new MemDumpCommand());
     addCustomCommand(new MemWriteCommand());
     addCustomCommand(new WatchCommand());
@@ -444,6 +444,9 @@ SimulatorTextGenerator::SimulatorTextGenerator() {
     addText(Texts::TXT_INTERP_SETTING_BUSTRACE,             
             "Writing of the bus trace.");
 
+    addText(Texts::TXT_INTERP_SETTING_BUSTRACE_BINARY,
+            "Writing of the bus trace in the binary format.");
+
     addText(
         Texts::TXT_INTERP_SETTING_FU_CONFLICT_DETECTION,
         "Function unit resource conflict detection (disable for speedup).");
@@ -144,6 +144,7 @@ namespace Texts {
         ///< In case user tried to set a setting with illegal parameter.
         TXT_INTERP_SETTING_EXECTRACE,
         TXT_INTERP_SETTING_BUSTRACE,
+        TXT_INTERP_SETTING_BUSTRACE_BINARY,
         TXT_INTERP_SETTING_RFTRACKING,
         TXT_INTERP_SETTING_HISTORY_FILENAME,
         TXT_INTERP_SETTING_NEXT_INSTRUCTION_PRINTING,
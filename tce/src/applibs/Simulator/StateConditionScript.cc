@@ -0,0 +1,83 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file StateConditionScript.cc
+ *
+ * Definition of StateConditionScript class.
+ *
+ * @note rating: red
+ */
+
+#include "StateConditionScript.hh"
+#include "StateExpression.hh"
+
+/**
+ * Constructor.
+ *
+ * @param condition The condition the expression was compiled from.
+ * @param expression The compiled condition, becomes owned by the script.
+ */
+StateConditionScript::StateConditionScript(
+    const TclConditionScript& condition, StateExpression* expression) :
+    TclConditionScript(condition), expression_(expression) {
+}
+
+/**
+ * Copy constructor.
+ *
+ * @param source The script to copy.
+ */
+StateConditionScript::StateConditionScript(
+    const StateConditionScript& source) :
+    TclConditionScript(source),
+    expression_(new StateExpression(*source.expression_)) {
+}
+
+/**
+ * Destructor.
+ */
+StateConditionScript::~StateConditionScript() {
+    delete expression_;
+    expression_ = NULL;
+}
+
+/**
+ * Evaluates the compiled condition.
+ *
+ * @return True if the condition is true.
+ */
+bool
+StateConditionScript::conditionOk() {
+    return expression_->value() != 0;
+}
+
+/**
+ * Copies the condition script.
+ *
+ * @return A new instance which is identical to this.
+ */
+ConditionScript*
+StateConditionScript::copy() const {
+    return new StateConditionScript(*this);
+}
@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file StateConditionScript.hh
+ *
+ * Declaration of StateConditionScript class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_STATE_CONDITION_SCRIPT_HH
+#define TTA_STATE_CONDITION_SCRIPT_HH
+
+#include "TclConditionScript.hh"
+
+class StateExpression;
+
+/**
+ * A condition script that is evaluated as a compiled StateExpression
+ * instead of by the interpreter.
+ *
+ * The script of the original condition is kept for displaying.
+ */
+class StateConditionScript : public TclConditionScript {
+public:
+    StateConditionScript(
+        const TclConditionScript& condition, StateExpression* expression);
+    StateConditionScript(const StateConditionScript& source);
+    virtual ~StateConditionScript();
+
+    virtual bool conditionOk();
+
+    virtual ConditionScript* copy() const;
+
+private:
+    /// Assignment not allowed.
+    StateConditionScript& operator=(const StateConditionScript&);
+
+    /// The compiled condition.
+    StateExpression* expression_;
+};
+
+#endif
@@ -0,0 +1,709 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file StateExpression.cc
+ *
+ * Definition of StateExpression class.
+ *
+ * @note rating: red
+ */
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+#include "StateExpression.hh"
+#include "SimControlLanguageCommand.hh"
+#include "SimulatorFrontend.hh"
+#include "MachineState.hh"
+#include "PortState.hh"
+#include "StateData.hh"
+#include "Memory.hh"
+#include "Address.hh"
+#include "AddressSpace.hh"
+#include "NullAddressSpace.hh"
+#include "SimValue.hh"
+#include "StringTools.hh"
+#include "Exception.hh"
+
+/**
+ * Parses scripts to StateExpressions.
+ *
+ * The parse functions return NULL for scripts that cannot be compiled.
+ */
+class StateExpression::Parser {
+public:
+    Parser(SimControlLanguageCommand& command);
+
+    StateExpression* parseTerm(const std::string& term);
+    StateExpression* parseCondition(const std::string& condition);
+
+private:
+    bool tokenize(const std::string& condition);
+    bool parseInteger(const std::string& text, SLongWord& value) const;
+
+    StateExpression* parseRegister(const TokenList& words);
+    StateExpression* parsePort(const TokenList& words);
+    StateExpression* parseMemory(const TokenList& words);
+
+    StateExpression* parseOr();
+    StateExpression* parseAnd();
+    StateExpression* parseComparison();
+    StateExpression* parseNot();
+    StateExpression* parseOperand();
+
+    StateExpression* binary(
+        Kind kind, StateExpression* left, StateExpression* right) const;
+    bool accept(const std::string& token);
+
+    /// The command that compiles the expression.
+    SimControlLanguageCommand& command_;
+    /// The tokens of the parsed condition.
+    TokenList tokens_;
+    /// The index of the next token.
+    std::size_t position_;
+};
+
+/**
+ * Constructor.
+ *
+ * @param command The command that compiles the expression.
+ */
+StateExpression::Parser::Parser(SimControlLanguageCommand& command) :
+    command_(command), position_(0) {
+}
+
+/**
+ * Parses a term of a watch.
+ *
+ * @param term The term, a simulator command.
+ * @return The compiled term, or NULL.
+ */
+StateExpression*
+StateExpression::Parser::parseTerm(const std::string& term) {
+    const std::string specialCharacters = "$[]{}\"\\;#";
+    if (term.find_first_of(specialCharacters) != std::string::npos) {
+        return NULL;
+    }
+
+    TokenList words;
+    std::size_t i = 0;
+    while (i < term.size()) {
+        if (std::isspace(static_cast<unsigned char>(term[i]))) {
+            ++i;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < term.size() &&
+               !std::isspace(static_cast<unsigned char>(term[end]))) {
+            ++end;
+        }
+        words.push_back(term.substr(i, end - i));
+        i = end;
+    }
+
+    if (words.size() == 4 && words[0] == "info" && words[1] == "registers") {
+        return parseRegister(words);
+    } else if (words.size() == 4 && words[0] == "info" &&
+               words[1] == "ports") {
+        return parsePort(words);
+    } else if (words.size() > 1 && words[0] == "x") {
+        return parseMemory(words);
+    }
+    return NULL;
+}
+
+/**
+ * Parses a condition.
+ *
+ * @param condition The condition, a Tcl expression.
+ * @return The compiled condition, or NULL.
+ */
+StateExpression*
+StateExpression::Parser::parseCondition(const std::string& condition) {
+    if (!tokenize(condition) || tokens_.empty()) {
+        return NULL;
+    }
+    position_ = 0;
+    StateExpression* expression = parseOr();
+    if (expression != NULL && position_ != tokens_.size()) {
+        delete expression;
+        return NULL;
+    }
+    return expression;
+}
+
+/**
+ * Splits a condition to tokens.
+ *
+ * Commands in brackets are single tokens.
+ *
+ * @param condition The condition.
+ * @return False if the condition has characters the conditions compiled
+ * by the parser cannot have.
+ */
+bool
+StateExpression::Parser::tokenize(const std::string& condition) {
+    tokens_.clear();
+    std::size_t i = 0;
+    while (i < condition.size()) {
+        const char c = condition[i];
+        const char next = i + 1 < condition.size() ? condition[i + 1] : '\0';
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (c == '[') {
+            const std::size_t end = condition.find_first_of("[]", i + 1);
+            if (end == std::string::npos || condition[end] != ']') {
+                return false;
+            }
+            tokens_.push_back(condition.substr(i, end - i + 1));
+            i = end + 1;
+        } else if ((c == '&' && next == '&') || (c == '|' && next == '|') ||
+                   (c == '=' && next == '=') || (c == '!' && next == '=') ||
+                   (c == '<' && next == '=') || (c == '>' && next == '=')) {
+            tokens_.push_back(condition.substr(i, 2));
+            i += 2;
+        } else if (c == '(' || c == ')' || c == '!' || c == '<' || c == '>') {
+            tokens_.push_back(condition.substr(i, 1));
+            ++i;
+        } else if (std::isdigit(static_cast<unsigned char>(c)) ||
+                   (c == '-' &&
+                    std::isdigit(static_cast<unsigned char>(next)))) {
+            std::size_t end = i + 1;
+            while (end < condition.size() &&
+                   std::isalnum(static_cast<unsigned char>(condition[end]))) {
+                ++end;
+            }
+            tokens_.push_back(condition.substr(i, end - i));
+            i = end;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Parses an integer literal the way Tcl does.
+ *
+ * Decimal and hexadecimal literals are accepted. Literals with a leading
+ * zero are octal in Tcl and not accepted, neither are literals out of the
+ * range of the value, they are left for the interpreter to reject.
+ *
+ * @param text The literal.
+ * @param value The parsed value.
+ * @return True if the literal was parsed.
+ */
+bool
+StateExpression::Parser::parseInteger(
+    const std::string& text, SLongWord& value) const {
+
+    std::string digits = text;
+    if (!digits.empty() && digits[0] == '-') {
+        digits = digits.substr(1);
+    }
+    if (digits.empty() ||
+        (digits.size() > 1 && digits[0] == '0' &&
+         digits[1] != 'x' && digits[1] != 'X')) {
+        return false;
+    }
+    char* end = NULL;
+    errno = 0;
+    value = std::strtoll(text.c_str(), &end, 0);
+    return *end == '\0' && errno != ERANGE;
+}
+
+/**
+ * Parses an 'info registers rf index' term.
+ */
+StateExpression*
+StateExpression::Parser::parseRegister(const TokenList& words) {
+    SimulatorFrontend& frontend = command_.simulatorFrontend();
+    SLongWord index = 0;
+    if (frontend.isCompiledSimulation() || !parseInteger(words[3], index) ||
+        index < 0) {
+        return NULL;
+    }
+
+    const StateData* state = NULL;
+    try {
+        state = &frontend.findRegister(words[2], index);
+    } catch (const Exception&) {
+        return NULL;
+    }
+    const int width = state->value().width();
+    if (width > 63) {
+        return NULL;
+    }
+
+    StateExpression* expression = new StateExpression(REGISTER);
+    expression->state_ = state;
+    expression->mask_ = (ULongWord(1) << width) - 1;
+    return expression;
+}
+
+/**
+ * Parses an 'info ports fu port' term.
+ */
+StateExpression*
+StateExpression::Parser::parsePort(const TokenList& words) {
+    SimulatorFrontend& frontend = command_.simulatorFrontend();
+    if (frontend.isCompiledSimulation()) {
+        return NULL;
+    }
+
+    const PortState& state =
+        frontend.machineState().portState(words[3], words[2]);
+    if (&state == &NullPortState::instance()) {
+        return NULL;
+    }
+
+    StateExpression* expression = new StateExpression(PORT);
+    expression->state_ = &state;
+    return expression;
+}
+
+/**
+ * Parses an 'x' term.
+ *
+ * The count of the read MAUs must be given, since 'x' uses the count of
+ * its previous call otherwise.
+ */
+StateExpression*
+StateExpression::Parser::parseMemory(const TokenList& words) {
+    std::string addressSpaceName = "";
+    int count = 0;
+    for (std::size_t i = 1; i < words.size() - 1; i += 2) {
+        const std::string& option = words[i];
+        const std::string& argument = words[i + 1];
+        if (i + 1 == words.size() - 1) {
+            return NULL;
+        } else if (StringTools::ciEqual(option, "/a")) {
+            addressSpaceName = argument;
+        } else if (StringTools::ciEqual(option, "/u")) {
+            if (StringTools::ciEqual(argument, "b")) {
+                count = 1;
+            } else if (StringTools::ciEqual(argument, "h")) {
+                count = 2;
+            } else if (StringTools::ciEqual(argument, "w")) {
+                count = 4;
+            } else {
+                return NULL;
+            }
+        } else if (!StringTools::ciEqual(option, "/n") || argument != "1") {
+            return NULL;
+        }
+    }
+    if (count == 0) {
+        return NULL;
+    }
+
+    ULongWord address = 0;
+    try {
+        const TTAProgram::Address& parsedAddress =
+            command_.parseDataAddressExpression(words.back());
+        if (&parsedAddress.space() !=
+            &TTAMachine::NullAddressSpace::instance()) {
+            addressSpaceName = parsedAddress.space().name();
+        }
+        address = parsedAddress.location();
+    } catch (const Exception&) {
+        return NULL;
+    }
+
+    MemorySystem& memorySystem = command_.simulatorFrontend().memorySystem();
+    MemorySystem::MemoryPtr memory;
+    int MAUSize = 0;
+    try {
+        if (memorySystem.memoryCount() == 1) {
+            memory = memorySystem.memory(0);
+            MAUSize = memorySystem.addressSpace(0).width();
+        } else if (memorySystem.memoryCount() > 1 && addressSpaceName != "") {
+            memory = memorySystem.memory(addressSpaceName);
+            MAUSize = memorySystem.addressSpace(addressSpaceName).width();
+        } else {
+            return NULL;
+        }
+        if (MAUSize * count > 63) {
+            return NULL;
+        }
+        ULongWord data = 0;
+        memory->read(address, count, data);
+    } catch (const Exception&) {
+        return NULL;
+    }
+
+    StateExpression* expression = new StateExpression(MEMORY);
+    expression->memory_ = memory;
+    expression->address_ = address;
+    expression->count_ = count;
+    return expression;
+}
+
+/**
+ * Parses a disjunction.
+ */
+StateExpression*
+StateExpression::Parser::parseOr() {
+    StateExpression* expression = parseAnd();
+    while (expression != NULL && accept("||")) {
+        expression = binary(OR, expression, parseAnd());
+    }
+    return expression;
+}
+
+/**
+ * Parses a conjunction.
+ */
+StateExpression*
+StateExpression::Parser::parseAnd() {
+    StateExpression* expression = parseComparison();
+    while (expression != NULL && accept("&&")) {
+        expression = binary(AND, expression, parseComparison());
+    }
+    return expression;
+}
+
+/**
+ * Parses a comparison.
+ */
+StateExpression*
+StateExpression::Parser::parseComparison() {
+    StateExpression* expression = parseNot();
+    if (expression == NULL) {
+        return NULL;
+    } else if (accept("==")) {
+        return binary(EQUAL, expression, parseNot());
+    } else if (accept("!=")) {
+        return binary(NOT_EQUAL, expression, parseNot());
+    } else if (accept("<")) {
+        return binary(LESS, expression, parseNot());
+    } else if (accept("<=")) {
+        return binary(LESS_EQUAL, expression, parseNot());
+    } else if (accept(">")) {
+        return binary(GREATER, expression, parseNot());
+    } else if (accept(">=")) {
+        return binary(GREATER_EQUAL, expression, parseNot());
+    }
+    return expression;
+}
+
+/**
+ * Parses a negation.
+ *
+ * The negation binds tighter than the comparisons as in Tcl.
+ */
+StateExpression*
+StateExpression::Parser::parseNot() {
+    if (!accept("!")) {
+        return parseOperand();
+    }
+    StateExpression* operand = parseNot();
+    if (operand == NULL) {
+        return NULL;
+    }
+    StateExpression* expression = new StateExpression(NOT);
+    expression->left_ = operand;
+    return expression;
+}
+
+/**
+ * Parses an operand of a comparison.
+ */
+StateExpression*
+StateExpression::Parser::parseOperand() {
+    if (position_ == tokens_.size()) {
+        return NULL;
+    }
+    const std::string token = tokens_[position_++];
+    if (token == "(") {
+        StateExpression* expression = parseOr();
+        if (expression != NULL && !accept(")")) {
+            delete expression;
+            return NULL;
+        }
+        return expression;
+    } else if (token[0] == '[') {
+        return parseTerm(token.substr(1, token.size() - 2));
+    }
+
+    SLongWord value = 0;
+    if (!parseInteger(token, value)) {
+        return NULL;
+    }
+    StateExpression* expression = new StateExpression(CONSTANT);
+    expression->constant_ = value;
+    return expression;
+}
+
+/**
+ * Builds a binary node.
+ *
+ * Deletes the operands if either of them is missing.
+ */
+StateExpression*
+StateExpression::Parser::binary(
+    Kind kind, StateExpression* left, StateExpression* right) const {
+
+    if (left == NULL || right == NULL) {
+        delete left;
+        delete right;
+        return NULL;
+    }
+    StateExpression* expression = new StateExpression(kind);
+    expression->left_ = left;
+    expression->right_ = right;
+    return expression;
+}
+
+/**
+ * Skips the next token if it is the given one.
+ *
+ * @return True if the token was skipped.
+ */
+bool
+StateExpression::Parser::accept(const std::string& token) {
+    if (position_ < tokens_.size() && tokens_[position_] == token) {
+        ++position_;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Constructor.
+ *
+ * @param kind The kind of the node.
+ */
+StateExpression::StateExpression(Kind kind) :
+    kind_(kind), constant_(0), state_(NULL), mask_(0), address_(0),
+    count_(0), left_(NULL), right_(NULL) {
+}
+
+/**
+ * Copy constructor.
+ *
+ * The operands are copied.
+ *
+ * @param source The expression to copy.
+ */
+StateExpression::StateExpression(const StateExpression& source) :
+    kind_(source.kind_), constant_(source.constant_), state_(source.state_),
+    mask_(source.mask_), memory_(source.memory_), address_(source.address_),
+    count_(source.count_), left_(NULL), right_(NULL) {
+
+    if (source.left_ != NULL) {
+        left_ = new StateExpression(*source.left_);
+    }
+    if (source.right_ != NULL) {
+        right_ = new StateExpression(*source.right_);
+    }
+}
+
+/**
+ * Destructor.
+ */
+StateExpression::~StateExpression() {
+    delete left_;
+    left_ = NULL;
+    delete right_;
+    right_ = NULL;
+}
+
+/**
+ * Compiles a watch script.
+ *
+ * @param script The watch script.
+ * @param scriptResult The result of the script evaluated by the
+ * interpreter, used to check the compiled script.
+ * @param command The command that creates the watch.
+ * @return The compiled script, or NULL if the script cannot be compiled.
+ */
+StateExpression*
+StateExpression::compileWatch(
+    const std::string& script,
+    const std::string& scriptResult,
+    SimControlLanguageCommand& command) {
+
+    Parser parser(command);
+    std::string trimmed = StringTools::trim(script);
+    StateExpression* expression = NULL;
+    if (trimmed.substr(0, 5) == "expr ") {
+        trimmed = StringTools::trim(trimmed.substr(5));
+        if (trimmed.size() > 1 && trimmed[0] == '{' &&
+            trimmed[trimmed.size() - 1] == '}') {
+            trimmed = trimmed.substr(1, trimmed.size() - 2);
+        }
+        expression = parser.parseCondition(trimmed);
+    } else {
+        expression = parser.parseTerm(trimmed);
+    }
+
+    if (expression != NULL && !expression->matches(scriptResult, false)) {
+        delete expression;
+        return NULL;
+    }
+    return expression;
+}
+
+/**
+ * Compiles a condition.
+ *
+ * @param condition The condition, a Tcl expression.
+ * @param conditionResult The truth value of the condition evaluated by
+ * the interpreter, used to check the compiled condition.
+ * @param command The command that creates the condition.
+ * @return The compiled condition, or NULL if the condition cannot be
+ * compiled.
+ */
+StateExpression*
+StateExpression::compileCondition(
+    const std::string& condition,
+    const std::string& conditionResult,
+    SimControlLanguageCommand& command) {
+
+    Parser parser(command);
+    StateExpression* expression = parser.parseCondition(condition);
+    if (expression != NULL && !expression->matches(conditionResult, true)) {
+        delete expression;
+        return NULL;
+    }
+    return expression;
+}
+
+/**
+ * Evaluates the expression.
+ *
+ * @return The value of the expression.
+ */
+SLongWord
+StateExpression::value() const {
+    switch (kind_) {
+    case CONSTANT:
+        return constant_;
+    case REGISTER:
+        return state_->value().uLongWordValue() & mask_;
+    case PORT:
+        return state_->value().intValue();
+    case MEMORY: {
+        ULongWord data = 0;
+        memory_->read(address_, count_, data);
+        return data;
+    }
+    case NOT:
+        return !left_->value();
+    case AND:
+        return left_->value() && right_->value();
+    case OR:
+        return left_->value() || right_->value();
+    case EQUAL:
+        return left_->value() == right_->value();
+    case NOT_EQUAL:
+        return left_->value() != right_->value();
+    case LESS:
+        return left_->value() < right_->value();
+    case LESS_EQUAL:
+        return left_->value() <= right_->value();
+    case GREATER:
+        return left_->value() > right_->value();
+    case GREATER_EQUAL:
+        return left_->value() >= right_->value();
+    }
+    return 0;
+}
+
+/**
+ * Tells whether the value of the expression changes only with writes to
+ * the memories.
+ *
+ * @return True if the expression reads no registers or ports.
+ */
+bool
+StateExpression::readsOnlyMemory() const {
+    if (kind_ == REGISTER || kind_ == PORT) {
+        return false;
+    }
+    return (left_ == NULL || left_->readsOnlyMemory()) &&
+        (right_ == NULL || right_->readsOnlyMemory());
+}
+
+/**
+ * Watches the writes to the memory words the expression reads.
+ *
+ * @param written The flag to raise on a write.
+ */
+void
+StateExpression::addWriteWatches(bool& written) {
+    if (kind_ == MEMORY) {
+        memory_->addWriteWatch(address_, address_ + count_ - 1, written);
+    }
+    if (left_ != NULL) {
+        left_->addWriteWatches(written);
+    }
+    if (right_ != NULL) {
+        right_->addWriteWatches(written);
+    }
+}
+
+/**
+ * Removes the write watches added with addWriteWatches().
+ *
+ * @param written The flag of the write watches.
+ */
+void
+StateExpression::removeWriteWatches(const bool& written) {
+    if (kind_ == MEMORY) {
+        memory_->removeWriteWatch(written);
+    }
+    if (left_ != NULL) {
+        left_->removeWriteWatches(written);
+    }
+    if (right_ != NULL) {
+        right_->removeWriteWatches(written);
+    }
+}
+
+/**
+ * Checks the compiled expression against the result of the interpreter.
+ *
+ * @param result The result the interpreter gave for the script.
+ * @param truthValue Compare only the truth values.
+ * @return True if the expression gives the same result.
+ */
+bool
+StateExpression::matches(const std::string& result, bool truthValue) const {
+    const std::string trimmed = StringTools::trim(result);
+    if (trimmed.empty()) {
+        return false;
+    }
+    char* end = NULL;
+    const SLongWord expected = std::strtoll(trimmed.c_str(), &end, 0);
+    if (*end != '\0') {
+        return false;
+    }
+    if (truthValue) {
+        return (value() != 0) == (expected != 0);
+    }
+    return value() == expected;
+}
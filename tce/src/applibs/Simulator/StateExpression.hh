@@ -0,0 +1,138 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file StateExpression.hh
+ *
+ * Declaration of StateExpression class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_STATE_EXPRESSION_HH
+#define TTA_STATE_EXPRESSION_HH
+
+#include <string>
+#include <vector>
+
+#include "BaseType.hh"
+#include "MemorySystem.hh"
+
+class StateData;
+class SimControlLanguageCommand;
+
+/**
+ * A watch or condition expression compiled to a predicate over the
+ * simulated state.
+ *
+ * Watch and condition scripts are Tcl scripts that are evaluated by the
+ * interpreter at every check, which dominates the simulation time when a
+ * watch is set. The common forms of the scripts are compiled to a tree
+ * of StateExpressions that read the register, port and memory states
+ * resolved when the expression is compiled:
+ *
+ * term       := "info registers" rf index | "info ports" fu port |
+ *               "x" ["/a" space] "/u" (b|h|w) ["/n 1"] address
+ * watch      := term | "expr" condition
+ * condition  := or
+ * or         := and ("||" and)*
+ * and        := comparison ("&&" comparison)*
+ * comparison := not [("=="|"!="|"<"|"<="|">"|">=") not]
+ * not        := "!" not | operand
+ * operand    := "[" term "]" | integer | "(" or ")"
+ *
+ * The values are the integers the Tcl commands return. Scripts of other
+ * forms, values wider than 63 bits and register or port terms of the
+ * compiled simulation are left to the interpreter.
+ */
+class StateExpression {
+public:
+    StateExpression(const StateExpression& source);
+    virtual ~StateExpression();
+
+    static StateExpression* compileWatch(
+        const std::string& script,
+        const std::string& scriptResult,
+        SimControlLanguageCommand& command);
+    static StateExpression* compileCondition(
+        const std::string& condition,
+        const std::string& conditionResult,
+        SimControlLanguageCommand& command);
+
+    SLongWord value() const;
+    bool readsOnlyMemory() const;
+
+    void addWriteWatches(bool& written);
+    void removeWriteWatches(const bool& written);
+
+private:
+    /// The kinds of the expression nodes.
+    enum Kind {
+        CONSTANT,     ///< An integer literal.
+        REGISTER,     ///< A register as 'info registers' returns it.
+        PORT,         ///< An FU port as 'info ports' returns it.
+        MEMORY,       ///< A memory word as 'x' returns it.
+        NOT,          ///< Logical negation of the left operand.
+        AND,          ///< Logical and of the operands.
+        OR,           ///< Logical or of the operands.
+        EQUAL,        ///< Comparisons of the operands.
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL
+    };
+
+    /// The tokens of a script.
+    typedef std::vector<std::string> TokenList;
+
+    class Parser;
+
+    StateExpression(Kind kind);
+
+    bool matches(const std::string& result, bool truthValue) const;
+
+    /// Assignment not allowed.
+    StateExpression& operator=(const StateExpression&);
+
+    /// The kind of the node.
+    Kind kind_;
+    /// The value of a constant.
+    SLongWord constant_;
+    /// The register or port state read.
+    const StateData* state_;
+    /// Mask of the bits of a register value.
+    ULongWord mask_;
+    /// The memory read.
+    MemorySystem::MemoryPtr memory_;
+    /// The address of the memory word read.
+    ULongWord address_;
+    /// The number of MAUs read from the memory.
+    int count_;
+    /// The left or only operand.
+    StateExpression* left_;
+    /// The right operand.
+    StateExpression* right_;
+};
+
+#endif
@@ -46,6 +46,11 @@ namespace TTAMachine {
 /**
  * Calculates processor utilization data from instructions and their
  * execution counts.
+ *
+ * Does not listen to simulation events. The simulation only counts the
+ * executions of each instruction and move in the ExecutableInstructions,
+ * and the counts are folded into the utilization data when the statistics
+ * are requested.
  */
 class UtilizationStats : public SimulationStatisticsCalculator {
 public:
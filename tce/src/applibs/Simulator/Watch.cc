@@ -31,6 +31,7 @@
  */
 
 #include "Watch.hh"
+#include "StateExpression.hh"
 #include "ConditionScript.hh"
 #include "ExpressionScript.hh"
 #include "SimulatorConstants.hh"
@@ -44,18 +45,38 @@
  *
  * @param frontend Used to fetch the simulation clock.
  * @param expression The expression watched.
+ * @param compiledExpression The expression compiled, or NULL if it is to
+ * be interpreted. Becomes owned by the watch.
  */
 Watch::Watch(
     const SimulatorFrontend& frontend, 
-    const ExpressionScript& expression) :
-    StopPoint(), expression_(expression), frontend_(frontend),
+    const ExpressionScript& expression,
+    StateExpression* compiledExpression) :
+    StopPoint(), expression_(expression),
+    compiledExpression_(compiledExpression), lastValue_(0),
+    watchesWrites_(false), written_(false), frontend_(frontend),
     isTriggered_(false), lastCheckedCycle_(0) {
+
+    if (compiledExpression_ != NULL) {
+        lastValue_ = compiledExpression_->value();
+        watchesWrites_ = compiledExpression_->readsOnlyMemory();
+        if (watchesWrites_) {
+            compiledExpression_->addWriteWatches(written_);
+        }
+    }
 }
 
 /**
  * Destructor.
  */
 Watch::~Watch() {
+    if (compiledExpression_ != NULL) {
+        if (watchesWrites_) {
+            compiledExpression_->removeWriteWatches(written_);
+        }
+        delete compiledExpression_;
+        compiledExpression_ = NULL;
+    }
 }
 
 /**
@@ -63,7 +84,11 @@ Watch::~Watch() {
  */
 StopPoint*
 Watch::copy() const {
-    StopPoint* aCopy = new Watch(frontend_, expression_);
+    Watch* aCopy = new Watch(
+        frontend_, expression_,
+        compiledExpression_ == NULL ?
+        NULL : new StateExpression(*compiledExpression_));
+    aCopy->lastValue_ = lastValue_;
     if (conditional_) {
         assert(condition_ != NULL);
         ConditionScript* conditionCopy = condition_->copy();
@@ -97,6 +122,13 @@ Watch::expression() const {
 void
 Watch::setExpression(const ExpressionScript& expression) {
     expression_ = expression;
+    if (compiledExpression_ != NULL) {
+        if (watchesWrites_) {
+            compiledExpression_->removeWriteWatches(written_);
+        }
+        delete compiledExpression_;
+        compiledExpression_ = NULL;
+    }
 }
 
 /**
@@ -111,13 +143,23 @@ Watch::isTriggered() const {
     if (lastCheckedCycle_ != frontend_.cycleCount()) {
         // simulation clock has changed since the last expression check,
         // let's see if the watch expression value has changed
-        try {
-            isTriggered_ = expression_.resultChanged();
-        } catch (const Exception&) {
-            // for example simulation might not be initialized in every
-            // check so the script throws, we'll assume that no triggering
-            // should happen at that case
+        if (compiledExpression_ != NULL) {
             isTriggered_ = false;
+            if (!watchesWrites_ || written_) {
+                written_ = false;
+                const SLongWord value = compiledExpression_->value();
+                isTriggered_ = value != lastValue_;
+                lastValue_ = value;
+            }
+        } else {
+            try {
+                isTriggered_ = expression_.resultChanged();
+            } catch (const Exception&) {
+                // for example simulation might not be initialized in every
+                // check so the script throws, we'll assume that no
+                // triggering should happen at that case
+                isTriggered_ = false;
+            }
         }
         lastCheckedCycle_ = frontend_.cycleCount();
     }
@@ -39,17 +39,24 @@
 #include "ExpressionScript.hh"
 
 class SimulatorFrontend;
+class StateExpression;
 
 /**
  * Represents a simulation watch point.
  *
  * Watch stops simulation when user-given expression changes its value.
+ *
+ * If the expression could be compiled to a StateExpression, the compiled
+ * expression is evaluated instead of the script. Compiled expressions that
+ * read only memory are evaluated only after the memory words they read
+ * have been written.
  */
 class Watch : public StopPoint {
 public:
     Watch(
         const SimulatorFrontend& frontend, 
-        const ExpressionScript& expression);
+        const ExpressionScript& expression,
+        StateExpression* compiledExpression = NULL);
     virtual ~Watch();
 
     virtual bool isTriggered() const;
@@ -64,6 +71,15 @@ private:
     Watch(const Watch& source);
     /// The expression that is watched.
     mutable ExpressionScript expression_;
+    /// The compiled expression, NULL if the script is interpreted.
+    StateExpression* compiledExpression_;
+    /// The value of the compiled expression in the last check.
+    mutable SLongWord lastValue_;
+    /// True if the compiled expression is checked only after memory writes.
+    bool watchesWrites_;
+    /// Raised by the memories when the words the expression reads are
+    /// written.
+    mutable bool written_;
     /// The simulator frontend which is used to fetch the current PC.
     const SimulatorFrontend& frontend_;
     /// Flag which tells whether the watch was triggered in current simulation
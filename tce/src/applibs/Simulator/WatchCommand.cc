@@ -39,6 +39,7 @@
 #include "Breakpoint.hh"
 #include "ExpressionScript.hh"
 #include "Watch.hh"
+#include "StateExpression.hh"
 
 #include <iostream>
 
@@ -80,7 +81,11 @@ WatchCommand::execute(const std::vector<DataObject>& arguments) {
         return false;
     }
 
-    Watch watch(simulatorFrontend(), expression);
+    Watch watch(
+        simulatorFrontend(), expression,
+        StateExpression::compileWatch(
+            expression.script().at(0), expression.lastResult().stringValue(),
+            *this));
 
     StopPointManager& stopPointManager = 
         simulatorFrontend().stopPointManager();
@@ -0,0 +1,153 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTrace.cc
+ *
+ * Definition of BinaryBusTrace class.
+ *
+ * @note rating: red
+ */
+
+#include "BinaryBusTrace.hh"
+#include "BinaryTrace.hh"
+
+const std::string BinaryBusTrace::MAGIC = "TCEBUSTR";
+
+/**
+ * Returns the number of bytes a value of the given width takes.
+ *
+ * @param width The width of the bus in bits.
+ * @return The size of the value in bytes.
+ */
+std::size_t
+BinaryBusTrace::valueSize(int width) {
+    return (width + 7) / 8;
+}
+
+/**
+ * Returns the size of a record.
+ *
+ * @param widths The widths of the buses.
+ * @return The size of a record in bytes.
+ */
+std::size_t
+BinaryBusTrace::recordSize(const std::vector<int>& widths) {
+    std::size_t size = CYCLE_SIZE;
+    for (std::size_t i = 0; i < widths.size(); ++i) {
+        size += valueSize(widths[i]);
+    }
+    return size;
+}
+
+/**
+ * Encodes the file header.
+ *
+ * @param names The names of the buses.
+ * @param widths The widths of the buses.
+ * @return The header.
+ */
+std::vector<unsigned char>
+BinaryBusTrace::header(
+    const std::vector<std::string>& names,
+    const std::vector<int>& widths) {
+
+    std::vector<unsigned char> header(MAGIC.begin(), MAGIC.end());
+    BinaryTrace::writeUInt32(header, FORMAT_VERSION);
+    BinaryTrace::writeUInt32(header, widths.size());
+    for (std::size_t i = 0; i < widths.size(); ++i) {
+        BinaryTrace::writeUInt32(header, widths[i]);
+        BinaryTrace::writeUInt32(header, names[i].size());
+        header.insert(header.end(), names[i].begin(), names[i].end());
+    }
+    return header;
+}
+
+/**
+ * Stores the cycle of a record.
+ *
+ * @param record The record.
+ * @param cycle The cycle.
+ */
+void
+BinaryBusTrace::writeCycle(unsigned char* record, uint64_t cycle) {
+    for (std::size_t i = 0; i < CYCLE_SIZE; ++i) {
+        record[i] = static_cast<unsigned char>(cycle >> (8 * i));
+    }
+}
+
+/**
+ * Returns the cycle of a record.
+ *
+ * @param record The record.
+ * @return The cycle.
+ */
+uint64_t
+BinaryBusTrace::readCycle(const unsigned char* record) {
+    return static_cast<uint64_t>(BinaryTrace::readInt64(record));
+}
+
+/**
+ * Appends a record in the text bus trace format to a string.
+ *
+ * The values are printed as hexadecimal numbers of (width + 3) / 4
+ * digits, as SimValue::hexValue() prints them. No line feed is appended.
+ *
+ * @param line The string to append to.
+ * @param record The record.
+ * @param widths The widths of the buses.
+ */
+void
+BinaryBusTrace::appendText(
+    std::string& line,
+    const unsigned char* record,
+    const std::vector<int>& widths) {
+
+    static const char DIGITS[] = "0123456789abcdef";
+
+    char cycle[24];
+    int length = 0;
+    uint64_t value = readCycle(record);
+    do {
+        cycle[length++] = DIGITS[value % 10];
+        value /= 10;
+    } while (value != 0);
+    while (length > 0) {
+        line += cycle[--length];
+    }
+
+    const unsigned char* data = record + CYCLE_SIZE;
+    for (std::size_t i = 0; i < widths.size(); ++i) {
+        line += COLUMN_SEPARATOR;
+        const int width = widths[i];
+        for (int digit = (width + 3) / 4 - 1; digit >= 0; --digit) {
+            unsigned nibble = (data[digit / 2] >> (4 * (digit % 2))) & 0xf;
+            const int bitsLeft = width - 4 * digit;
+            if (bitsLeft < 4) {
+                nibble &= (1u << bitsLeft) - 1;
+            }
+            line += DIGITS[nibble];
+        }
+        data += valueSize(width);
+    }
+}
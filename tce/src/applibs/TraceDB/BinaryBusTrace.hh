@@ -0,0 +1,83 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTrace.hh
+ *
+ * Declaration of BinaryBusTrace class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_BUS_TRACE_HH
+#define TTA_BINARY_BUS_TRACE_HH
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Definitions of the binary bus trace file format.
+ *
+ * The binary bus trace stores the same data as the text bus trace: the
+ * value of each bus at the end of each simulated cycle, in the order of
+ * the buses in the machine, squashed moves as zero. The records have a
+ * fixed size, so they are written without formatting and the record of
+ * a cycle can be located directly.
+ *
+ * header := magic "TCEBUSTR", version (uint32), bus count (uint32),
+ *           bus count * (width in bits (uint32), name length (uint32),
+ *           name)
+ * record := cycle (uint64), bus count * value
+ *
+ * All integers are little endian. A value takes (width + 7) / 8 bytes,
+ * stored little endian like SimValue stores it.
+ */
+class BinaryBusTrace {
+public:
+    /// The magic string at the beginning of the file.
+    static const std::string MAGIC;
+    /// The version of the file format.
+    static const uint32_t FORMAT_VERSION = 1;
+    /// Size of the cycle field of a record in bytes.
+    static const std::size_t CYCLE_SIZE = 8;
+    /// The separator of the columns in the text format.
+    static const char COLUMN_SEPARATOR = ',';
+
+    static std::size_t valueSize(int width);
+    static std::size_t recordSize(const std::vector<int>& widths);
+
+    static std::vector<unsigned char> header(
+        const std::vector<std::string>& names,
+        const std::vector<int>& widths);
+
+    static void writeCycle(unsigned char* record, uint64_t cycle);
+    static uint64_t readCycle(const unsigned char* record);
+
+    static void appendText(
+        std::string& line,
+        const unsigned char* record,
+        const std::vector<int>& widths);
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTraceReader.cc
+ *
+ * Definition of BinaryBusTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryBusTraceReader.hh"
+#include "BinaryTrace.hh"
+#include "Conversion.hh"
+
+/**
+ * Constructor.
+ *
+ * Maps the file to memory and reads its header.
+ *
+ * @param fileName The trace file.
+ * @exception IOException If the file cannot be read or is not a binary
+ * bus trace.
+ */
+BinaryBusTraceReader::BinaryBusTraceReader(const std::string& fileName) :
+    fileName_(fileName), mapping_(NULL), size_(0), records_(NULL),
+    recordSize_(0), recordCount_(0) {
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        std::string error = std::strerror(errno);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot open bus trace file '" + fileName + "': " + error);
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+        mapping_ = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    int mapError = errno;
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = NULL;
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot map bus trace file '" + fileName + "': " +
+            std::strerror(mapError));
+    }
+
+    try {
+        readHeader();
+    } catch (...) {
+        if (mapping_ != NULL) {
+            munmap(mapping_, size_);
+            mapping_ = NULL;
+        }
+        throw;
+    }
+}
+
+/**
+ * Destructor.
+ *
+ * Unmaps the file.
+ */
+BinaryBusTraceReader::~BinaryBusTraceReader() {
+    if (mapping_ != NULL) {
+        munmap(mapping_, size_);
+        mapping_ = NULL;
+    }
+}
+
+/**
+ * Reads the bus descriptions of the header and locates the records.
+ *
+ * @exception IOException If the file is not a binary bus trace.
+ */
+void
+BinaryBusTraceReader::readHeader() {
+    const unsigned char* data = static_cast<const unsigned char*>(mapping_);
+    const unsigned char* end = data + size_;
+    const std::size_t fixedSize = BinaryBusTrace::MAGIC.size() + 8;
+    const std::string invalid =
+        "'" + fileName_ + "' is not a bus trace file of this TCE version.";
+
+    if (size_ < fixedSize ||
+        std::string(data, data + BinaryBusTrace::MAGIC.size()) !=
+        BinaryBusTrace::MAGIC ||
+        BinaryTrace::readUInt32(data + BinaryBusTrace::MAGIC.size()) !=
+        BinaryBusTrace::FORMAT_VERSION) {
+        throw IOException(__FILE__, __LINE__, __func__, invalid);
+    }
+    uint32_t busCount =
+        BinaryTrace::readUInt32(data + BinaryBusTrace::MAGIC.size() + 4);
+    data += fixedSize;
+
+    std::size_t offset = BinaryBusTrace::CYCLE_SIZE;
+    for (uint32_t bus = 0; bus < busCount; ++bus) {
+        if (end - data < 8) {
+            throw IOException(__FILE__, __LINE__, __func__, invalid);
+        }
+        int width = BinaryTrace::readUInt32(data);
+        uint32_t nameLength = BinaryTrace::readUInt32(data + 4);
+        data += 8;
+        if (width <= 0 ||
+            static_cast<std::size_t>(end - data) < nameLength) {
+            throw IOException(__FILE__, __LINE__, __func__, invalid);
+        }
+        names_.push_back(std::string(data, data + nameLength));
+        widths_.push_back(width);
+        offsets_.push_back(offset);
+        offset += BinaryBusTrace::valueSize(width);
+        data += nameLength;
+    }
+
+    records_ = data;
+    recordSize_ = offset;
+    recordCount_ = (end - data) / recordSize_;
+}
+
+/**
+ * Returns the number of traced buses.
+ *
+ * @return The number of buses.
+ */
+std::size_t
+BinaryBusTraceReader::busCount() const {
+    return names_.size();
+}
+
+/**
+ * Returns the name of a bus.
+ *
+ * @param bus Index of the bus.
+ * @return The name of the bus.
+ * @exception OutOfRange If the index is out of range.
+ */
+const std::string&
+BinaryBusTraceReader::busName(std::size_t bus) const {
+    if (bus >= names_.size()) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "Bus index " + Conversion::toString(bus) + " out of range.");
+    }
+    return names_[bus];
+}
+
+/**
+ * Returns the width of a bus.
+ *
+ * @param bus Index of the bus.
+ * @return The width of the bus in bits.
+ * @exception OutOfRange If the index is out of range.
+ */
+int
+BinaryBusTraceReader::busWidth(std::size_t bus) const {
+    if (bus >= widths_.size()) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "Bus index " + Conversion::toString(bus) + " out of range.");
+    }
+    return widths_[bus];
+}
+
+/**
+ * Returns the widths of all the buses.
+ *
+ * @return The widths of the buses in bits.
+ */
+const std::vector<int>&
+BinaryBusTraceReader::busWidths() const {
+    return widths_;
+}
+
+/**
+ * Returns the number of complete records in the file.
+ *
+ * @return The number of records.
+ */
+std::size_t
+BinaryBusTraceReader::recordCount() const {
+    return recordCount_;
+}
+
+/**
+ * Returns a record.
+ *
+ * @param index Index of the record.
+ * @return The record in the mapped file.
+ * @exception OutOfRange If the index is out of range.
+ */
+const unsigned char*
+BinaryBusTraceReader::record(std::size_t index) const {
+    if (index >= recordCount_) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "Record index " + Conversion::toString(index) +
+            " out of range.");
+    }
+    return records_ + index * recordSize_;
+}
+
+/**
+ * Returns the cycle of a record.
+ *
+ * @param index Index of the record.
+ * @return The cycle.
+ * @exception OutOfRange If the index is out of range.
+ */
+uint64_t
+BinaryBusTraceReader::cycle(std::size_t index) const {
+    return BinaryBusTrace::readCycle(record(index));
+}
+
+/**
+ * Returns the value of a bus in a record.
+ *
+ * @param index Index of the record.
+ * @param bus Index of the bus.
+ * @return The little endian value of busWidth() bits.
+ * @exception OutOfRange If an index is out of range.
+ */
+const unsigned char*
+BinaryBusTraceReader::value(std::size_t index, std::size_t bus) const {
+    busWidth(bus);
+    return record(index) + offsets_[bus];
+}
+
+/**
+ * Returns a record in the text bus trace format.
+ *
+ * @param index Index of the record.
+ * @return The record as a line of the text trace without the line feed.
+ * @exception OutOfRange If the index is out of range.
+ */
+std::string
+BinaryBusTraceReader::text(std::size_t index) const {
+    std::string line;
+    BinaryBusTrace::appendText(line, record(index), widths_);
+    return line;
+}
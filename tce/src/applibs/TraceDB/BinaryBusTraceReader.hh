@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTraceReader.hh
+ *
+ * Declaration of BinaryBusTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_BUS_TRACE_READER_HH
+#define TTA_BINARY_BUS_TRACE_READER_HH
+
+#include <string>
+#include <vector>
+
+#include "BinaryBusTrace.hh"
+#include "Exception.hh"
+
+/**
+ * Reads a binary bus trace file.
+ *
+ * The file is mapped to memory and the records are accessed in place.
+ * A record cut short by a writer that has not finished is ignored. See
+ * BinaryBusTrace for the format.
+ */
+class BinaryBusTraceReader {
+public:
+    explicit BinaryBusTraceReader(const std::string& fileName);
+    virtual ~BinaryBusTraceReader();
+
+    std::size_t busCount() const;
+    const std::string& busName(std::size_t bus) const;
+    int busWidth(std::size_t bus) const;
+    const std::vector<int>& busWidths() const;
+
+    std::size_t recordCount() const;
+    const unsigned char* record(std::size_t index) const;
+    uint64_t cycle(std::size_t index) const;
+    const unsigned char* value(std::size_t index, std::size_t bus) const;
+
+    std::string text(std::size_t index) const;
+
+private:
+    void readHeader();
+
+    /// Copying not allowed.
+    BinaryBusTraceReader(const BinaryBusTraceReader&);
+    /// Assignment not allowed.
+    BinaryBusTraceReader& operator=(const BinaryBusTraceReader&);
+
+    /// The trace file.
+    std::string fileName_;
+    /// The mapped file, NULL if the file is empty.
+    void* mapping_;
+    /// Size of the mapped file.
+    std::size_t size_;
+    /// The first record in the mapped file.
+    const unsigned char* records_;
+    /// Size of a record in bytes.
+    std::size_t recordSize_;
+    /// The number of complete records.
+    std::size_t recordCount_;
+    /// The names of the buses.
+    std::vector<std::string> names_;
+    /// The widths of the buses.
+    std::vector<int> widths_;
+    /// Offsets of the bus values in a record.
+    std::vector<std::size_t> offsets_;
+};
+
+#endif
@@ -0,0 +1,163 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTraceWriter.cc
+ *
+ * Definition of BinaryBusTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "BinaryBusTraceWriter.hh"
+#include "BlockFileWriter.hh"
+#include "Application.hh"
+
+const std::size_t BinaryBusTraceWriter::BLOCK_SIZE = 1024 * 1024;
+const std::size_t BinaryBusTraceWriter::MAX_QUEUED_BLOCKS = 8;
+
+/**
+ * Constructor.
+ *
+ * Creates the trace file and writes its header.
+ *
+ * @param fileName The trace file.
+ * @param names The names of the traced buses.
+ * @param widths The widths of the traced buses.
+ * @exception IOException If the file cannot be written.
+ */
+BinaryBusTraceWriter::BinaryBusTraceWriter(
+    const std::string& fileName,
+    const std::vector<std::string>& names,
+    const std::vector<int>& widths) :
+    writer_(NULL), recordSize_(BinaryBusTrace::recordSize(widths)),
+    blockSize_(0), block_(NULL), used_(0) {
+
+    blockSize_ = (BLOCK_SIZE / recordSize_ + 1) * recordSize_;
+
+    std::FILE* file = std::fopen(fileName.c_str(), "wb");
+    if (file == NULL) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot open trace file '" + fileName + "' for writing: " +
+            std::strerror(errno));
+    }
+    std::vector<unsigned char> header =
+        BinaryBusTrace::header(names, widths);
+    if (std::fwrite(&header[0], 1, header.size(), file) != header.size()) {
+        std::fclose(file);
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot write trace file '" + fileName + "'.");
+    }
+
+    writer_ = new BlockFileWriter(file, MAX_QUEUED_BLOCKS, "bus trace");
+    block_ = writer_->freeBlock();
+    block_->resize(blockSize_);
+}
+
+/**
+ * Destructor.
+ *
+ * Writes the buffered records to the file and closes it.
+ */
+BinaryBusTraceWriter::~BinaryBusTraceWriter() {
+    try {
+        flush();
+    } catch (const Exception& e) {
+        debugLog(
+            "Exception almost leaked from ~BinaryBusTraceWriter! Message: " +
+            e.errorMessage());
+    }
+    delete block_;
+    block_ = NULL;
+    delete writer_;
+    writer_ = NULL;
+}
+
+/**
+ * Returns the size of a record in bytes.
+ *
+ * @return The size of a record.
+ */
+std::size_t
+BinaryBusTraceWriter::recordSize() const {
+    return recordSize_;
+}
+
+/**
+ * Returns the space of the next record.
+ *
+ * The caller fills all recordSize() bytes of the record before the next
+ * call. The record is written to the file eventually.
+ *
+ * @return The record to fill.
+ * @exception IOException If writing the file has failed.
+ */
+unsigned char*
+BinaryBusTraceWriter::nextRecord() {
+    if (used_ == blockSize_) {
+        emitBlock();
+    }
+    unsigned char* record = &(*block_)[used_];
+    used_ += recordSize_;
+    return record;
+}
+
+/**
+ * Writes all the buffered records to the file.
+ *
+ * Returns after the writer thread has written them.
+ *
+ * @exception IOException If writing the file has failed.
+ */
+void
+BinaryBusTraceWriter::flush() {
+    emitBlock();
+    writer_->flush();
+}
+
+/**
+ * Passes the current block to the writer thread and takes a free one.
+ *
+ * Waits if the writer thread has too many blocks queued already.
+ *
+ * @exception IOException If writing the file has failed.
+ */
+void
+BinaryBusTraceWriter::emitBlock() {
+    if (used_ == 0) {
+        return;
+    }
+
+    std::vector<unsigned char>* block = block_;
+    std::size_t size = used_;
+    block_ = writer_->freeBlock();
+    block_->resize(blockSize_);
+    used_ = 0;
+    writer_->write(block, size);
+}
@@ -0,0 +1,89 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryBusTraceWriter.hh
+ *
+ * Declaration of BinaryBusTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_BUS_TRACE_WRITER_HH
+#define TTA_BINARY_BUS_TRACE_WRITER_HH
+
+#include <string>
+#include <vector>
+
+#include "BinaryBusTrace.hh"
+#include "Exception.hh"
+
+class BlockFileWriter;
+
+/**
+ * Writes a binary bus trace file.
+ *
+ * The records are filled in place in a block buffer by the caller. Full
+ * blocks are written to the file by a background thread and reused, thus
+ * the caller neither formats nor allocates per cycle and waits for the
+ * disk only if the writer falls behind by more than a bounded number of
+ * blocks. See BinaryBusTrace for the format.
+ */
+class BinaryBusTraceWriter {
+public:
+    BinaryBusTraceWriter(
+        const std::string& fileName,
+        const std::vector<std::string>& names,
+        const std::vector<int>& widths);
+    virtual ~BinaryBusTraceWriter();
+
+    std::size_t recordSize() const;
+    unsigned char* nextRecord();
+    void flush();
+
+private:
+    void emitBlock();
+
+    /// Copying not allowed.
+    BinaryBusTraceWriter(const BinaryBusTraceWriter&);
+    /// Assignment not allowed.
+    BinaryBusTraceWriter& operator=(const BinaryBusTraceWriter&);
+
+    /// Writes the blocks to the trace file.
+    BlockFileWriter* writer_;
+    /// Size of a record in bytes.
+    std::size_t recordSize_;
+    /// Size of a block in bytes, a multiple of the record size.
+    std::size_t blockSize_;
+    /// The block the records are currently added to.
+    std::vector<unsigned char>* block_;
+    /// The number of bytes used in the current block.
+    std::size_t used_;
+
+    /// The approximate size of a block in bytes.
+    static const std::size_t BLOCK_SIZE;
+    /// The maximum number of blocks waiting to be written.
+    static const std::size_t MAX_QUEUED_BLOCKS;
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTrace.cc
+ *
+ * Definition of BinaryTrace class.
+ *
+ * @note rating: red
+ */
+
+#include "BinaryTrace.hh"
+#include "Exception.hh"
+
+const std::string BinaryTrace::MAGIC = "TCETRACE";
+
+/**
+ * Appends a little endian 32-bit integer to the buffer.
+ *
+ * @param buffer The buffer to append to.
+ * @param value The value to append.
+ */
+void
+BinaryTrace::writeUInt32(std::vector<unsigned char>& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+/**
+ * Appends a little endian 64-bit integer to the buffer.
+ *
+ * @param buffer The buffer to append to.
+ * @param value The value to append.
+ */
+void
+BinaryTrace::writeInt64(std::vector<unsigned char>& buffer, int64_t value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<unsigned char>(bits >> (8 * i)));
+    }
+}
+
+/**
+ * Appends a variable length unsigned integer to the buffer.
+ *
+ * Each byte stores 7 bits of the value, the lowest bits first. The highest
+ * bit of the byte is set if more bytes follow.
+ *
+ * @param buffer The buffer to append to.
+ * @param value The value to append.
+ */
+void
+BinaryTrace::writeVarUInt(std::vector<unsigned char>& buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * Appends the difference of two values to the buffer.
+ *
+ * The difference is zigzag encoded, so that small negative differences
+ * take as few bytes as small positive ones.
+ *
+ * @param buffer The buffer to append to.
+ * @param previous The previous value of the column.
+ * @param value The value to append.
+ */
+void
+BinaryTrace::writeDelta(
+    std::vector<unsigned char>& buffer, int64_t previous, int64_t value) {
+    // computed unsigned to make the overflow defined
+    uint64_t delta =
+        static_cast<uint64_t>(value) - static_cast<uint64_t>(previous);
+    uint64_t zigzag = (delta << 1) ^ (0 - (delta >> 63));
+    writeVarUInt(buffer, zigzag);
+}
+
+/**
+ * Reads a little endian 32-bit integer.
+ *
+ * @param data Pointer to the first byte of the integer.
+ * @return The integer.
+ */
+uint32_t
+BinaryTrace::readUInt32(const unsigned char* data) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/**
+ * Reads a little endian 64-bit integer.
+ *
+ * @param data Pointer to the first byte of the integer.
+ * @return The integer.
+ */
+int64_t
+BinaryTrace::readInt64(const unsigned char* data) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | data[i];
+    }
+    return static_cast<int64_t>(value);
+}
+
+/**
+ * Reads a variable length unsigned integer.
+ *
+ * @param data Pointer to the first byte of the integer, advanced past the
+ * integer.
+ * @param end End of the data.
+ * @return The integer.
+ * @exception OutOfRange If the integer continues past the end of the data.
+ */
+uint64_t
+BinaryTrace::readVarUInt(
+    const unsigned char*& data, const unsigned char* end) {
+    uint64_t value = 0;
+    for (int shift = 0; data < end && shift < 64; shift += 7) {
+        unsigned char byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw OutOfRange(
+        __FILE__, __LINE__, __func__, "Truncated value in the trace.");
+}
+
+/**
+ * Reads a value stored with writeDelta().
+ *
+ * @param data Pointer to the first byte of the difference, advanced past it.
+ * @param end End of the data.
+ * @param previous The previous value of the column.
+ * @return The value.
+ * @exception OutOfRange If the difference continues past the end of the
+ * data.
+ */
+int64_t
+BinaryTrace::readDelta(
+    const unsigned char*& data, const unsigned char* end, int64_t previous) {
+    uint64_t zigzag = readVarUInt(data, end);
+    uint64_t delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+    return static_cast<int64_t>(static_cast<uint64_t>(previous) + delta);
+}
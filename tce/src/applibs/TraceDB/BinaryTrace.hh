@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTrace.hh
+ *
+ * Declaration of BinaryTrace class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_TRACE_HH
+#define TTA_BINARY_TRACE_HH
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Definitions of the binary columnar execution trace file format.
+ *
+ * The trace is a sequence of columns of 64-bit integers. A table of the
+ * trace is a set of columns with the same number of values, the row i of
+ * the table consists of the value i of each of its columns. Strings, such
+ * as unit names, are interned: a string column stores an index to the
+ * string table of the file.
+ *
+ * The file starts with a header followed by any number of chunks:
+ *
+ * header := magic "TCETRACE", version (uint32)
+ * chunk  := column (uint32), flags (uint32), value count (uint32),
+ *           payload size in bytes (uint32), first value (int64),
+ *           last value (int64), payload
+ *
+ * All fixed size fields are little endian. The payload of a chunk stores
+ * the values of the column as the differences to the previous value of
+ * the chunk (the first one to zero) zigzag encoded to variable length
+ * integers of 7 bits per byte. The chunks of the string table column
+ * store each string as its length followed by its bytes, the first string
+ * of the file has the index 0.
+ *
+ * Chunks are independent of each other, thus a file can be appended to
+ * and read while the appending continues. The chunks of a column are in
+ * the order of the values, chunks of different columns may interleave.
+ */
+class BinaryTrace {
+public:
+    /// Type for the column identifiers.
+    typedef uint32_t ColumnID;
+
+    /// The column holding the string table.
+    static const ColumnID STRING_TABLE_COLUMN = 0;
+    /// Chunk flag: the values of the chunk are in strictly ascending order.
+    static const uint32_t CHUNK_SORTED = 1;
+
+    /// The magic string at the beginning of the file.
+    static const std::string MAGIC;
+    /// The version of the file format.
+    static const uint32_t FORMAT_VERSION = 1;
+    /// Size of the file header in bytes.
+    static const std::size_t HEADER_SIZE = 12;
+    /// Size of the chunk header in bytes.
+    static const std::size_t CHUNK_HEADER_SIZE = 32;
+
+    static void writeUInt32(std::vector<unsigned char>& buffer, uint32_t value);
+    static void writeInt64(std::vector<unsigned char>& buffer, int64_t value);
+    static void writeVarUInt(std::vector<unsigned char>& buffer, uint64_t value);
+    static void writeDelta(
+        std::vector<unsigned char>& buffer, int64_t previous, int64_t value);
+
+    static uint32_t readUInt32(const unsigned char* data);
+    static int64_t readInt64(const unsigned char* data);
+    static uint64_t readVarUInt(
+        const unsigned char*& data, const unsigned char* end);
+    static int64_t readDelta(
+        const unsigned char*& data, const unsigned char* end,
+        int64_t previous);
+};
+
+#endif
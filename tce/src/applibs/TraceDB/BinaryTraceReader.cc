@@ -0,0 +1,333 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTraceReader.cc
+ *
+ * Definition of BinaryTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryTraceReader.hh"
+#include "Conversion.hh"
+
+/**
+ * Constructor.
+ *
+ * @param chunks The chunks of the column to iterate.
+ */
+BinaryTraceReader::ColumnIterator::ColumnIterator(
+    const std::vector<Chunk>& chunks) :
+    chunks_(&chunks), chunk_(0), left_(0), position_(NULL), previous_(0) {
+
+    if (!chunks_->empty()) {
+        left_ = (*chunks_)[0].count;
+        position_ = (*chunks_)[0].data;
+    }
+}
+
+/**
+ * Returns true if the column has more values.
+ *
+ * @return True if next() returns a value.
+ */
+bool
+BinaryTraceReader::ColumnIterator::hasNext() const {
+    if (left_ > 0) {
+        return true;
+    }
+    for (std::size_t i = chunk_ + 1; i < chunks_->size(); ++i) {
+        if ((*chunks_)[i].count > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the next value of the column.
+ *
+ * @return The value.
+ * @exception OutOfRange If there are no more values or the chunk is
+ * corrupted.
+ */
+int64_t
+BinaryTraceReader::ColumnIterator::next() {
+    while (left_ == 0) {
+        if (chunk_ + 1 >= chunks_->size()) {
+            throw OutOfRange(
+                __FILE__, __LINE__, __func__, "No more values in column.");
+        }
+        ++chunk_;
+        const Chunk& chunk = (*chunks_)[chunk_];
+        left_ = chunk.count;
+        position_ = chunk.data;
+        previous_ = 0;
+    }
+    const Chunk& chunk = (*chunks_)[chunk_];
+    previous_ = BinaryTrace::readDelta(
+        position_, chunk.data + chunk.size, previous_);
+    --left_;
+    return previous_;
+}
+
+/**
+ * Constructor.
+ *
+ * Maps the file to memory and indexes its chunks.
+ *
+ * @param fileName The trace file.
+ * @param columnCount The number of column ids of the file format, the
+ * column ids of the file must be smaller.
+ * @exception IOException If the file cannot be read or is not a binary
+ * trace.
+ */
+BinaryTraceReader::BinaryTraceReader(
+    const std::string& fileName, BinaryTrace::ColumnID columnCount) :
+    fileName_(fileName), mapping_(NULL), size_(0),
+    columnCount_(columnCount) {
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        std::string error = std::strerror(errno);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot open trace file '" + fileName + "': " + error);
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+        mapping_ = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    int mapError = errno;
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = NULL;
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot map trace file '" + fileName + "': " +
+            std::strerror(mapError));
+    }
+
+    try {
+        indexChunks();
+    } catch (const Exception& e) {
+        if (mapping_ != NULL) {
+            munmap(mapping_, size_);
+            mapping_ = NULL;
+        }
+        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    }
+}
+
+/**
+ * Destructor.
+ *
+ * Unmaps the file.
+ */
+BinaryTraceReader::~BinaryTraceReader() {
+    if (mapping_ != NULL) {
+        munmap(mapping_, size_);
+        mapping_ = NULL;
+    }
+}
+
+/**
+ * Checks the file header and indexes the chunks of the mapped file.
+ *
+ * A chunk cut short by a writer that has not finished is ignored.
+ *
+ * @exception IOException If the file is not a binary trace.
+ * @exception OutOfRange If a column id or the string table is corrupted.
+ */
+void
+BinaryTraceReader::indexChunks() {
+    const unsigned char* data = static_cast<const unsigned char*>(mapping_);
+    const unsigned char* end = data + size_;
+    if (size_ < BinaryTrace::HEADER_SIZE ||
+        std::string(data, data + BinaryTrace::MAGIC.size()) !=
+        BinaryTrace::MAGIC ||
+        BinaryTrace::readUInt32(data + BinaryTrace::MAGIC.size()) !=
+        BinaryTrace::FORMAT_VERSION) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "'" + fileName_ + "' is not a trace file of this TCE version.");
+    }
+
+    data += BinaryTrace::HEADER_SIZE;
+    while (static_cast<std::size_t>(end - data) >=
+           BinaryTrace::CHUNK_HEADER_SIZE) {
+        BinaryTrace::ColumnID column = BinaryTrace::readUInt32(data);
+        Chunk chunk;
+        chunk.flags = BinaryTrace::readUInt32(data + 4);
+        chunk.count = BinaryTrace::readUInt32(data + 8);
+        chunk.size = BinaryTrace::readUInt32(data + 12);
+        chunk.first = BinaryTrace::readInt64(data + 16);
+        chunk.last = BinaryTrace::readInt64(data + 24);
+        chunk.data = data + BinaryTrace::CHUNK_HEADER_SIZE;
+        if (static_cast<std::size_t>(end - chunk.data) < chunk.size) {
+            break;
+        }
+        data = chunk.data + chunk.size;
+
+        if (column >= columnCount_) {
+            throw OutOfRange(
+                __FILE__, __LINE__, __func__,
+                "Unknown column in '" + fileName_ + "'.");
+        }
+        if (column >= chunks_.size()) {
+            chunks_.resize(column + 1);
+        }
+        chunks_[column].push_back(chunk);
+
+        if (column == BinaryTrace::STRING_TABLE_COLUMN) {
+            const unsigned char* string = chunk.data;
+            for (uint32_t i = 0; i < chunk.count; ++i) {
+                std::size_t length = BinaryTrace::readVarUInt(string, data);
+                if (static_cast<std::size_t>(data - string) < length) {
+                    throw OutOfRange(
+                        __FILE__, __LINE__, __func__,
+                        "Corrupted string table in '" + fileName_ + "'.");
+                }
+                strings_.push_back(std::string(string, string + length));
+                string += length;
+            }
+        }
+    }
+}
+
+/**
+ * Returns the string table of the file.
+ *
+ * @return The strings in the order of their indices.
+ */
+const std::vector<std::string>&
+BinaryTraceReader::strings() const {
+    return strings_;
+}
+
+/**
+ * Returns a string of the string table.
+ *
+ * @param index The index of the string, the value in a string column.
+ * @return The string.
+ * @exception OutOfRange If there is no string with the index.
+ */
+const std::string&
+BinaryTraceReader::string(int64_t index) const {
+    if (index < 0 || static_cast<uint64_t>(index) >= strings_.size()) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "No string " + Conversion::toString(index) + " in '" +
+            fileName_ + "'.");
+    }
+    return strings_[index];
+}
+
+/**
+ * Returns the number of values in a column.
+ *
+ * @param column The column.
+ * @return The number of values, 0 if the file has no such column.
+ */
+std::size_t
+BinaryTraceReader::valueCount(BinaryTrace::ColumnID column) const {
+    if (column >= chunks_.size()) {
+        return 0;
+    }
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < chunks_[column].size(); ++i) {
+        count += chunks_[column][i].count;
+    }
+    return count;
+}
+
+/**
+ * Returns true if the values of a column are in strictly ascending order.
+ *
+ * Only the chunk headers are read.
+ *
+ * @param column The column.
+ * @return True if the column is sorted.
+ */
+bool
+BinaryTraceReader::isSorted(BinaryTrace::ColumnID column) const {
+    if (column >= chunks_.size()) {
+        return true;
+    }
+    const std::vector<Chunk>& chunks = chunks_[column];
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        if ((chunks[i].flags & BinaryTrace::CHUNK_SORTED) == 0 ||
+            (i > 0 && chunks[i].first <= chunks[i - 1].last)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the last value of a column.
+ *
+ * Only the chunk headers are read.
+ *
+ * @param column The column.
+ * @return The last value.
+ * @exception OutOfRange If the column has no values.
+ */
+int64_t
+BinaryTraceReader::lastValue(BinaryTrace::ColumnID column) const {
+    if (column >= chunks_.size() || chunks_[column].empty()) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__, "The column has no values.");
+    }
+    return chunks_[column].back().last;
+}
+
+/**
+ * Returns an iterator to the values of a column.
+ *
+ * The iterator is valid as long as the reader.
+ *
+ * @param column The column.
+ * @return The iterator, without values if the file has no such column.
+ */
+BinaryTraceReader::ColumnIterator
+BinaryTraceReader::column(BinaryTrace::ColumnID column) const {
+    static const std::vector<Chunk> noChunks;
+    if (column >= chunks_.size()) {
+        return ColumnIterator(noChunks);
+    }
+    return ColumnIterator(chunks_[column]);
+}
@@ -0,0 +1,125 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTraceReader.hh
+ *
+ * Declaration of BinaryTraceReader class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_TRACE_READER_HH
+#define TTA_BINARY_TRACE_READER_HH
+
+#include <string>
+#include <vector>
+
+#include "BinaryTrace.hh"
+#include "Exception.hh"
+
+/**
+ * Reads a binary trace file.
+ *
+ * The file is mapped to memory and only the chunk headers are read when
+ * the file is opened. The values of a column are decoded on demand by
+ * iterating it with a ColumnIterator. See BinaryTrace for the format.
+ *
+ * The reader sees the chunks that were in the file when it was opened.
+ */
+class BinaryTraceReader {
+public:
+    /// A chunk of a column in the mapped file.
+    struct Chunk {
+        /// The encoded values.
+        const unsigned char* data;
+        /// Size of the encoded values in bytes.
+        std::size_t size;
+        /// The number of values.
+        uint32_t count;
+        /// The chunk flags.
+        uint32_t flags;
+        /// The first value of the chunk.
+        int64_t first;
+        /// The last value of the chunk.
+        int64_t last;
+    };
+
+    /**
+     * Iterates the values of a column in order.
+     */
+    class ColumnIterator {
+    public:
+        ColumnIterator(const std::vector<Chunk>& chunks);
+
+        bool hasNext() const;
+        int64_t next();
+
+    private:
+        /// The chunks of the column.
+        const std::vector<Chunk>* chunks_;
+        /// Index of the current chunk.
+        std::size_t chunk_;
+        /// Number of values left in the current chunk.
+        uint32_t left_;
+        /// The next encoded value of the current chunk.
+        const unsigned char* position_;
+        /// The previous value of the current chunk.
+        int64_t previous_;
+    };
+
+    BinaryTraceReader(
+        const std::string& fileName, BinaryTrace::ColumnID columnCount);
+    virtual ~BinaryTraceReader();
+
+    const std::vector<std::string>& strings() const;
+    const std::string& string(int64_t index) const;
+
+    std::size_t valueCount(BinaryTrace::ColumnID column) const;
+    bool isSorted(BinaryTrace::ColumnID column) const;
+    int64_t lastValue(BinaryTrace::ColumnID column) const;
+    ColumnIterator column(BinaryTrace::ColumnID column) const;
+
+private:
+    void indexChunks();
+
+    /// Copying not allowed.
+    BinaryTraceReader(const BinaryTraceReader&);
+    /// Assignment not allowed.
+    BinaryTraceReader& operator=(const BinaryTraceReader&);
+
+    /// The trace file.
+    std::string fileName_;
+    /// The mapped file, NULL if the file is empty.
+    void* mapping_;
+    /// Size of the mapped file.
+    std::size_t size_;
+    /// The number of column ids of the file format.
+    BinaryTrace::ColumnID columnCount_;
+    /// The chunks of each column indexed by the column id.
+    std::vector<std::vector<Chunk> > chunks_;
+    /// The string table.
+    std::vector<std::string> strings_;
+};
+
+#endif
@@ -0,0 +1,213 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTraceWriter.cc
+ *
+ * Definition of BinaryTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "BinaryTraceWriter.hh"
+#include "BlockFileWriter.hh"
+#include "Application.hh"
+
+const std::size_t BinaryTraceWriter::CHUNK_SIZE = 64 * 1024;
+const std::size_t BinaryTraceWriter::MAX_QUEUED_CHUNKS = 64;
+
+/**
+ * Constructor.
+ *
+ * Creates the trace file, or appends to it if it exists.
+ *
+ * @param fileName The trace file.
+ * @param strings The string table of the existing file, if the file
+ * exists.
+ * @exception IOException If the file cannot be opened for writing.
+ */
+BinaryTraceWriter::BinaryTraceWriter(
+    const std::string& fileName, const std::vector<std::string>& strings) :
+    writer_(NULL) {
+
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        stringIndices_[strings[i]] = i;
+    }
+
+    std::FILE* file = std::fopen(fileName.c_str(), "ab");
+    if (file == NULL) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot open trace file '" + fileName + "' for writing: " +
+            std::strerror(errno));
+    }
+    if (std::ftell(file) == 0) {
+        std::vector<unsigned char> header(
+            BinaryTrace::MAGIC.begin(), BinaryTrace::MAGIC.end());
+        BinaryTrace::writeUInt32(header, BinaryTrace::FORMAT_VERSION);
+        if (std::fwrite(&header[0], 1, header.size(), file) !=
+            header.size()) {
+            std::fclose(file);
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Cannot write trace file '" + fileName + "'.");
+        }
+    }
+
+    writer_ = new BlockFileWriter(file, MAX_QUEUED_CHUNKS, "trace");
+}
+
+/**
+ * Destructor.
+ *
+ * Writes the buffered values to the file and closes it.
+ */
+BinaryTraceWriter::~BinaryTraceWriter() {
+    try {
+        flush();
+    } catch (const Exception& e) {
+        debugLog(
+            "Exception almost leaked from ~BinaryTraceWriter! Message: " +
+            e.errorMessage());
+    }
+    delete writer_;
+    writer_ = NULL;
+}
+
+/**
+ * Appends a value to a column.
+ *
+ * @param column The column.
+ * @param value The value.
+ * @exception IOException If writing the file has failed.
+ */
+void
+BinaryTraceWriter::addValue(BinaryTrace::ColumnID column, int64_t value) {
+    if (column >= columns_.size()) {
+        columns_.resize(column + 1);
+    }
+    ColumnBuffer& buffer = columns_[column];
+    if (buffer.count == 0) {
+        buffer.first = value;
+        BinaryTrace::writeDelta(buffer.data, 0, value);
+    } else {
+        if (value <= buffer.last) {
+            buffer.sorted = false;
+        }
+        BinaryTrace::writeDelta(buffer.data, buffer.last, value);
+    }
+    buffer.last = value;
+    ++buffer.count;
+
+    if (buffer.data.size() >= CHUNK_SIZE) {
+        emitChunk(column, buffer);
+    }
+}
+
+/**
+ * Returns the index of the string in the string table.
+ *
+ * The string is added to the table if it is not there yet.
+ *
+ * @param string The string.
+ * @return The index to store in a string column.
+ * @exception IOException If writing the file has failed.
+ */
+int64_t
+BinaryTraceWriter::stringIndex(const std::string& string) {
+    std::map<std::string, int64_t>::const_iterator i =
+        stringIndices_.find(string);
+    if (i != stringIndices_.end()) {
+        return i->second;
+    }
+
+    int64_t index = stringIndices_.size();
+    stringIndices_[string] = index;
+
+    if (columns_.empty()) {
+        columns_.resize(1);
+    }
+    ColumnBuffer& table = columns_[BinaryTrace::STRING_TABLE_COLUMN];
+    BinaryTrace::writeVarUInt(table.data, string.size());
+    table.data.insert(table.data.end(), string.begin(), string.end());
+    table.sorted = false;
+    ++table.count;
+    if (table.data.size() >= CHUNK_SIZE) {
+        emitChunk(BinaryTrace::STRING_TABLE_COLUMN, table);
+    }
+    return index;
+}
+
+/**
+ * Writes all the buffered values to the file.
+ *
+ * Returns after the writer thread has written them.
+ *
+ * @exception IOException If writing the file has failed.
+ */
+void
+BinaryTraceWriter::flush() {
+    for (std::size_t column = 0; column < columns_.size(); ++column) {
+        emitChunk(column, columns_[column]);
+    }
+    writer_->flush();
+}
+
+/**
+ * Passes the buffered values of a column to the writer thread.
+ *
+ * Waits if the writer thread has too many chunks queued already.
+ *
+ * @param column The column.
+ * @param buffer The buffer of the column, empty after the call.
+ * @exception IOException If writing the file has failed.
+ */
+void
+BinaryTraceWriter::emitChunk(
+    BinaryTrace::ColumnID column, ColumnBuffer& buffer) {
+    if (buffer.count == 0) {
+        return;
+    }
+
+    std::vector<unsigned char>* chunk = writer_->freeBlock();
+    chunk->clear();
+    chunk->reserve(BinaryTrace::CHUNK_HEADER_SIZE + buffer.data.size());
+    BinaryTrace::writeUInt32(*chunk, column);
+    BinaryTrace::writeUInt32(
+        *chunk, buffer.sorted ? BinaryTrace::CHUNK_SORTED : 0);
+    BinaryTrace::writeUInt32(*chunk, buffer.count);
+    BinaryTrace::writeUInt32(*chunk, buffer.data.size());
+    BinaryTrace::writeInt64(*chunk, buffer.first);
+    BinaryTrace::writeInt64(*chunk, buffer.last);
+    chunk->insert(chunk->end(), buffer.data.begin(), buffer.data.end());
+
+    buffer.data.clear();
+    buffer.count = 0;
+    buffer.sorted = true;
+
+    writer_->write(chunk, chunk->size());
+}
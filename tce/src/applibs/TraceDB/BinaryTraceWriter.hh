@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryTraceWriter.hh
+ *
+ * Declaration of BinaryTraceWriter class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_TRACE_WRITER_HH
+#define TTA_BINARY_TRACE_WRITER_HH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BinaryTrace.hh"
+#include "Exception.hh"
+
+class BlockFileWriter;
+
+/**
+ * Appends columns of values to a binary trace file.
+ *
+ * The values are encoded to per-column buffers in the calling thread.
+ * Full buffers are written to the file as chunks by a background thread,
+ * thus the caller waits for the disk only if the writer falls behind by
+ * more than a bounded number of chunks. See BinaryTrace for the format.
+ */
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter(
+        const std::string& fileName,
+        const std::vector<std::string>& strings =
+        std::vector<std::string>());
+    virtual ~BinaryTraceWriter();
+
+    void addValue(BinaryTrace::ColumnID column, int64_t value);
+    int64_t stringIndex(const std::string& string);
+    void flush();
+
+private:
+    /// The values of a column not yet passed to the writer thread.
+    struct ColumnBuffer {
+        ColumnBuffer() :
+            count(0), first(0), last(0), sorted(true) {}
+        /// The encoded values.
+        std::vector<unsigned char> data;
+        /// The number of values in the buffer.
+        uint32_t count;
+        /// The first value in the buffer.
+        int64_t first;
+        /// The last value in the buffer.
+        int64_t last;
+        /// True if the values are in strictly ascending order.
+        bool sorted;
+    };
+
+    void emitChunk(BinaryTrace::ColumnID column, ColumnBuffer& buffer);
+
+    /// Copying not allowed.
+    BinaryTraceWriter(const BinaryTraceWriter&);
+    /// Assignment not allowed.
+    BinaryTraceWriter& operator=(const BinaryTraceWriter&);
+
+    /// Writes the chunks to the trace file.
+    BlockFileWriter* writer_;
+    /// The buffers of the columns indexed by the column id.
+    std::vector<ColumnBuffer> columns_;
+    /// Indices of the strings in the string table.
+    std::map<std::string, int64_t> stringIndices_;
+    /// Size of a column buffer that is written as a chunk.
+    static const std::size_t CHUNK_SIZE;
+    /// The maximum number of chunks waiting to be written.
+    static const std::size_t MAX_QUEUED_CHUNKS;
+};
+
+#endif
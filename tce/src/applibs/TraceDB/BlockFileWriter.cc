@@ -0,0 +1,185 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BlockFileWriter.cc
+ *
+ * Definition of BlockFileWriter class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <boost/bind.hpp>
+
+#include "BlockFileWriter.hh"
+#include "SequenceTools.hh"
+
+/**
+ * Constructor.
+ *
+ * Starts the writer thread.
+ *
+ * @param file The file to write, closed by the destructor.
+ * @param maxQueuedBlocks The maximum number of blocks waiting to be
+ * written.
+ * @param description What is written, e.g. "trace", for the error
+ * messages.
+ */
+BlockFileWriter::BlockFileWriter(
+    std::FILE* file, std::size_t maxQueuedBlocks,
+    const std::string& description) :
+    file_(file), maxQueuedBlocks_(maxQueuedBlocks),
+    description_(description), writing_(false), closing_(false),
+    writerThread_(NULL) {
+
+    writerThread_ = new boost::thread(
+        boost::bind(&BlockFileWriter::writeBlocks, this));
+}
+
+/**
+ * Destructor.
+ *
+ * Writes the queued blocks, stops the writer thread and closes the file.
+ * Write errors not reported by flush() are ignored.
+ */
+BlockFileWriter::~BlockFileWriter() {
+    {
+        boost::mutex::scoped_lock lock(queueLock_);
+        closing_ = true;
+    }
+    blocksQueued_.notify_all();
+    writerThread_->join();
+    delete writerThread_;
+    writerThread_ = NULL;
+
+    SequenceTools::deleteAllItems(freeBlocks_);
+
+    std::fclose(file_);
+    file_ = NULL;
+}
+
+/**
+ * Returns a block to fill.
+ *
+ * The block is one written earlier, if there is such, and its contents
+ * are undefined.
+ *
+ * @return The block, owned by the caller until it is passed to write().
+ */
+std::vector<unsigned char>*
+BlockFileWriter::freeBlock() {
+    boost::mutex::scoped_lock lock(queueLock_);
+    if (freeBlocks_.empty()) {
+        return new std::vector<unsigned char>();
+    }
+    std::vector<unsigned char>* block = freeBlocks_.back();
+    freeBlocks_.pop_back();
+    return block;
+}
+
+/**
+ * Passes a block to the writer thread.
+ *
+ * Waits if the writer thread has too many blocks queued already.
+ *
+ * @param block The block, owned by the writer after the call.
+ * @param size The number of bytes to write from the start of the block.
+ * @exception IOException If writing the file has failed.
+ */
+void
+BlockFileWriter::write(std::vector<unsigned char>* block, std::size_t size) {
+    boost::mutex::scoped_lock lock(queueLock_);
+    while (queue_.size() >= maxQueuedBlocks_ && error_.empty()) {
+        blockWritten_.wait(lock);
+    }
+    if (!error_.empty()) {
+        freeBlocks_.push_back(block);
+        throw IOException(__FILE__, __LINE__, __func__, error_);
+    }
+    queue_.push_back(block);
+    queuedSizes_.push_back(size);
+    blocksQueued_.notify_one();
+}
+
+/**
+ * Writes all the queued blocks to the file.
+ *
+ * Returns after the writer thread has written them.
+ *
+ * @exception IOException If writing the file has failed.
+ */
+void
+BlockFileWriter::flush() {
+    boost::mutex::scoped_lock lock(queueLock_);
+    while (!queue_.empty() || writing_) {
+        blockWritten_.wait(lock);
+    }
+    // the writer thread is idle until more blocks are queued
+    if (std::fflush(file_) != 0 && error_.empty()) {
+        error_ = "Writing the " + description_ + " failed: " +
+            std::strerror(errno);
+    }
+    if (!error_.empty()) {
+        throw IOException(__FILE__, __LINE__, __func__, error_);
+    }
+}
+
+/**
+ * The main loop of the writer thread.
+ *
+ * Writes the queued blocks to the file until the writer is closed.
+ */
+void
+BlockFileWriter::writeBlocks() {
+    boost::mutex::scoped_lock lock(queueLock_);
+    while (true) {
+        while (queue_.empty() && !closing_) {
+            blocksQueued_.wait(lock);
+        }
+        if (queue_.empty()) {
+            return;
+        }
+        std::vector<unsigned char>* block = queue_.front();
+        std::size_t size = queuedSizes_.front();
+        queue_.pop_front();
+        queuedSizes_.pop_front();
+        writing_ = true;
+        lock.unlock();
+
+        bool failed =
+            size > 0 && std::fwrite(&(*block)[0], 1, size, file_) != size;
+        int errorCode = errno;
+
+        lock.lock();
+        freeBlocks_.push_back(block);
+        writing_ = false;
+        if (failed && error_.empty()) {
+            error_ = "Writing the " + description_ + " failed: " +
+                std::strerror(errorCode);
+        }
+        blockWritten_.notify_all();
+    }
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BlockFileWriter.hh
+ *
+ * Declaration of BlockFileWriter class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BLOCK_FILE_WRITER_HH
+#define TTA_BLOCK_FILE_WRITER_HH
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "Exception.hh"
+
+/**
+ * Writes blocks of bytes to a file in a background thread.
+ *
+ * The caller waits for the disk only if the writer thread falls behind by
+ * more than a bounded number of blocks. The written blocks are kept for
+ * reuse, so filling the blocks need not allocate once the writer is
+ * running. Used by the binary trace writers.
+ */
+class BlockFileWriter {
+public:
+    BlockFileWriter(
+        std::FILE* file, std::size_t maxQueuedBlocks,
+        const std::string& description);
+    virtual ~BlockFileWriter();
+
+    std::vector<unsigned char>* freeBlock();
+    void write(std::vector<unsigned char>* block, std::size_t size);
+    void flush();
+
+private:
+    void writeBlocks();
+
+    /// Copying not allowed.
+    BlockFileWriter(const BlockFileWriter&);
+    /// Assignment not allowed.
+    BlockFileWriter& operator=(const BlockFileWriter&);
+
+    /// The file, owned by the writer.
+    std::FILE* file_;
+    /// The maximum number of blocks waiting to be written.
+    std::size_t maxQueuedBlocks_;
+    /// What is written, for the error messages.
+    std::string description_;
+    /// Blocks waiting to be written by the writer thread.
+    std::deque<std::vector<unsigned char>*> queue_;
+    /// The numbers of bytes to write from the queued blocks.
+    std::deque<std::size_t> queuedSizes_;
+    /// Written blocks that can be reused.
+    std::vector<std::vector<unsigned char>*> freeBlocks_;
+    /// True while the writer thread is writing a block.
+    bool writing_;
+    /// True when the writer thread should exit after the queued blocks.
+    bool closing_;
+    /// Description of the first write error, empty if none.
+    std::string error_;
+    /// Guards the queue and the state shared with the writer thread.
+    boost::mutex queueLock_;
+    /// Signaled when blocks are queued or the writer is closed.
+    boost::condition_variable blocksQueued_;
+    /// Signaled when the writer thread has written a block.
+    boost::condition_variable blockWritten_;
+    /// The writer thread.
+    boost::thread* writerThread_;
+};
+
+#endif
@@ -31,82 +31,52 @@
  */
 
 #include <string>
-#include "boost/format.hpp"
+#include <cstring>
+#include <limits>
 
 #include "Application.hh"
 #include "ExecutionTrace.hh"
 #include "Conversion.hh"
 #include "InstructionExecution.hh"
 #include "FileSystem.hh"
-#include "SQLite.hh"
 #include "SimValue.hh"
-#include "RelationalDBQueryResult.hh"
-#include "DataObject.hh"
-
-/// database table creation queries (CQ)
-
-const std::string CQ_DATABASE_INFO =
-"CREATE TABLE database_info (" 
-"       version INTEGER PRIMARY KEY," 
-"       tpef_filename TEXT);";
-
-const std::string CQ_INSTRUCTION_EXECUTION =
-"CREATE TABLE instruction_execution (" 
-"       cycle INTEGER PRIMARY KEY," 
-"       address INTEGER NOT NULL);";
-
-const std::string CQ_PROCEDURE_ADDRESS_RANGE =
-"CREATE TABLE procedure_address_range ("
-"       first_address INTEGER UNIQUE, "
-"       last_address INTEGER UNIQUE, "
-"       procedure_name TEXT NOT NULL);";
-
-const std::string CQ_BUS_ACTIVITY = 
-"CREATE TABLE bus_activity ("
-"       cycle INTEGER NOT NULL,"
-"       bus TEXT NOT NULL,"
-"       segment TEXT NOT NULL,"
-"       squash BOOLEAN DEFAULT false,"
-"       data_as_int INTEGER,"
-"       data_as_double REAL);";
-
-const std::string CQ_CONCURRENT_REGISTER_FILE_ACCESS = 
-"CREATE TABLE concurrent_register_file_access ("
-"       register_file TEXT NOT NULL,"
-"       reads INTEGER NOT NULL,"
-"       writes INTEGER NOT NULL,"
-"       count INTEGER NOT NULL);";
-
-const std::string CQ_REGISTER_ACCESS = 
-"CREATE TABLE register_access ("
-"       register_file TEXT NOT NULL,"
-"       register_index INTEGER NOT NULL,"
-"       reads INTEGER NOT NULL,"
-"       writes INTEGER NOT NULL);";
-
-const std::string CQ_FU_OPERATION_TRIGGERS = 
-"CREATE TABLE fu_operation_triggers ("
-"       function_unit TEXT NOT NULL,"
-"       operation TEXT NOT NULL,"
-"       count INTEGER NOT NULL);";
-
-const std::string CQ_BUS_WRITE_COUNTS = 
-"CREATE TABLE bus_write_counts ("
-"       bus TEXT NOT NULL,"
-"       writes INTEGER NOT NULL);";
-
-const std::string CQ_SOCKET_WRITE_COUNTS = 
-"CREATE TABLE socket_write_counts ("
-"       socket TEXT NOT NULL,"
-"       writes INTEGER NOT NULL);";
-
-const std::string CQ_TOTALS = 
-"CREATE TABLE totals ("
-"       value_name TEXT NOT NULL,"
-"       integer_value INTEGER);";
-
-/// the version number of the database schema
-const int DB_VERSION = 1;
+#include "BinaryTrace.hh"
+#include "BinaryTraceReader.hh"
+#include "BinaryTraceWriter.hh"
+
+/// The columns of the trace file. The columns with the same prefix form a
+/// table, string columns store indices to the string table of the file.
+/// The ids are part of the file format, new columns get new ids.
+enum TraceColumn {
+    INSTRUCTION_EXECUTION_CYCLE = 1,
+    INSTRUCTION_EXECUTION_ADDRESS = 2,
+    PROCEDURE_ADDRESS_RANGE_FIRST_ADDRESS = 3,
+    PROCEDURE_ADDRESS_RANGE_LAST_ADDRESS = 4,
+    PROCEDURE_ADDRESS_RANGE_PROCEDURE_NAME = 5, ///< string
+    BUS_ACTIVITY_CYCLE = 6,
+    BUS_ACTIVITY_BUS = 7, ///< string
+    BUS_ACTIVITY_SEGMENT = 8, ///< string
+    BUS_ACTIVITY_SQUASH = 9,
+    BUS_ACTIVITY_DATA_AS_INT = 10,
+    BUS_ACTIVITY_DATA_AS_DOUBLE = 11, ///< bit pattern of the double
+    CONCURRENT_RF_ACCESS_REGISTER_FILE = 12, ///< string
+    CONCURRENT_RF_ACCESS_READS = 13,
+    CONCURRENT_RF_ACCESS_WRITES = 14,
+    CONCURRENT_RF_ACCESS_COUNT = 15,
+    REGISTER_ACCESS_REGISTER_FILE = 16, ///< string
+    REGISTER_ACCESS_REGISTER_INDEX = 17,
+    REGISTER_ACCESS_READS = 18,
+    REGISTER_ACCESS_WRITES = 19,
+    FU_OPERATION_TRIGGERS_FUNCTION_UNIT = 20, ///< string
+    FU_OPERATION_TRIGGERS_OPERATION = 21, ///< string
+    FU_OPERATION_TRIGGERS_COUNT = 22,
+    BUS_WRITE_COUNTS_BUS = 23, ///< string
+    BUS_WRITE_COUNTS_WRITES = 24,
+    SOCKET_WRITE_COUNTS_SOCKET = 25, ///< string
+    SOCKET_WRITE_COUNTS_WRITES = 26,
+    TOTALS_CYCLE_COUNT = 27,
+    TRACE_COLUMN_COUNT ///< the number of column ids, not a column
+};
 
 /** 
  * Creates a new execution trace database.
@@ -117,8 +87,8 @@ const int DB_VERSION = 1;
  * 
  * The filenames are formed as follows:
  *
- * fileName             The main traceDB relational database file,
- *                      always created
+ * fileName             The main traceDB file in the binary trace format
+ *                      (see BinaryTrace), always created
  *                      (e.g. foobar.tpef.1.trace).
  * fileName.calls       The call trace, produced with 
  *                      'procedure_transfer_tracking' setting of ttasim 
@@ -127,6 +97,8 @@ const int DB_VERSION = 1;
  *                      'profile_data_saving' setting of ttasim
  *                      (e.g. foobar.tpef.1.trace.profile).
  *
+ * New data added to an existing writable database is appended to it.
+ *
  * @param fileName Full path to the traceDB file to be opened.
  * @return A pointer to opened execution trace database instance. Instance
  *         is owned by the client and should be deleted after use.
@@ -141,16 +113,8 @@ ExecutionTrace::open(const std::string& fileName) {
             fileName, FileSystem::fileExists(fileName) && 
             !FileSystem::fileIsWritable(fileName));
     try {
-        bool newDatabase = !FileSystem::fileExists(fileName);
         traceDB->open();
-        if (newDatabase) {
-            traceDB->initialize();	
-        } else {
-            // tests that the file is really a trace DB by querying the
-            // instruction_execution table
-            traceDB->instructionExecutions();
-        }
-    } catch (const RelationalDBException& e) {
+    } catch (const Exception& e) {
         delete traceDB;
         throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
     }
@@ -161,14 +125,23 @@ ExecutionTrace::open(const std::string& fileName) {
 /**
  * Initializes the trace files.
  *
- * For the traceDB sqlite file, starts a new transaction. Transaction is 
- * committed in destructor. This consumes lots of memory but should 
- * reduce I/O to the minimum.
+ * Loads the tables of an existing trace file and, unless the trace is
+ * read-only, starts the writer that appends to the file. The writer
+ * buffers the data and writes it in a background thread.
+ *
+ * @exception IOException If the trace file cannot be read or written.
  */
 void
 ExecutionTrace::open() {
-    dbConnection_ = &db_->connect(fileName_);
-    dbConnection_->beginTransaction();
+    std::vector<std::string> strings;
+    if (FileSystem::fileExists(fileName_)) {
+        BinaryTraceReader reader(fileName_, TRACE_COLUMN_COUNT);
+        loadTables(reader);
+        strings = reader.strings();
+    }
+    if (!readOnly_) {
+        writer_ = new BinaryTraceWriter(fileName_, strings);
+    }
 }
 
 /**
@@ -188,15 +161,16 @@ ExecutionTrace::ExecutionTrace(const std::string& fileName, bool readOnly) :
         (FileSystem::fileExists(fileName) || readOnly) ? 
         std::fstream::in : 
         std::fstream::out | std::fstream::trunc),
-    readOnly_(readOnly), db_(new SQLite()), 
-    dbConnection_(NULL), instructionExecution_(NULL)  {
+    readOnly_(readOnly), writer_(NULL), instructionExecution_(NULL),
+    hasInstructionExecutions_(false), lastExecutedCycle_(0),
+    simulatedCycleCount_(-1) {
 }
 
 /**
  * Destructor.
  *
- * Closes the database and frees the resources connected to it. Commits the
- * transaction so updates are written to disk.
+ * Closes the database and frees the resources connected to it. Writes the
+ * buffered data to disk.
  * 
  */
 ExecutionTrace::~ExecutionTrace() {
@@ -207,25 +181,12 @@ ExecutionTrace::~ExecutionTrace() {
             instructionExecution_ = NULL;
         }
 
-        if (dbConnection_ != NULL) {
-            dbConnection_->commit();
-            try {
-                assert(db_ != NULL);
-                db_->close(*dbConnection_);
-                dbConnection_ = NULL;
-            } catch (const RelationalDBException& e) {
-                Application::writeToErrorLog(
-                    __FILE__, __LINE__, __func__, e.errorMessage());
-            }
-        }
+        // flushes the file
+        delete writer_;
+        writer_ = NULL;
 
         callTrace_.close();
         instructionProfile_.close();
-
-        if (db_ != NULL) {
-            delete db_;
-            db_ = NULL;
-        }
     
     } catch (const Exception& e) {
         debugLog(
@@ -235,61 +196,152 @@ ExecutionTrace::~ExecutionTrace() {
 }
 
 /**
- * Initializes a new trace database.
+ * Loads the tables used by the queries from an existing trace file.
  *
- * @exception IOException If an I/O error occured.
+ * The tables of the statistics are small, thus they are kept in memory.
+ * The instruction executions are read from the file when queried.
+ *
+ * @param reader The reader of the trace file.
+ * @exception OutOfRange If the file is corrupted.
  */
 void
-ExecutionTrace::initialize() {
-    assert(dbConnection_ != NULL);
-    
-    try {
-        dbConnection_->DDLQuery(CQ_DATABASE_INFO);
-        dbConnection_->DDLQuery(CQ_INSTRUCTION_EXECUTION);
-        dbConnection_->DDLQuery(CQ_PROCEDURE_ADDRESS_RANGE);
-        dbConnection_->DDLQuery(CQ_BUS_ACTIVITY);
-        dbConnection_->DDLQuery(CQ_REGISTER_ACCESS);
-        dbConnection_->DDLQuery(CQ_CONCURRENT_REGISTER_FILE_ACCESS);
-        dbConnection_->DDLQuery(CQ_TOTALS);
-        dbConnection_->DDLQuery(CQ_FU_OPERATION_TRIGGERS);
-        dbConnection_->DDLQuery(CQ_BUS_WRITE_COUNTS);
-        dbConnection_->DDLQuery(CQ_SOCKET_WRITE_COUNTS);
-
-        dbConnection_->updateQuery(
-            (boost::format(
-                "INSERT INTO database_info(version) VALUES (%d);") %
-             DB_VERSION).str());
-
-    } catch (const RelationalDBException& e) {
-        debugLog(
-            std::string("") + "Error while initializing TraceDB. " +
-            e.errorMessage());
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+ExecutionTrace::loadTables(const BinaryTraceReader& reader) {
+
+    BinaryTraceReader::ColumnIterator registerFiles =
+        reader.column(CONCURRENT_RF_ACCESS_REGISTER_FILE);
+    BinaryTraceReader::ColumnIterator reads =
+        reader.column(CONCURRENT_RF_ACCESS_READS);
+    BinaryTraceReader::ColumnIterator writes =
+        reader.column(CONCURRENT_RF_ACCESS_WRITES);
+    BinaryTraceReader::ColumnIterator counts =
+        reader.column(CONCURRENT_RF_ACCESS_COUNT);
+    while (registerFiles.hasNext()) {
+        const std::string& registerFile =
+            reader.string(registerFiles.next());
+        RegisterAccessCount readCount = reads.next();
+        RegisterAccessCount writeCount = writes.next();
+        rfAccessCounts_[registerFile].push_back(
+            boost::make_tuple(readCount, writeCount, counts.next()));
+    }
+
+    BinaryTraceReader::ColumnIterator functionUnits =
+        reader.column(FU_OPERATION_TRIGGERS_FUNCTION_UNIT);
+    BinaryTraceReader::ColumnIterator operations =
+        reader.column(FU_OPERATION_TRIGGERS_OPERATION);
+    BinaryTraceReader::ColumnIterator triggers =
+        reader.column(FU_OPERATION_TRIGGERS_COUNT);
+    while (functionUnits.hasNext()) {
+        const std::string& functionUnit =
+            reader.string(functionUnits.next());
+        const std::string& operation = reader.string(operations.next());
+        operationTriggerCounts_[functionUnit].push_back(
+            boost::make_tuple(operation, triggers.next()));
+    }
+
+    BinaryTraceReader::ColumnIterator sockets =
+        reader.column(SOCKET_WRITE_COUNTS_SOCKET);
+    BinaryTraceReader::ColumnIterator socketWrites =
+        reader.column(SOCKET_WRITE_COUNTS_WRITES);
+    while (sockets.hasNext()) {
+        const std::string& socket = reader.string(sockets.next());
+        socketWriteCounts_.insert(
+            std::make_pair(socket, socketWrites.next()));
+    }
+
+    BinaryTraceReader::ColumnIterator buses =
+        reader.column(BUS_WRITE_COUNTS_BUS);
+    BinaryTraceReader::ColumnIterator busWrites =
+        reader.column(BUS_WRITE_COUNTS_WRITES);
+    while (buses.hasNext()) {
+        const std::string& bus = reader.string(buses.next());
+        busWriteCounts_.insert(std::make_pair(bus, busWrites.next()));
+    }
+
+    BinaryTraceReader::ColumnIterator totals =
+        reader.column(TOTALS_CYCLE_COUNT);
+    if (totals.hasNext()) {
+        simulatedCycleCount_ = totals.next();
+    }
+
+    if (reader.valueCount(INSTRUCTION_EXECUTION_CYCLE) > 0) {
+        hasInstructionExecutions_ = true;
+        // without order, every new cycle must be checked for duplicates
+        lastExecutedCycle_ =
+            reader.isSorted(INSTRUCTION_EXECUTION_CYCLE) ?
+            reader.lastValue(INSTRUCTION_EXECUTION_CYCLE) :
+            std::numeric_limits<ClockCycleCount>::max();
     }
 }
 
+/**
+ * Returns the writer of the trace file.
+ *
+ * @return The writer.
+ * @exception IOException If the trace is read-only.
+ */
+BinaryTraceWriter&
+ExecutionTrace::writer() {
+    if (writer_ == NULL) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Trace file '" + fileName_ + "' is read-only.");
+    }
+    return *writer_;
+}
+
 /**
  * Adds a new instruction execution record to the database.
  *
+ * The records are expected in the order of the cycles. Records added out
+ * of order are accepted but are slow to add and to query.
+ *
  * @param cycle The clock cycle on which the instruction execution happened.
  * @param address The address of the executed instruction.
- * @exception IOException In case an error in adding the data happened.
+ * @exception IOException In case an error in adding the data happened,
+ *                        e.g., if there is a record of the cycle already.
  */
 void
 ExecutionTrace::addInstructionExecution(
     ClockCycleCount cycle, InstructionAddress address) {
-    const std::string query =
-      (boost::format(
-        "INSERT INTO instruction_execution(cycle, address) VALUES(" 
-	"%.0f, %d);") % cycle % address).str();
 
-    assert(dbConnection_ != NULL);
+    if (hasInstructionExecutions_ && cycle <= lastExecutedCycle_) {
+        if (hasInstructionExecution(cycle)) {
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Instruction execution of cycle " +
+                Conversion::toString(cycle) + " is in the trace already.");
+        }
+    } else {
+        lastExecutedCycle_ = cycle;
+        hasInstructionExecutions_ = true;
+    }
+    writer().addValue(INSTRUCTION_EXECUTION_CYCLE, cycle);
+    writer().addValue(INSTRUCTION_EXECUTION_ADDRESS, address);
+}
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+/**
+ * Returns true if there is an instruction execution record of the cycle.
+ *
+ * Scans the whole trace.
+ *
+ * @param cycle The clock cycle.
+ * @return True if the record exists.
+ * @exception IOException If the trace cannot be read.
+ */
+bool
+ExecutionTrace::hasInstructionExecution(ClockCycleCount cycle) {
+    if (writer_ != NULL) {
+        writer_->flush();
     }
+    BinaryTraceReader reader(fileName_, TRACE_COLUMN_COUNT);
+    BinaryTraceReader::ColumnIterator cycles =
+        reader.column(INSTRUCTION_EXECUTION_CYCLE);
+    while (cycles.hasNext()) {
+        if (cycles.next() == cycle) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -304,20 +356,6 @@ void
 ExecutionTrace::addInstructionExecutionCount(
     InstructionAddress address, ClockCycleCount count) {
     instructionProfile_ << address << "\t" << count << std::endl;
-#if 0
-    const std::string query =
-        "INSERT INTO instruction_execution_count(address, count) VALUES(" + 
-        Conversion::toString(address) + ", " + 
-        Conversion::toString(count) + ");";
-
-    assert(dbConnection_ != NULL);
-
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
-#endif
 }
 
 /**
@@ -335,20 +373,12 @@ void
 ExecutionTrace::addProcedureAddressRange(
     InstructionAddress firstAddress, InstructionAddress lastAddress,
     const std::string& procedureName) {
-    const std::string query =
-        "INSERT INTO procedure_address_range(first_address, last_address, "
-        "procedure_name) VALUES(" + 
-        Conversion::toString(firstAddress) + ", " + 
-        Conversion::toString(lastAddress) + ", '" + 
-        procedureName + "');";
-
-    assert(dbConnection_ != NULL);
-
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(PROCEDURE_ADDRESS_RANGE_FIRST_ADDRESS, firstAddress);
+    trace.addValue(PROCEDURE_ADDRESS_RANGE_LAST_ADDRESS, lastAddress);
+    trace.addValue(
+        PROCEDURE_ADDRESS_RANGE_PROCEDURE_NAME,
+        trace.stringIndex(procedureName));
 }
 
 /**
@@ -367,9 +397,12 @@ ExecutionTrace::instructionExecutions() {
     }
 
     try {
+        if (writer_ != NULL) {
+            writer_->flush();
+        }
         instructionExecution_ = new InstructionExecution(
-            dbConnection_->query(
-                "SELECT * FROM instruction_execution ORDER BY cycle"));
+            new BinaryTraceReader(fileName_, TRACE_COLUMN_COUNT),
+            INSTRUCTION_EXECUTION_CYCLE, INSTRUCTION_EXECUTION_ADDRESS);
     } catch (const Exception& e) {
         throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
     } 
@@ -391,36 +424,23 @@ void
 ExecutionTrace::addBusActivity(
     ClockCycleCount cycle, const BusID& busId, const SegmentID& segmentId,
     bool squash, const SimValue& data) {
-    std::string query = 
-        "INSERT INTO bus_activity(cycle, bus, segment, squash, "
-        "data_as_int, data_as_double) VALUES(" + 
-        Conversion::toString(cycle) + ", '" + busId + "', '" + segmentId + 
-        "', ";
-
-    if (squash) 
-        query += "'TRUE'";
-    else
-        query += "'FALSE'";
-
-    std::string doubleString = Conversion::toString(data.doubleWordValue());
-    if (doubleString == "nan")
-        doubleString = "NULL";
-
-    if (!squash && &data != &NullSimValue::instance())
-        query += ", " + Conversion::toString(data.uIntWordValue()) + ", " + 
-            doubleString + ")";        
-    else
-        query += ", 0, 0.0)";
- 
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(std::string("query: ") + query);
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    int64_t intData = 0;
+    double doubleData = 0.0;
+    if (!squash && &data != &NullSimValue::instance()) {
+        intData = data.uIntWordValue();
+        doubleData = data.doubleWordValue();
     }
+    int64_t doubleBits = 0;
+    std::memcpy(&doubleBits, &doubleData, sizeof(doubleBits));
+
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(BUS_ACTIVITY_CYCLE, cycle);
+    trace.addValue(BUS_ACTIVITY_BUS, trace.stringIndex(busId));
+    trace.addValue(BUS_ACTIVITY_SEGMENT, trace.stringIndex(segmentId));
+    trace.addValue(BUS_ACTIVITY_SQUASH, squash);
+    trace.addValue(BUS_ACTIVITY_DATA_AS_INT, intData);
+    trace.addValue(BUS_ACTIVITY_DATA_AS_DOUBLE, doubleBits);
 }
 
 /**
@@ -440,23 +460,16 @@ void
 ExecutionTrace::addConcurrentRegisterFileAccessCount(
     RegisterFileID registerFile, RegisterAccessCount reads,
     RegisterAccessCount writes, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO concurrent_register_file_access("
-        "                register_file, reads, writes, count) "
-        "VALUES('" + registerFile + "', " +
-        Conversion::toString(reads) + ", " +
-        Conversion::toString(writes) + ", " +
-        Conversion::toString(count) + ")";
 
-    assert(dbConnection_ != NULL);
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(
+        CONCURRENT_RF_ACCESS_REGISTER_FILE, trace.stringIndex(registerFile));
+    trace.addValue(CONCURRENT_RF_ACCESS_READS, reads);
+    trace.addValue(CONCURRENT_RF_ACCESS_WRITES, writes);
+    trace.addValue(CONCURRENT_RF_ACCESS_COUNT, count);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    rfAccessCounts_[registerFile].push_back(
+        boost::make_tuple(reads, writes, count));
 }
 
 /**
@@ -475,21 +488,13 @@ void
 ExecutionTrace::addRegisterAccessCount(
     RegisterFileID registerFile, RegisterID registerIndex,
     ClockCycleCount reads, ClockCycleCount writes) {
-    const std::string query =
-        (boost::format(
-            "INSERT INTO register_access("
-            "                register_file, register_index, reads, writes) "
-            "VALUES('%s', %d, %.0f, %.0f)") 
-         % registerFile % registerIndex % reads % writes).str();
-
-    assert(dbConnection_ != NULL);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(
+        REGISTER_ACCESS_REGISTER_FILE, trace.stringIndex(registerFile));
+    trace.addValue(REGISTER_ACCESS_REGISTER_INDEX, registerIndex);
+    trace.addValue(REGISTER_ACCESS_READS, reads);
+    trace.addValue(REGISTER_ACCESS_WRITES, writes);
 }
 
 /**
@@ -499,36 +504,15 @@ ExecutionTrace::addRegisterAccessCount(
  *
  * @param registerFile The register file for which the stats are needed.
  * @return A list of accesses. Must be deleted by the client after use.
- * @exception IOException If an I/O error occurs.
  */
 ExecutionTrace::ConcurrentRFAccessCountList*
 ExecutionTrace::registerFileAccessCounts(RegisterFileID registerFile) const {
-    ConcurrentRFAccessCountList* accesses = NULL;
-    try {
-        assert(dbConnection_ != NULL);
-
-        RelationalDBQueryResult* result =
-            dbConnection_->query(
-                std::string("") +
-                "SELECT * FROM concurrent_register_file_access " +
-                "WHERE register_file LIKE('" + registerFile + "')");
-        accesses = new ConcurrentRFAccessCountList();
-        while (result->hasNext()) {
-            result->next();
-            accesses->push_back(
-                boost::make_tuple(
-                    (result->data("reads")).integerValue(),
-                    (result->data("writes")).integerValue(),
-                    (result->data("count")).integerValue()));
-        }
-        delete result;
-        result = NULL;
-    } catch (const Exception& e) {
-        delete accesses;
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    std::map<RegisterFileID, ConcurrentRFAccessCountList>::const_iterator i =
+        rfAccessCounts_.find(registerFile);
+    if (i == rfAccessCounts_.end()) {
+        return new ConcurrentRFAccessCountList();
     }
-
-    return accesses;
+    return new ConcurrentRFAccessCountList(i->second);
 }
 
 /**
@@ -546,21 +530,16 @@ void
 ExecutionTrace::addFunctionUnitOperationTriggerCount(
     FunctionUnitID functionUnit, OperationID operation,
     OperationTriggerCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO fu_operation_triggers("
-        "                function_unit, operation, count) "
-        "VALUES('" + functionUnit + "', '" + operation + "', " +
-        Conversion::toString(count) + ")";
 
-    assert(dbConnection_ != NULL);
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(
+        FU_OPERATION_TRIGGERS_FUNCTION_UNIT, trace.stringIndex(functionUnit));
+    trace.addValue(
+        FU_OPERATION_TRIGGERS_OPERATION, trace.stringIndex(operation));
+    trace.addValue(FU_OPERATION_TRIGGERS_COUNT, count);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    operationTriggerCounts_[functionUnit].push_back(
+        boost::make_tuple(operation, count));
 }
 
 /**
@@ -585,36 +564,16 @@ ExecutionTrace::addProcedureTransfer(
  *
  * @param functionUnit The function unit for which the stats are needed.
  * @return A list of access counts. Must be deleted by the client after use.
- * @exception IOException If an I/O error occurs.
  */
 ExecutionTrace::FUOperationTriggerCountList*
 ExecutionTrace::functionUnitOperationTriggerCounts(
     FunctionUnitID functionUnit) const {
-    FUOperationTriggerCountList* accesses = NULL;
-    try {
-        assert(dbConnection_ != NULL);
-
-        RelationalDBQueryResult* result =
-            dbConnection_->query(
-                std::string("") +
-                "SELECT * FROM fu_operation_triggers WHERE function_unit "
-                "LIKE('" + functionUnit + "')");
-        accesses = new FUOperationTriggerCountList();
-        while (result->hasNext()) {
-            result->next();
-            accesses->push_back(
-                boost::make_tuple(
-                    (result->data("operation")).stringValue(),
-                    (result->data("count")).integerValue()));
-        }
-        delete result;
-        result = NULL;
-    } catch (const Exception& e) {
-        delete accesses;
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    std::map<FunctionUnitID, FUOperationTriggerCountList>::const_iterator i =
+        operationTriggerCounts_.find(functionUnit);
+    if (i == operationTriggerCounts_.end()) {
+        return new FUOperationTriggerCountList();
     }
-
-    return accesses;
+    return new FUOperationTriggerCountList(i->second);
 }
 
 /**
@@ -629,19 +588,11 @@ ExecutionTrace::functionUnitOperationTriggerCounts(
  */
 void
 ExecutionTrace::addSocketWriteCount(SocketID socket, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO socket_write_counts(socket, writes) "
-        "VALUES('" + socket + "', " + Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(SOCKET_WRITE_COUNTS_SOCKET, trace.stringIndex(socket));
+    trace.addValue(SOCKET_WRITE_COUNTS_WRITES, count);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    socketWriteCounts_.insert(std::make_pair(socket, count));
 }
 
 /**
@@ -654,24 +605,9 @@ ExecutionTrace::addSocketWriteCount(SocketID socket, ClockCycleCount count) {
  */
 ClockCycleCount
 ExecutionTrace::socketWriteCount(SocketID socket) const {
-
-    RelationalDBQueryResult* result = NULL;
-    ClockCycleCount count = 0;
-    try {
-        result = dbConnection_->query(
-            (boost::format(
-                "SELECT writes FROM socket_write_counts "
-                "WHERE socket LIKE('%s')") % socket).str());
-
-        if (result->hasNext()) {
-            result->next();
-            count = (result->data("writes")).integerValue();
-        }
-    } catch (const Exception&) {
-    } 
-    delete result;
-    result = NULL;
-    return count;
+    std::map<SocketID, ClockCycleCount>::const_iterator i =
+        socketWriteCounts_.find(socket);
+    return i == socketWriteCounts_.end() ? 0 : i->second;
 }
 
 /**
@@ -686,19 +622,11 @@ ExecutionTrace::socketWriteCount(SocketID socket) const {
  */
 void
 ExecutionTrace::addBusWriteCount(BusID bus, ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO bus_write_counts(bus, writes) "
-        "VALUES('" + bus + "', " + Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
+    BinaryTraceWriter& trace = writer();
+    trace.addValue(BUS_WRITE_COUNTS_BUS, trace.stringIndex(bus));
+    trace.addValue(BUS_WRITE_COUNTS_WRITES, count);
 
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
-    }
+    busWriteCounts_.insert(std::make_pair(bus, count));
 }
 
 /**
@@ -711,24 +639,9 @@ ExecutionTrace::addBusWriteCount(BusID bus, ClockCycleCount count) {
  */
 ClockCycleCount
 ExecutionTrace::busWriteCount(BusID bus) const {
-
-    RelationalDBQueryResult* result = NULL;
-    ClockCycleCount count = 0;
-    try {
-        result = dbConnection_->query(
-            (boost::format(
-                "SELECT writes FROM bus_write_counts "
-                "WHERE bus LIKE('%s')") % bus).str());
-
-        if (result->hasNext()) {
-            result->next();
-            count = (result->data("writes")).integerValue();
-        }
-    } catch (const Exception&) {
-    } 
-    delete result;
-    result = NULL;
-    return count;
+    std::map<BusID, ClockCycleCount>::const_iterator i =
+        busWriteCounts_.find(bus);
+    return i == busWriteCounts_.end() ? 0 : i->second;
 }
 
 /**
@@ -739,18 +652,9 @@ ExecutionTrace::busWriteCount(BusID bus) const {
  */
 void
 ExecutionTrace::setSimulatedCycleCount(ClockCycleCount count) {
-    const std::string query =
-        std::string("") +
-        "INSERT INTO totals(value_name, integer_value) "
-        "VALUES('cycle_count', " + Conversion::toString(count) + ")";
-
-    assert(dbConnection_ != NULL);
-
-    try {
-        dbConnection_->updateQuery(query);
-    } catch (const RelationalDBException& e) {
-        debugLog(query + " failed!");
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    writer().addValue(TOTALS_CYCLE_COUNT, count);
+    if (simulatedCycleCount_ < 0) {
+        simulatedCycleCount_ = count;
     }
 }
 
@@ -762,26 +666,10 @@ ExecutionTrace::setSimulatedCycleCount(ClockCycleCount count) {
  */
 ClockCycleCount
 ExecutionTrace::simulatedCycleCount() const {
-    RelationalDBQueryResult* result = NULL;
-    try {
-        result = dbConnection_->query(
-            "SELECT integer_value FROM totals "
-            "WHERE value_name LIKE('cycle_count')");
-        if (!result->hasNext()) {
-            delete result;
-            result = NULL;
-            throw IOException(
-                __FILE__, __LINE__, __func__, 
-                "No 'cycle_count' entry in 'totals' table.");
-        }
-        result->next();
-        ClockCycleCount count = (result->data("integer_value")).integerValue();
-        delete result;
-        result = NULL;
-        return count;
-    } catch (const Exception& e) {
-        delete result;
-        result = NULL;
-        throw IOException(__FILE__, __LINE__, __func__, e.errorMessage());
+    if (simulatedCycleCount_ < 0) {
+        throw IOException(
+            __FILE__, __LINE__, __func__, 
+            "No cycle count in trace '" + fileName_ + "'.");
     }
+    return simulatedCycleCount_;
 }
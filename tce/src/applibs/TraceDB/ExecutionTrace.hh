@@ -35,17 +35,19 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
 #include <fstream>
 
 #include "boost/tuple/tuple.hpp"
 
 #include "SimValue.hh"
 #include "FileSystem.hh"
-#include "RelationalDB.hh"
 #include "SimulatorConstants.hh"
 
 
 class InstructionExecution;
+class BinaryTraceReader;
+class BinaryTraceWriter;
 
 /**
  * The main class of the Execution Trace Database (TraceDB).
@@ -191,23 +193,39 @@ protected:
     void open();
 
 private:
-    void initialize();
+    void loadTables(const BinaryTraceReader& reader);
+    bool hasInstructionExecution(ClockCycleCount cycle);
+    BinaryTraceWriter& writer();
 
-    /// Filename of the trace database (sqlite file).
-    const std::string& fileName_;
+    /// Filename of the trace database (binary trace file).
+    const std::string fileName_;
     /// The call trace file.
     std::fstream callTrace_;
     /// The instruction profile file.
     std::fstream instructionProfile_;
     /// Is the database access mode read-only?
     bool readOnly_;
-    /// Handle to the sqlite trace database.
-    RelationalDB* db_;
-    /// Handle to the database connection;
-    RelationalDBConnection* dbConnection_;
+    /// Appends to the trace file, NULL if the trace is read-only.
+    BinaryTraceWriter* writer_;
     /// Handle object for the queries of instruction executions.
     InstructionExecution* instructionExecution_;
-    
+    /// True if the trace has instruction executions.
+    bool hasInstructionExecutions_;
+    /// The latest cycle of the instruction executions in the trace.
+    ClockCycleCount lastExecutedCycle_;
+
+    /// The concurrent register file accesses indexed by register file.
+    std::map<RegisterFileID, ConcurrentRFAccessCountList> rfAccessCounts_;
+    /// The operation trigger counts indexed by function unit.
+    std::map<FunctionUnitID, FUOperationTriggerCountList>
+    operationTriggerCounts_;
+    /// The socket write counts indexed by socket.
+    std::map<SocketID, ClockCycleCount> socketWriteCounts_;
+    /// The bus write counts indexed by bus.
+    std::map<BusID, ClockCycleCount> busWriteCounts_;
+    /// The total count of simulated cycles, -1 if not set.
+    ClockCycleCount simulatedCycleCount_;
+
 };
 
 #endif
@@ -30,10 +30,11 @@
  * @note rating: red
  */
 
+#include <algorithm>
+
 #include "Application.hh"
 #include "InstructionExecution.hh"
 #include "ExecutionTrace.hh" 
-#include "DataObject.hh"
 
 /**
  * Constructor.
@@ -41,17 +42,27 @@
  * Object is initialized to point to the first record in the record set,
  * if any.
  *
- * @param result The query result to traverse.
+ * @param reader The reader of the trace file, owned by the object.
+ * @param cycleColumn The column of the cycles of the records.
+ * @param addressColumn The column of the addresses of the records.
  */
-InstructionExecution::InstructionExecution(RelationalDBQueryResult* result) :
-    result_(result), addressColumnIndex_(-1), cycleColumnIndex_(-1) {
-    cycleColumnIndex_ = result_->column("cycle");
-    addressColumnIndex_ = result_->column("address");
+InstructionExecution::InstructionExecution(
+    BinaryTraceReader* reader, BinaryTrace::ColumnID cycleColumn,
+    BinaryTrace::ColumnID addressColumn) :
+    reader_(reader), cycles_(reader->column(cycleColumn)),
+    addresses_(reader->column(addressColumn)), useSorted_(false),
+    nextSorted_(0), hasCurrent_(false) {
+
+    if (!reader_->isSorted(cycleColumn)) {
+        while (cycles_.hasNext()) {
+            ClockCycleCount cycle = cycles_.next();
+            sortedExecutions_.push_back(
+                Execution(cycle, addresses_.next()));
+        }
+        std::stable_sort(sortedExecutions_.begin(), sortedExecutions_.end());
+        useSorted_ = true;
+    }
 
-    assert(addressColumnIndex_ > -1);
-    assert(cycleColumnIndex_ > -1);
-    assert(result != NULL);
-    
     if (hasNext()) {
         next();
     }
@@ -61,8 +72,8 @@ InstructionExecution::InstructionExecution(RelationalDBQueryResult* result) :
  * Destructor.
  */
 InstructionExecution::~InstructionExecution() {
-    delete result_;
-    result_ = NULL;
+    delete reader_;
+    reader_ = NULL;
 }
 
 /**
@@ -73,12 +84,12 @@ InstructionExecution::~InstructionExecution() {
  */
 ClockCycleCount
 InstructionExecution::cycle() const {
-    if (&result_->data(cycleColumnIndex_) == &NullDataObject::instance()) {
+    if (!hasCurrent_) {
         const std::string errorMsg =
             "Tried to fetch data from an empty result set.";
         throw NotAvailable(__FILE__, __LINE__, __func__, errorMsg);
     }
-    return result_->data(cycleColumnIndex_).integerValue();
+    return current_.first;
 }
 
 /**
@@ -89,12 +100,12 @@ InstructionExecution::cycle() const {
  */
 InstructionAddress
 InstructionExecution::address() const {
-    if (&result_->data(addressColumnIndex_) == &NullDataObject::instance()) {
+    if (!hasCurrent_) {
         const std::string errorMsg =
             "Tried to fetch data from an empty result set.";
         throw NotAvailable(__FILE__, __LINE__, __func__, errorMsg);
     }
-    return result_->data(addressColumnIndex_).integerValue();
+    return current_.second;
 }
 
 /**
@@ -104,10 +115,17 @@ InstructionExecution::address() const {
  */
 void
 InstructionExecution::next() {
-    if (!result_->hasNext()) {
+    if (!hasNext()) {
         throw NotAvailable(__FILE__, __LINE__, __func__, "No more results.");
     }
-    result_->next();
+    if (useSorted_) {
+        current_ = sortedExecutions_[nextSorted_];
+        ++nextSorted_;
+    } else {
+        current_.first = cycles_.next();
+        current_.second = addresses_.next();
+    }
+    hasCurrent_ = true;
 }
 
 /**
@@ -117,5 +135,8 @@ InstructionExecution::next() {
  */
 bool
 InstructionExecution::hasNext() const {
-    return result_->hasNext();
+    if (useSorted_) {
+        return nextSorted_ < sortedExecutions_.size();
+    }
+    return cycles_.hasNext();
 }
@@ -32,19 +32,27 @@
 #ifndef TTA_INSTRUCTION_EXECUTION_HH
 #define TTA_INSTRUCTION_EXECUTION_HH
  
+#include <utility>
+#include <vector>
+
 #include "Exception.hh"
 #include "ExecutionTrace.hh"
-#include "RelationalDBQueryResult.hh"
+#include "BinaryTraceReader.hh"
 #include "SimulatorConstants.hh"
 
 /**
  * Class used to navigate through the list of all execution cycles.
  *
  * This class is also used to access the data of the pointed record.
+ *
+ * The records are streamed from the trace file if they are in the order of
+ * the cycles in the file, otherwise they are read to memory and sorted.
  */
 class InstructionExecution {
 public:
-    InstructionExecution(RelationalDBQueryResult* result);
+    InstructionExecution(
+        BinaryTraceReader* reader, BinaryTrace::ColumnID cycleColumn,
+        BinaryTrace::ColumnID addressColumn);
     virtual ~InstructionExecution();
 
     ClockCycleCount cycle() const;
@@ -54,9 +62,25 @@ public:
     bool hasNext() const;
 
 private:
-    RelationalDBQueryResult* result_;
-    int addressColumnIndex_;
-    int cycleColumnIndex_;
+    /// A record of the trace.
+    typedef std::pair<ClockCycleCount, InstructionAddress> Execution;
+
+    /// The reader of the trace file.
+    BinaryTraceReader* reader_;
+    /// The cycles of the records in the file.
+    BinaryTraceReader::ColumnIterator cycles_;
+    /// The addresses of the records in the file.
+    BinaryTraceReader::ColumnIterator addresses_;
+    /// The records sorted by the cycle, if the file is not in order.
+    std::vector<Execution> sortedExecutions_;
+    /// True if the records are read from sortedExecutions_.
+    bool useSorted_;
+    /// Index of the next record in sortedExecutions_.
+    std::size_t nextSorted_;
+    /// The current record.
+    Execution current_;
+    /// True if there is a current record.
+    bool hasCurrent_;
 };
 
 #endif
@@ -61,8 +61,8 @@ CostDBEntry::CostDBEntry(
     const CostDBEntry& entry2,
     const EntryKeyField& weighter) {
 
-    EntryKeyField field1 = entry1.keyFieldOfType(*weighter.type());
-    EntryKeyField field2 = entry2.keyFieldOfType(*weighter.type());
+    const EntryKeyField& field1 = entry1.keyFieldOfType(*weighter.type());
+    const EntryKeyField& field2 = entry2.keyFieldOfType(*weighter.type());
     double coefficient = weighter.coefficient(field1, field2);
 
     entryKey_ = entry1.entryKey_->copy();
@@ -144,7 +144,7 @@ CostDBEntry::type() const {
  * @param type Type of the field.
  * @return Demanded entry field.
  */
-EntryKeyField
+const EntryKeyField&
 CostDBEntry::keyFieldOfType(const EntryKeyFieldProperty& type) const {
     return entryKey_->keyFieldOfType(type);
 }
@@ -204,6 +204,28 @@ CostDBEntry::isEqualKey(const CostDBEntry& entry) const {
     return entryKey_->isEqual(*entry.entryKey_);
 }
 
+/**
+ * Returns a hash value of the entry key.
+ *
+ * @return Hash value which is equal for entries with equal keys.
+ */
+std::size_t
+CostDBEntry::keyHashValue() const {
+    return entryKey_->hashValue();
+}
+
+/**
+ * Returns a hash value of the given fields of the entry key.
+ *
+ * @param fieldTypes Types of the fields to include.
+ * @return Hash value which is equal for entries with equal fields.
+ */
+std::size_t
+CostDBEntry::keyHashValue(
+    const std::vector<const EntryKeyFieldProperty*>& fieldTypes) const {
+    return entryKey_->hashValue(fieldTypes);
+}
+
 /**
  * Add new statistics into this entry.
  *
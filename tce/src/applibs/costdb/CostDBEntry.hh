@@ -59,7 +59,8 @@ public:
     virtual ~CostDBEntry();
     CostDBEntry* copy() const;
 
-    EntryKeyField keyFieldOfType(const EntryKeyFieldProperty& type) const;
+    const EntryKeyField& keyFieldOfType(
+        const EntryKeyFieldProperty& type) const;
     EntryKeyField keyFieldOfType(std::string type) const;
     const EntryKeyProperty* type() const;
 
@@ -67,6 +68,9 @@ public:
     int fieldCount() const;
     const EntryKeyField& field(int index) const;
     bool isEqualKey(const CostDBEntry& entry) const;
+    std::size_t keyHashValue() const;
+    std::size_t keyHashValue(
+        const std::vector<const EntryKeyFieldProperty*>& fieldTypes) const;
 
     void addStatistics(CostDBEntryStats* newStats);
     int statisticsCount() const;
@@ -34,6 +34,20 @@
 #include "CostDBEntryKey.hh"
 #include "Application.hh"
 #include <iostream>
+#include <functional>
+
+/**
+ * Returns the hash value of a field combined with its type.
+ *
+ * The values of the fields of a key are summed, so the hash value of a
+ * key does not depend on the order of its fields.
+ */
+static std::size_t
+fieldHash(const EntryKeyField& field) {
+    std::size_t hash = field.hashValue() * 31 +
+        std::hash<const EntryKeyFieldProperty*>()(field.type());
+    return std::hash<std::size_t>()(hash);
+}
 
 /**
  * Constructor.
@@ -119,7 +133,7 @@ CostDBEntryKey::replaceField(EntryKeyField* newField) {
  * @param fieldType Type of the field.
  * @exception KeyNotFound Requested field type was not found.
  */
-EntryKeyField
+const EntryKeyField&
 CostDBEntryKey::keyFieldOfType(const EntryKeyFieldProperty& fieldType) const {
     for (FieldTable::const_iterator i = fields_.begin();
          i != fields_.end(); i++) {
@@ -168,6 +182,42 @@ CostDBEntryKey::isEqual(const CostDBEntryKey& entryKey) const {
     return false;
 }
 
+/**
+ * Returns a hash value of the entry key.
+ *
+ * Keys for which isEqual() holds have equal hash values.
+ *
+ * @return Hash value of all the fields.
+ */
+std::size_t
+CostDBEntryKey::hashValue() const {
+    std::size_t hash = 0;
+    for (FieldTable::const_iterator f = fields_.begin();
+         f != fields_.end(); f++) {
+        hash += fieldHash(*(*f));
+    }
+    return hash;
+}
+
+/**
+ * Returns a hash value of the given fields of the entry key.
+ *
+ * @param fieldTypes Types of the fields to include.
+ * @return Hash value of the fields.
+ * @exception KeyNotFound The key does not have some of the fields.
+ */
+std::size_t
+CostDBEntryKey::hashValue(
+    const std::vector<const EntryKeyFieldProperty*>& fieldTypes) const {
+
+    std::size_t hash = 0;
+    for (std::vector<const EntryKeyFieldProperty*>::const_iterator f =
+             fieldTypes.begin(); f != fieldTypes.end(); f++) {
+        hash += fieldHash(keyFieldOfType(*(*f)));
+    }
+    return hash;
+}
+
 /**
  * Returns the field found on the given index.
  *
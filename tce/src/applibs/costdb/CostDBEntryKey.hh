@@ -56,9 +56,13 @@ public:
     CostDBEntryKey* copy() const;
 
     const EntryKeyProperty* type() const;
-    EntryKeyField keyFieldOfType(const EntryKeyFieldProperty& fieldType) const;
+    const EntryKeyField& keyFieldOfType(
+        const EntryKeyFieldProperty& fieldType) const;
     EntryKeyField keyFieldOfType(std::string fieldType) const;
     bool isEqual(const CostDBEntryKey& entryKey) const;
+    std::size_t hashValue() const;
+    std::size_t hashValue(
+        const std::vector<const EntryKeyFieldProperty*>& fieldTypes) const;
 
     void addField(EntryKeyField* field);
     void replaceField(EntryKeyField* newField);
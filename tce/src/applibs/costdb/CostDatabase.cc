@@ -35,10 +35,9 @@
 #include <set>
 #include <map>
 #include <string>
-#include "CompilerWarnings.hh"
-IGNORE_CLANG_WARNING("-Wkeyword-macro")
-#include <boost/regex.hpp>
-POP_CLANG_DIAGS
+#include <sstream>
+#include <algorithm>
+#include <cctype>
 
 #include "Application.hh"
 #include "HDBManager.hh"
@@ -361,13 +360,10 @@ CostDatabase::buildRegisterFiles(const std::string& rfEstimatorPluginName) {
                     "input_delay", data.value().doubleValue());
                 continue;
             }
-            boost::smatch match = 
-                getValues(dataName, "input_delay[ \t]*(\\S+)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the port name
+            std::string portName;
+            if (nameParameter(dataName, "input_delay", portName)) {
                 newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
+                    portName, data.value().doubleValue());
                 continue;
             }
 
@@ -380,34 +376,21 @@ CostDatabase::buildRegisterFiles(const std::string& rfEstimatorPluginName) {
                 continue;
             }
 
-            match = getValues(dataName, "output_delay[ \t]*(\\S+)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the port name
+            if (nameParameter(dataName, "output_delay", portName)) {
                 newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
-                continue;
-            }
-            
-            if (dataName == "output_delay") {
-                // match[0] contains the whole string
-                // match[1] contains the name of the port
-                newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
+                    portName, data.value().doubleValue());
                 continue;
             }
 
-            // access energies
-            match =
-                getValues(dataName, "rf_access_energy ([0-9])* ([0-9])*");
-            if (match.size() == 3) {
-                // match[0] contains the whole string
-                // match[1] contains the number of reads
-                // match[2] contains the number of writes
+            // access energies, "rf_access_energy <reads> <writes>"
+            std::istringstream accessFields(dataName);
+            std::string accessName;
+            int reads = 0;
+            int writes = 0;
+            if ((accessFields >> accessName >> reads >> writes) &&
+                accessName == "rf_access_energy") {
                 newStatistics->setEnergyReadWrite(
-                    Conversion::toInt(
-                        match[1]), Conversion::toInt(match[2]),
-                    data.value().doubleValue());
+                    reads, writes, data.value().doubleValue());
                 continue;
             }
 
@@ -564,13 +547,11 @@ CostDatabase::buildFunctionUnits(const std::string& fuEstimatorPluginName) {
                 continue;
             }
 
-            boost::smatch match = 
-                getValues(dataName, "input_delay[ \t]*(\\S+)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the name of the port
+            std::string parameter;
+            if (nameParameter(dataName, "input_delay", parameter)) {
+                // the parameter is the name of the port
                 newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
+                    parameter, data.value().doubleValue());
                 continue;
             }
             
@@ -583,33 +564,24 @@ CostDatabase::buildFunctionUnits(const std::string& fuEstimatorPluginName) {
                 continue;
             }
 
-            match = getValues(
-                dataName, "output_delay[ \t]*(\\S+)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the name of the port
+            if (nameParameter(dataName, "output_delay", parameter)) {
+                // the parameter is the name of the port
                 newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
+                    parameter, data.value().doubleValue());
                 continue;
             }
-            match = getValues(
-                dataName, "(output_delay)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the name of the port
+            if (dataName.compare(0, 12, "output_delay") == 0) {
                 newStatistics->setDelay(
-                    match[1], data.value().doubleValue());
+                    "output_delay", data.value().doubleValue());
                 continue;
             }
 
             // operation energies
-            match = getValues(
-                dataName, "operation_execution_energy (\\S+)");
-            if (match.size() == 2) {
-                // match[0] contains the whole string
-                // match[1] contains the operation name
+            if (nameParameter(
+                    dataName, "operation_execution_energy ", parameter)) {
+                // the parameter is the name of the operation
                 newStatistics->setEnergyOperation(
-                    match[1], data.value().doubleValue());
+                    parameter, data.value().doubleValue());
                 continue;
             }
 
@@ -882,6 +854,10 @@ CostDatabase::buildSockets(const std::string& socketEstimatorPluginName) {
  * @param searchKey Search key.
  * @param match Type of matches.
  * @return Entries matching the search.
+ * The entries are first looked up from an index of the fields that must
+ * match exactly, so the search strategy gets only the entries that may
+ * match instead of all the entries of the type.
+ *
  * @exception KeyNotFound If search key type is not found.
  */
 CostDBTypes::EntryTable
@@ -894,8 +870,67 @@ CostDatabase::search(
     if (i == entries_.end()) {
         throw KeyNotFound(__FILE__, __LINE__, "CostDatabase::search");
     }
-    
-    return searchStrategy_->search(searchKey, i->second, match);
+
+    FieldTypes exactFields;
+    for (CostDBTypes::MatchTypeTable::const_iterator m = match.begin();
+         m != match.end(); m++) {
+        if ((*m)->matchingType() == CostDBTypes::MATCH_EXACT) {
+            exactFields.push_back((*m)->fieldType());
+        }
+    }
+    if (exactFields.empty() || i->second.empty()) {
+        return searchStrategy_->search(searchKey, i->second, match);
+    }
+    std::sort(exactFields.begin(), exactFields.end());
+    exactFields.erase(
+        std::unique(exactFields.begin(), exactFields.end()),
+        exactFields.end());
+
+    // pass the candidates in the order of insertion as the full
+    // table would have been
+    const EntryIndex& index = fieldIndex(searchKey.type(), exactFields);
+    std::pair<EntryIndex::const_iterator, EntryIndex::const_iterator> range =
+        index.equal_range(searchKey.hashValue(exactFields));
+    std::vector<int> positions;
+    for (EntryIndex::const_iterator p = range.first; p != range.second;
+         p++) {
+        positions.push_back(p->second);
+    }
+    std::sort(positions.begin(), positions.end());
+    CostDBTypes::EntryTable candidates;
+    for (std::size_t p = 0; p < positions.size(); p++) {
+        candidates.push_back(i->second[positions[p]]);
+    }
+    return searchStrategy_->search(searchKey, candidates, match);
+}
+
+/**
+ * Returns the index of the given fields of the entries of a type.
+ *
+ * The index is built on the first request and kept up to date by
+ * insertEntry().
+ *
+ * @param type Entry type.
+ * @param fields Types of the indexed fields in ascending order.
+ * @return Positions of the entries in the entry table by the hash value
+ * of the fields.
+ */
+const CostDatabase::EntryIndex&
+CostDatabase::fieldIndex(
+    const EntryKeyProperty* type, const FieldTypes& fields) const {
+
+    IndexKey key(type, fields);
+    FieldIndexMap::const_iterator i = fieldIndices_.find(key);
+    if (i != fieldIndices_.end()) {
+        return i->second;
+    }
+    EntryIndex& index = fieldIndices_[key];
+    const CostDBTypes::EntryTable& entries = entries_.find(type)->second;
+    for (std::size_t p = 0; p < entries.size(); p++) {
+        index.insert(
+            std::make_pair(entries[p]->keyHashValue(fields), int(p)));
+    }
+    return index;
 }
 
 /**
@@ -906,34 +941,41 @@ CostDatabase::search(
  */
 void
 CostDatabase::insertEntry(CostDBEntry* entry) {
-    EntryMap::iterator i = entries_.find(entry->type());
-
-    if (i == entries_.end()) {
-        CostDBTypes::EntryTable newEntries;
-        newEntries.push_back(entry);
-        entries_.insert(pair<const EntryKeyProperty*, CostDBTypes::EntryTable>(
-                            entry->type(), newEntries));
-    } else {
-        // if the database already contains an entry with same search
-        // key, the statistics of the new entry will be added into the
-        // existing entry
-        for (CostDBTypes::EntryTable::iterator j = i->second.begin();
-             j != i->second.end(); j++) {
-
-            if ((*j)->isEqualKey(*entry)) {
-		if (*j == entry) {
-		    throw ObjectAlreadyExists(__FILE__, __LINE__,
-					      "CostDatabase::insertEntry");
-		}
-                for (int k = 0; k < entry->statisticsCount(); k++) {
-                    CostDBEntryStats* newStats = entry->statistics(k).copy();
-                    (*j)->addStatistics(newStats);
-                }
-                return;
+    CostDBTypes::EntryTable& entries = entries_[entry->type()];
+    EntryIndex& keyIndex = keyIndex_[entry->type()];
+    std::size_t hash = entry->keyHashValue();
+
+    // if the database already contains an entry with same search
+    // key, the statistics of the new entry will be added into the
+    // existing entry
+    std::pair<EntryIndex::iterator, EntryIndex::iterator> range =
+        keyIndex.equal_range(hash);
+    for (EntryIndex::iterator i = range.first; i != range.second; i++) {
+        CostDBEntry* existing = entries[i->second];
+        if (existing->isEqualKey(*entry)) {
+            if (existing == entry) {
+                throw ObjectAlreadyExists(__FILE__, __LINE__,
+                                          "CostDatabase::insertEntry");
+            }
+            for (int k = 0; k < entry->statisticsCount(); k++) {
+                CostDBEntryStats* newStats = entry->statistics(k).copy();
+                existing->addStatistics(newStats);
             }
+            return;
         }
-        i->second.push_back(entry);
     }
+
+    int position = entries.size();
+    keyIndex.insert(std::make_pair(hash, position));
+    for (FieldIndexMap::iterator i = fieldIndices_.begin();
+         i != fieldIndices_.end(); i++) {
+        if (i->first.first == entry->type()) {
+            i->second.insert(
+                std::make_pair(
+                    entry->keyHashValue(i->first.second), position));
+        }
+    }
+    entries.push_back(entry);
 }
 
 /**
@@ -990,20 +1032,48 @@ CostDatabase::setSearchStrategy(SearchStrategy* strategy) {
 }
 
 /**
- * Returns the matching strings out of the text using regexp.
- * 
- * @param text String the regular expression is used for.
- * @param regex Regular expression to be matched with the text.
- * @return Returns the matched string patterns from the text or empty smatch
- *         if matching failed.
- **/
-boost::smatch
-CostDatabase::getValues(const string& text, const string& regex) {
-    boost::regex regx(regex + ".*");
-    boost::smatch what;
-    if (boost::regex_match(text, what, regx, boost::match_extra)) {
-        return what;
+ * Tells whether a search strategy has been set.
+ *
+ * @return True if a search strategy has been set.
+ */
+bool
+CostDatabase::hasSearchStrategy() const {
+    return searchStrategy_ != NULL;
+}
+
+/**
+ * Parses the parameter of a cost data name such as "input_delay in1t".
+ *
+ * Blanks between the prefix and the parameter are skipped and the
+ * parameter ends at the next white space.
+ *
+ * @param name The cost data name.
+ * @param prefix The expected prefix of the name.
+ * @param parameter Set to the parameter if one is found.
+ * @return True if the name starts with the prefix followed by a
+ *         parameter.
+ */
+bool
+CostDatabase::nameParameter(
+    const std::string& name, const std::string& prefix,
+    std::string& parameter) {
+
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::size_t start = prefix.size();
+    while (start < name.size() &&
+           (name[start] == ' ' || name[start] == '\t')) {
+        start++;
+    }
+    std::size_t end = start;
+    while (end < name.size() &&
+           !std::isspace(static_cast<unsigned char>(name[end]))) {
+        end++;
+    }
+    if (end == start) {
+        return false;
     }
-    boost::smatch empty;
-    return empty;
+    parameter = name.substr(start, end - start);
+    return true;
 }
@@ -38,10 +38,7 @@
 #include <vector>
 #include <map>
 #include <string>
-#include "CompilerWarnings.hh"
-IGNORE_CLANG_WARNING("-Wkeyword-macro")
-#include <boost/regex.hpp>
-POP_CLANG_DIAGS
+#include <unordered_map>
 
 #include "CostDBTypes.hh"
 #include "Exception.hh"
@@ -78,6 +75,7 @@ public:
 
     void insertEntry(CostDBEntry* entry);
     void setSearchStrategy(SearchStrategy* strategy);
+    bool hasSearchStrategy() const;
     CostDBTypes::EntryTable search(
         const CostDBEntryKey& searchKey,
         const CostDBTypes::MatchTypeTable& match) const;
@@ -86,8 +84,21 @@ private:
     /// CostDatabase must be created with instance() method.
     CostDatabase(const HDB::HDBManager& hdb);
 
-    /// Finds string matches using regular expressions.
-    boost::smatch getValues(const std::string& text, const std::string& regex);
+    /// Field types of an index.
+    typedef std::vector<const EntryKeyFieldProperty*> FieldTypes;
+    /// Positions of entries in their entry table by hash value of fields.
+    typedef std::unordered_multimap<std::size_t, int> EntryIndex;
+    /// Entry type and the indexed fields of an index.
+    typedef std::pair<const EntryKeyProperty*, FieldTypes> IndexKey;
+    /// Indices of the fields used in exact matches.
+    typedef std::map<IndexKey, EntryIndex> FieldIndexMap;
+
+    const EntryIndex& fieldIndex(
+        const EntryKeyProperty* type, const FieldTypes& fields) const;
+
+    static bool nameParameter(
+        const std::string& name, const std::string& prefix,
+        std::string& parameter);
 
     /// Value type for map of search types.
     typedef std::pair<
@@ -103,6 +114,10 @@ private:
     SearchStrategy* searchStrategy_;
     /// Database entries.
     EntryMap entries_;
+    /// Index of the whole keys of the entries of each type.
+    std::map<const EntryKeyProperty*, EntryIndex> keyIndex_;
+    /// Indices of the exact match fields, built on demand by searches.
+    mutable FieldIndexMap fieldIndices_;
     /// HDB used for creating cost database.
     const HDB::HDBManager& hdb_;
     /// Flag to note is register files built
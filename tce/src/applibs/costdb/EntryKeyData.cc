@@ -36,10 +36,12 @@
 #include <string>
 #include <sstream>
 #include <typeinfo>
+#include <functional>
 #include "EntryKeyData.hh"
 #include "Conversion.hh"
 #include "FunctionUnit.hh"
 #include "HWOperation.hh"
+#include "AddressSpace.hh"
 
 using std::string;
 using std::set;
@@ -205,6 +207,16 @@ EntryKeyDataInt::toString() const {
     return Conversion::toString(data_);
 }
 
+/**
+ * Returns a hash value of the integer.
+ *
+ * @return Hash value.
+ */
+std::size_t
+EntryKeyDataInt::hashValue() const {
+    return std::hash<int>()(data_);
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // EntryKeyDataDouble
@@ -347,6 +359,16 @@ EntryKeyDataDouble::toString() const {
     return Conversion::toString(data_);
 }
 
+/**
+ * Returns a hash value of the double.
+ *
+ * @return Hash value.
+ */
+std::size_t
+EntryKeyDataDouble::hashValue() const {
+    return std::hash<double>()(data_);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // EntryKeyDataOperationSet
 ///////////////////////////////////////////////////////////////////////////////
@@ -471,6 +493,21 @@ EntryKeyDataOperationSet::toString() const {
     return result;
 }
 
+/**
+ * Returns a hash value of the operation set.
+ *
+ * @return Hash value.
+ */
+std::size_t
+EntryKeyDataOperationSet::hashValue() const {
+    std::size_t hash = data_.size();
+    for (std::set<string>::const_iterator i = data_.begin();
+         i != data_.end(); i++) {
+        hash = hash * 31 + std::hash<string>()(*i);
+    }
+    return hash;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // EntryKeyDataBool
 ///////////////////////////////////////////////////////////////////////////////
@@ -591,6 +628,16 @@ EntryKeyDataBool::toString() const {
     }
 }
 
+/**
+ * Returns a hash value of the boolean.
+ *
+ * @return Hash value.
+ */
+std::size_t
+EntryKeyDataBool::hashValue() const {
+    return data_ ? 1 : 0;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // EntryKeyDataFunctioUnit
@@ -719,3 +766,22 @@ EntryKeyDataFunctionUnit::toString() const {
     }
     return result;
 }
+
+/**
+ * Returns a hash value of the function unit architecture.
+ *
+ * Covers only the properties isArchitectureEqual() requires to be
+ * equal, so that equal architectures get equal hash values.
+ *
+ * @return Hash value.
+ */
+std::size_t
+EntryKeyDataFunctionUnit::hashValue() const {
+    std::size_t hash = data_->operationCount();
+    hash = hash * 31 + data_->operationPortCount();
+    hash = hash * 31 + data_->pipelineElementCount();
+    if (data_->addressSpace() != NULL) {
+        hash = hash * 31 + std::hash<string>()(data_->addressSpace()->name());
+    }
+    return hash;
+}
@@ -40,6 +40,7 @@
 #include <string>
 #include <set>
 #include <vector>
+#include <cstddef>
 
 #include "Exception.hh"
 
@@ -68,6 +69,8 @@ public:
         const EntryKeyData*, const EntryKeyData*) const = 0;
     /// Converts the data into a string.
     virtual std::string toString() const = 0;
+    /// Returns a hash value which is equal for equal data.
+    virtual std::size_t hashValue() const = 0;
     
 private:
     /// Copying not allowed.
@@ -93,6 +96,7 @@ public:
     double coefficient(
         const EntryKeyData* data1, const EntryKeyData* data2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
 
 private:
     /// Integer data.
@@ -121,6 +125,7 @@ public:
     double coefficient(
         const EntryKeyData* data1, const EntryKeyData* data2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
 
 private:
     /// Double data.
@@ -149,6 +154,7 @@ public:
     double coefficient(
         const EntryKeyData* data1, const EntryKeyData* data2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
 
 private:
     /// Operation set data.
@@ -176,6 +182,7 @@ public:
     double coefficient(
         const EntryKeyData* data1, const EntryKeyData* data2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
 
 private:
     /// Boolean data.
@@ -203,6 +210,7 @@ public:
     double coefficient(
         const EntryKeyData* data1, const EntryKeyData* data2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
 
 private:
     /// FunctionUnit* data.
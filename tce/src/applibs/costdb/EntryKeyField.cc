@@ -143,3 +143,13 @@ std::string
 EntryKeyField::toString() const {
     return data_->toString();
 }
+
+/**
+ * Returns a hash value of the field value.
+ *
+ * @return Hash value which is equal for equal field values.
+ */
+std::size_t
+EntryKeyField::hashValue() const {
+    return data_->hashValue();
+}
@@ -55,6 +55,7 @@ public:
     double coefficient(const EntryKeyField& field1,
                        const EntryKeyField& field2) const;
     std::string toString() const;
+    std::size_t hashValue() const;
     const EntryKeyFieldProperty* type() const;
 
 private:
@@ -87,6 +87,7 @@ FilterSearch::copy() const {
     }
     FilterSearch* newSearch = new FilterSearch();
     newSearch->entryCache_ = newEntryCache;
+    newSearch->cacheIndex_ = cacheIndex_;
     return newSearch;
 }
 
@@ -139,6 +140,8 @@ FilterSearch::search(
     }
     
     // insert found entries into cache
+    cacheIndex_.insert(
+        std::make_pair(searchKey.hashValue(), int(entryCache_.size())));
     entryCache_.push_back(new Cache(match, searchKey.copy(), components));
     
     return components;
@@ -147,6 +150,9 @@ FilterSearch::search(
 /**
  * Finds entries matching search key and type of match from the cache.
  *
+ * Only the results of the queries with an equal search key hash value
+ * are compared. If several of them match, the oldest one is used.
+ *
  * @param searchKey Search key.
  * @param match Type of match.
  * @return Entries matching search key and type of match.
@@ -157,14 +163,20 @@ FilterSearch::findFromCache(
     const CostDBTypes::MatchTypeTable& match) {
     
     CostDBTypes::EntryTable cacheEntries;
-    for (CacheTable::iterator i = entryCache_.begin();
-         i != entryCache_.end(); i++) {
-        
-        if ((*i)->isEqual(match, &searchKey)) {
-            cacheEntries = (*i)->entries();
-            break;
+    int found = -1;
+    std::pair<CacheIndex::const_iterator, CacheIndex::const_iterator> range =
+        cacheIndex_.equal_range(searchKey.hashValue());
+    for (CacheIndex::const_iterator i = range.first; i != range.second;
+         i++) {
+
+        if ((found == -1 || i->second < found) &&
+            entryCache_[i->second]->isEqual(match, &searchKey)) {
+            found = i->second;
         }
     }
+    if (found != -1) {
+        cacheEntries = entryCache_[found]->entries();
+    }
     return cacheEntries;
 }
 
@@ -36,6 +36,7 @@
 
 
 #include <vector>
+#include <unordered_map>
 
 #include "CostDBTypes.hh"
 #include "SearchStrategy.hh"
@@ -104,6 +105,8 @@ private:
 
     /// Table of cache entries.
     typedef std::vector<Cache*> CacheTable;
+    /// Positions of cache entries by hash value of their search key.
+    typedef std::unordered_multimap<std::size_t, int> CacheIndex;
     /// Table of matcher types.
     typedef std::vector<Matcher*> MatcherTable;
 
@@ -114,6 +117,8 @@ private:
 
     /// Results of the previous queries.
     CacheTable entryCache_;
+    /// Index of the results of the previous queries.
+    CacheIndex cacheIndex_;
     /// Storage for all matchers. They cannot be deleted before search
     /// strategy itself is deleted. Thus, this storage exists to
     /// deallocate the memory reserved by matchers.
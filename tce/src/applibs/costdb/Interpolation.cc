@@ -92,11 +92,11 @@ void
 Interpolation::filter(
     const CostDBEntryKey& searchKey, CostDBTypes::EntryTable& components) {
     vector<Pair> entries;
-    EntryKeyField searchField = searchKey.keyFieldOfType(*fieldType());
+    const EntryKeyField& searchField = searchKey.keyFieldOfType(*fieldType());
     for (CostDBTypes::EntryTable::iterator i = components.begin();
          i != components.end(); i++) {
 
-        EntryKeyField field = (*i)->keyFieldOfType(*fieldType());
+        const EntryKeyField& field = (*i)->keyFieldOfType(*fieldType());
         bool newPair = true;
         for (vector<Pair>::iterator p = entries.begin();
              p != entries.end(); p++) {
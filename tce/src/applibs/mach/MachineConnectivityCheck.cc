@@ -34,6 +34,7 @@
 #include <set>
 
 #include "MachineConnectivityCheck.hh"
+#include "MachineConnectivityIndex.hh"
 #include "MachineInfo.hh"
 #include "Application.hh"
 #include "Bus.hh"
@@ -83,6 +84,76 @@ MachineConnectivityCheck::MachineConnectivityCheck(
     const std::string& shortDesc_) : MachineCheck(shortDesc_) {
 }
 
+/**
+ * Returns the connectivity index of the given machine.
+ *
+ * The index is rebuilt if the machine has been modified since the cached
+ * one was built, or if the cached one belongs to a deleted machine that
+ * was allocated at the same address.
+ *
+ * @param mach The machine.
+ * @return The connectivity index.
+ */
+std::shared_ptr<const MachineConnectivityIndex>
+MachineConnectivityCheck::connectivityIndex(const TTAMachine::Machine& mach) {
+
+    boost::mutex::scoped_lock lock(cacheLock_);
+    IndexMap::const_iterator i = indexCache_.find(&mach);
+    if (i != indexCache_.end() &&
+        i->second->modificationStamp() == mach.modificationStamp()) {
+        return i->second;
+    }
+    if (i == indexCache_.end() && indexCache_.size() >= MAX_CACHED_INDICES) {
+        indexCache_.clear();
+    }
+    std::shared_ptr<const MachineConnectivityIndex> index(
+        new MachineConnectivityIndex(mach));
+    indexCache_[&mach] = index;
+    return index;
+}
+
+/**
+ * Looks up a connection from the connectivity index of the machine of the
+ * source.
+ *
+ * @param source The source port or register file.
+ * @param destination The destination port or register file.
+ * @param connected Set to the result if the connection was found.
+ * @return True if both the source and the destination are in the index.
+ */
+template <typename SourceType, typename DestinationType>
+bool
+MachineConnectivityCheck::findConnected(
+    const SourceType& source, const DestinationType& destination,
+    bool& connected) {
+
+    const TTAMachine::Machine* mach = parentMachine(source);
+    if (mach == NULL) {
+        return false;
+    }
+    return connectivityIndex(*mach)->findConnected(
+        source, destination, connected);
+}
+
+/**
+ * Returns the machine the given port belongs to, or NULL if none.
+ */
+const TTAMachine::Machine*
+MachineConnectivityCheck::parentMachine(const TTAMachine::Port& port) {
+    if (port.parentUnit() == NULL) {
+        return NULL;
+    }
+    return port.parentUnit()->machine();
+}
+
+/**
+ * Returns the machine the given register file belongs to, or NULL if none.
+ */
+const TTAMachine::Machine*
+MachineConnectivityCheck::parentMachine(
+    const TTAMachine::BaseRegisterFile& rf) {
+    return rf.machine();
+}
 
 bool
 MachineConnectivityCheck::isConnected(
@@ -130,12 +201,10 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& destinationPort,
     const Guard* guard) {
 
-    // TODO: replace this cache's second value(bool) with set of buses.
-    PortPortBoolMap::const_iterator
-        i = portPortCache_.find(PortPortPair(&sourcePort, &destinationPort));
-    if (i != portPortCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
+    bool connected = false;
+    if (findConnected(sourcePort, destinationPort, connected)) {
+        if (connected == false || guard == NULL) {
+            return connected;
         }
     }
     std::set<const TTAMachine::Bus*> sourceBuses;
@@ -149,7 +218,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(sourceBuses, destinationBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = true;
 
         if (guard == NULL) {
             return true;
@@ -164,7 +232,6 @@ MachineConnectivityCheck::isConnected(
              
         return false; // bus found but lacks the guards
     } else {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = false;
         return false;
     }
 }
@@ -293,11 +360,10 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::Port& destPort) {
 
-    RfPortBoolMap::const_iterator
-        i = rfPortCache_.find(RfPortPair(&sourceRF, &destPort));
-    if (i != rfPortCache_.end()) {
-        return i->second;
-    }    
+    bool connected = false;
+    if (findConnected(sourceRF, destPort, connected)) {
+        return connected;
+    }
     std::set<const TTAMachine::Bus*> destBuses = connectedSourceBuses(destPort);
     std::set<const TTAMachine::Bus*> srcBuses;
 
@@ -312,10 +378,8 @@ MachineConnectivityCheck::isConnected(
     SetTools::intersection(
         srcBuses, destBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = true;
         return true;
     } else {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = false;
         return false;
     }
 }
@@ -336,11 +400,10 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& destRF,
     const TTAMachine::Guard* guard) {
     
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
+    bool connected = false;
+    if (findConnected(sourceRF, destRF, connected)) {
+        if (connected == false || guard == NULL) {
+            return connected;
         }
     }
     std::set<const TTAMachine::Bus*> srcBuses;
@@ -352,7 +415,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(srcBuses, dstBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         if (guard == NULL) {
             return true;
         }
@@ -365,7 +427,6 @@ MachineConnectivityCheck::isConnected(
         }
         return false; // bus found but lacks the guards
     } else {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = false;
         return false;
     }
 }
@@ -411,10 +472,9 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& sourcePort,
     const TTAMachine::RegisterFile& destRF) {
 
-    PortRfBoolMap::const_iterator
-        i = portRfCache_.find(PortRfPair(&sourcePort, &destRF));
-    if (i != portRfCache_.end()) {
-        return i->second;
+    bool connected = false;
+    if (findConnected(sourcePort, destRF, connected)) {
+        return connected;
     }
 
     std::set<const TTAMachine::Bus*> sourceBuses =
@@ -432,10 +492,8 @@ MachineConnectivityCheck::isConnected(
     SetTools::intersection(sourceBuses, destBuses, sharedBuses);
 
     if (sharedBuses.size() > 0) {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = true;
         return true;
     } else {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = false;
         return false;
     }
 }
@@ -1852,10 +1910,9 @@ MachineConnectivityCheck::addAnnotatedFUs(
 }
 
 /* These are static */
-MachineConnectivityCheck::PortPortBoolMap MachineConnectivityCheck::portPortCache_;
-MachineConnectivityCheck::RfRfBoolMap MachineConnectivityCheck::rfRfCache_;
-MachineConnectivityCheck::RfPortBoolMap MachineConnectivityCheck::rfPortCache_;
-MachineConnectivityCheck::PortRfBoolMap MachineConnectivityCheck::portRfCache_;
+const unsigned int MachineConnectivityCheck::MAX_CACHED_INDICES;
+MachineConnectivityCheck::IndexMap MachineConnectivityCheck::indexCache_;
+boost::mutex MachineConnectivityCheck::cacheLock_;
 
 
 bool
@@ -1934,10 +1991,9 @@ MachineConnectivityCheck::isConnectedWithBothGuards(
     const TTAMachine::BaseRegisterFile& destRF,
     std::pair<const RegisterFile*,int> guardReg) {
     
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false) {
+    bool connected = false;
+    if (findConnected(sourceRF, destRF, connected)) {
+        if (connected == false) {
             return false;
         }
     }
@@ -1953,7 +2009,6 @@ MachineConnectivityCheck::isConnectedWithBothGuards(
     bool trueOK = false;
     bool falseOK = false;
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         for (auto bus: sharedBuses) {
             std::pair<bool, bool> guardsOK = hasBothGuards(bus, guardReg);
             trueOK |= guardsOK.first;
@@ -36,6 +36,9 @@
 #include <set>
 #include <map>
 #include <vector>
+#include <memory>
+
+#include <boost/thread/mutex.hpp>
 
 #include "MachineCheck.hh"
 #include "ProgramAnnotation.hh"
@@ -44,6 +47,7 @@
 class TCEString;
 class MoveNode;
 class Operation;
+class MachineConnectivityIndex;
 
 namespace TTAMachine {
     class Port;
@@ -296,27 +300,28 @@ static bool raConnected(const TTAMachine::Machine& machine);
 protected:
     MachineConnectivityCheck(const std::string& shortDesc_);
 private:
-    typedef std::pair<const TTAMachine::Port*,const TTAMachine::Port*> 
-    PortPortPair;
-
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::BaseRegisterFile*> RfRfPair;
-
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::Port*> RfPortPair;
-
-    typedef std::pair<const TTAMachine::Port*,
-                      const TTAMachine::BaseRegisterFile*> PortRfPair;
+    typedef std::map<const TTAMachine::Machine*,
+                     std::shared_ptr<const MachineConnectivityIndex> >
+    IndexMap;
 
-    typedef std::map<PortPortPair,bool> PortPortBoolMap;
-    typedef std::map<RfRfPair,bool> RfRfBoolMap;
-    typedef std::map<RfPortPair,bool> RfPortBoolMap;
-    typedef std::map<PortRfPair,bool> PortRfBoolMap;
-
-    static PortPortBoolMap portPortCache_;
-    static RfRfBoolMap rfRfCache_;
-    static RfPortBoolMap rfPortCache_;
-    static PortRfBoolMap portRfCache_;
+    static std::shared_ptr<const MachineConnectivityIndex> connectivityIndex(
+        const TTAMachine::Machine& mach);
+    template <typename SourceType, typename DestinationType>
+    static bool findConnected(
+        const SourceType& source, const DestinationType& destination,
+        bool& connected);
+    static const TTAMachine::Machine* parentMachine(
+        const TTAMachine::Port& port);
+    static const TTAMachine::Machine* parentMachine(
+        const TTAMachine::BaseRegisterFile& rf);
+
+    /// Maximum number of machines whose connectivity indices are kept.
+    static const unsigned int MAX_CACHED_INDICES = 32;
+    /// Connectivity indices of the recently queried machines.
+    static IndexMap indexCache_;
+    /// Serializes the accesses to the index cache, the checks are called
+    /// from several explorer threads at the same time.
+    static boost::mutex cacheLock_;
 };
 
 #endif
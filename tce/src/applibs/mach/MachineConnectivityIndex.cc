@@ -0,0 +1,302 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityIndex.cc
+ *
+ * Implementation of MachineConnectivityIndex class.
+ *
+ * @note rating: red
+ */
+
+#include "MachineConnectivityIndex.hh"
+
+#include <set>
+#include <vector>
+#include <map>
+
+#include "MachineConnectivityCheck.hh"
+#include "Machine.hh"
+#include "ControlUnit.hh"
+#include "FunctionUnit.hh"
+#include "RegisterFile.hh"
+#include "ImmediateUnit.hh"
+#include "Port.hh"
+#include "Bus.hh"
+
+using namespace TTAMachine;
+
+/**
+ * Builds the connectivity index of the given machine.
+ *
+ * @param machine The machine.
+ */
+MachineConnectivityIndex::MachineConnectivityIndex(const Machine& machine) :
+    modificationStamp_(machine.modificationStamp()),
+    portPort_(NULL), rfPort_(NULL), portRf_(NULL), rfRf_(NULL) {
+
+    const Machine::FunctionUnitNavigator& fuNav =
+        machine.functionUnitNavigator();
+    for (int i = 0; i < fuNav.count(); i++) {
+        addPorts(*fuNav.item(i));
+    }
+    if (machine.controlUnit() != NULL) {
+        addPorts(*machine.controlUnit());
+    }
+
+    std::vector<const BaseRegisterFile*> rfs;
+    const Machine::RegisterFileNavigator& rfNav =
+        machine.registerFileNavigator();
+    for (int i = 0; i < rfNav.count(); i++) {
+        rfs.push_back(rfNav.item(i));
+    }
+    const Machine::ImmediateUnitNavigator& iuNav =
+        machine.immediateUnitNavigator();
+    for (int i = 0; i < iuNav.count(); i++) {
+        rfs.push_back(iuNav.item(i));
+    }
+    for (unsigned int i = 0; i < rfs.size(); i++) {
+        rfIndices_[rfs[i]] = i;
+        addPorts(*rfs[i]);
+    }
+
+    // collect the ports and register files writing to and reading from
+    // each bus
+    const Machine::BusNavigator& busNav = machine.busNavigator();
+    std::map<const Bus*, int> busIndices;
+    for (int i = 0; i < busNav.count(); i++) {
+        busIndices[busNav.item(i)] = i;
+    }
+    std::vector<std::set<int> > portWriters(busNav.count());
+    std::vector<std::set<int> > portReaders(busNav.count());
+    std::vector<std::set<int> > rfWriters(busNav.count());
+    std::vector<std::set<int> > rfReaders(busNav.count());
+
+    for (PortIndexMap::const_iterator i = portIndices_.begin();
+         i != portIndices_.end(); i++) {
+        const Port& port = *i->first;
+        const BaseRegisterFile* rf =
+            dynamic_cast<const BaseRegisterFile*>(port.parentUnit());
+        int rfIdx = rf != NULL ? rfIndex(*rf) : -1;
+
+        std::set<const Bus*> buses;
+        MachineConnectivityCheck::appendConnectedDestinationBuses(
+            port, buses);
+        for (std::set<const Bus*>::const_iterator b = buses.begin();
+             b != buses.end(); b++) {
+            int busIdx = busIndices[*b];
+            portWriters[busIdx].insert(i->second);
+            if (rfIdx != -1) {
+                rfWriters[busIdx].insert(rfIdx);
+            }
+        }
+
+        buses.clear();
+        MachineConnectivityCheck::appendConnectedSourceBuses(port, buses);
+        for (std::set<const Bus*>::const_iterator b = buses.begin();
+             b != buses.end(); b++) {
+            int busIdx = busIndices[*b];
+            portReaders[busIdx].insert(i->second);
+            if (rfIdx != -1) {
+                rfReaders[busIdx].insert(rfIdx);
+            }
+        }
+    }
+
+    const int portCount = portIndices_.size();
+    const int rfCount = rfIndices_.size();
+    portPort_ = new BitMatrix(portCount, portCount, false);
+    rfPort_ = new BitMatrix(portCount, rfCount, false);
+    portRf_ = new BitMatrix(rfCount, portCount, false);
+    rfRf_ = new BitMatrix(rfCount, rfCount, false);
+
+    typedef std::set<int>::const_iterator Iter;
+    for (int bus = 0; bus < busNav.count(); bus++) {
+        for (Iter dst = portReaders[bus].begin();
+             dst != portReaders[bus].end(); dst++) {
+            for (Iter src = portWriters[bus].begin();
+                 src != portWriters[bus].end(); src++) {
+                portPort_->setBit(*dst, *src, true);
+            }
+            for (Iter src = rfWriters[bus].begin();
+                 src != rfWriters[bus].end(); src++) {
+                rfPort_->setBit(*dst, *src, true);
+            }
+        }
+        for (Iter dst = rfReaders[bus].begin();
+             dst != rfReaders[bus].end(); dst++) {
+            for (Iter src = portWriters[bus].begin();
+                 src != portWriters[bus].end(); src++) {
+                portRf_->setBit(*dst, *src, true);
+            }
+            for (Iter src = rfWriters[bus].begin();
+                 src != rfWriters[bus].end(); src++) {
+                rfRf_->setBit(*dst, *src, true);
+            }
+        }
+    }
+}
+
+/**
+ * Destructor.
+ */
+MachineConnectivityIndex::~MachineConnectivityIndex() {
+    delete portPort_;
+    delete rfPort_;
+    delete portRf_;
+    delete rfRf_;
+}
+
+/**
+ * Returns the modification stamp of the machine at the time the index
+ * was built.
+ *
+ * @return The modification stamp.
+ */
+unsigned long long
+MachineConnectivityIndex::modificationStamp() const {
+    return modificationStamp_;
+}
+
+/**
+ * Looks up whether there is a bus between two ports.
+ *
+ * @param sourcePort The source port.
+ * @param destinationPort The destination port.
+ * @param connected Set to the result if both ports are in the index.
+ * @return False if either of the ports is not in the index.
+ */
+bool
+MachineConnectivityIndex::findConnected(
+    const Port& sourcePort, const Port& destinationPort,
+    bool& connected) const {
+
+    int src = portIndex(sourcePort);
+    int dst = portIndex(destinationPort);
+    if (src == -1 || dst == -1) {
+        return false;
+    }
+    connected = portPort_->bitAt(dst, src);
+    return true;
+}
+
+/**
+ * Looks up whether there is a bus from any port of a register file to a
+ * port.
+ *
+ * @param sourceRF The source register file or immediate unit.
+ * @param destinationPort The destination port.
+ * @param connected Set to the result if both are in the index.
+ * @return False if the register file or the port is not in the index.
+ */
+bool
+MachineConnectivityIndex::findConnected(
+    const BaseRegisterFile& sourceRF, const Port& destinationPort,
+    bool& connected) const {
+
+    int src = rfIndex(sourceRF);
+    int dst = portIndex(destinationPort);
+    if (src == -1 || dst == -1) {
+        return false;
+    }
+    connected = rfPort_->bitAt(dst, src);
+    return true;
+}
+
+/**
+ * Looks up whether there is a bus from a port to any port of a register
+ * file.
+ *
+ * @param sourcePort The source port.
+ * @param destinationRF The destination register file or immediate unit.
+ * @param connected Set to the result if both are in the index.
+ * @return False if the port or the register file is not in the index.
+ */
+bool
+MachineConnectivityIndex::findConnected(
+    const Port& sourcePort, const BaseRegisterFile& destinationRF,
+    bool& connected) const {
+
+    int src = portIndex(sourcePort);
+    int dst = rfIndex(destinationRF);
+    if (src == -1 || dst == -1) {
+        return false;
+    }
+    connected = portRf_->bitAt(dst, src);
+    return true;
+}
+
+/**
+ * Looks up whether there is a bus from any port of a register file to any
+ * port of another register file.
+ *
+ * @param sourceRF The source register file or immediate unit.
+ * @param destinationRF The destination register file or immediate unit.
+ * @param connected Set to the result if both are in the index.
+ * @return False if either of the register files is not in the index.
+ */
+bool
+MachineConnectivityIndex::findConnected(
+    const BaseRegisterFile& sourceRF, const BaseRegisterFile& destinationRF,
+    bool& connected) const {
+
+    int src = rfIndex(sourceRF);
+    int dst = rfIndex(destinationRF);
+    if (src == -1 || dst == -1) {
+        return false;
+    }
+    connected = rfRf_->bitAt(dst, src);
+    return true;
+}
+
+/**
+ * Gives indices to the ports of the given unit.
+ *
+ * @param unit The unit.
+ */
+void
+MachineConnectivityIndex::addPorts(const Unit& unit) {
+    for (int i = 0; i < unit.portCount(); i++) {
+        int index = portIndices_.size();
+        portIndices_[unit.port(i)] = index;
+    }
+}
+
+/**
+ * Returns the index of the given port, or -1 if it is not in the index.
+ */
+int
+MachineConnectivityIndex::portIndex(const Port& port) const {
+    PortIndexMap::const_iterator i = portIndices_.find(&port);
+    return i == portIndices_.end() ? -1 : i->second;
+}
+
+/**
+ * Returns the index of the given register file, or -1 if it is not in the
+ * index.
+ */
+int
+MachineConnectivityIndex::rfIndex(const BaseRegisterFile& rf) const {
+    RFIndexMap::const_iterator i = rfIndices_.find(&rf);
+    return i == rfIndices_.end() ? -1 : i->second;
+}
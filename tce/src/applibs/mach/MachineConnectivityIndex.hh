@@ -0,0 +1,114 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityIndex.hh
+ *
+ * Declaration of MachineConnectivityIndex class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_MACHINE_CONNECTIVITY_INDEX_HH
+#define TTA_MACHINE_CONNECTIVITY_INDEX_HH
+
+#include <unordered_map>
+
+#include "BitMatrix.hh"
+
+namespace TTAMachine {
+    class Machine;
+    class Unit;
+    class Port;
+    class BaseRegisterFile;
+}
+
+/**
+ * Precomputed port and register file connectivity of one machine.
+ *
+ * The ports and register files (including immediate units) of the machine
+ * are given dense indices, and the connections between them through the
+ * buses are stored in bit matrices, so each query is a couple of table
+ * lookups. A register file is connected to a port or to another register
+ * file if any of its ports is.
+ *
+ * The index is immutable after construction and describes the machine as
+ * it was at the given modification stamp, see
+ * TTAMachine::Machine::modificationStamp(). It can thus be shared between
+ * threads.
+ */
+class MachineConnectivityIndex {
+public:
+    explicit MachineConnectivityIndex(const TTAMachine::Machine& machine);
+    virtual ~MachineConnectivityIndex();
+
+    unsigned long long modificationStamp() const;
+
+    bool findConnected(
+        const TTAMachine::Port& sourcePort,
+        const TTAMachine::Port& destinationPort,
+        bool& connected) const;
+    bool findConnected(
+        const TTAMachine::BaseRegisterFile& sourceRF,
+        const TTAMachine::Port& destinationPort,
+        bool& connected) const;
+    bool findConnected(
+        const TTAMachine::Port& sourcePort,
+        const TTAMachine::BaseRegisterFile& destinationRF,
+        bool& connected) const;
+    bool findConnected(
+        const TTAMachine::BaseRegisterFile& sourceRF,
+        const TTAMachine::BaseRegisterFile& destinationRF,
+        bool& connected) const;
+
+private:
+    typedef std::unordered_map<const TTAMachine::Port*, int> PortIndexMap;
+    typedef std::unordered_map<const TTAMachine::BaseRegisterFile*, int>
+    RFIndexMap;
+
+    /// Copying forbidden.
+    MachineConnectivityIndex(const MachineConnectivityIndex&);
+    /// Assignment forbidden.
+    MachineConnectivityIndex& operator=(const MachineConnectivityIndex&);
+
+    void addPorts(const TTAMachine::Unit& unit);
+    int portIndex(const TTAMachine::Port& port) const;
+    int rfIndex(const TTAMachine::BaseRegisterFile& rf) const;
+
+    /// Modification stamp of the machine the index was built from.
+    unsigned long long modificationStamp_;
+    /// Dense indices of the ports of all the units.
+    PortIndexMap portIndices_;
+    /// Dense indices of the register files and immediate units.
+    RFIndexMap rfIndices_;
+    /// Source port as row, destination port as column.
+    BitMatrix* portPort_;
+    /// Source register file as row, destination port as column.
+    BitMatrix* rfPort_;
+    /// Source port as row, destination register file as column.
+    BitMatrix* portRf_;
+    /// Source register file as row, destination register file as column.
+    BitMatrix* rfRf_;
+};
+
+#endif
@@ -58,6 +58,7 @@ namespace boost {
 
 #include <map>
 #include <set>
+#include <vector>
 
 // these need to be included before Boost so we include a working
 // and warning-free hash_map
@@ -312,18 +313,39 @@ protected:
     void  sourceDistDecreased(const GraphNode& n) const;
 
     virtual int edgeWeight( GraphEdge& e, const GraphNode& n) const;
-    
+
+    /**
+     * Path lengths of the nodes indexed by their node descriptors.
+     *
+     * The node descriptors are dense indices of the vertex vector, so a
+     * length is found without searching. Setting a length with the
+     * subscript operator marks it calculated.
+     */
+    class PathLengthTable {
+    public:
+        inline PathLengthTable();
+        inline bool contains(NodeDescriptor nd) const;
+        inline int& operator[](NodeDescriptor nd);
+        inline void erase(NodeDescriptor nd);
+        inline void move(NodeDescriptor from, NodeDescriptor to);
+        inline bool empty() const;
+        inline void clear();
+    private:
+        /// Marks the nodes whose length has not been calculated.
+        static const int NOT_CALCULATED;
+        /// The lengths indexed by node descriptors.
+        std::vector<int> lengths_;
+        /// Number of calculated lengths.
+        int count_;
+    };
+
     // Calculated path lengths
-    mutable std::map<const GraphNode*,int, typename GraphNode::Comparator>
-    sourceDistances_;
-    mutable std::map<const GraphNode*,int, typename GraphNode::Comparator> 
-    sinkDistances_;
+    mutable PathLengthTable sourceDistances_;
+    mutable PathLengthTable sinkDistances_;
 
     // Calculated path lengths
-    mutable std::map<const GraphNode*,int, typename GraphNode::Comparator>
-    loopingSourceDistances_;
-    mutable std::map<const GraphNode*,int, typename GraphNode::Comparator> 
-    loopingSinkDistances_;
+    mutable PathLengthTable loopingSourceDistances_;
+    mutable PathLengthTable loopingSinkDistances_;
     
     mutable int height_;
 
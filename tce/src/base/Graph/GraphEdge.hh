@@ -36,6 +36,8 @@
 #ifndef TTA_GRAPH_EDGE_HH
 #define TTA_GRAPH_EDGE_HH
 
+#include <atomic>
+
 #include "TCEString.hh"
 
 /**
@@ -75,7 +77,8 @@ public:
 private:
     int edgeID_;
     int weight_;
-    static int edgeCounter_;
+    /// atomic as graphs are built in concurrent scheduler threads
+    static std::atomic<int> edgeCounter_;
 };
 
 #endif
@@ -219,6 +219,7 @@ AddressSpace::setWidth(int width) {
     }
 
     width_ = width;
+    setModified();
 }
 
 /**
@@ -237,6 +238,7 @@ AddressSpace::setAddressBounds(ULongWord start, ULongWord end) {
 
     minAddress_ = start;
     maxAddress_ = end;
+    setModified();
 }
 
 /**
@@ -377,6 +379,7 @@ AddressSpace::loadState(const ObjectState* state) {
 void
 AddressSpace::addNumericalId(unsigned id) {
     numericalIds_.insert(id);
+    setModified();
 }
 
 bool
@@ -425,6 +428,7 @@ AddressSpace::setNumericalIds(const std::set<unsigned>& ids) {
 
     // no violating ids found, overwrite ids for this address space
     numericalIds_ = ids;
+    setModified();
     return true;
 }
 
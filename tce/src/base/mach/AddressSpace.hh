@@ -68,7 +68,10 @@ public:
     virtual bool hasNumericalId(unsigned id) const;
     std::set<unsigned> numericalIds() const;
     bool setNumericalIds(const std::set<unsigned>& ids);
-    virtual void setShared(bool shared) { shared_ = shared; }
+    virtual void setShared(bool shared) {
+        shared_ = shared;
+        setModified();
+    }
     virtual bool isShared() const { return shared_; }
 
     virtual void setMachine(Machine& mach);
@@ -125,6 +125,7 @@ BaseFUPort::setWidth(int width) {
     }
 
     width_ = width;
+    setModified();
 }
 
 /**
@@ -100,6 +100,7 @@ BaseRegisterFile::setNumberOfRegisters(int registers) {
     }
 
     size_ = registers;
+    setModified();
 }
 
 /**
@@ -116,6 +117,7 @@ BaseRegisterFile::setWidth(int width) {
     }
 
     width_ = width;
+    setModified();
 }
 
 /**
@@ -385,6 +385,7 @@ Bridge::setSourceAndDestination(Bus& sourceBus, Bus& destinationBus) {
     destinationBus.setSourceBridge(*this);
     sourceBus_ = &sourceBus;
     destinationBus_ = &destinationBus;
+    setModified();
 }
 
 
@@ -428,6 +429,7 @@ Bridge::setFirstOfChain(const Bus& bus) {
                 bridge->destinationBus() != NULL &&
                 AssocTools::containsKey(busesInChain, bridge->nextBus())) {
                 bridge->sourcePrevious_ = !bridge->sourcePrevious_;
+                bridge->setModified();
             }
         }
     }
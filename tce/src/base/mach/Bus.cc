@@ -228,6 +228,7 @@ Bus::setWidth(int width) {
     }
 
     width_ = width;
+    setModified();
 }
 
 /**
@@ -244,6 +245,7 @@ Bus::setImmediateWidth(int width) {
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
     immWidth_ = width;
+    setModified();
 }
 
 /**
@@ -252,6 +254,7 @@ Bus::setImmediateWidth(int width) {
 void
 Bus::setZeroExtends() {
     extensionMode_ = Machine::ZERO;
+    setModified();
 }
 
 
@@ -261,6 +264,7 @@ Bus::setZeroExtends() {
 void
 Bus::setSignExtends() {
     extensionMode_ = Machine::SIGN;
+    setModified();
 }
 
 
@@ -270,6 +274,7 @@ Bus::setSignExtends() {
 void
 Bus::setExtensionMode(const Machine::Extension extension) {
     extensionMode_ = extension;
+    setModified();
 }
 
 
@@ -415,6 +420,7 @@ Bus::addGuard(Guard& guard) {
     }
 
     guards_.push_back(&guard);
+    setModified();
 }
 
 /**
@@ -429,6 +435,7 @@ Bus::removeGuard(Guard& guard) {
     // run time check: can be called from Guard destructor only
     assert(guard.parentBus() == NULL);
     ContainerTools::removeValueIfExists(guards_, &guard);
+    setModified();
 }
 
 
@@ -598,6 +605,7 @@ Bus::setSourceBridge(Bridge& bridge) {
 
     assert(sourceBridges_.size() < 2);
     sourceBridges_.push_back(&bridge);
+    setModified();
 }
 
 
@@ -617,6 +625,7 @@ Bus::setDestinationBridge(Bridge& bridge) {
 
     assert(destinationBridges_.size() < 2);
     destinationBridges_.push_back(&bridge);
+    setModified();
 }
 
 
@@ -637,6 +646,7 @@ Bus::clearSourceBridge(Bridge& bridge) {
     bool removed = ContainerTools::removeValueIfExists(
         sourceBridges_, &bridge);
     assert(removed);
+    setModified();
 }
 
 
@@ -657,6 +667,7 @@ Bus::clearDestinationBridge(Bridge& bridge) {
     bool removed = ContainerTools::removeValueIfExists(
         destinationBridges_, &bridge);
     assert(removed);
+    setModified();
 }
 
 
@@ -743,6 +754,7 @@ Bus::addSegment(Segment& segment) {
         throw ComponentAlreadyExists(__FILE__, __LINE__, procname);
     } else {
         segments_.push_back(&segment);
+        setModified();
     }
 }
 
@@ -761,6 +773,7 @@ Bus::removeSegment(Segment& segment) {
 
     bool removed = ContainerTools::removeValueIfExists(segments_, &segment);
     assert(removed);
+    setModified();
 }
 
 
@@ -147,6 +147,7 @@ ControlUnit::setDelaySlots(int delaySlots) {
         throw OutOfRange(__FILE__, __LINE__, __func__);
     }
     delaySlots_ = delaySlots;
+    setModified();
 }
 
 /**
@@ -174,6 +175,7 @@ ControlUnit::setGlobalGuardLatency(int latency) {
     }
 
     globalGuardLatency_ = latency;
+    setModified();
 }
 
 /**
@@ -275,6 +277,7 @@ ControlUnit::setReturnAddressPort(const SpecialRegisterPort& port) {
     }
 
     raPort_ = const_cast<SpecialRegisterPort*>(&port);
+    setModified();
 }
 
 /**
@@ -283,6 +286,7 @@ ControlUnit::setReturnAddressPort(const SpecialRegisterPort& port) {
 void
 ControlUnit::unsetReturnAddressPort() {
     raPort_ = NULL;
+    setModified();
 }
 
 
@@ -119,6 +119,7 @@ ExecutionPipeline::addResourceUse(
     checkResourceAvailability(name, start, duration);
 
     internalAddResourceUse(name, start, duration);
+    parent_->parentUnit()->setModified();
 }
 
 /**
@@ -147,6 +148,7 @@ ExecutionPipeline::addPortRead(int operand, int start, int duration) {
     checkOperandAvailability(operand, start, duration);
 
     internalAddPortUse(operand, start, duration, opReads_);
+    parent_->parentUnit()->setModified();
 }
 
 /**
@@ -176,6 +178,7 @@ ExecutionPipeline::addPortWrite(int operand, int start, int duration) {
     checkOperandAvailability(operand, start, duration);
 
     internalAddPortUse(operand, start, duration, opWrites_);
+    parent_->parentUnit()->setModified();
 }
 
 /**
@@ -199,6 +202,7 @@ ExecutionPipeline::removeResourceUse(const std::string& name) {
     }
 
     internalRemoveResourceUse(name, 0, latency());
+    parent_->parentUnit()->setModified();
 }
 
 /**
@@ -234,6 +238,7 @@ ExecutionPipeline::removeResourceUse(const std::string& name, int cycle) {
     }
 
     internalRemoveResourceUse(name, cycle, 1);
+    parent_->parentUnit()->setModified();
 }
 
 /**
@@ -255,6 +260,7 @@ ExecutionPipeline::removeAllResourceUses() {
          iter != usedResources.end(); iter++) {
         parent->cleanup((*iter)->name());
     }
+    parent_->parentUnit()->setModified();
 }
 
 
@@ -285,6 +291,7 @@ ExecutionPipeline::removeOperandUse(int operand, int cycle) {
     }
 
     internalRemoveOperandUse(operand, cycle, 1);
+    parent_->parentUnit()->setModified();
 }
 
 /**
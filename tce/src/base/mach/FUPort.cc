@@ -227,6 +227,7 @@ FUPort::setTriggering(bool triggers) {
         setsOpcode_ = false;
     }
     triggers_ = triggers;
+    setModified();
 }
 
 
@@ -478,6 +479,7 @@ FUPort::noRegister() const {
 void
 FUPort::setNoRegister(bool noRegister) {
     noRegister_ = noRegister;
+    setModified();
 }
     
 }
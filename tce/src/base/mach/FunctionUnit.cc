@@ -290,6 +290,7 @@ FunctionUnit::addOperation(HWOperation& operation) {
 
     if (!FunctionUnit::hasOperation(operation.name())) {
         operations_.push_back(&operation);
+        setModified();
     } else {
         string procName = "FunctionUnit::addOperation";
         throw ComponentAlreadyExists(__FILE__, __LINE__, procName);
@@ -318,6 +319,7 @@ FunctionUnit::deleteOperation(HWOperation& operation) {
         }
         delete &operation;
     }
+    setModified();
 }
 
 /**
@@ -474,6 +476,7 @@ FunctionUnit::addPipelineElement(PipelineElement& element) {
         throw ComponentAlreadyExists(__FILE__, __LINE__, procName);
     } else {
         pipelineElements_.push_back(&element);
+        setModified();
     }
 }
 
@@ -495,6 +498,7 @@ FunctionUnit::deletePipelineElement(PipelineElement& element) {
     bool removed = ContainerTools::removeValueIfExists(
         pipelineElements_, &element);
     assert(removed);
+    setModified();
 }
 
 
@@ -597,6 +601,7 @@ FunctionUnit::setAddressSpace(AddressSpace* as) {
     }
 
     addressSpace_ = as;
+    setModified();
 }
 
 /**
@@ -927,5 +932,6 @@ FunctionUnit::orderNumber() const {
 void
 FunctionUnit::setOrderNumber(int number) {
     orderNumber_ = number;
+    setModified();
 }
 }
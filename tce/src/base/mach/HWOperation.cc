@@ -179,6 +179,7 @@ HWOperation::setName(const std::string& name) {
     }
 
     name_ = lowerName;
+    parentUnit()->setModified();
 }
 
 /**
@@ -285,6 +286,7 @@ HWOperation::bindPort(int operand, const FUPort& port) {
 
     operandBinding_[operand] = &port;
     port.updateBindingString();
+    parentUnit()->setModified();
 }
 
 /**
@@ -296,6 +298,7 @@ void
 HWOperation::unbindPort(const FUPort& port) {
     MapTools::removeItemsByValue(operandBinding_, &port);
     port.updateBindingString();
+    parentUnit()->setModified();
 }
 
 
@@ -184,6 +184,7 @@ ImmediateUnit::setMaxWrites(int maxWrites) {
 void
 ImmediateUnit::setExtensionMode(Machine::Extension mode) {
     extension_ = mode;
+    setModified();
 }
 
 
@@ -200,6 +201,7 @@ ImmediateUnit::setLatency(int latency) {
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
     latency_ = latency;
+    setModified();
 }
 
 /**
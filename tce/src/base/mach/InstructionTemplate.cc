@@ -189,6 +189,7 @@ InstructionTemplate::addSlot(
     } else {
         throw InstanceNotFound(__FILE__, __LINE__, procName);
     }
+    setModified();
 }
 
 /**
@@ -203,6 +204,7 @@ InstructionTemplate::removeSlot(const std::string& slotName) {
         bool removed = ContainerTools::deleteValueIfExists(slots_, slot);
         assert(removed);
     }
+    setModified();
 }
 
 
@@ -224,6 +226,7 @@ InstructionTemplate::removeSlots(const ImmediateUnit& dstUnit) {
             iter++;
         }
     }
+    setModified();
 }
 
 /**
@@ -612,6 +615,7 @@ InstructionTemplate::loadState(const ObjectState* state) {
 void
 InstructionTemplate::deleteAllSlots() {
     SequenceTools::deleteAllItems(slots_);
+    setModified();
 }
 
 
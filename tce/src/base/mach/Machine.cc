@@ -33,6 +33,7 @@
 
 #include <string>
 #include <set>
+#include <atomic>
 #include <boost/functional/hash.hpp>
 
 #include "Machine.hh"
@@ -69,11 +70,15 @@ const string Machine::OSKEY_TRIGGER_INVALIDATES_OLD_RESULTS
 	= "trigger-invalidates";
 const string Machine::OSKEY_FUNCTION_UNITS_ORDERED = "fu-ordered";
 
+/// The last modification stamp given to any machine.
+static std::atomic<unsigned long long> lastModificationStamp(0);
+
 /**
  * Constructor.
  */
 Machine::Machine() : 
-    controlUnit_(NULL), doValidityChecks_(true), 
+    hash_(), hashValid_(false), modificationStamp_(++lastModificationStamp),
+    controlUnit_(NULL), doValidityChecks_(true),
     machineTester_(new MachineTester(*this)), 
     dummyMachineTester_(new DummyMachineTester(*this)),
     EMPTY_ITEMP_NAME_("no_limm"), alwaysWriteResults_(false), 
@@ -92,7 +97,9 @@ Machine::Machine() :
  * @param old The machine to be copied.
  */
 Machine::Machine(const Machine& old) : 
-    Serializable(), controlUnit_(NULL), doValidityChecks_(false),
+    Serializable(), hash_(), hashValid_(false),
+    modificationStamp_(++lastModificationStamp), controlUnit_(NULL),
+    doValidityChecks_(false),
     machineTester_(new MachineTester(*this)), 
     dummyMachineTester_(new DummyMachineTester(*this)),
     littleEndian_(old.littleEndian_),
@@ -102,6 +109,10 @@ Machine::Machine(const Machine& old) :
     loadState(state);
     delete state;
     doValidityChecks_ = true;
+
+    // the machines are equal, so the hash of the old one is valid
+    hash_ = old.hash_;
+    hashValid_ = old.hashValid_;
 }
     
         
@@ -318,6 +329,7 @@ Machine::setGlobalControl(ControlUnit& unit) {
         unit.setMachine(*this);
     } else {
         controlUnit_ = &unit;
+        setModified();
     }
 }
 
@@ -545,6 +557,7 @@ Machine::unsetGlobalControl() {
     } else {
         if (controlUnit_->machine() == NULL) {
             controlUnit_ = NULL;
+            setModified();
         } else {
             controlUnit_->unsetMachine();
         }
@@ -696,6 +709,8 @@ Machine::loadState(const ObjectState* state) {
         throw ObjectStateLoadingException(__FILE__, __LINE__, procName);
     }
 
+    setModified();
+
     // delete all the old components
     busses_.deleteAll();
     sockets_.deleteAll();
@@ -878,30 +893,103 @@ Machine::writeToADF(const std::string& adfFileName) const {
  * Returns a hash string of the machine to determine quickly
  * in case two machines are the same.
  *
- * The hash consists of a 32bit hash of the .adf xml data concat with
- * the .adf data length as a hex string. 
+ * The hash consists of the number of the components concat with a hash of
+ * the structure of the machine, both as hex strings. The hash of the
+ * structure combines the hashes of the components and does not depend on
+ * the order of the components in the machine. The hashes of the components
+ * are cached and recomputed only for the components modified since, and
+ * the hash string is cached until the next modification of the machine.
  *
- * @note The hash string is done based on the ADF XML format, thus does 
- * not account for changes that have the different XML output, but in
- * reality are the same architecture (in the point of view of the 
- * programmer).
+ * @note The hash is based on the ObjectState trees of the components, thus
+ * does not account for changes that have different trees, but in reality
+ * are the same architecture (in the point of view of the programmer).
  */
 TCEString
 Machine::hash() const {
-    ADFSerializer serializer;
-    std::string buffer;
-    serializer.setDestinationString(buffer);
-    serializer.writeMachine(*this);
+    if (hashValid_) {
+        return hash_;
+    }
 
-    boost::hash<std::string> string_hasher;
-    size_t h = string_hasher(buffer);
+    std::size_t h = 0;
+    boost::hash_combine(h, componentsHash(busses_));
+    boost::hash_combine(h, componentsHash(sockets_));
+    boost::hash_combine(h, componentsHash(bridges_));
+    boost::hash_combine(h, componentsHash(functionUnits_));
+    boost::hash_combine(h, componentsHash(registerFiles_));
+    boost::hash_combine(h, componentsHash(immediateUnits_));
+    boost::hash_combine(h, componentsHash(addressSpaces_));
+    boost::hash_combine(h, componentsHash(instructionTemplates_));
+    boost::hash_combine(h, componentsHash(immediateSlots_));
+    int componentCount =
+        busses_.count() + sockets_.count() + bridges_.count() +
+        functionUnits_.count() + registerFiles_.count() +
+        immediateUnits_.count() + addressSpaces_.count() +
+        instructionTemplates_.count() + immediateSlots_.count();
+    if (controlUnit_ != NULL) {
+        boost::hash_combine(h, controlUnit_->structuralHash());
+        componentCount++;
+    }
 
-    TCEString hash =
-        (Conversion::toHexString(buffer.length())).substr(2);
+    boost::hash_combine(h, alwaysWriteResults_);
+    boost::hash_combine(h, triggerInvalidatesResults_);
+    boost::hash_combine(h, fuOrdered_);
+    boost::hash_combine(h, littleEndian_);
+    boost::hash_combine(h, bitness64_);
+
+    hash_ = (Conversion::toHexString(componentCount)).substr(2);
+    hash_ += "_";
+    hash_ += (Conversion::toHexString(h)).substr(2);
+    hashValid_ = true;
+    return hash_;
+}
 
-    hash += "_";
-    hash += (Conversion::toHexString(h)).substr(2);
-    return hash;
+/**
+ * Notifies the machine that it or one of its components has been modified.
+ *
+ * Drops the cached hash string and renews the modification stamp.
+ */
+void
+Machine::setModified() {
+    hashValid_ = false;
+    modificationStamp_ = ++lastModificationStamp;
+}
+
+/**
+ * Returns a stamp that identifies the current state of the machine.
+ *
+ * The stamp changes whenever the machine or one of its components is
+ * modified, and no two machines of the process share the same stamp, even
+ * if one of them is deleted and the other is allocated to its address.
+ * Analyses can thus cache their results keyed by the stamp.
+ *
+ * @return The modification stamp.
+ */
+unsigned long long
+Machine::modificationStamp() const {
+    return modificationStamp_;
+}
+
+/**
+ * Drops the cached hashes of all the components of the machine.
+ *
+ * Called when a component is renamed, as the other components may refer to
+ * it by its name.
+ */
+void
+Machine::setComponentsModified() {
+    setComponentsModified(busses_);
+    setComponentsModified(sockets_);
+    setComponentsModified(bridges_);
+    setComponentsModified(functionUnits_);
+    setComponentsModified(registerFiles_);
+    setComponentsModified(immediateUnits_);
+    setComponentsModified(addressSpaces_);
+    setComponentsModified(instructionTemplates_);
+    setComponentsModified(immediateSlots_);
+    if (controlUnit_ != NULL) {
+        controlUnit_->setModified();
+    }
+    setModified();
 }
 
 /**
@@ -942,6 +1030,7 @@ Machine::isFUOrdered() const {
 void 
 Machine::setAlwaysWriteResults(bool result){
     alwaysWriteResults_ = result;
+    setModified();
 }
     
 /**
@@ -950,6 +1039,7 @@ Machine::setAlwaysWriteResults(bool result){
 void 
 Machine::setTriggerInvalidatesResults(bool trigger) {
     triggerInvalidatesResults_ = trigger;
+    setModified();
 }
 
 /* *
@@ -962,6 +1052,7 @@ Machine::setTriggerInvalidatesResults(bool trigger) {
 void 
 Machine::setFUOrdered(bool order){
     fuOrdered_ = order;
+    setModified();
 }
 
 /**
@@ -980,6 +1071,38 @@ Machine::saveComponentStates(ContainerType& container, ObjectState* parent) {
     }
 }
 
+/**
+ * Returns the sum of the structural hashes of the components in the given
+ * container.
+ *
+ * The sum does not depend on the order of the components.
+ *
+ * @param container The container.
+ * @return The combined hash.
+ */
+template <typename ContainerType>
+std::size_t
+Machine::componentsHash(const ContainerType& container) {
+    std::size_t hash = 0;
+    for (int i = 0; i < container.count(); i++) {
+        hash += container.item(i)->structuralHash();
+    }
+    return hash;
+}
+
+/**
+ * Drops the cached hashes of the components in the given container.
+ *
+ * @param container The container.
+ */
+template <typename ContainerType>
+void
+Machine::setComponentsModified(ContainerType& container) {
+    for (int i = 0; i < container.count(); i++) {
+        container.item(i)->setModified();
+    }
+}
+
 /**
  * Gets the maximum latency of any operation supported by this machine.
  */
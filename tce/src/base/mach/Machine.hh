@@ -137,6 +137,9 @@ public:
     void writeToADF(const std::string& adfFileName) const;
 
     TCEString hash() const;
+    void setModified();
+    void setComponentsModified();
+    unsigned long long modificationStamp() const;
 
     bool hasOperation(const TCEString& opName) const;
 
@@ -244,9 +247,9 @@ public:
     static const std::string OSKEY_FUNCTION_UNITS_ORDERED;
 
     bool isLittleEndian() const { return littleEndian_; }
-    void setLittleEndian(bool flag) { littleEndian_ = flag; }
+    void setLittleEndian(bool flag) { littleEndian_ = flag; setModified(); }
     bool is64bit() const { return bitness64_; }
-    void set64bits(bool flag) { bitness64_ = flag; }
+    void set64bits(bool flag) { bitness64_ = flag; setModified(); }
 private:
     /// Assignment not allowed.
     Machine& operator=(const Machine&);
@@ -268,6 +271,21 @@ private:
         ContainerType& container,
         ObjectState* parent);
 
+    template <typename ContainerType>
+    static std::size_t componentsHash(const ContainerType& container);
+
+    template <typename ContainerType>
+    static void setComponentsModified(ContainerType& container);
+
+    /// The cached hash string of the machine. Declared before the
+    /// components, which may modify the machine while being destructed.
+    mutable TCEString hash_;
+    /// True if the cached hash string is up to date.
+    mutable bool hashValid_;
+    /// Identifies the current state of the machine, see
+    /// modificationStamp().
+    unsigned long long modificationStamp_;
+
     /// Contains all the busses attached to the machine.
     ComponentContainer<Bus> busses_;
     /// Contains all the sockets attached to the machine.
@@ -39,6 +39,7 @@
 #include "MOMTextGenerator.hh"
 #include "Application.hh"
 #include "ObjectState.hh"
+#include "Machine.hh"
 
 using std::string;
 using boost::format;
@@ -80,7 +81,8 @@ const string Component::OSKEY_NAME = "name";
  *                        component.
  */
 Component::Component(const std::string& name)
-    : MachinePart(), name_(name), machine_(NULL) {
+    : MachinePart(), name_(name), machine_(NULL), hash_(0),
+      hashValid_(false) {
     if (!MachineTester::isValidComponentName(name)) {
         const string procName = "Component::Component";
         MOMTextGenerator textGen;
@@ -99,7 +101,8 @@ Component::Component(const std::string& name)
  * @exception ObjectStateLoadingException If the given ObjectState instance
  *                                        is invalid.
  */
-Component::Component(const ObjectState* state) : MachinePart(), machine_(NULL) {
+Component::Component(const ObjectState* state)
+    : MachinePart(), machine_(NULL), hash_(0), hashValid_(false) {
     try {
         setName(state->stringAttribute(OSKEY_NAME));
     } catch (const Exception& e) {
@@ -149,6 +152,7 @@ Component::setName(const std::string& name) {
     }
 
     name_ = name;
+    setNamesModified();
 }
 
 /**
@@ -179,6 +183,56 @@ Component::isRegistered() const {
 }
 
 
+/**
+ * Returns a hash value of the component and its subcomponents.
+ *
+ * The hash is computed from the ObjectState tree of the component and
+ * cached until the component is modified.
+ *
+ * @return The hash value.
+ */
+std::size_t
+Component::structuralHash() const {
+    if (!hashValid_) {
+        ObjectState* state = saveState();
+        hash_ = state->hashValue();
+        delete state;
+        hashValid_ = true;
+    }
+    return hash_;
+}
+
+/**
+ * Notifies the component that its state has been modified.
+ *
+ * Drops the cached hash of the component and the hash of the machine it is
+ * registered to. All the methods that modify the state saved by saveState()
+ * must call this, including the ones of the subcomponents.
+ */
+void
+Component::setModified() {
+    hashValid_ = false;
+    if (machine_ != NULL) {
+        machine_->setModified();
+    }
+}
+
+/**
+ * Notifies the component that the name of it or of one of its
+ * subcomponents has changed.
+ *
+ * The other components of the machine refer to the component by its name,
+ * so the cached hashes of all of them are dropped.
+ */
+void
+Component::setNamesModified() {
+    if (machine_ != NULL) {
+        machine_->setComponentsModified();
+    } else {
+        setModified();
+    }
+}
+
 /**
  * Creates a new ObjectState instance and saves the name of the component
  * into it.
@@ -205,6 +259,8 @@ void
 Component::loadState(const ObjectState* state) {
     const string procName = "Component::loadState";
 
+    setModified();
+
     try {
         string name = state->stringAttribute(OSKEY_NAME);
         setName(name);
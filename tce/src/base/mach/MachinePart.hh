@@ -35,6 +35,7 @@
 #ifndef TTA_MACHINE_PART_HH
 #define TTA_MACHINE_PART_HH
 
+#include <cstddef>
 #include <string>
 
 #include "Serializable.hh"
@@ -110,6 +111,10 @@ public:
     virtual void ensureRegistration(const Component& component) const;
     virtual bool isRegistered() const;
 
+    std::size_t structuralHash() const;
+    void setModified();
+    void setNamesModified();
+
     // methods inherited from Serializable interface
     virtual ObjectState* saveState() const;
     virtual void loadState(const ObjectState* state);
@@ -153,6 +158,10 @@ private:
     std::string name_;
     /// Machine to which the component is registered.
     Machine* machine_;
+    /// Cached structural hash of the component.
+    mutable std::size_t hash_;
+    /// True if the cached structural hash is up to date.
+    mutable bool hashValid_;
 };
 
 ////////////////////////////////////////////////////////////////////////////
@@ -106,6 +106,7 @@ PipelineElement::setName(const std::string& name) {
     }
 
     name_ = name;
+    parentUnit()->setModified();
 }
 
 bool PipelineElement::Comparator::operator()(
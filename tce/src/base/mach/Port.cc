@@ -172,6 +172,7 @@ Port::setName(const std::string& name) {
     }
 
     name_ = name;
+    parentUnit()->setNamesModified();
 }
 
 /**
@@ -215,6 +216,7 @@ Port::attachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.attachPort(*this);
+    setModified();
 
     // sanity check
     if (socket2_ != NULL) {
@@ -247,6 +249,7 @@ Port::detachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.detachPort(*this);
+    setModified();
 }
 
 /**
@@ -542,9 +545,20 @@ Port::detachAllSockets() {
         socket2_->detachPort(*this);
         socket2_ = NULL;
     }
+    setModified();
 }
 
 
+/**
+ * Notifies the parent unit that the port has been modified.
+ */
+void
+Port::setModified() {
+    if (parentUnit_ != NULL) {
+        parentUnit_->setModified();
+    }
+}
+
 bool 
 Port::PairComparator::operator()(
     const std::pair<const Port*, const Port*>& pp1, 
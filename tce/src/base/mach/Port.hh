@@ -93,6 +93,7 @@ public:
 
 protected:
     Port(const std::string& name, FunctionUnit& parentUnit);
+    void setModified();
 
 private:
     /// Copying forbidden.
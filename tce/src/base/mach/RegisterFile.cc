@@ -228,6 +228,7 @@ RegisterFile::setMaxReads(int reads) {
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
     maxReads_ = reads;
+    setModified();
 }
 
 /**
@@ -248,6 +249,7 @@ RegisterFile::setMaxWrites(int maxWrites) {
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
     maxWrites_ = maxWrites;
+    setModified();
 }
 
 /**
@@ -301,6 +303,7 @@ RegisterFile::updateMaxReadsAndWrites() const {
 void
 RegisterFile::setType(RegisterFile::Type type) {
     type_ = type;
+    setModified();
 }
 
 
@@ -364,6 +367,7 @@ RegisterFile::setGuardLatency(int latency) {
     }   
 
     guardLatency_ = latency;
+    setModified();
 }
 
 /**
@@ -165,6 +165,7 @@ Segment::setName(const string& name) {
     }
 
     name_ = name;
+    parentBus()->setNamesModified();
 }
 
 /**
@@ -184,6 +185,7 @@ Segment::attachSocket(Socket& socket) {
         if (!isConnectedTo(socket)) {
             const Connection* conn = &(socket.connection(*this));
             connections_.push_back(conn);
+            parentBus()->setModified();
         } else {
             MachineTester& tester = parentBus()->machine()->machineTester();
             assert(!tester.canConnect(socket, *this));
@@ -340,6 +342,7 @@ Segment::moveBefore(Segment& segment) {
     destinationSegment_ = &segment;
 
     segment.sourceSegment_ = this;
+    parentBus()->setModified();
 }
 
 /**
@@ -377,6 +380,7 @@ Segment::moveAfter(Segment& segment) {
     destinationSegment_ = segment.destinationSegment_;
 
     segment.destinationSegment_ = this;
+    parentBus()->setModified();
 }
 
 /**
@@ -409,6 +413,9 @@ Segment::hasDestinationSegment() const {
 void
 Segment::removeConnection(const Connection* connection) {
     ContainerTools::removeValueIfExists(connections_, connection);
+    if (parent_ != NULL) {
+        parent_->setModified();
+    }
 }
 
 
@@ -141,6 +141,7 @@ Socket::setDirection(Direction direction) {
     MachineTester& tester = machine()->machineTester();
     if (tester.canSetDirection(*this, direction)) {
         direction_ = direction;
+        setModified();
     } else {
         string errorMsg = MachineTestReporter::socketDirectionSettingError(
             *this, direction, tester);
@@ -177,6 +178,7 @@ Socket::attachBus(Segment& bus) {
     if (!bus.isConnectedTo(*this)) {
         const Connection* conn = new Connection(*this, bus);
         busses_.push_back(conn);
+        setModified();
         bus.attachSocket(*this);
     } else {
         assert(false);
@@ -604,6 +606,7 @@ Socket::loadState(const ObjectState* state) {
 void
 Socket::removeConnection(const Connection* connection) {
     ContainerTools::removeValueIfExists(busses_, connection);
+    setModified();
 }
 
 
@@ -217,6 +217,7 @@ Unit::addPort(Port& port) {
     // check that a port with same name does not exist
     if (!hasPort(port.name())) {
         ports_.push_back(&port);
+        setModified();
         return;
     }
 
@@ -239,6 +240,7 @@ Unit::removePort(Port& port) {
     assert(port.parentUnit() == NULL);
     bool removed = ContainerTools::removeValueIfExists(ports_, &port);
     assert(removed);
+    setModified();
 }
 
 
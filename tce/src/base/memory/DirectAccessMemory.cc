@@ -55,8 +55,7 @@ using std::string;
 DirectAccessMemory::DirectAccessMemory(
     ULongWord start, ULongWord end, Word MAUSize, bool littleEndian) :
     Memory(start, end, MAUSize, littleEndian), 
-    start_(start), end_(end), MAUSize_(MAUSize),
-    MAUSize3_(MAUSize_ * 3), MAUSize2_(MAUSize_ * 2) {
+    start_(start), end_(end), MAUSize_(MAUSize) {
         
     /// @note In C++, when shifting more bits than there are in integer, the
     /// result is undefined. Thus, we just set the mask to ~0 in this case.
@@ -68,7 +67,7 @@ DirectAccessMemory::DirectAccessMemory(
         mask_ = ~(~0u << MAUSize_);
     }
 
-    data_ = new MemoryContents(end_ - start_);
+    data_ = new MemoryContents(end_ - start_ + 1, MAUSize_);
 }
 
 
@@ -114,176 +113,67 @@ DirectAccessMemory::write(ULongWord address, Memory::MAU data) {
  */
 void
 DirectAccessMemory::writeBE(ULongWord address, int count, ULongWord data) {
-    Memory::writeBE(address, count,  data);
     // compiled simulator does not call advance clock of
-    // memories at every cycle for efficiency, so we have
-    // to "flush" the writes right away
-    Memory::advanceClock();
+    // memories at every cycle for efficiency, so the writes
+    // are stored right away
+    checkRange(address, count);
+    data_->writeBE(address - start_, count, data);
+    reportWrite(address, count);
 }
 
 /**
- * Reads a single MAU using the fastest possible method.
+ * A convenience method for writing units of data to the memory in
+ * little endian order.
  *
- * @param address The address.
- * @return Data.
- */
-Memory::MAU 
-DirectAccessMemory::read(ULongWord address) {
-    ULongWord data = 0;
-    fastReadMAU(address, data);
-    return data;
-}
-
-/**
- * Writes 1 MAU to the memory as fast as possible
- * 
- * @param address address to write
- * @param data data to be written
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastWriteMAU(ULongWord address, ULongWord data) {
-    data_->writeData(address - start_, (int)(data & mask_));
-}
-
-/**
- * Writes 2 MAUs to the memory as fast as possible
- * 
- * @param address address to write
- * @param data data to be written
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastWrite2MAUsBE(ULongWord address, ULongWord data) {
-    const Word index = address - start_;
-    data_->writeData(index, (int)((data >> MAUSize_) & mask_));
-    data_->writeData(index + 1, (int)(data & mask_));
-}
-
-/**
- * Writes 2 MAUs to the memory as fast as possible in little Endian
- * 
- * @param address address to write
- * @param data data to be written
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastWrite2MAUsLE(ULongWord address, ULongWord data) {
-    const Word index = address - start_;
-    data_->writeData(index + 1, (int)((data >> MAUSize_) & mask_));
-    data_->writeData(index, (int)(data & mask_));
-}
-
-/**
- * Writes 4 MAUs to the memory as fast as possible in BE.
- * 
- * @param address address to write
- * @param data data to be written
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastWrite4MAUsBE(ULongWord address, ULongWord data) {
-    const Word index = address - start_;
-    data_->writeData(index, (int)((data >> MAUSize3_) & mask_));
-    data_->writeData(index + 1, (int)((data >> MAUSize2_) & mask_));
-    data_->writeData(index + 2, (int)((data >> MAUSize_) & mask_));
-    data_->writeData(index + 3, (int)(data & mask_));
-}
-
-/**
- * Writes 4 MAUs to the memory as fast as possible in LE
- * 
- * @param address address to write
- * @param data data to be written
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastWrite4MAUsLE(ULongWord address, ULongWord data) {
-    const Word index = address - start_;
-    data_->writeData(index + 3, (int)((data >> MAUSize3_) & mask_));
-    data_->writeData(index + 2, (int)((data >> MAUSize2_) & mask_));
-    data_->writeData(index + 1, (int)((data >> MAUSize_) & mask_));
-    data_->writeData(index, (int)(data & mask_));
-}
-
-/**
- * Reads 1 MAU from the memory as fast as possible
- * 
- * @param address address to read
- * @param data reference to the read data
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
- */
-void 
-DirectAccessMemory::fastReadMAU(ULongWord address, ULongWord& data) {
-    data = data_->readData(address - start_);
-}
-
-/**
- * Reads 2 MAUs from the memory as fast as possible in BE
- * 
- * @param address address to read
- * @param data reference to the read data
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
+ * @param address The address to write.
+ * @param count Number of MAUs to write.
+ * @param data The data to write.
+ * @exception OutOfRange in case the address is out of range of the memory.
  */
-void 
-DirectAccessMemory::fastRead2MAUsBE(ULongWord address, ULongWord& data) {
-    const Word index = address - start_;
-    data = data_->readData(index) << MAUSize_;
-    data |= data_->readData(index + 1);
+void
+DirectAccessMemory::writeLE(ULongWord address, int count, ULongWord data) {
+    checkRange(address, count);
+    data_->writeLE(address - start_, count, data);
+    reportWrite(address, count);
 }
 
 /**
- * Reads 2 MAUs from the memory as fast as possible in LE
- * 
- * @param address address to read
- * @param data reference to the read data
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
+ * Reads units of data from the memory in big endian order.
+ *
+ * @param address The address to read.
+ * @param count Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
  */
-void 
-DirectAccessMemory::fastRead2MAUsLE(ULongWord address, ULongWord& data) {
-    const Word index = address - start_;
-    data = data_->readData(index +1) << MAUSize_;
-    data |= data_->readData(index);
+void
+DirectAccessMemory::readBE(ULongWord address, int count, ULongWord& data) {
+    checkRange(address, count);
+    data = data_->readBE(address - start_, count);
 }
 
 /**
- * Reads 4 MAUs from the memory as fast as possible in BE
- * 
- * @param address address to read
- * @param data reference to the read data
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
+ * Reads units of data from the memory in little endian order.
+ *
+ * @param address The address to read.
+ * @param count Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
  */
-void 
-DirectAccessMemory::fastRead4MAUsBE(ULongWord address, ULongWord& data) {
-    const Word index = address - start_;
-    data = data_->readData(index) << MAUSize3_;
-    data |= data_->readData(index + 1) << MAUSize2_;
-    data |= data_->readData(index + 2) << MAUSize_;
-    data |= data_->readData(index + 3);
+void
+DirectAccessMemory::readLE(ULongWord address, int count, ULongWord& data) {
+    checkRange(address, count);
+    data = data_->readLE(address - start_, count);
 }
 
 /**
- * Reads 4 MAUs from the memory as fast as possible in LE
- * 
- * @param address address to read
- * @param data reference to the read data
- * @note No bounds checking is made so the address is assumed to be in range.
- * @note On a cycle with read and write, make sure the read is done *first* !
+ * Reads a single MAU using the fastest possible method.
+ *
+ * @param address The address.
+ * @return Data.
  */
-void 
-DirectAccessMemory::fastRead4MAUsLE(ULongWord address, ULongWord& data) {
-    const Word index = address - start_;
-    data = data_->readData(index + 3) << MAUSize3_;
-    data |= data_->readData(index + 2) << MAUSize2_;
-    data |= data_->readData(index + 1) << MAUSize_;
-    data |= data_->readData(index);
+Memory::MAU 
+DirectAccessMemory::read(ULongWord address) {
+    ULongWord data = 0;
+    fastReadMAU(address, data);
+    return data;
 }
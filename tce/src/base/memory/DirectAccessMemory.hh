@@ -35,10 +35,9 @@
 #define TTA_DIRECT_ACCESS_MEMORY_HH
 
 #include "Memory.hh"
+#include "MemoryContents.hh"
 #include "BaseType.hh"
 
-class MemoryContents;
-
 /**
  * Class that models an "ideal" memory to which updates are visible
  * immediately.
@@ -48,6 +47,12 @@ class MemoryContents;
  * one has to make sure that all reads in the same cycle are executed
  * before writes in order for the reads to read the old values.
  *
+ * The fast access methods are inline and access the flat MemoryContents
+ * directly, thus the generated simulation code compiles them to plain
+ * host loads and stores.
+ * The writes are reported to the write watches of the memory, which
+ * costs one predictable branch per store when no range is watched.
+ *
  * Note that all range checking is disabled for fastest possible simulation
  * model. In case you are unsure of your simulated input correctness, use
  * the old simulation engine for verification.
@@ -75,6 +80,10 @@ public:
         ULongWord address,
         ULongWord data);
 
+    void fastWrite8MAUsBE(
+        ULongWord address,
+        ULongWord data);
+
     void fastWrite2MAUsLE(
         ULongWord address,
         ULongWord data);
@@ -83,6 +92,10 @@ public:
         ULongWord address,
         ULongWord data);
 
+    void fastWrite8MAUsLE(
+        ULongWord address,
+        ULongWord data);
+
     Memory::MAU read(ULongWord address) override;
     
     void fastReadMAU(
@@ -97,6 +110,10 @@ public:
         ULongWord address,
         ULongWord& data);
 
+    void fastRead8MAUsBE(
+        ULongWord address,
+        ULongWord& data);
+
     void fastRead2MAUsLE(
         ULongWord address,
         ULongWord& data);
@@ -105,15 +122,25 @@ public:
         ULongWord address,
         ULongWord& data);
 
+    void fastRead8MAUsLE(
+        ULongWord address,
+        ULongWord& data);
+
     virtual void advanceClock() {}
     virtual void reset() {}
     virtual void fillWithZeros();
 
     void writeBE(ULongWord address, int count, ULongWord data) override;
-
+    void writeLE(ULongWord address, int count, ULongWord data) override;
+    void readBE(ULongWord address, int count, ULongWord& data) override;
+    void readLE(ULongWord address, int count, ULongWord& data) override;
 
     using Memory::write;
     using Memory::read;
+    using Memory::writeBE;
+    using Memory::writeLE;
+    using Memory::readBE;
+    using Memory::readLE;
 
 private:
     /// Copying not allowed.
@@ -122,17 +149,11 @@ private:
     DirectAccessMemory& operator=(const DirectAccessMemory&);
 
     /// Starting point of the address space.
-    Word start_;
+    ULongWord start_;
     /// End point of the address space.
-    Word end_;
+    ULongWord end_;
     /// Size of the minimum adressable unit.
     Word MAUSize_;
-    /// precalculated MAUSize_ * 3
-    Word MAUSize3_;
-    /// precalculated MAUSize_ * 2
-    Word MAUSize2_;    
-    /// Size of the natural word as MAUs.
-    Word wordSize_;
     /// Mask bit pattern for unpacking IntWord to MAUs.
     Word mask_;
     /// Contains MAUs of the memory model, that is, the actual data of the
@@ -140,4 +161,6 @@ private:
     MemoryContents* data_;
 };
 
+#include "DirectAccessMemory.icc"
+
 #endif
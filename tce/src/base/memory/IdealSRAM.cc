@@ -56,7 +56,7 @@ using std::string;
 IdealSRAM::IdealSRAM(ULongWord start, ULongWord end, Word MAUSize, bool littleEndian) :
     Memory(start, end, MAUSize, littleEndian), start_(start), end_(end), 
     MAUSize_(MAUSize) {
-    data_ = new MemoryContents(end_ - start_);
+    data_ = new MemoryContents(end_ - start_ + 1, MAUSize_);
 }
 
 
@@ -97,6 +97,37 @@ IdealSRAM::read(ULongWord address) {
     return data_->readData(address - start_);
 }
 
+/**
+ * Reads units of data from the memory in big endian order.
+ *
+ * Reads the committed contents directly, the writes of the current cycle
+ * are not visible, as with the MAU-wise read of the base class.
+ *
+ * @param address The address to read.
+ * @param size Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+IdealSRAM::readBE(ULongWord address, int size, ULongWord& data) {
+    checkRange(address, size);
+    data = data_->readBE(address - start_, size);
+}
+
+/**
+ * Reads units of data from the memory in little endian order.
+ *
+ * @param address The address to read.
+ * @param size Number of MAUs to read.
+ * @param data The read data.
+ * @exception OutOfRange in case the address is out of range of the memory.
+ */
+void
+IdealSRAM::readLE(ULongWord address, int size, ULongWord& data) {
+    checkRange(address, size);
+    data = data_->readLE(address - start_, size);
+}
+
 /**
  * Fills the whole memory with zeros.
  *
@@ -48,9 +48,8 @@ class MemoryContents;
  * Also, after a store is initiated, data is written into memory as soon as
  * the clock advances.
  *
- * This implementation uses a "paged array" as the storage structure which
- * avoids unnecessary allocation while providing O(1) access time. See
- * PagedArray for more details.
+ * This implementation stores the data in a flat MemoryContents region
+ * which the host allocates lazily. See MemoryContents for more details.
  */
 class IdealSRAM : public Memory {
 public:
@@ -60,8 +59,13 @@ public:
     virtual void write(ULongWord address, MAU data) override;
     virtual Memory::MAU read(ULongWord address) override;
 
+    void readBE(ULongWord address, int size, ULongWord& data) override;
+    void readLE(ULongWord address, int size, ULongWord& data) override;
+
     using Memory::write;
     using Memory::read;
+    using Memory::readBE;
+    using Memory::readLE;
 
     virtual void fillWithZeros();
 
@@ -72,9 +76,9 @@ private:
     IdealSRAM& operator=(const IdealSRAM&);
 
     /// Starting point of the address space.
-    UIntWord start_;
+    ULongWord start_;
     /// End point of the address space.
-    UIntWord end_;
+    ULongWord end_;
     /// Size of the minimum adressable unit.
     Word MAUSize_;
     /// Container for holding read/write requests.
@@ -119,6 +119,7 @@ Memory::writeDirectlyBE(ULongWord address, int count, ULongWord data) {
     for (int i = 0; i < count; ++i) {
         write(address + i, MAUData[i]);
     }
+    reportWrite(address, count);
 }
 
 /**
@@ -144,6 +145,7 @@ Memory::writeDirectlyLE(ULongWord address, int count, ULongWord data) {
     for (int i = 0; i < count; ++i) {
         write(address + i, MAUData[i]);
     }
+    reportWrite(address, count);
 }
 
 
@@ -203,7 +205,7 @@ Memory::writeBE(ULongWord address, int count, ULongWord data) {
     std::memcpy(request->data_, MAUData, count*sizeof(MAU));
     request->size_ = count;
     request->address_ = address;
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 
@@ -230,7 +232,7 @@ Memory::writeLE(ULongWord address, int count, ULongWord data) {
     std::memcpy(request->data_, MAUData, count*sizeof(MAU));
     request->size_ = count;
     request->address_ = address;
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 /**
@@ -376,7 +378,7 @@ Memory::writeBE(ULongWord address, FloatWord data) {
         #endif
         request->data_[i] = data;
     }
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 /**
@@ -421,7 +423,7 @@ Memory::writeLE(ULongWord address, FloatWord data) {
         #endif
         request->data_[i] = data;
     }
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 
@@ -578,7 +580,7 @@ Memory::writeBE(ULongWord address, DoubleWord data) {
         #endif
         request->data_[i] = data;
     }
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 /**
@@ -623,7 +625,7 @@ Memory::writeLE(ULongWord address, DoubleWord data) {
         #endif
         request->data_[i] = data;
     }
-    writeRequests_->push_back(request);
+    writeRequests_->add(request);
 }
 
 /**
@@ -710,7 +712,9 @@ Memory::fillWithZeros() {
 /**
  * Resets the memory.
  *
- * Clears any pending write requests.
+ * Clears any pending write requests. Raises the flags of all write watches,
+ * as the memory is reinitialized after a reset with write(address, MAU),
+ * which does not report the writes.
  */
 void
 Memory::reset() {
@@ -722,6 +726,10 @@ Memory::reset() {
         ++iter;
     }
     writeRequests_->clear();
+
+    for (std::size_t i = 0; i < writeWatches_.size(); ++i) {
+        *writeWatches_[i].written = true;
+    }
 }
 
 /**
@@ -808,6 +816,26 @@ Memory::unpackLE(
     }
 }
 
+/**
+ * Sets whether the memory may be written from several threads during
+ * a single clock cycle.
+ *
+ * Used for memories shared by cores that are simulated in parallel.
+ * The pending write requests are then queued under a lock. The commit
+ * in advanceClock() must still be done from a single thread.
+ *
+ * @param concurrent True in case concurrent writes should be allowed.
+ */
+void
+Memory::setConcurrentWrites(bool concurrent) {
+    if (concurrent && writeRequests_->lock_ == NULL) {
+        writeRequests_->lock_ = new boost::mutex();
+    } else if (!concurrent) {
+        delete writeRequests_->lock_;
+        writeRequests_->lock_ = NULL;
+    }
+}
+
 /**
  * Advances clock for one cycle.
  *
@@ -824,6 +852,7 @@ Memory::advanceClock() {
         for (int i = 0; i < req->size_; ++i) {
             write(req->address_ + i, req->data_[i]);
         }
+        reportWrite(req->address_, req->size_);
         delete[] (*iter)->data_;
         (*iter)->data_ = NULL;
         delete (*iter);
@@ -833,6 +862,58 @@ Memory::advanceClock() {
     writeRequests_->clear();
 }
 
+/**
+ * Starts watching an address range for writes.
+ *
+ * The flag is raised whenever a write to any address of the range is
+ * committed and when the memory is reset. It is never cleared by the
+ * memory.
+ *
+ * @param first The first address of the range.
+ * @param last The last address of the range.
+ * @param written The flag to raise. Identifies the watch.
+ */
+void
+Memory::addWriteWatch(ULongWord first, ULongWord last, bool& written) {
+    WriteWatch watch;
+    watch.first = first;
+    watch.last = last;
+    watch.written = &written;
+    writeWatches_.push_back(watch);
+}
+
+/**
+ * Stops watching the range of a write watch.
+ *
+ * @param written The flag of the watch.
+ */
+void
+Memory::removeWriteWatch(const bool& written) {
+    for (std::size_t i = 0; i < writeWatches_.size(); ++i) {
+        if (writeWatches_[i].written == &written) {
+            writeWatches_.erase(writeWatches_.begin() + i);
+            return;
+        }
+    }
+}
+
+/**
+ * Raises the flags of the write watches a write overlaps.
+ *
+ * @param address The first written address.
+ * @param numberOfMAUs The number of written MAUs.
+ */
+void
+Memory::reportWatchedWrite(ULongWord address, int numberOfMAUs) {
+    const ULongWord last = address + numberOfMAUs - 1;
+    for (std::size_t i = 0; i < writeWatches_.size(); ++i) {
+        const WriteWatch& watch = writeWatches_[i];
+        if (address <= watch.last && last >= watch.first) {
+            *watch.written = true;
+        }
+    }
+}
+
 /**
  * Helper for checking the legality of the memory access address range.
  *
@@ -843,8 +924,8 @@ Memory::advanceClock() {
 void
 Memory::checkRange(ULongWord startAddress, int numberOfMAUs) {
 
-    unsigned int low = start(); 
-    unsigned int high = end(); 
+    ULongWord low = start(); 
+    ULongWord high = end(); 
 
     if ((startAddress < low) || (startAddress > high - numberOfMAUs + 1)) {
         throw OutOfRange(
@@ -35,6 +35,8 @@
 #ifndef TTA_MEMORY_MODEL_HH
 #define TTA_MEMORY_MODEL_HH
 
+#include <vector>
+
 #include "BaseType.hh"
 
 struct WriteRequest;
@@ -70,6 +72,10 @@ struct RequestQueue;
  * access the Memory for storing writing doubles and floats in case it 
  * implements floating point memory operations. Interface for those is
  * out of the abstraction level of this interface.
+ *
+ * Clients can watch address ranges for writes. The memory raises the flag
+ * of a write watch when a write to the range is committed, thus watching
+ * a memory location does not require polling its contents.
  */
 class Memory {
 public:
@@ -113,6 +119,11 @@ public:
     virtual void reset();
     virtual void fillWithZeros();
 
+    void setConcurrentWrites(bool concurrent);
+
+    virtual void addWriteWatch(ULongWord first, ULongWord last, bool& written);
+    virtual void removeWriteWatch(const bool& written);
+
     virtual ULongWord start() { return start_; }
     virtual ULongWord end() { return end_; }
     virtual ULongWord MAUSize() { return MAUSize_; }
@@ -124,16 +135,28 @@ protected:
     void unpackBE(const ULongWord& value, int size, Memory::MAUTable data);
     void packLE(const Memory::MAUTable data, int size, ULongWord& value);
     void unpackLE(const ULongWord& value, int size, Memory::MAUTable data);
+    void checkRange(ULongWord startAddress, int numberOfMAUs);
+    void reportWrite(ULongWord address, int numberOfMAUs);
     
     bool littleEndian_;
 private:
+    /// An address range watched for writes.
+    struct WriteWatch {
+        /// The first address of the range.
+        ULongWord first;
+        /// The last address of the range.
+        ULongWord last;
+        /// The flag raised when the range is written.
+        bool* written;
+    };
+
+    void reportWatchedWrite(ULongWord address, int numberOfMAUs);
+
     /// Copying not allowed.
     Memory(const Memory&);
     /// Assignment not allowed.
     Memory& operator=(const Memory&);
 
-    void checkRange(ULongWord startAddress, int numberOfMAUs);
-
     /// Starting point of the address space.
     ULongWord start_;
     /// End point of the address space.
@@ -145,6 +168,8 @@ private:
     RequestQueue* writeRequests_;
     /// Mask bit pattern for unpacking IntULongWord to MAUs.
     int mask_;
+    /// The address ranges watched for writes.
+    std::vector<WriteWatch> writeWatches_;
 
 };
 
@@ -0,0 +1,178 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MemoryContents.cc
+ *
+ * Definition of MemoryContents class.
+ *
+ * @note rating: red
+ */
+
+#include <sys/mman.h>
+#include <limits>
+
+#include <boost/format.hpp>
+
+#include "MemoryContents.hh"
+#include "Exception.hh"
+
+/**
+ * Constructor.
+ *
+ * Reserves the host address range for the contents. No host memory is
+ * allocated until the MAUs are written.
+ *
+ * @param size Number of MAUs in the memory.
+ * @param MAUSize Bit width of the MAU.
+ * @exception OutOfRange If the host cannot reserve a range that large.
+ */
+MemoryContents::MemoryContents(ULongWord size, Word MAUSize) :
+    size_(size), MAUSize_(MAUSize), narrowMAUs_(MAUSize <= 8),
+    byteMAUs_(MAUSize == 8), regionSize_(0), region_(NULL), bytes_(NULL),
+    maus_(NULL) {
+
+    if (MAUSize_ >= static_cast<Word>(std::numeric_limits<Word>::digits)) {
+        mask_ = ~0u;
+    } else {
+        mask_ = ~(~0u << MAUSize_);
+    }
+
+    std::size_t elementSize = narrowMAUs_ ? 1 : sizeof(Memory::MAU);
+    if (size_ == 0 ||
+        size_ > std::numeric_limits<std::size_t>::max() / elementSize) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Cannot reserve host memory for %d MAUs.") % size_).str());
+    }
+    regionSize_ = size_ * elementSize;
+    reserve();
+}
+
+/**
+ * Destructor.
+ */
+MemoryContents::~MemoryContents() {
+    if (region_ != NULL) {
+        munmap(region_, regionSize_);
+    }
+}
+
+/**
+ * Sets all the MAUs to zero and releases the host memory of the contents.
+ */
+void
+MemoryContents::clear() {
+    munmap(region_, regionSize_);
+    region_ = NULL;
+    reserve();
+}
+
+/**
+ * Maps a zero filled region of regionSize_ bytes.
+ *
+ * @exception OutOfRange If the mapping fails.
+ */
+void
+MemoryContents::reserve() {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    // the pages of a sparsely used address space are never touched
+    flags |= MAP_NORESERVE;
+#endif
+    void* region =
+        mmap(NULL, regionSize_, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (region == MAP_FAILED) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Cannot reserve %d bytes of host memory for %d MAUs.") %
+             regionSize_ % size_).str());
+    }
+    region_ = region;
+    bytes_ = static_cast<std::uint8_t*>(region_);
+    maus_ = static_cast<Memory::MAU*>(region_);
+}
+
+/**
+ * Packs MAUs to a word in big endian order one MAU at a time.
+ *
+ * @param index Index of the first MAU.
+ * @param count Number of MAUs.
+ * @return The packed word.
+ */
+ULongWord
+MemoryContents::packBE(ULongWord index, int count) const {
+    ULongWord value = 0;
+    for (int i = 0; i < count; ++i) {
+        value = (value << MAUSize_) | readData(index + i);
+    }
+    return value;
+}
+
+/**
+ * Packs MAUs to a word in little endian order one MAU at a time.
+ *
+ * @param index Index of the first MAU.
+ * @param count Number of MAUs.
+ * @return The packed word.
+ */
+ULongWord
+MemoryContents::packLE(ULongWord index, int count) const {
+    ULongWord value = 0;
+    for (int i = count - 1; i >= 0; --i) {
+        value = (value << MAUSize_) | readData(index + i);
+    }
+    return value;
+}
+
+/**
+ * Unpacks a word to MAUs in big endian order one MAU at a time.
+ *
+ * @param index Index of the first MAU.
+ * @param count Number of MAUs.
+ * @param data The packed word.
+ */
+void
+MemoryContents::unpackBE(ULongWord index, int count, ULongWord data) {
+    for (int i = count - 1; i >= 0; --i) {
+        writeData(index + i, static_cast<Memory::MAU>(data & mask_));
+        data >>= MAUSize_;
+    }
+}
+
+/**
+ * Unpacks a word to MAUs in little endian order one MAU at a time.
+ *
+ * @param index Index of the first MAU.
+ * @param count Number of MAUs.
+ * @param data The packed word.
+ */
+void
+MemoryContents::unpackLE(ULongWord index, int count, ULongWord data) {
+    for (int i = 0; i < count; ++i) {
+        writeData(index + i, static_cast<Memory::MAU>(data & mask_));
+        data >>= MAUSize_;
+    }
+}
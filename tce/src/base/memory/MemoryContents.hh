@@ -35,21 +35,81 @@
 #ifndef TTA_MEMORY_CONTENTS_HH
 #define TTA_MEMORY_CONTENTS_HH
 
-#include "PagedArray.hh"
-#include "Memory.hh"
-
+#include <cstddef>
+#include <cstdint>
 
-/// Size of a memory chunk in MAUs.
-#define MEM_CHUNK_SIZE (1024)
+#include "Memory.hh"
+#include "BaseType.hh"
 
 /**
  * Models the data contained in memory.
+ *
+ * The data is stored in one flat host memory region reserved with mmap
+ * for the whole address space. The host OS allocates the pages lazily
+ * when they are first written, thus sparsely used address spaces, also
+ * 64-bit ones, cost only the touched pages. Unwritten data reads as zero.
+ *
+ * MAUs of at most 8 bits take one byte of the region, wider ones a
+ * Memory::MAU. With 8-bit MAUs the multi-MAU accesses are single host
+ * loads and stores, byte swapped when the endianness differs from the
+ * host's.
  */
-class MemoryContents : public PagedArray<Memory::MAU, MEM_CHUNK_SIZE, 0> {
+class MemoryContents {
 public:
-    MemoryContents(std::size_t size) :
-        PagedArray<Memory::MAU, MEM_CHUNK_SIZE, 0>(size) { }
-    virtual ~MemoryContents() { }
+    MemoryContents(ULongWord size, Word MAUSize);
+    virtual ~MemoryContents();
+
+    void writeData(ULongWord index, Memory::MAU data);
+    Memory::MAU readData(ULongWord index) const;
+
+    template <int COUNT>
+    ULongWord readBE(ULongWord index) const;
+    template <int COUNT>
+    ULongWord readLE(ULongWord index) const;
+    template <int COUNT>
+    void writeBE(ULongWord index, ULongWord data);
+    template <int COUNT>
+    void writeLE(ULongWord index, ULongWord data);
+
+    ULongWord readBE(ULongWord index, int count) const;
+    ULongWord readLE(ULongWord index, int count) const;
+    void writeBE(ULongWord index, int count, ULongWord data);
+    void writeLE(ULongWord index, int count, ULongWord data);
+
+    void clear();
+
+private:
+    /// Copying not allowed.
+    MemoryContents(const MemoryContents&);
+    /// Assignment not allowed.
+    MemoryContents& operator=(const MemoryContents&);
+
+    void reserve();
+    ULongWord packBE(ULongWord index, int count) const;
+    ULongWord packLE(ULongWord index, int count) const;
+    void unpackBE(ULongWord index, int count, ULongWord data);
+    void unpackLE(ULongWord index, int count, ULongWord data);
+
+    /// Number of MAUs in the memory.
+    ULongWord size_;
+    /// Size of the MAU in bits.
+    Word MAUSize_;
+    /// Mask of the bits of a single MAU.
+    Memory::MAU mask_;
+    /// True if each MAU is stored in a byte.
+    bool narrowMAUs_;
+    /// True if the multi-MAU accesses can use host words.
+    bool byteMAUs_;
+    /// Size of the mapped region in bytes.
+    std::size_t regionSize_;
+    /// The mapped region, aliased by the typed pointers below.
+    void* region_;
+    /// The region for MAUs of at most 8 bits.
+    std::uint8_t* bytes_;
+    /// The region for wider MAUs.
+    Memory::MAU* maus_;
 };
 
+#include "MemoryContents.icc"
+
 #endif
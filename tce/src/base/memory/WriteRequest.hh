@@ -35,6 +35,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <boost/thread/mutex.hpp>
 
 /**
 * Models an uncommitted write request.
@@ -53,8 +54,25 @@ struct WriteRequest {
 
 /**
  * A "typedef" for request queue
+ *
+ * Adding requests can be serialized with a lock in case the memory is
+ * written by several simulation threads during the same cycle.
  */
 struct RequestQueue : public std::vector<WriteRequest*> {
+    RequestQueue() : lock_(NULL) {}
+    ~RequestQueue() { delete lock_; }
+
+    void add(WriteRequest* request) {
+        if (lock_ == NULL) {
+            push_back(request);
+            return;
+        }
+        boost::mutex::scoped_lock lock(*lock_);
+        push_back(request);
+    }
+
+    /// Guards add() when concurrent writers are enabled, NULL otherwise.
+    boost::mutex* lock_;
 };
 
 #endif
@@ -0,0 +1,433 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryOperationIndex.cc
+ *
+ * Definition of BinaryOperationIndex class.
+ *
+ * @note rating: red
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryOperationIndex.hh"
+#include "OperationSerializer.hh"
+#include "OperationModule.hh"
+#include "OperationIndex.hh"
+#include "ObjectState.hh"
+#include "FileSystem.hh"
+#include "Conversion.hh"
+
+const std::string BinaryOperationIndex::FILE_EXTENSION = ".oppc";
+const std::string BinaryOperationIndex::MAGIC = "TCEOSALI";
+
+namespace {
+
+/**
+ * Appends a little endian 32-bit integer to the buffer.
+ */
+void
+appendUInt32(std::vector<unsigned char>& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back((value >> (8 * i)) & 0xff);
+    }
+}
+
+}
+
+/**
+ * Returns the name of the compiled file of an operation properties file.
+ *
+ * @param propertiesModule The .opp file.
+ * @return The .oppc file next to it.
+ */
+std::string
+BinaryOperationIndex::fileName(const std::string& propertiesModule) {
+    std::string body = propertiesModule;
+    const std::string& extension = OperationIndex::PROPERTY_FILE_EXTENSION;
+    if (body.size() >= extension.size() &&
+        body.compare(
+            body.size() - extension.size(), extension.size(),
+            extension) == 0) {
+        body.erase(body.size() - extension.size());
+    }
+    return body + FILE_EXTENSION;
+}
+
+/**
+ * Compiles an operation properties file to the binary form.
+ *
+ * @param propertiesModule The .opp file.
+ * @param compiledModule The output file, by default next to the .opp file.
+ * @exception SerializerException If the properties file cannot be read.
+ * @exception IOException If the compiled file cannot be written.
+ */
+void
+BinaryOperationIndex::compile(
+    const std::string& propertiesModule,
+    const std::string& compiledModule) {
+
+    OperationSerializer serializer;
+    serializer.setSourceFile(propertiesModule);
+    ObjectState* operations = serializer.readState();
+
+    OperationModule module(
+        FileSystem::fileNameBody(propertiesModule),
+        FileSystem::directoryOfPath(propertiesModule));
+    std::string behaviorModule;
+    if (module.definesBehavior()) {
+        behaviorModule = FileSystem::fileOfPath(module.behaviorModule());
+    }
+    try {
+        write(
+            *operations, behaviorModule,
+            FileSystem::sizeInBytes(propertiesModule),
+            compiledModule.empty() ?
+            fileName(propertiesModule) : compiledModule);
+    } catch (...) {
+        delete operations;
+        throw;
+    }
+    delete operations;
+}
+
+/**
+ * Loads the compiled form of an operation properties file.
+ *
+ * @param propertiesModule The .opp file.
+ * @return The operation definitions of the module, NULL if there is no
+ * compiled file, it is older than the properties file, it was compiled
+ * from a different version of the properties file or it is of another
+ * format version.
+ * @exception IOException If the compiled file is corrupted.
+ */
+ObjectState*
+BinaryOperationIndex::load(const std::string& propertiesModule) {
+    const std::string compiledModule = fileName(propertiesModule);
+    if (!FileSystem::fileExists(compiledModule) ||
+        FileSystem::lastModificationTime(compiledModule) <
+        FileSystem::lastModificationTime(propertiesModule)) {
+        return NULL;
+    }
+
+    std::string behaviorModule;
+    uint64_t sourceSize = 0;
+    ObjectState* operations = read(compiledModule, behaviorModule, sourceSize);
+    if (operations != NULL &&
+        sourceSize != FileSystem::sizeInBytes(propertiesModule)) {
+        delete operations;
+        operations = NULL;
+    }
+    return operations;
+}
+
+/**
+ * Writes a compiled operation properties file.
+ *
+ * The file is written under a temporary name and renamed, so the readers
+ * never see a partially written file.
+ *
+ * @param operations The operation definitions of the module.
+ * @param behaviorModule The behavior module relative to the file, empty
+ * if the module does not define behavior.
+ * @param sourceSize Size of the properties file in bytes.
+ * @param fileName The file to write.
+ * @exception IOException If the file cannot be written.
+ */
+void
+BinaryOperationIndex::write(
+    const ObjectState& operations,
+    const std::string& behaviorModule,
+    uint64_t sourceSize,
+    const std::string& fileName) {
+
+    std::map<std::string, uint32_t> index;
+    std::vector<std::string> strings;
+    std::vector<unsigned char> nodes;
+    uint32_t behaviorIndex = internString(behaviorModule, index, strings);
+    uint32_t nodeCount = 0;
+
+    std::vector<const ObjectState*> stack(1, &operations);
+    while (!stack.empty()) {
+        const ObjectState* node = stack.back();
+        stack.pop_back();
+        ++nodeCount;
+        appendUInt32(nodes, internString(node->name(), index, strings));
+        appendUInt32(nodes, internString(node->stringValue(), index, strings));
+        appendUInt32(nodes, node->attributeCount());
+        appendUInt32(nodes, node->childCount());
+        for (int i = 0; i < node->attributeCount(); ++i) {
+            const ObjectState::Attribute* attribute = node->attribute(i);
+            appendUInt32(nodes, internString(attribute->name, index, strings));
+            appendUInt32(
+                nodes, internString(attribute->value, index, strings));
+        }
+        for (int i = node->childCount() - 1; i >= 0; --i) {
+            stack.push_back(node->child(i));
+        }
+    }
+
+    std::vector<unsigned char> header(MAGIC.begin(), MAGIC.end());
+    appendUInt32(header, FORMAT_VERSION);
+    appendUInt32(header, sourceSize & 0xffffffff);
+    appendUInt32(header, sourceSize >> 32);
+    appendUInt32(header, behaviorIndex);
+    appendUInt32(header, strings.size());
+    appendUInt32(header, nodeCount);
+    assert(header.size() == HEADER_SIZE);
+
+    const std::string tempName =
+        fileName + ".tmp" + Conversion::toString(getpid());
+    std::ofstream out(tempName.c_str(), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header[0]), header.size());
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        std::vector<unsigned char> length;
+        appendUInt32(length, strings[i].size());
+        out.write(reinterpret_cast<const char*>(&length[0]), length.size());
+        out.write(strings[i].data(), strings[i].size());
+    }
+    out.write(reinterpret_cast<const char*>(&nodes[0]), nodes.size());
+    out.close();
+    if (!out || std::rename(tempName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tempName.c_str());
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot write compiled operation properties '" + fileName +
+            "'.");
+    }
+}
+
+/**
+ * Reads a compiled operation properties file.
+ *
+ * The file is mapped to memory for the reading.
+ *
+ * @param fileName The file to read.
+ * @param behaviorModule Set to the behavior module of the file.
+ * @param sourceSize Set to the size of the properties file the file was
+ * compiled from.
+ * @return The operation definitions, NULL if the file is of another format
+ * version.
+ * @exception IOException If the file cannot be read or is corrupted.
+ */
+ObjectState*
+BinaryOperationIndex::read(
+    const std::string& fileName,
+    std::string& behaviorModule,
+    uint64_t& sourceSize) {
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        std::string error = std::strerror(errno);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot open compiled operation properties '" + fileName +
+            "': " + error);
+    }
+    std::size_t size = status.st_size;
+    void* mapping = MAP_FAILED;
+    if (size >= HEADER_SIZE) {
+        mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Cannot map compiled operation properties '" + fileName + "'.");
+    }
+
+    const unsigned char* data = static_cast<const unsigned char*>(mapping);
+    const unsigned char* end = data + size;
+    ObjectState* operations = NULL;
+    try {
+        if (MAGIC.compare(
+                0, MAGIC.size(), reinterpret_cast<const char*>(data),
+                MAGIC.size()) != 0) {
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "'" + fileName + "' is not a compiled operation "
+                "properties file.");
+        }
+        data += MAGIC.size();
+        if (readUInt32(data, end) != FORMAT_VERSION) {
+            munmap(mapping, size);
+            return NULL;
+        }
+        sourceSize = readUInt32(data, end);
+        sourceSize |= static_cast<uint64_t>(readUInt32(data, end)) << 32;
+        uint32_t behaviorIndex = readUInt32(data, end);
+        uint32_t stringCount = readUInt32(data, end);
+        uint32_t nodeCount = readUInt32(data, end);
+        // each string and node takes at least one integer, check the
+        // counts before allocating anything for them
+        std::size_t maxCount = (end - data) / 4;
+        if (stringCount > maxCount || nodeCount > maxCount) {
+            throw IOException(
+                __FILE__, __LINE__, __func__,
+                "Corrupted string or node count.");
+        }
+
+        std::vector<std::string> strings;
+        strings.reserve(stringCount);
+        for (uint32_t i = 0; i < stringCount; ++i) {
+            uint32_t length = readUInt32(data, end);
+            if (length > static_cast<std::size_t>(end - data)) {
+                throw IOException(
+                    __FILE__, __LINE__, __func__,
+                    "Truncated compiled operation properties '" +
+                    fileName + "'.");
+            }
+            strings.push_back(
+                std::string(reinterpret_cast<const char*>(data), length));
+            data += length;
+        }
+        behaviorModule = stringAt(strings, behaviorIndex);
+        operations = readNode(data, end, strings, nodeCount);
+    } catch (const Exception& e) {
+        munmap(mapping, size);
+        throw IOException(
+            __FILE__, __LINE__, __func__,
+            "Error reading '" + fileName + "': " + e.errorMessage());
+    }
+    munmap(mapping, size);
+    return operations;
+}
+
+/**
+ * Returns the index of a string in the string table of a file to write.
+ *
+ * @param value The string.
+ * @param index The indices of the strings added so far.
+ * @param strings The string table.
+ * @return The index of the string.
+ */
+uint32_t
+BinaryOperationIndex::internString(
+    const std::string& value,
+    std::map<std::string, uint32_t>& index,
+    std::vector<std::string>& strings) {
+
+    std::map<std::string, uint32_t>::const_iterator i = index.find(value);
+    if (i != index.end()) {
+        return i->second;
+    }
+    uint32_t newIndex = strings.size();
+    strings.push_back(value);
+    index[value] = newIndex;
+    return newIndex;
+}
+
+/**
+ * Reads a node and its children.
+ *
+ * @param data The position of the node, moved past the subtree.
+ * @param end The end of the data.
+ * @param strings The string table.
+ * @param nodesLeft The number of nodes left in the file.
+ * @return The read subtree.
+ * @exception IOException If the data is corrupted.
+ */
+ObjectState*
+BinaryOperationIndex::readNode(
+    const unsigned char*& data, const unsigned char* end,
+    const std::vector<std::string>& strings, uint32_t& nodesLeft) {
+
+    if (nodesLeft == 0) {
+        throw IOException(
+            __FILE__, __LINE__, __func__, "Node count mismatch.");
+    }
+    --nodesLeft;
+
+    ObjectState* node = new ObjectState(stringAt(strings, readUInt32(data, end)));
+    try {
+        node->setValue(stringAt(strings, readUInt32(data, end)));
+        uint32_t attributeCount = readUInt32(data, end);
+        uint32_t childCount = readUInt32(data, end);
+        for (uint32_t i = 0; i < attributeCount; ++i) {
+            const std::string& name = stringAt(strings, readUInt32(data, end));
+            node->setAttribute(name, stringAt(strings, readUInt32(data, end)));
+        }
+        for (uint32_t i = 0; i < childCount; ++i) {
+            node->addChild(readNode(data, end, strings, nodesLeft));
+        }
+    } catch (...) {
+        delete node;
+        throw;
+    }
+    return node;
+}
+
+/**
+ * Reads a little endian 32-bit integer.
+ *
+ * @param data The position of the integer, moved past it.
+ * @param end The end of the data.
+ * @return The integer.
+ * @exception IOException If the data ends before the integer.
+ */
+uint32_t
+BinaryOperationIndex::readUInt32(
+    const unsigned char*& data, const unsigned char* end) {
+
+    if (end - data < 4) {
+        throw IOException(
+            __FILE__, __LINE__, __func__, "Unexpected end of file.");
+    }
+    uint32_t value =
+        data[0] | (data[1] << 8) | (data[2] << 16) |
+        (static_cast<uint32_t>(data[3]) << 24);
+    data += 4;
+    return value;
+}
+
+/**
+ * Returns a string of the string table.
+ *
+ * @param strings The string table.
+ * @param index The index of the string.
+ * @return The string.
+ * @exception IOException If the index is out of range.
+ */
+const std::string&
+BinaryOperationIndex::stringAt(
+    const std::vector<std::string>& strings, uint32_t index) {
+
+    if (index >= strings.size()) {
+        throw IOException(
+            __FILE__, __LINE__, __func__, "String index out of range.");
+    }
+    return strings[index];
+}
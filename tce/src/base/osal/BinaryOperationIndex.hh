@@ -0,0 +1,112 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryOperationIndex.hh
+ *
+ * Declaration of BinaryOperationIndex class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_BINARY_OPERATION_INDEX_HH
+#define TTA_BINARY_OPERATION_INDEX_HH
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+#include "Exception.hh"
+
+class ObjectState;
+
+/**
+ * Precompiled binary form of the operation properties of an OSAL module.
+ *
+ * Reading the .opp XML files through Xerces dominates the start up of short
+ * tool runs. The compiled file stores the same object state tree the XML
+ * serializer produces, so all the operation properties, the operands and
+ * the DAG texts, together with the path of the behavior module. The file is
+ * named after the properties file with the extension .oppc and is used
+ * instead of the XML file when it is not older than it and was compiled
+ * from a properties file of the same size.
+ *
+ * All fields are little endian:
+ *
+ * header := magic "TCEOSALI", version (uint32), source size (uint64),
+ *           behavior module (uint32), string count (uint32),
+ *           node count (uint32)
+ * string := length (uint32), bytes
+ * node   := name (uint32), value (uint32), attribute count (uint32),
+ *           child count (uint32), (attribute name (uint32),
+ *           attribute value (uint32))*
+ *
+ * The header is followed by the strings and the nodes of the tree in
+ * preorder. Names and values are indices to the strings. The behavior
+ * module is relative to the directory of the compiled file, an empty
+ * string if the module has no compiled behavior.
+ */
+class BinaryOperationIndex {
+public:
+    /// Extension of the compiled operation property files.
+    static const std::string FILE_EXTENSION;
+    /// The magic string at the beginning of the file.
+    static const std::string MAGIC;
+    /// The version of the file format.
+    static const uint32_t FORMAT_VERSION = 1;
+
+    static std::string fileName(const std::string& propertiesModule);
+    static void compile(
+        const std::string& propertiesModule,
+        const std::string& compiledModule = "");
+    static ObjectState* load(const std::string& propertiesModule);
+
+    static void write(
+        const ObjectState& operations,
+        const std::string& behaviorModule,
+        uint64_t sourceSize,
+        const std::string& fileName);
+    static ObjectState* read(
+        const std::string& fileName,
+        std::string& behaviorModule,
+        uint64_t& sourceSize);
+
+private:
+    /// Size of the file header in bytes.
+    static const std::size_t HEADER_SIZE = 32;
+
+    static uint32_t internString(
+        const std::string& value,
+        std::map<std::string, uint32_t>& index,
+        std::vector<std::string>& strings);
+    static ObjectState* readNode(
+        const unsigned char*& data, const unsigned char* end,
+        const std::vector<std::string>& strings, uint32_t& nodesLeft);
+    static uint32_t readUInt32(
+        const unsigned char*& data, const unsigned char* end);
+    static const std::string& stringAt(
+        const std::vector<std::string>& strings, uint32_t index);
+};
+
+#endif
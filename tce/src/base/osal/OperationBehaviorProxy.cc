@@ -43,6 +43,8 @@
 
 using std::string;
 
+boost::recursive_mutex OperationBehaviorProxy::initializationLock_;
+
 /**
  * Constructor.
  *
@@ -186,7 +188,9 @@ OperationBehaviorProxy::canBeSimulated() const {
  *
  * This method is executed only once. After that, this function does nothing.
  * This function may abort the program, if error condition occurs while
- * operation behavior model is imported.
+ * operation behavior model is imported. Threads that enter the proxy while
+ * another one is loading the behavior wait for it and then use the loaded
+ * model.
  *
  * @exception DynamicLibraryException Leaked from importBehavior in case 
  *                                    behavior file was invalid.
@@ -194,10 +198,17 @@ OperationBehaviorProxy::canBeSimulated() const {
 void
 OperationBehaviorProxy::initializeBehavior() const {
 
-    if (initialized_) {
+    if (initialized_.load(std::memory_order_acquire)) {
         return;
     }
-    
+
+    boost::recursive_mutex::scoped_lock lock(initializationLock_);
+    if (initialized_.load(std::memory_order_relaxed) ||
+        &target_->behavior() != this) {
+        // another thread loaded the behavior while we waited for the lock
+        return;
+    }
+
     try {
         OperationBehavior& ob = loader_->importBehavior(*target_);
         target_->setBehavior(ob);
@@ -216,7 +227,7 @@ OperationBehaviorProxy::initializeBehavior() const {
 
     // if there is DAG to create behavior model...
     if (target_->dagCount() == 0) {
-        initialized_ = true;
+        initialized_.store(true, std::memory_order_release);
         return;
     }
 
@@ -232,7 +243,7 @@ OperationBehaviorProxy::initializeBehavior() const {
     // add for cleanup
     cleanUs_.insert(behavior);
 
-    initialized_ = true;
+    initialized_.store(true, std::memory_order_release);
 }
 
 
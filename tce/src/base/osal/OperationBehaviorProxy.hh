@@ -36,9 +36,12 @@
 #ifndef TTA_OPERATION_BEHAVIOR_PROXY_HH
 #define TTA_OPERATION_BEHAVIOR_PROXY_HH
 
+#include <atomic>
 #include <vector>
 #include <set>
 
+#include <boost/thread/recursive_mutex.hpp>
+
 #include "OperationBehavior.hh"
 #include "OperationDAGBehavior.hh"
 
@@ -88,8 +91,9 @@ private:
     Operation* target_;
     /// Used to load behavior model for operation.
     OperationBehaviorLoader* loader_;
-    /// Flag indicating whether proxy is initialized or not.
-    mutable bool initialized_;
+    /// Flag indicating whether proxy is initialized or not. Read without
+    /// the lock by the threads entering the proxy.
+    mutable std::atomic<bool> initialized_;
     /// Clean up list for created OperationDAGBehaviors
     mutable std::set<OperationDAGBehavior*> cleanUs_;
     /// If this is true, the behavior is always (re)loaded from the
@@ -99,6 +103,9 @@ private:
     /// Helpers variable to catch infinite recursive function call due to
     /// missing or undefined operation behavior.
     mutable bool alreadyCreatingState_;
+    /// Serializes the behavior loading of operations simulated in several
+    /// threads at the same time.
+    static boost::recursive_mutex initializationLock_;
 };
 
 #endif
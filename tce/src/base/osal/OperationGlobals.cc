@@ -38,15 +38,22 @@
 #include "TCEString.hh"
 
 std::ostream* OperationGlobals::outputStream_ = &std::cout;
+thread_local std::ostream* OperationGlobals::threadOutputStream_ = NULL;
 
 
 /**
  * Returns the current output stream
+ *
+ * The output stream set for the calling thread is preferred over the
+ * global one.
  * 
  * @return the current output stream
  */
 std::ostream& 
 OperationGlobals::outputStream() {
+    if (threadOutputStream_ != NULL) {
+        return *threadOutputStream_;
+    }
     return *outputStream_;
 }
 
@@ -60,6 +67,20 @@ OperationGlobals::setOutputStream(std::ostream& newOutputStream) {
     outputStream_ = &newOutputStream;
 }
 
+/**
+ * Sets an output stream for the operations simulated in the calling thread.
+ *
+ * Lets several simulations that run in parallel threads collect their
+ * outputs separately.
+ *
+ * @param newOutputStream The output stream of the thread, NULL to use the
+ * global output stream again.
+ */
+void
+OperationGlobals::setThreadOutputStream(std::ostream* newOutputStream) {
+    threadOutputStream_ = newOutputStream;
+}
+
 /**
  * Throws an exception with a message
  * 
@@ -41,6 +41,7 @@ class OperationGlobals {
 public:
     static std::ostream& outputStream();
     static void setOutputStream(std::ostream& newOutputStream);
+    static void setThreadOutputStream(std::ostream* newOutputStream);
     static void runtimeError(
         const char* message, 
         const char* file, 
@@ -57,6 +58,8 @@ private:
     
     /// The global output stream, defaults to std::cout
     static std::ostream* outputStream_;
+    /// Overrides the global output stream in the calling thread if set.
+    static thread_local std::ostream* threadOutputStream_;
 };
 
 #endif
@@ -33,6 +33,7 @@
  */
 
 #include "OperationIndex.hh"
+#include "BinaryOperationIndex.hh"
 #include "Operation.hh"
 #include "OperationModule.hh"
 #include "ObjectState.hh"
@@ -384,6 +385,19 @@ OperationIndex::operationCount(const OperationModule& om) {
  */
 void
 OperationIndex::readOperations(const OperationModule& module) {
+    // prefer the compiled properties, fall back to the XML file if they
+    // are missing, out of date or broken
+    ObjectState* compiled = NULL;
+    try {
+        compiled = BinaryOperationIndex::load(module.propertiesModule());
+    } catch (const Exception&) {
+        compiled = NULL;
+    }
+    if (compiled != NULL) {
+        opDefinitions_[module.propertiesModule()] = compiled;
+        return;
+    }
+
     serializer_.setSourceFile(module.propertiesModule());
     ObjectState* tree = serializer_.readState();
     opDefinitions_[module.propertiesModule()] = tree;
@@ -100,6 +100,36 @@ OperationPool::operation(const char* name) {
     return pimpl_->operation(name);
 }
 
+/**
+ * Returns the operation of an interned operation name.
+ *
+ * This is a constant time lookup that does not lock once the operation
+ * has been loaded, and should be preferred over the name based lookup in
+ * code that repeatedly needs the same operations.
+ *
+ * @param id The handle returned by operationID().
+ * @return The wanted operation, a null operation if there is no operation
+ * with the interned name.
+ */
+Operation&
+OperationPool::operation(OpId id) {
+    return pimpl_->operation(id);
+}
+
+/**
+ * Interns an operation name.
+ *
+ * The name is case insensitive. The operation itself is not loaded until it
+ * is requested with operation(OpId).
+ *
+ * @param name The name of the operation.
+ * @return The handle of the name.
+ */
+OperationPool::OpId
+OperationPool::operationID(const char* name) {
+    return pimpl_->operationID(name);
+}
+
 /**
  * Returns the operation index of operation pool.
  *
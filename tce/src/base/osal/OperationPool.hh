@@ -51,10 +51,17 @@ namespace llvm {
  */
 class OperationPool {
 public:
+    /// Handle of an interned operation name. The same name always maps to
+    /// the same handle for the lifetime of the process, also across
+    /// cleanupCache().
+    typedef unsigned int OpId;
+
     OperationPool();
     virtual ~OperationPool();
 
     Operation& operation(const char* name);
+    Operation& operation(OpId id);
+    OpId operationID(const char* name);
     OperationIndex& index();
     bool sharesState(const Operation& op);
 
@@ -50,7 +50,6 @@
 #include "Application.hh"
 #include "OperationIndex.hh"
 #include "OperationPoolPimpl.hh"
-#include "OperationSerializer.hh"
 #include "TCEString.hh"
 #include "ObjectState.hh"
 
@@ -65,9 +64,15 @@
 using std::vector;
 using std::string;
 
-OperationPoolPimpl::OperationTable OperationPoolPimpl::operationCache_;
+OperationPoolPimpl::OperationIDTable OperationPoolPimpl::operationIDs_;
+std::list<std::string> OperationPoolPimpl::nameSpellings_;
+std::atomic<OperationPoolPimpl::OperationSlot*>
+OperationPoolPimpl::slotBlocks_[MAX_SLOT_BLOCKS];
+OperationPool::OpId OperationPoolPimpl::slotCount_(0);
+std::map<const Operation*, bool> OperationPoolPimpl::sharedStates_;
 OperationIndex* OperationPoolPimpl::index_(NULL);
 const llvm::MCInstrInfo* OperationPoolPimpl::llvmTargetInstrInfo_(NULL);
+boost::recursive_mutex OperationPoolPimpl::lock_;
 
 /**
  * The constructor
@@ -75,12 +80,21 @@ const llvm::MCInstrInfo* OperationPoolPimpl::llvmTargetInstrInfo_(NULL);
 OperationPoolPimpl::OperationPoolPimpl() {
     // if this is a first created instance of OperationPool,
     // initialize the OperationIndex instance with the search paths
+    boost::recursive_mutex::scoped_lock lock(lock_);
     if (index_ == NULL) {
-        index_ = new OperationIndex();
-        vector<string> paths = Environment::osalPaths();
-        for (unsigned int i = 0; i < paths.size(); i++) {
-            index_->addPath(paths[i]);
-        }
+        createIndex();
+    }
+}
+
+/**
+ * Creates the operation index with the OSAL search paths.
+ */
+void
+OperationPoolPimpl::createIndex() {
+    index_ = new OperationIndex();
+    vector<string> paths = Environment::osalPaths();
+    for (unsigned int i = 0; i < paths.size(); i++) {
+        index_->addPath(paths[i]);
     }
 }
 
@@ -94,11 +108,16 @@ OperationPoolPimpl::~OperationPoolPimpl() {
  * Cleans up the static Operation cache.
  *
  * Deletes also the Operation instances, so be sure you are not using
- * them after calling this!
+ * them after calling this! The interned operation handles stay valid,
+ * their operations are reloaded when requested the next time.
  */
 void
 OperationPoolPimpl::cleanupCache() {
-    AssocTools::deleteAllValues(operationCache_);
+    boost::recursive_mutex::scoped_lock lock(lock_);
+    for (OperationPool::OpId id = 0; id < slotCount_; ++id) {
+        delete slot(id).operation.exchange(NULL);
+    }
+    sharedStates_.clear();
     delete index_;
     index_ = NULL;
 }
@@ -114,12 +133,110 @@ OperationPoolPimpl::cleanupCache() {
  */
 Operation&
 OperationPoolPimpl::operation(const char* name) {
+    return operation(operationID(name));
+}
+
+/**
+ * Returns the slot of an interned operation name.
+ *
+ * Does not lock, the block of a handle is published before the handle.
+ *
+ * @param id The handle of the operation name.
+ * @return The slot of the name.
+ */
+OperationPoolPimpl::OperationSlot&
+OperationPoolPimpl::slot(OperationPool::OpId id) {
+    OperationSlot* block =
+        slotBlocks_[id / SLOT_BLOCK_SIZE].load(std::memory_order_acquire);
+    assert(block != NULL && "Invalid operation handle.");
+    return block[id % SLOT_BLOCK_SIZE];
+}
+
+/**
+ * Returns the operation of an interned operation name.
+ *
+ * The operation is loaded when it is requested the first time. Once
+ * loaded, it is returned without locking.
+ *
+ * @param id The handle of the operation name.
+ * @return The wanted operation, or a null operation if not found.
+ */
+Operation&
+OperationPoolPimpl::operation(OperationPool::OpId id) {
+    OperationSlot& opSlot = slot(id);
+    Operation* op = opSlot.operation.load(std::memory_order_acquire);
+    if (op != NULL) {
+        return *op;
+    }
+
+    boost::recursive_mutex::scoped_lock lock(lock_);
+    op = opSlot.operation.load(std::memory_order_relaxed);
+    if (op != NULL) {
+        return *op;
+    }
+    op = loadOperation(opSlot.name);
+    if (op == NULL) {
+        return NullOperation::instance();
+    }
+    opSlot.operation.store(op, std::memory_order_release);
+    // the new operation may share state with the loaded ones
+    sharedStates_.clear();
+    return *op;
+}
+
+/**
+ * Interns an operation name.
+ *
+ * The names the clients have already used are found with a single hash
+ * lookup, other spellings are converted to lower case first.
+ *
+ * @param name The name of the operation.
+ * @return The handle of the name.
+ */
+OperationPool::OpId
+OperationPoolPimpl::operationID(const char* name) {
+    boost::recursive_mutex::scoped_lock lock(lock_);
+    OperationIDTable::const_iterator it = operationIDs_.find(name);
+    if (it != operationIDs_.end()) {
+        return it->second;
+    }
 
-    OperationTable::iterator it =
-        operationCache_.find(StringTools::stringToLower(name));
-    if (it != operationCache_.end()) {
-        return *((*it).second);
+    const std::string lowerName = StringTools::stringToLower(name);
+    it = operationIDs_.find(lowerName.c_str());
+    OperationPool::OpId id = 0;
+    if (it != operationIDs_.end()) {
+        id = it->second;
+    } else {
+        id = slotCount_;
+        unsigned blockIndex = id / SLOT_BLOCK_SIZE;
+        if (blockIndex >= MAX_SLOT_BLOCKS) {
+            abortWithError("Too many operation names interned.");
+        }
+        if (id % SLOT_BLOCK_SIZE == 0) {
+            slotBlocks_[blockIndex].store(
+                new OperationSlot[SLOT_BLOCK_SIZE],
+                std::memory_order_release);
+        }
+        OperationSlot& newSlot = slot(id);
+        newSlot.name = lowerName;
+        operationIDs_[newSlot.name.c_str()] = id;
+        ++slotCount_;
     }
+    if (lowerName != name) {
+        nameSpellings_.push_back(name);
+        operationIDs_[nameSpellings_.back().c_str()] = id;
+    }
+    return id;
+}
+
+/**
+ * Loads the operation with the given lower case name.
+ *
+ * @param name The name of the operation.
+ * @return The operation, or NULL if it is not found.
+ */
+Operation*
+OperationPoolPimpl::loadOperation(const std::string& name) {
 
     // If llvmTargetInstrInfo_ is set, the scheduler is called
     // directly from LLVM code gen. Use the TargetInstrDesc as
@@ -130,28 +247,23 @@ OperationPoolPimpl::operation(const char* name) {
             const llvm::MCInstrDesc& tid = llvmTargetInstrInfo_->get(opc);
             TCEString operName =
                 TCEString(llvmTargetInstrInfo_->getName(opc).str()).lower();
-            if (operName == TCEString(name).lower()) {
-                Operation* llvmOperation = loadFromLLVM(tid);
-                operationCache_[operName] = llvmOperation;
-                return *llvmOperation;
+            if (operName == name) {
+                return loadFromLLVM(tid);
             }
         }
         abortWithError(
             TCEString("Did not find info for LLVM operation ") + name);
     }
 
+    // pools that outlive cleanupCache() need the index recreated
+    if (index_ == NULL) {
+        createIndex();
+    }
     OperationModule& module = index_->moduleOf(name);
     if (&module == &NullOperationModule::instance()) {
-        return NullOperation::instance();
-    }
-
-    Operation* effective = index_->effectiveOperation(name);
-    if (effective != NULL) {
-        operationCache_[StringTools::stringToLower(name)] = effective;
-        return *effective;
-    } else {
-        return NullOperation::instance();            
+        return NULL;
     }
+    return index_->effectiveOperation(name);
 }
 
 /**
@@ -215,14 +327,29 @@ OperationPoolPimpl::index() {
     return *index_;
 }
 
+/**
+ * Checks whether the given operation shares state with any of the loaded
+ * operations.
+ *
+ * The answers are cached per operation until a new operation is loaded.
+ */
 bool
 OperationPoolPimpl::sharesState(const Operation& op) {
     if (op.affectsCount() > 0 || op.affectedByCount() > 0)
         return true;
-    for (const auto& entry : operationCache_) {
-        const Operation& other = *entry.second;
-        if (other.dependsOn(op))
-            return true;
+    boost::recursive_mutex::scoped_lock lock(lock_);
+    std::map<const Operation*, bool>::const_iterator cached =
+        sharedStates_.find(&op);
+    if (cached != sharedStates_.end()) {
+        return cached->second;
+    }
+
+    bool shares = false;
+    for (OperationPool::OpId id = 0; id < slotCount_ && !shares; ++id) {
+        const Operation* other =
+            slot(id).operation.load(std::memory_order_relaxed);
+        shares = other != NULL && other->dependsOn(op);
     }
-    return false;
+    sharedStates_[&op] = shares;
+    return shares;
 }
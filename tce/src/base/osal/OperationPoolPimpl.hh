@@ -35,7 +35,14 @@
 
 #include <string>
 #include <map>
+#include <list>
+#include <vector>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
+#include <boost/thread/recursive_mutex.hpp>
 #include "tce_config.h"
+#include "OperationPool.hh"
 
 class OperationPool;
 class OperationBehaviorLoader;
@@ -56,6 +63,8 @@ public:
     ~OperationPoolPimpl();
     
     Operation& operation(const char* name);
+    Operation& operation(OperationPool::OpId id);
+    OperationPool::OpId operationID(const char* name);
     OperationIndex& index();
     bool sharesState(const Operation& op);
 
@@ -67,30 +76,81 @@ public:
 private:
     OperationPoolPimpl();
     
-    /// Container for operations indexed by their names.
-    typedef std::map<std::string, Operation*> OperationTable;
+    /// Hash of a C string, so the names can be looked up without
+    /// constructing std::strings.
+    struct NameHash {
+        std::size_t operator()(const char* name) const {
+            std::size_t hash = 2166136261u;
+            for (; *name != '\0'; ++name) {
+                hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+            }
+            return hash;
+        }
+    };
+    /// Equality of C strings.
+    struct NameEqual {
+        bool operator()(const char* a, const char* b) const {
+            return std::strcmp(a, b) == 0;
+        }
+    };
+    /// Maps the operation names to their interned handles. The keys point
+    /// to the names stored in the slots and in nameSpellings_.
+    typedef std::unordered_map<
+        const char*, OperationPool::OpId, NameHash, NameEqual>
+    OperationIDTable;
+
+    /// An interned operation name and its operation.
+    struct OperationSlot {
+        OperationSlot() : operation(NULL) {}
+        /// The lower case name of the operation.
+        std::string name;
+        /// The operation, NULL if not loaded yet. Written under lock_,
+        /// read without it.
+        std::atomic<Operation*> operation;
+    };
+
+    /// The slots are allocated in blocks that are never moved, so the
+    /// filled slots can be read while new names are interned.
+    static const unsigned SLOT_BLOCK_SIZE = 256;
+    /// The maximum number of slot blocks.
+    static const unsigned MAX_SLOT_BLOCKS = 4096;
 
     /// Copying not allowed.
     OperationPoolPimpl(const OperationPoolPimpl&);
     /// Assignment not allowed.
     OperationPoolPimpl& operator=(const OperationPoolPimpl&);
     Operation* loadFromLLVM(const llvm::MCInstrDesc& tid);
+    Operation* loadOperation(const std::string& name);
+    static void createIndex();
+    static OperationSlot& slot(OperationPool::OpId id);
     /// Operation pool uses this to load behavior models of the operations.
     static OperationBehaviorLoader* loader_;
     /// Indexed table used to find out which operation module contains the
     /// given operation.
     static OperationIndex* index_;
     
-    OperationSerializer serializer_;
-    
-    /// Contains all operations that have been already requested by the client.
-    static OperationTable operationCache_;
+    /// Handles of the interned names. Contains both the lower case names
+    /// and the spellings the clients have used.
+    static OperationIDTable operationIDs_;
+    /// The spellings of the names other than the lower case ones.
+    static std::list<std::string> nameSpellings_;
+    /// The blocks of the operation slots, indexed by the handles.
+    static std::atomic<OperationSlot*> slotBlocks_[MAX_SLOT_BLOCKS];
+    /// The number of interned names.
+    static OperationPool::OpId slotCount_;
+    /// Cached sharesState() answers of the loaded operations, cleared when
+    /// a new operation is loaded.
+    static std::map<const Operation*, bool> sharedStates_;
     /// Contains all operation behavior proxies.
     static std::vector<OperationBehaviorProxy*> proxies_; 
     /// If this is set, OSAL data is loaded from the TargetInstrInfo
     /// instead of .opp XML files. Used when calling the TCE scheduler from
     /// non-TTA LLVM targets.
     static const llvm::MCInstrInfo* llvmTargetInstrInfo_;
+    /// Serializes the accesses to the static index and operation cache
+    /// when the pool is used from several threads. The loaded operations
+    /// are looked up by their handles without it.
+    static boost::recursive_mutex lock_;
 };
 
 #endif
@@ -152,6 +152,19 @@ InstructionReferenceImpl::setInstruction(Instruction& ins) {
     ins_ = &ins;
 }
     
+/**
+ * Moves this object under another instruction reference manager.
+ * 
+ * This method should be only called by InstructionReferenceManager.
+ *
+ * @param irm The new owner of this object.
+ */
+void
+InstructionReferenceImpl::setReferenceManager(
+    InstructionReferenceManager& irm) {
+    refMan_ = &irm;
+}
+
 /**
  * Returns a reference pointing into instruction handled by this object.
  *
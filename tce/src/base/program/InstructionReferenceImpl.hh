@@ -56,6 +56,7 @@ public:
     void addRef(InstructionReference& ref);
     bool removeRef(InstructionReference& ref);
     InstructionReferenceManager& referencemanager();
+    void setReferenceManager(InstructionReferenceManager& irm);
     void setInstruction(Instruction& ins);
     void merge(InstructionReferenceImpl& other);
     inline Instruction& instruction();
@@ -170,6 +170,33 @@ InstructionReferenceManager::referenceDied(Instruction* ins) {
     references_.erase(iter);
 }
 
+/**
+ * Moves all the references of another manager to this manager.
+ *
+ * The references keep pointing to the same instructions. References to
+ * an instruction this manager already has a reference to are merged.
+ * The other manager is left empty.
+ *
+ * @param other The manager to take the references from.
+ */
+void
+InstructionReferenceManager::takeReferences(
+    InstructionReferenceManager& other) {
+    while (!other.references_.empty()) {
+        RefMap::iterator iter = other.references_.begin();
+        RefMap::iterator existing = references_.find(iter->first);
+        if (existing != references_.end()) {
+            // the merged impl dies through the other manager which
+            // removes it from its map
+            existing->second->merge(*iter->second);
+        } else {
+            iter->second->setReferenceManager(*this);
+            references_.insert(*iter);
+            other.references_.erase(iter);
+        }
+    }
+}
+
 /**
  * Performs sanity checks to the instruction references.
  *
@@ -93,6 +93,7 @@ public:
     bool hasReference(Instruction& ins) const;
     unsigned int referenceCount(Instruction& ins) const;
     void referenceDied(Instruction* ins);
+    void takeReferences(InstructionReferenceManager& other);
 
     void validate();
 
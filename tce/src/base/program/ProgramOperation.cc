@@ -838,7 +838,7 @@ ProgramOperation::hasConstantOperand() const {
     return false;
 }
 
-unsigned int ProgramOperation::idCounter = 0;
+std::atomic<unsigned int> ProgramOperation::idCounter(0);
 
 const TTAMachine::FunctionUnit*
 ProgramOperation::fuFromOutMove(const MoveNode& outputNode) const {
@@ -940,12 +940,15 @@ bool ProgramOperation::isLegalFU(const TTAMachine::FunctionUnit& fu) const {
 
 void ProgramOperation::setOperation(const Operation& op) {
     operation_ = &op;
+    // look the operation up once for all the terminals
+    OperationPool pool;
+    OperationPool::OpId opId = pool.operationID(op.name().c_str());
     for (int i = 0; i < inputMoveCount(); i++) {
         MoveNode& mn = inputMove(i);
         TTAProgram::TerminalFUPort* tfp = dynamic_cast<TTAProgram::TerminalFUPort*>(
             &mn.move().destination());
         assert(tfp);
-        tfp->setHintOperation(op.name().c_str());
+        tfp->setHintOperation(opId);
     }
 
     for (int i = 0; i < outputMoveCount(); i++) {
@@ -953,6 +956,6 @@ void ProgramOperation::setOperation(const Operation& op) {
         TTAProgram::TerminalFUPort* tfp = dynamic_cast<TTAProgram::TerminalFUPort*>(
             &mn.move().source());
         assert(tfp);
-        tfp->setHintOperation(op.name().c_str());
+        tfp->setHintOperation(opId);
     }
 }
@@ -38,6 +38,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "Exception.hh"
 
@@ -171,7 +172,8 @@ private:
     // all output moves
     MoveVector allOutputMoves_;
     unsigned int poId_;
-    static unsigned int idCounter;
+    /// atomic as operations are created in concurrent scheduler threads
+    static std::atomic<unsigned int> idCounter;
     // Reference to original LLVM MachineInstruction
     const llvm::MachineInstr* mInstr_;
 };
@@ -105,17 +105,7 @@ TerminalFUPort::TerminalFUPort(const HWOperation& operation, int opIndex)
     : port_(*operation.port(opIndex)),
       operation_(&operation),
       opIndex_(opIndex) {
-    /* In case the operand cannot be resolved to a legal port, it's an
-       error in the loaded input program. Thus, we cannot abort the program but
-       we'll throw an exception instead. */
-    if (dynamic_cast<const FUPort*>(&port_) == NULL) {
-        throw IllegalParameters(
-            __FILE__, __LINE__, __func__,
-            (boost::format(
-                "Port binding of operand %d of operation '%s' "
-                "cannot be resolved.") % opIndex % operation.name()).
-            str());
-    }
+    checkOperandPort();
     static OperationPool pool;
     // opcode is NullOperation instance if operation for that name was not
     // found
@@ -132,6 +122,44 @@ TerminalFUPort::TerminalFUPort(const HWOperation& operation, int opIndex)
     }
 }
 
+/**
+ * Constructor for callers that already have the OSAL operation.
+ *
+ * Saves the operation lookup by name done by the other constructors.
+ *
+ * @param operation Operation of terminal.
+ * @param opIndex Operation index.
+ * @param osalOperation The OSAL operation of the terminal.
+ */
+TerminalFUPort::TerminalFUPort(
+    const HWOperation& operation, int opIndex, Operation& osalOperation)
+    : port_(*operation.port(opIndex)),
+      operation_(&operation),
+      opcode_(&osalOperation),
+      opIndex_(opIndex) {
+    checkOperandPort();
+}
+
+/**
+ * Checks that the operand of the terminal is bound to a FU port.
+ *
+ * @exception IllegalParameters If the port binding cannot be resolved.
+ */
+void
+TerminalFUPort::checkOperandPort() const {
+    /* In case the operand cannot be resolved to a legal port, it's an
+       error in the loaded input program. Thus, we cannot abort the program but
+       we'll throw an exception instead. */
+    if (dynamic_cast<const FUPort*>(&port_) == NULL) {
+        throw IllegalParameters(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Port binding of operand %d of operation '%s' "
+                "cannot be resolved.") % opIndex_ % operation_->name()).
+            str());
+    }
+}
+
 /**
  * Copy Constructor. private, only called internally by copy().
  *
@@ -269,8 +297,13 @@ TerminalFUPort::hintOperation() const {
 
 void TerminalFUPort::setHintOperation(const char* name) {
     OperationPool opPool;
-    assert(&opPool.operation(name) != &NullOperation::instance());
-    opcode_ = &opPool.operation(name);
+    setHintOperation(opPool.operationID(name));
+}
+
+void TerminalFUPort::setHintOperation(OperationPool::OpId id) {
+    OperationPool opPool;
+    opcode_ = &opPool.operation(id);
+    assert(opcode_ != &NullOperation::instance());
     operation_ = nullptr;
 }
 
@@ -37,6 +37,7 @@
 #include "Exception.hh"
 #include "Terminal.hh"
 #include "ProgramOperation.hh"
+#include "OperationPool.hh"
 
 namespace TTAMachine {
     class HWOperation;
@@ -61,6 +62,9 @@ public:
 
     TerminalFUPort(const TTAMachine::BaseFUPort& port);
     TerminalFUPort(const TTAMachine::HWOperation& operation, int opIndex);
+    TerminalFUPort(
+        const TTAMachine::HWOperation& operation, int opIndex,
+        Operation& osalOperation);
     virtual ~TerminalFUPort();
 
     virtual bool isOpcodeSetting() const;
@@ -77,6 +81,7 @@ public:
     // but are known to be part of an operation execution
     virtual void setOperation(const TTAMachine::HWOperation& hwOp);
     void setHintOperation(const char* name);
+    void setHintOperation(OperationPool::OpId id);
 
     virtual int operationIndex() const;
     virtual void setOperationIndex(int index) { opIndex_ = index; }
@@ -108,6 +113,7 @@ private:
     /// Assignment not allowed.
     TerminalFUPort& operator=(const TerminalFUPort&);
     int findNewOperationIndex() const;
+    void checkOperandPort() const;
 
     /// Port of the unit.
     const TTAMachine::BaseFUPort& port_;
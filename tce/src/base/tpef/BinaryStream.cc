@@ -38,6 +38,11 @@
 #include <cassert>
 #include <boost/format.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "BinaryStream.hh"
 #include "Swapper.hh"
 #include "BaseType.hh"
@@ -48,8 +53,9 @@ using std::ios;
 namespace TPEF {
 
 BinaryStream::BinaryStream(std::ostream& stream, bool littleEndian): 
-    fileName_(""), extOStream_(&stream), littleEndianStorage_(littleEndian),
-    tpefVersion_(TPEFHeaders::TPEF_V2) {
+    inputData_(NULL), inputSize_(0), inputOpen_(false), readPosition_(0),
+    endOfInput_(false), fileName_(""), extOStream_(&stream),
+    littleEndianStorage_(littleEndian), tpefVersion_(TPEFHeaders::TPEF_V2) {
 }
 
 /**
@@ -62,8 +68,9 @@ BinaryStream::BinaryStream(std::ostream& stream, bool littleEndian):
  * @note The initial read and write positions of the stream are 0.
  */
 BinaryStream::BinaryStream(std::string name, bool littleEndian): 
-    fileName_(name), extOStream_(NULL), littleEndianStorage_(littleEndian),
-    tpefVersion_(TPEFHeaders::TPEF_V1) {
+    inputData_(NULL), inputSize_(0), inputOpen_(false), readPosition_(0),
+    endOfInput_(false), fileName_(name), extOStream_(NULL),
+    littleEndianStorage_(littleEndian), tpefVersion_(TPEFHeaders::TPEF_V1) {
 }
 
 /**
@@ -224,6 +231,9 @@ BinaryStream::readWord() {
 void
 BinaryStream::readByteBlock(Byte* buffer, unsigned int howmany) {
     try {
+        if (readMapped(buffer, howmany)) {
+            return;
+        }
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = getByte();
         }
@@ -253,6 +263,18 @@ BinaryStream::readByteBlock(Byte* buffer, unsigned int howmany) {
 void
 BinaryStream::readHalfWordBlock(HalfWord* buffer, unsigned int howmany) {
     try {
+        if (readMapped(
+                reinterpret_cast<Byte*>(buffer),
+                howmany * sizeof(HalfWord))) {
+            // convert the half-words to host endianess in place
+            if (needsSwap()) {
+                for (unsigned int i = 0; i < howmany; i++) {
+                    Byte* bytes = reinterpret_cast<Byte*>(&buffer[i]);
+                    Swapper::swap(bytes, bytes, sizeof(HalfWord));
+                }
+            }
+            return;
+        }
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = readHalfWord();
         }
@@ -282,6 +304,17 @@ BinaryStream::readHalfWordBlock(HalfWord* buffer, unsigned int howmany) {
 void
 BinaryStream::readWordBlock(Word* buffer, unsigned int howmany) {
     try {
+        if (readMapped(
+                reinterpret_cast<Byte*>(buffer), howmany * sizeof(Word))) {
+            // convert the words to host endianess in place
+            if (needsSwap()) {
+                for (unsigned int i = 0; i < howmany; i++) {
+                    Byte* bytes = reinterpret_cast<Byte*>(&buffer[i]);
+                    Swapper::swap(bytes, bytes, sizeof(Word));
+                }
+            }
+            return;
+        }
         for (unsigned int i = 0; i < howmany; i++) {
             buffer[i] = readWord();
         }
@@ -476,9 +509,11 @@ BinaryStream::writeWordBlock(Word* words, unsigned int howmany) {
 /**
  * Opens the binary file for input.
  *
+ * The whole file is mapped to memory.
+ *
  * @param name Name of the input file.
  * @exception UnreachableStream If file is not found or is unreadable.
- * @note The initial read position is 0.
+ * @note The read position is not changed.
  */
 void
 BinaryStream::openInput(std::string name) {
@@ -487,18 +522,35 @@ BinaryStream::openInput(std::string name) {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    iStream_.open(name.c_str());
+    if (oStream_.is_open()) {
+        oStream_.flush();
+    }
 
-    if (!iStream_.is_open()) {
+    int fd = ::open(name.c_str(), O_RDONLY);
+    struct stat status;
+    void* mapping = NULL;
+    if (fd >= 0 && fstat(fd, &status) == 0 && S_ISREG(status.st_mode)) {
+        if (status.st_size > 0) {
+            mapping = mmap(
+                NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+    } else {
+        mapping = MAP_FAILED;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+
+    if (mapping == MAP_FAILED) {
         const std::string error = (boost::format(
             "File '%s' could not be opened for input.") % name).str();
         throw UnreachableStream(
             __FILE__, __LINE__, __func__, error);
     }
-    if (oStream_.is_open()) {
-        oStream_.flush();
-    }
-    iStream_.tie(&oStream_);
+
+    inputData_ = static_cast<const Byte*>(mapping);
+    inputSize_ = status.st_size;
+    inputOpen_ = true;
 }
 
 /**
@@ -537,14 +589,27 @@ BinaryStream::openOutput(std::string name) {
     }
 }
 
+/**
+ * Unmaps the input file.
+ *
+ * The read position and the end of file status are kept.
+ */
+void
+BinaryStream::closeInput() {
+    if (inputData_ != NULL) {
+        munmap(const_cast<Byte*>(inputData_), inputSize_);
+        inputData_ = NULL;
+    }
+    inputSize_ = 0;
+    inputOpen_ = false;
+}
+
 /**
  * Closes the stream.
  */
 void
 BinaryStream::close() {
-    if (iStream_.is_open()) {
-        iStream_.close();
-    }
+    closeInput();
     if (oStream_.is_open()) {
         oStream_.close();
     }
@@ -564,7 +629,7 @@ BinaryStream::readPosition() {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (!inputOpen_) {
         try {
             openInput(fileName_);
         } catch (const UnreachableStream& error) {
@@ -575,11 +640,7 @@ BinaryStream::readPosition() {
         }
     }
 
-    if (iStream_.bad()) {
-        throw UnreachableStream(__FILE__, __LINE__,
-                                "BinaryStream::readPosition", fileName_);
-    }
-    return iStream_.tellg();
+    return readPosition_;
 }
 
 /**
@@ -632,7 +693,7 @@ BinaryStream::setReadPosition(unsigned int position) {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (!inputOpen_) {
         try {
             openInput(fileName_);
 
@@ -643,34 +704,12 @@ BinaryStream::setReadPosition(unsigned int position) {
             throw newException;
         }
     }
-    if (iStream_.bad()) {
-        throw UnreachableStream(
-            __FILE__, __LINE__, __func__, fileName_);
-    }
-
-    // if eof is already reached, the stream must be cleared to make it
-    // accessible again
-    bool eof = false;
-    if (iStream_.eof()) {
-        eof = true;
-        iStream_.clear();
-    }
 
     // possible eof-status is cleared if the position is set before eof
-    iStream_.seekg(0, ios::end);
-    unsigned int fileSize = iStream_.tellg();
-    if (position <= fileSize) {
-        iStream_.clear();
-        eof = false;
-    }
-
-    iStream_.seekg(position);
-
-    // return the eof status if it has been cleared earlier to access the
-    // stream and read position is not set before eof
-    if (eof) {
-        iStream_.setstate(ios::eofbit);
+    if (position <= inputSize_) {
+        endOfInput_ = false;
     }
+    readPosition_ = position;
 }
 
 /**
@@ -725,7 +764,7 @@ BinaryStream::endOfFile() {
             __FILE__, __LINE__, __func__, "External stream is write-only.");
     }
 
-    if (!iStream_.is_open()) {
+    if (!inputOpen_) {
         try {
             openInput(fileName_);
 
@@ -737,12 +776,7 @@ BinaryStream::endOfFile() {
         }
     }
 
-    if (iStream_.bad()) {
-        throw UnreachableStream(
-            __FILE__, __LINE__, __func__, fileName_);
-    }
-
-    return iStream_.eof();
+    return endOfInput_;
 }
 
 /**
@@ -777,7 +811,7 @@ BinaryStream::sizeOfFile() {
         setWritePosition(currentPos);
         return fileSize;
 
-    } else if (!iStream_.is_open()) {
+    } else if (!inputOpen_) {
         try {
             openInput(fileName_);
 
@@ -789,15 +823,6 @@ BinaryStream::sizeOfFile() {
         }
     }
 
-    if (iStream_.bad()) {
-        throw UnreachableStream(
-            __FILE__, __LINE__, __func__, fileName_);
-    }
-
-    unsigned int currentPos = readPosition();
-    iStream_.seekg(0, ios::end);
-    unsigned int fileSize = iStream_.tellg();
-    setReadPosition(currentPos);
-    return fileSize;
+    return inputSize_;
 }
 }
@@ -50,6 +50,10 @@ namespace TPEF {
  * It takes care of opening and closing the streams automatically, and
  * hides possible byte order mismatch.
  *
+ * Input files are mapped to memory as a whole when first read, so the
+ * reads are copies from the mapping. Writing to the file through the
+ * stream unmaps it, the file is mapped again on the next read.
+ *
  * The bits read from the stream are converted to the byte order of
  * the host machine. Conversely, the bits written into the stream will
  * be converted to the standard byte order of TTA Program Exchange
@@ -89,8 +93,16 @@ public:
     TPEFHeaders::TPEFVersion TPEFVersion() const;
 
 private:
-    /// The input stream.
-    std::ifstream iStream_;
+    /// The input file mapped to memory, NULL if the file is empty.
+    const Byte* inputData_;
+    /// The size of the mapped input file.
+    unsigned int inputSize_;
+    /// True if the input file is mapped.
+    bool inputOpen_;
+    /// The position of the read cursor.
+    unsigned int readPosition_;
+    /// True if a read has been attempted at the end of the input file.
+    bool endOfInput_;
     /// The output stream.
     std::ofstream oStream_;
     /// The name of the stream.
@@ -113,8 +125,10 @@ private:
 
     void openInput(std::string name);
     void openOutput(std::string name);
+    void closeInput();
     void close();
     Byte getByte();
+    bool readMapped(Byte* buffer, unsigned int howmany);
     void putByte(Byte byte);
 
     bool needsSwap() const;
@@ -432,8 +432,8 @@ SafePointer::notifyDeleted(const SafePointable* obj) {
     // if the safe pointer list we just cleaned up is not referenced in any
     // map anymore, it can be deleted safely
 
-    // TODO: for hashmap implementation this will take *very* long time
-    //       so fix this before change typedefs in SafePointer.hh
+    // the key tables are scanned linearly, but they are normally empty
+    // here as they are cleaned up after reading and writing a binary
     if (!MapTools::containsValue(*sectionMap_,       listOfObj) &&
         !MapTools::containsValue(*sectionIndexMap_,  listOfObj) &&
         !MapTools::containsValue(*sectionOffsetMap_, listOfObj) &&
@@ -30,8 +30,10 @@
  * @note rating: red
  */
 #include <iostream>
+#include <memory>
 #include "Application.hh"
 #include "LLVMBackend.hh"
+#include "TCETargetMachinePlugin.hh"
 #include "LLVMTCECmdLineOptions.hh"
 #include "Program.hh"
 #include "ADFSerializer.hh"
@@ -39,16 +41,6 @@
 #include "InterPassData.hh"
 #include "Machine.hh"
 
-#include "CompilerWarnings.hh"
-IGNORE_COMPILER_WARNING("-Wunused-parameter")
-
-#ifndef __STDC_LIMIT_MACROS
-#define __STDC_LIMIT_MACROS
-#endif
-#include <llvm/Support/CommandLine.h>
-
-POP_COMPILER_DIAGS
-
 const std::string DEFAULT_OUTPUT_FILENAME = "out.tpef";
 const int DEFAULT_OPT_LEVEL = 2;
 
@@ -78,7 +70,9 @@ main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
-    if (options->numberOfArguments() != 1) {
+    // only the target is needed for building the backend plugin
+    bool pluginOnly = options->generatePluginOnly();
+    if (options->numberOfArguments() != (pluginOnly ? 0 : 1)) {
         options->printHelp();
         return EXIT_FAILURE;
     }
@@ -130,6 +124,27 @@ main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    bool useInstalledVersion = Application::isInstalled();
+
+    if (pluginOnly) {
+        // Builds the plugin to the plugin cache unless it is already there.
+        try {
+            LLVMBackend compiler(useInstalledVersion, options->tempDir());
+            std::unique_ptr<llvm::TCETargetMachinePlugin> plugin(
+                compiler.createPlugin(*mach));
+            std::cout << "Generated TCE LLVM Backend plugin: "
+                      << compiler.createdPluginFilename() << std::endl;
+        } catch (const Exception& e) {
+            std::cerr << "Error generating backend plugin for '"
+                      << targetADF << "':" << std::endl
+                      << e.errorMessageStack() << std::endl;
+            return EXIT_FAILURE;
+        }
+        delete mach;
+        mach = NULL;
+        return EXIT_SUCCESS;
+    }
+
     // --- Output file name ---
     std::string outputFileName = DEFAULT_OUTPUT_FILENAME;
     if (options->isOutputFileDefined()) {
@@ -156,8 +171,6 @@ main(int argc, char* argv[]) {
     
     //--- check if program was ran in src dir or from install dir ---
     std::string runPath = std::string(argv[0]);
-
-    bool useInstalledVersion = Application::isInstalled();
     
     // All emulation code which cannot be linked in before last global dce is
     // executed, for emulation of instructions which are generated during 
@@ -171,8 +184,7 @@ main(int argc, char* argv[]) {
     try {
         InterPassData* ipData = new InterPassData;
 
-        const char* argv[] = {"llvm-tce", "--no-stack-coloring"};
-        llvm::cl::ParseCommandLineOptions(2, argv, "llvm linker\n");
+        LLVMBackend::initializeLLVMOptions();
 
         LLVMBackend compiler(useInstalledVersion, options->tempDir());
         TTAProgram::Program* seqProg =
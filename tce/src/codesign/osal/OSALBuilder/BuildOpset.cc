@@ -43,6 +43,7 @@
 #include "Conversion.hh"
 #include "tce_config.h"
 #include "OperationBuilder.hh"
+#include "BinaryOperationIndex.hh"
 
 using std::string;
 using std::cout;
@@ -119,7 +120,8 @@ BuildOpsetOptions::ignore() const {
  * Main program.
  *
  * Searches for XML file given to it as a parameter. Then searches for a
- * corresponding operation behavior source file and compiles it.
+ * corresponding operation behavior source file and compiles it. Finally
+ * compiles the XML file to the binary form OSAL loads faster.
  */
 int main(int argc, char* argv[]) {
 
@@ -186,6 +188,15 @@ int main(int argc, char* argv[]) {
             return EXIT_FAILURE;
         }
 
+        // precompile the operation properties for faster loading, the
+        // compiled file is optional, OSAL reads the .opp without it
+        try {
+            BinaryOperationIndex::compile(module + ".opp");
+        } catch (const Exception& e) {
+            cerr << "Warning: operation properties were not precompiled: "
+                 << e.errorMessage() << endl;
+        }
+
     } catch (ParserStopRequest) {
         return EXIT_SUCCESS;
     } catch (const IllegalCommandLine& i) { 
@@ -0,0 +1,132 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file OSALCompiler.cc
+ *
+ * Implementation of osalc, the compiler of the binary operation property
+ * files.
+ *
+ * @note rating: red
+ */
+
+#include <string>
+#include <iostream>
+
+#include "OSALCompiler.hh"
+#include "BinaryOperationIndex.hh"
+#include "CmdLineOptions.hh"
+#include "Conversion.hh"
+#include "Application.hh"
+
+using std::string;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+//////////////////////////////////////////////////////////////////////////////
+// OSALCompilerOptions
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor.
+ */
+OSALCompilerOptions::OSALCompilerOptions() :
+    CmdLineOptions("Usage: osalc [options] module.opp [module.opp ...]") {
+
+    string desc =
+        "\n\tThe compiled file to write. Allowed with one module only.\n"
+        "\tBy default the compiled file is written next to the .opp file\n"
+        "\twith the extension .oppc.";
+    StringCmdLineOptionParser* output =
+        new StringCmdLineOptionParser("output", desc, "o");
+    addOption(output);
+}
+
+/**
+ * Destructor
+ */
+OSALCompilerOptions::~OSALCompilerOptions() {
+}
+
+/**
+ * Prints the version of the application.
+ */
+void
+OSALCompilerOptions::printVersion() const {
+    cout << "osalc - Operation property compiler "
+         << Application::TCEVersionString() << endl;
+}
+
+/**
+ * Returns the value of the output option.
+ *
+ * @return The value of the output option.
+ */
+string
+OSALCompilerOptions::outputFile() const {
+    return findOption("output")->String();
+}
+
+/**
+ * Main program.
+ *
+ * Compiles the operation property files given as arguments to the binary
+ * form that OSAL reads instead of the XML files.
+ */
+int main(int argc, char* argv[]) {
+
+    Application::initialize(argc, argv);
+
+    try {
+        OSALCompilerOptions* options = new OSALCompilerOptions;
+
+        options->parse(argv, argc);
+        Application::setCmdLineOptions(options);
+
+        int arguments = options->numberOfArguments();
+        if (arguments == 0 ||
+            (arguments > 1 && options->outputFile() != "")) {
+            options->printHelp();
+            return EXIT_FAILURE;
+        }
+
+        for (int i = 1; i <= arguments; ++i) {
+            BinaryOperationIndex::compile(
+                options->argument(i), options->outputFile());
+        }
+    } catch (ParserStopRequest) {
+        return EXIT_SUCCESS;
+    } catch (const IllegalCommandLine& i) {
+        cerr << i.errorMessage() << endl;
+        return EXIT_FAILURE;
+    } catch (const Exception& e) {
+        string linenum = Conversion::toString(e.lineNum());
+        cerr << "Exception thrown: " << e.fileName() << ": "
+             << linenum << ": " << e.procedureName() << ": "
+             << e.errorMessage() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
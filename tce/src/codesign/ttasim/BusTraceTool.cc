@@ -0,0 +1,181 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BusTraceTool.cc
+ *
+ * Implementation of ttasim-bustrace, a tool that converts binary bus traces
+ * written by ttasim to the text format and compares them with the bus
+ * dumps of RTL simulations.
+ *
+ * @note rating: red
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cctype>
+#include <cstdlib>
+
+#include "Application.hh"
+#include "BinaryBusTraceReader.hh"
+#include "Conversion.hh"
+
+/**
+ * Writes the binary bus trace in the text format.
+ *
+ * The output is identical to the bus trace ttasim writes when the binary
+ * format is not enabled.
+ *
+ * @param trace The binary bus trace.
+ * @param output The stream to write to.
+ */
+void
+writeText(const BinaryBusTraceReader& trace, std::ostream& output) {
+    std::string line;
+    for (std::size_t i = 0; i < trace.recordCount(); ++i) {
+        line.clear();
+        BinaryBusTrace::appendText(line, trace.record(i), trace.busWidths());
+        line += '\n';
+        output.write(line.data(), line.size());
+    }
+}
+
+/**
+ * Compares the binary bus trace with a bus dump of an RTL simulation.
+ *
+ * The dump is in the text bus trace format and may be longer than the
+ * trace, as the RTL simulation usually runs past the end of the program.
+ * The hexadecimal digits are compared case insensitively. The first
+ * mismatching cycle and bus is reported.
+ *
+ * @param trace The binary bus trace.
+ * @param dump The bus dump of the RTL simulation.
+ * @param dumpName The name of the dump file used in the messages.
+ * @return True if the dump matches the trace.
+ */
+bool
+compare(
+    const BinaryBusTraceReader& trace, std::istream& dump,
+    const std::string& dumpName) {
+
+    std::string expected;
+    std::string line;
+    for (std::size_t i = 0; i < trace.recordCount(); ++i) {
+        expected.clear();
+        BinaryBusTrace::appendText(
+            expected, trace.record(i), trace.busWidths());
+
+        if (!std::getline(dump, line)) {
+            std::cerr << dumpName << " ends at line " << i + 1
+                      << ", the trace has " << trace.recordCount()
+                      << " cycles." << std::endl;
+            return false;
+        }
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+
+        // find the first differing column
+        std::size_t column = 0;
+        std::size_t pos = 0;
+        while (pos < expected.size() && pos < line.size() &&
+               std::tolower(expected[pos]) == std::tolower(line[pos])) {
+            if (expected[pos] == BinaryBusTrace::COLUMN_SEPARATOR) {
+                ++column;
+            }
+            ++pos;
+        }
+        if (pos == expected.size() && pos == line.size()) {
+            continue;
+        }
+
+        std::cerr << "Mismatch at line " << i + 1 << ", cycle "
+                  << trace.cycle(i);
+        if (column > 0 && column <= trace.busCount()) {
+            std::cerr << ", bus " << trace.busName(column - 1);
+        }
+        std::cerr << ":" << std::endl
+                  << "  ttasim: " << expected << std::endl
+                  << "  " << dumpName << ": " << line << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Prints the usage of the tool.
+ */
+void
+printUsage() {
+    std::cerr
+        << "usage: ttasim-bustrace text trace.bustrace.bin [output]"
+        << std::endl
+        << "       ttasim-bustrace compare trace.bustrace.bin execbus.dump"
+        << std::endl;
+}
+
+int
+main(int argc, char* argv[]) {
+
+    Application::initialize();
+
+    if (argc < 3 || argc > 4) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    const std::string command = argv[1];
+
+    try {
+        BinaryBusTraceReader trace(argv[2]);
+
+        if (command == "text") {
+            if (argc == 3) {
+                writeText(trace, std::cout);
+                return EXIT_SUCCESS;
+            }
+            std::ofstream output(argv[3]);
+            if (!output) {
+                std::cerr << "Cannot open " << argv[3] << " for writing."
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            writeText(trace, output);
+            return output ? EXIT_SUCCESS : EXIT_FAILURE;
+        } else if (command == "compare" && argc == 4) {
+            std::ifstream dump(argv[3]);
+            if (!dump) {
+                std::cerr << "Cannot open " << argv[3] << "." << std::endl;
+                return EXIT_FAILURE;
+            }
+            return compare(trace, dump, argv[3]) ?
+                EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    } catch (const Exception& e) {
+        std::cerr << e.errorMessage() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    printUsage();
+    return EXIT_FAILURE;
+}
@@ -87,6 +87,7 @@ std::map<int, Application::UnixSignalHandler*> Application::signalHandlers_;
 
 int Application::verboseLevel_ = Application::VERBOSE_LEVEL_DEFAULT;
 CmdLineOptions* Application::cmdLineOptions_ = NULL;
+thread_local CmdLineOptions* Application::threadCmdLineOptions_ = NULL;
 
 int Application::argc_;
 char** Application::argv_;
@@ -393,11 +394,39 @@ Application::setCmdLineOptions(CmdLineOptions* options) {
     }
 }
 
+/**
+ * Returns the command line options of the calling thread.
+ *
+ * @return The options set for the thread, or the options of the
+ * application if none were set.
+ */
 CmdLineOptions*
 Application::cmdLineOptions() {
+    if (threadCmdLineOptions_ != NULL) {
+        return threadCmdLineOptions_;
+    }
     return cmdLineOptions_;
 }
 
+/**
+ * Sets the command line options seen by the calling thread.
+ *
+ * Lets library code which reads the options of another tool, e.g., the
+ * compiler run in-process, run in a thread while the other threads of the
+ * application keep using its own options. The instance is not owned by
+ * Application. See also ThreadCmdLineOptions.
+ *
+ * @param options The options of the thread, NULL for the options of the
+ * application.
+ * @return The previous options of the thread.
+ */
+CmdLineOptions*
+Application::setThreadCmdLineOptions(CmdLineOptions* options) {
+    CmdLineOptions* old = threadCmdLineOptions_;
+    threadCmdLineOptions_ = options;
+    return old;
+}
+
 /**
  * Sets a new signal handler for the given signal
  *
@@ -189,6 +189,7 @@ public:
 
     static void setCmdLineOptions(CmdLineOptions* options_);
     static CmdLineOptions* cmdLineOptions();
+    static CmdLineOptions* setThreadCmdLineOptions(CmdLineOptions* options);
     static int argc() { return argc_; }
     static char** argv() { return argv_; }
     static bool isInstalled();
@@ -211,6 +212,26 @@ public:
         virtual ~UnixSignalHandler() {}
     };
     
+    /**
+     * Sets the command line options of the calling thread for the
+     * lifetime of the object.
+     *
+     * The previous options of the thread are restored on destruction.
+     */
+    class ThreadCmdLineOptions {
+    public:
+        explicit ThreadCmdLineOptions(CmdLineOptions* options) :
+            previous_(setThreadCmdLineOptions(options)) {}
+        ~ThreadCmdLineOptions() { setThreadCmdLineOptions(previous_); }
+    private:
+        /// Copying not allowed.
+        ThreadCmdLineOptions(const ThreadCmdLineOptions&);
+        /// Assignment not allowed.
+        ThreadCmdLineOptions& operator=(const ThreadCmdLineOptions&);
+        /// The options of the thread before this object.
+        CmdLineOptions* previous_;
+    };
+
     // Unix signal handler set/reset functions
     static void setSignalHandler(int signalNum, UnixSignalHandler& handler);
     static UnixSignalHandler* getSignalHandler(int signalNum);
@@ -252,6 +273,8 @@ private:
     
     /// Holds command line options passed to program
     static CmdLineOptions* cmdLineOptions_;
+    /// Options used instead of cmdLineOptions_ in the thread, if not NULL.
+    static thread_local CmdLineOptions* threadCmdLineOptions_;
 
     /// The original argc and argv given to the main program, if applicable.
     static int argc_;
@@ -1081,6 +1081,39 @@ Environment::parsePathEnvVariable(std::vector<std::string>& paths) {
     StringTools::chopString(pathsEnv, ":", paths);
 }
 
+/**
+ * Returns full path to the standard emulation library bitcode tcecc passes
+ * to llvm-tce.
+ *
+ * The library implements the operations the target machine lacks.
+ *
+ * @param littleEndian True for little-endian targets.
+ * @param bits64 True for 64-bit targets.
+ * @return Full path to the library, or an empty string if not found.
+ */
+string
+Environment::standardEmulationLib(bool littleEndian, bool bits64) {
+
+    std::string target = "tce-llvm";
+    if (littleEndian) {
+        target = bits64 ? "tcele64-llvm" : "tcele-llvm";
+    }
+
+    std::string path;
+    if (Environment::developerMode()) {
+        path = string(TCE_BLD_ROOT) + DS + "newlib-1.17.0" + DS + target +
+            DS + target + DS + "newlib";
+    } else {
+        path = Application::installationDir() + DS + target + DS + "lib";
+    }
+    path += DS + "standard_emulation.o";
+
+    if (!FileSystem::fileExists(path)) {
+        return "";
+    }
+    return path;
+}
+
 /**
  * Returns full path to the default LLVM backend plugin cache directory.
  */
@@ -1096,6 +1129,28 @@ Environment::llvmtceCachePath() {
     return path;
 }
 
+/**
+ * Returns full path to the compiled simulation engine object cache.
+ *
+ * The path can be overridden with the TTASIM_CACHE_DIR environment
+ * variable.
+ */
+string
+Environment::compiledSimCachePath() {
+
+    std::string path = environmentVariable("TTASIM_CACHE_DIR");
+    if (path != "") {
+        return path;
+    }
+    path =
+        FileSystem::homeDirectory() +
+        FileSystem::DIRECTORY_SEPARATOR + string(".tce") +
+        FileSystem::DIRECTORY_SEPARATOR + string("ttasim") +
+        FileSystem::DIRECTORY_SEPARATOR + string("cache");
+
+    return path;
+}
+
 /**
  * Finds a first match of a given list of files from PATH env variable.
  *
@@ -94,6 +94,8 @@ public:
     static std::string defaultTextEditorPath();
 
     static std::string llvmtceCachePath();
+    static std::string compiledSimCachePath();
+    static std::string standardEmulationLib(bool littleEndian, bool bits64);
 
     static std::vector<std::string> implementationTesterTemplatePaths();
     static std::string simTraceDirPath();
@@ -85,7 +85,14 @@ Informer::findListenerSlot(int event, Listener* listener) {
  */
 bool
 Informer::registerListener(int event, Listener* listener) {
+    const std::size_t oldCount = eventListeners_.size();
     findListenerSlot(event, listener);
+    if (eventListeners_.size() != oldCount && event >= 0) {
+        if (static_cast<std::size_t>(event) >= listenerCounts_.size()) {
+            listenerCounts_.resize(event + 1, 0);
+        }
+        ++listenerCounts_[event];
+    }
     return true;
 }
 
@@ -102,8 +109,13 @@ Informer::registerListener(int event, Listener* listener) {
  */
 bool
 Informer::unregisterListener(int event, Listener* listener) {
+    const std::size_t oldCount = eventListeners_.size();
     std::size_t index = findListenerSlot(event, listener);
     ListenerList::iterator i = eventListeners_.begin() + index;
     eventListeners_.erase(i);
+    if (eventListeners_.size() != oldCount && event >= 0) {
+        // the listener was registered to the event
+        --listenerCounts_[event];
+    }
     return true;
 }
@@ -56,6 +56,7 @@ public:
     virtual ~Informer();
 
     void handleEvent(int event);
+    bool hasListeners(int event) const;
     virtual bool registerListener(int event, Listener* listener);
     virtual bool unregisterListener(int event, Listener* listener);
 
@@ -63,6 +64,8 @@ private:
     std::size_t findListenerSlot(int event, Listener* listener);
     typedef std::vector<std::pair<int, Listener*> > ListenerList;
     ListenerList eventListeners_;
+    /// Count of the registered listeners of each event, indexed by event.
+    std::vector<std::size_t> listenerCounts_;
 
 };
 
@@ -32,6 +32,7 @@
  */
 
 #include <iostream>
+#include <functional>
 
 #include "ObjectState.hh"
 #include "Conversion.hh"
@@ -520,6 +521,34 @@ ObjectState::operator!=(const ObjectState& object) {
     return false;
 }
 
+/**
+ * Returns a hash value of the object state tree.
+ *
+ * Object states that are equal according to operator!= have the same hash
+ * value. The hash does not depend on the order of the attributes, but
+ * does depend on the order of the children.
+ *
+ * @return The hash value.
+ */
+std::size_t
+ObjectState::hashValue() const {
+    std::hash<std::string> stringHash;
+    std::size_t hash = stringHash(name_) * 31 + stringHash(value_);
+
+    std::size_t attributeHash = 0;
+    for (size_t i = 0; i < attributes_.size(); i++) {
+        attributeHash +=
+            stringHash(attributes_[i].name) * 31 +
+            stringHash(attributes_[i].value);
+    }
+    hash = hash * 31 + attributeHash;
+
+    for (size_t i = 0; i < children_.size(); i++) {
+        hash = hash * 31 + children_[i]->hashValue();
+    }
+    return hash;
+}
+
 /**
  * Generates a common beginning of error messages.
  *
@@ -34,6 +34,7 @@
 #ifndef TTA_OBJECT_STATE_HH
 #define TTA_OBJECT_STATE_HH
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -114,6 +115,7 @@ public:
     ObjectState* child(int index) const;
 
     bool operator!=(const ObjectState& object);
+    std::size_t hashValue() const;
 
     static void dumpObjectState(
         const ObjectState& state,
@@ -45,7 +45,8 @@
  * width of SIMULATOR_MAX_INTWORD_BITWIDTH bits.
  */
 SimValue::SimValue() :
-    mask_(~ULongWord(0)) {
+    rawData_(inlineData_), mask_(~ULongWord(0)),
+    capacity_(SIMVALUE_INLINE_BYTE_SIZE) {
 
     setBitWidth(SIMULATOR_MAX_LONGWORD_BITWIDTH);
 }
@@ -56,7 +57,8 @@ SimValue::SimValue() :
  * @param width The bit width of the created SimValue.
  */
 SimValue::SimValue(int width) :
-    mask_(~ULongWord(0)) {
+    rawData_(inlineData_), mask_(~ULongWord(0)),
+    capacity_(SIMVALUE_INLINE_BYTE_SIZE) {
 
     setBitWidth(width);
 }
@@ -69,7 +71,8 @@ SimValue::SimValue(int width) :
  * @param width The bit width of the created SimValue.
  */
 SimValue::SimValue(SLongWord value, int width) :
-    mask_(~ULongWord(0)) {
+    rawData_(inlineData_), mask_(~ULongWord(0)),
+    capacity_(SIMVALUE_INLINE_BYTE_SIZE) {
 
     setBitWidth(width);
 
@@ -90,10 +93,22 @@ SimValue::SimValue(SLongWord value, int width) :
  *
  * @param source The source object from which to copy data.
  */
-SimValue::SimValue(const SimValue& source) {
+SimValue::SimValue(const SimValue& source) :
+    rawData_(inlineData_), capacity_(SIMVALUE_INLINE_BYTE_SIZE) {
     deepCopy(source);
 }
 
+/**
+ * Destructor.
+ *
+ * Frees the out-of-line storage of wide values.
+ */
+SimValue::~SimValue() {
+    if (rawData_ != inlineData_) {
+        delete[] rawData_;
+    }
+}
+
 /**
  * Returns the bit width of the SimValue.
  *
@@ -119,6 +134,7 @@ SimValue::setBitWidth(int width) {
     }
 
     const int BYTE_COUNT = (width + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
+    reserve(BYTE_COUNT);
 
     if (static_cast<size_t>(BYTE_COUNT) > sizeof(DoubleWord)) {
         clearToZero(width);
@@ -286,9 +302,14 @@ SimValue::operator=(const SimValue& source) {
     const size_t SRC_BYTE_COUNT =
         (source.bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
-    memcpy(rawData_, source.rawData_, SRC_BYTE_COUNT);
-    if (SRC_BYTE_COUNT < DST_BYTE_COUNT) {
-        memset(rawData_+SRC_BYTE_COUNT, 0, DST_BYTE_COUNT-SRC_BYTE_COUNT);
+    // The bytes above the destination width are only kept as far as
+    // the current storage reaches, they are never read back.
+    const size_t COPY_COUNT =
+        SRC_BYTE_COUNT < capacity_ ? SRC_BYTE_COUNT : capacity_;
+
+    memcpy(rawData_, source.rawData_, COPY_COUNT);
+    if (COPY_COUNT < DST_BYTE_COUNT) {
+        memset(rawData_+COPY_COUNT, 0, DST_BYTE_COUNT-COPY_COUNT);
     } else if (bitWidth_ % BYTE_BITWIDTH) {
         const unsigned bitsInMSB = bitWidth_ % BYTE_BITWIDTH;
         const Byte msbBitMask = static_cast<Byte>((1 << bitsInMSB) - 1);
@@ -309,6 +330,10 @@ SimValue::deepCopy(const SimValue& source) {
     const size_t BYTE_COUNT =
         (source.bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
+    if (this == &source) {
+        return;
+    }
+    reserve(BYTE_COUNT);
     memcpy(rawData_, source.rawData_, BYTE_COUNT);
     bitWidth_ = source.bitWidth_;
     mask_ = source.mask_;
@@ -1191,6 +1216,11 @@ SimValue::vectorElement(size_t elementIndex) const {
     // Element index must not cross SimValue's bitwidth.
     assert((elementIndex+1) <= (SIMVALUE_MAX_BYTE_SIZE / BYTE_COUNT));
 
+    // Bytes that were never written are zero.
+    if (OFFSET + BYTE_COUNT > capacity_) {
+        return T();
+    }
+
     union CastUnion {
         Byte bytes[sizeof(T)];
         T value;
@@ -1277,7 +1307,10 @@ SimValue::byteElement(size_t elementIndex) const {
 
     // Element index must not cross SimValue's bitwidth.
     assert((elementIndex+1) <= (SIMVALUE_MAX_BYTE_SIZE / BYTE_COUNT));
-    
+
+    if (OFFSET >= capacity_) {
+        return 0;
+    }
     return rawData_[OFFSET];
 }
 
@@ -1292,6 +1325,9 @@ SimValue::bitElement(size_t elementIndex) const {
     const size_t OFFSET = elementIndex / BYTE_BITWIDTH;
     const size_t LEFT_SHIFTS = elementIndex % BYTE_BITWIDTH;
 
+    if (OFFSET >= capacity_) {
+        return 0;
+    }
     Byte data = rawData_[OFFSET];
 
     if (data & (1 << LEFT_SHIFTS)) {
@@ -1322,7 +1358,11 @@ SimValue::element(size_t elementIndex, size_t elementWidth) const {
         const size_t OFFSET = elementIndex * BYTE_COUNT;
         const Word BITMASK =
             elementWidth < 32 ? ~(~Word(0) << elementWidth) : ~(Word(0));
-        Word tmp;
+        Word tmp = 0;
+
+        if (OFFSET + BYTE_COUNT > capacity_) {
+            return 0;
+        }
 
 #if HOST_BIGENDIAN == 1
         swapByteOrder(rawData_ + OFFSET, BYTE_COUNT, &tmp);
@@ -1342,6 +1382,7 @@ SimValue::setVectorElement(size_t elementIndex, T data) {
 
     // Element index must not cross SimValue's bitwidth.
     assert((elementIndex+1) <= (SIMVALUE_MAX_BYTE_SIZE / BYTE_COUNT));
+    reserve(OFFSET + BYTE_COUNT);
 
 #if HOST_BIGENDIAN == 1
     swapByteOrder((Byte*)&data, BYTE_COUNT, rawData_ + OFFSET);
@@ -1401,6 +1442,7 @@ SimValue::setBitElement(size_t elementIndex, UIntWord data) {
     const size_t OFFSET = elementIndex / BYTE_BITWIDTH;
     const size_t LEFT_SHIFTS = elementIndex % BYTE_BITWIDTH;
 
+    reserve(OFFSET + 1);
     Byte byte = rawData_[OFFSET];
 
     if (data == 0) {
@@ -1431,6 +1473,7 @@ SimValue::setElement(size_t elementIndex, size_t elementWidth, Word data) {
 
         // Element index must not cross SimValue's bitwidth.
         assert((elementIndex+1) <= (SIMVALUE_MAX_BYTE_SIZE / BYTE_COUNT));
+        reserve(OFFSET + BYTE_COUNT);
         // Cut excess bits from data
         Word BITMASK = ~Word(0);
         if (elementWidth < sizeof(Word)*8) {
@@ -1480,6 +1523,7 @@ SimValue::setValue(TCEString hexValue) {
         // Add padding zero bytes in case the hexValue defines less
         // bytes than the width of the value.
         paddingBytes = (VALUE_BITWIDTH - bitWidth_) / 8;
+        reserve(VALUE_BITWIDTH / 8 + paddingBytes);
         for (size_t i = 0; i < paddingBytes; ++i)
             rawData_[VALUE_BITWIDTH / 8 + i] = 0;
     }
@@ -1491,6 +1535,7 @@ SimValue::setValue(TCEString hexValue) {
     // remaining 4bits
     int byteWidth = VALUE_BITWIDTH / 8;
     if (VALUE_BITWIDTH % 8 != 0) ++byteWidth;
+    reserve(byteWidth);
 
     swapByteOrder(bigEndianData, byteWidth, rawData_);
 }
@@ -1506,7 +1551,8 @@ SimValue::clearToZero(int bitWidth) {
 
     const size_t BYTE_COUNT = (bitWidth + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
 
-    memset(rawData_, 0, BYTE_COUNT);
+    // Bytes beyond the allocated storage read as zero already.
+    memset(rawData_, 0, BYTE_COUNT < capacity_ ? BYTE_COUNT : capacity_);
 }
 
 /**
@@ -1540,6 +1586,7 @@ SimValue::signExtendTo(int bitWidth) {
 
     const size_t FIRST_BYTE = (bitWidth + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
     const size_t BYTE_COUNT = (bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
+    reserve(FIRST_BYTE > BYTE_COUNT ? FIRST_BYTE : BYTE_COUNT);
 
     rawData_[FIRST_BYTE-1] = MathTools::fastSignExtendTo(
                                         static_cast<int>(rawData_[FIRST_BYTE-1]),
@@ -1576,6 +1623,7 @@ SimValue::zeroExtendTo(int bitWidth) {
 
     const size_t FIRST_BYTE = (bitWidth + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
     const size_t BYTE_COUNT = (bitWidth_ + (BYTE_BITWIDTH - 1)) / BYTE_BITWIDTH;
+    reserve(FIRST_BYTE > BYTE_COUNT ? FIRST_BYTE : BYTE_COUNT);
 
     rawData_[FIRST_BYTE-1] = MathTools::fastZeroExtendTo(
                                         static_cast<int>(rawData_[FIRST_BYTE-1]),
@@ -1599,7 +1647,7 @@ SimValue::dump() const {
 
     // Convert the raw data buffer to hex string values one byte at a time.
     // Also, remove "0x" from the front of the hex string for each hex value.
-    for (int i = SIMVALUE_MAX_BYTE_SIZE - 1; i >= 0; --i) {
+    for (int i = capacity_ - 1; i >= 0; --i) {
         unsigned int value =
             static_cast<unsigned int>(rawData_[i]);
         result += Conversion::toHexString(value, 2).substr(2);
@@ -1608,6 +1656,37 @@ SimValue::dump() const {
     return result;
 }
 
+/**
+ * Makes sure the value storage can hold at least the given number of bytes.
+ *
+ * Moves the data to an out-of-line buffer in case the inline storage is
+ * not large enough. The new bytes are cleared to zero.
+ *
+ * @param byteCount The number of bytes needed.
+ */
+void
+SimValue::reserve(size_t byteCount) {
+    if (byteCount <= capacity_) {
+        return;
+    }
+    assert(byteCount <= SIMVALUE_MAX_BYTE_SIZE);
+
+    // Allocate in full 64-bit words so that aligned element accesses
+    // never straddle the end of the storage.
+    const size_t newCapacity =
+        (byteCount + sizeof(ULongWord) - 1) / sizeof(ULongWord) *
+        sizeof(ULongWord);
+    Byte* newData = new Byte[newCapacity];
+    memcpy(newData, rawData_, capacity_);
+    memset(newData + capacity_, 0, newCapacity - capacity_);
+
+    if (rawData_ != inlineData_) {
+        delete[] rawData_;
+    }
+    rawData_ = newData;
+    capacity_ = newCapacity;
+}
+
 /**
  * Copies the byte order from source array in opposite order to target array.
  *
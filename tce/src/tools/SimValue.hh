@@ -41,6 +41,7 @@
 
 #define SIMD_WORD_WIDTH 4096
 #define SIMVALUE_MAX_BYTE_SIZE (SIMD_WORD_WIDTH / BYTE_BITWIDTH)
+#define SIMVALUE_INLINE_BYTE_SIZE 8
 
 class TCEString;
 
@@ -91,6 +92,11 @@ class TCEString;
  * little-endian machine. However, users shouldn't access the public 
  * rawData_ member directly unless they know exactly what they are doing,
  * and always use the accessors for getting/setting lane data.
+ *
+ * Values up to SIMVALUE_INLINE_BYTE_SIZE bytes (the common scalar case)
+ * are stored inside the object. Wider (vector) values allocate an
+ * out-of-line buffer sized to their width, so scalar machine states,
+ * buses and operand slots do not pay for the maximum SIMD width.
  */
 
 class SimValue {
@@ -101,7 +107,7 @@ public:
     explicit SimValue(int width);
     explicit SimValue(SLongWord value, int width);
     SimValue(const SimValue& source);
-    ~SimValue() {}
+    ~SimValue();
 
     int width() const;
     void setBitWidth(int width);
@@ -198,14 +204,17 @@ public:
     void zeroExtendTo(int bitWidth);
     TCEString dump() const;
 
-    /// Array that contains SimValue's underlaying bytes in little endian.
-    Byte rawData_[SIMVALUE_MAX_BYTE_SIZE];
+    /// Points to the SimValue's underlaying bytes in little endian.
+    /// Either the inline storage or an out-of-line buffer for wide values.
+    Byte* rawData_;
 
     /// The bitwidth of the value.
     int bitWidth_;
 
 private:
 
+    void reserve(size_t byteCount);
+
     template <typename T>
     T vectorElement(size_t elementIndex) const;
     template <typename T>
@@ -221,6 +230,10 @@ private:
 
     /// Mask for masking extra bits when returning unsigned value.
     ULongWord mask_;
+    /// Number of bytes available in rawData_.
+    size_t capacity_;
+    /// Storage for values that fit in SIMVALUE_INLINE_BYTE_SIZE bytes.
+    Byte inlineData_[SIMVALUE_INLINE_BYTE_SIZE];
 
 };
 
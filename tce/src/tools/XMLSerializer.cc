@@ -72,6 +72,8 @@
 using std::string;
 using std::ifstream;
 
+boost::mutex XMLSerializer::xercesLock_;
+
 /**
  * Constructor.
  */
@@ -80,6 +82,7 @@ XMLSerializer::XMLSerializer() :
     useSchema_(false), parser_(NULL), domImplementation_(NULL),
     sourceString_(NULL), destinationString_(NULL), nsUri_("") {
 
+    boost::mutex::scoped_lock lock(xercesLock_);
     XMLPlatformUtils::Initialize();
 
     const XMLCh gLS[] = {chLatin_L, chLatin_S, chNull};
@@ -99,6 +102,7 @@ XMLSerializer::XMLSerializer() :
  * Destructor.
  */
 XMLSerializer::~XMLSerializer() {
+    boost::mutex::scoped_lock lock(xercesLock_);
     delete parser_;
     XMLPlatformUtils::Terminate();
 }
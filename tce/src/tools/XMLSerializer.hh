@@ -36,6 +36,8 @@
 
 #include <string>
 
+#include <boost/thread/mutex.hpp>
+
 #include <xercesc/util/XercesVersion.hpp>
 
 #if XERCES_VERSION_MAJOR >= 3
@@ -132,6 +134,10 @@ private:
 
     /// XML namespace URI
     std::string nsUri_;
+
+    /// Serializes the initialization and termination of Xerces, which
+    /// are not thread-safe, between the serializers of several threads.
+    static boost::mutex xercesLock_;
 };
 
 #endif
@@ -43,6 +43,7 @@
 #include "CostEstimates.hh"
 #include "MachineImplementation.hh"
 #include "Machine.hh"
+#include "RegisterFile.hh"
 
 
 /**
@@ -56,6 +57,7 @@ public:
     void testSchedule();
     void testSimulate();
     void testEvaluate();
+    void testEvaluateAll();
 
 private:
 
@@ -150,4 +152,50 @@ DesignSpaceExplorerTest::testEvaluate() {
     */
 }
 
+/**
+ * Test evaluating several configurations in parallel.
+ */
+void
+DesignSpaceExplorerTest::testEvaluateAll() {
+
+    FileSystem::removeFileOrDirectory("data/test.dsdb");
+    DSDBManager* dsdb = DSDBManager::createNew("data/test.dsdb");
+    TTAMachine::Machine* adf =
+        TTAMachine::Machine::loadFromADF(
+            "../../../../data/mach/minimal_be.adf");
+    dsdb->addApplication("data/TestApp");
+    dsdb->addApplication("data/TestApp2");
+
+    // two different machines, the DSDB stores only one copy of a machine
+    std::vector<DSDBManager::MachineConfiguration> confs(2);
+    confs[0].architectureID = dsdb->addArchitecture(*adf);
+    confs[0].hasImplementation = false;
+    dsdb->addConfiguration(confs[0]);
+    TTAMachine::Machine* adf2 = new TTAMachine::Machine(*adf);
+    TTAMachine::RegisterFile* rf = 
+        adf2->registerFileNavigator().item(0);
+    rf->setNumberOfRegisters(rf->numberOfRegisters() + 1);
+    confs[1].architectureID = dsdb->addArchitecture(*adf2);
+    confs[1].hasImplementation = false;
+    dsdb->addConfiguration(confs[1]);
+    TS_ASSERT_DIFFERS(confs[0].architectureID, confs[1].architectureID);
+
+    DesignSpaceExplorer explorer;
+    explorer.setDSDB(*dsdb);
+    explorer.setJobCount(2);
+    TS_ASSERT_EQUALS(explorer.jobCount(), 2);
+    Application::setVerboseLevel(0);
+    std::vector<bool> evaluated = explorer.evaluateAll(confs);
+    TS_ASSERT_EQUALS(evaluated.size(), 2u);
+    TS_ASSERT(evaluated.at(0));
+    TS_ASSERT(evaluated.at(1));
+    // a cycle count for both of the applications
+    TS_ASSERT_EQUALS(dsdb->cycleCounts(confs[0]).size(), 2u);
+    TS_ASSERT_EQUALS(dsdb->cycleCounts(confs[1]).size(), 2u);
+
+    delete adf2;
+    delete adf;
+    delete dsdb;
+}
+
 #endif
@@ -0,0 +1,171 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReservationBitVectorTest.hh
+ *
+ * A test suite for ReservationBitVector.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_RESERVATION_BIT_VECTOR_TEST_HH
+#define TTA_RESERVATION_BIT_VECTOR_TEST_HH
+
+#include <vector>
+#include <TestSuite.h>
+#include "ReservationBitVector.hh"
+
+/**
+ * Tests the reservation bookkeeping and the free index searches of
+ * ReservationBitVector.
+ */
+class ReservationBitVectorTest : public CxxTest::TestSuite {
+public:
+    void testReserveAndRelease();
+    void testFreeSearch();
+    void testFreeInAny();
+    void testModuloCycles();
+};
+
+/**
+ * Tests reserving and releasing indices far apart and around zero.
+ */
+void
+ReservationBitVectorTest::testReserveAndRelease() {
+    ReservationBitVector table;
+    TS_ASSERT(table.empty());
+    TS_ASSERT(!table.isReserved(0));
+
+    table.reserve(2000000);
+    table.reserve(1999936);
+    table.reserve(5);
+    table.reserve(-1);
+    TS_ASSERT(table.isReserved(2000000));
+    TS_ASSERT(table.isReserved(1999936));
+    TS_ASSERT(table.isReserved(5));
+    TS_ASSERT(table.isReserved(-1));
+    TS_ASSERT(!table.isReserved(1999999));
+    TS_ASSERT(!table.isReserved(-2));
+    TS_ASSERT(!table.isReserved(INT_MAX));
+    TS_ASSERT(!table.isReserved(INT_MIN));
+
+    // reserving twice does not count twice
+    table.reserve(5);
+    table.release(5);
+    TS_ASSERT(!table.isReserved(5));
+    table.release(5);
+    table.release(2000000);
+    table.release(1999936);
+    TS_ASSERT(!table.empty());
+    table.release(-1);
+    TS_ASSERT(table.empty());
+
+    table.reserve(64);
+    table.clear();
+    TS_ASSERT(table.empty());
+    TS_ASSERT(!table.isReserved(64));
+}
+
+/**
+ * Tests the searches of a single table across word boundaries.
+ */
+void
+ReservationBitVectorTest::testFreeSearch() {
+    ReservationBitVector table;
+    for (int i = 10; i < 200; i++) {
+        table.reserve(i);
+    }
+    TS_ASSERT_EQUALS(table.firstFree(10, 1000), 200);
+    TS_ASSERT_EQUALS(table.firstFree(0, 1000), 0);
+    TS_ASSERT_EQUALS(table.firstFree(63, 64), ReservationBitVector::NOT_FOUND);
+    TS_ASSERT_EQUALS(table.lastFree(199, 0), 9);
+    TS_ASSERT_EQUALS(table.lastFree(199, 10), ReservationBitVector::NOT_FOUND);
+    TS_ASSERT_EQUALS(table.lastFree(1000, 0), 1000);
+
+    table.release(130);
+    TS_ASSERT_EQUALS(table.firstFree(10, 1000), 130);
+    TS_ASSERT_EQUALS(table.lastFree(199, 0), 130);
+    TS_ASSERT_EQUALS(table.firstFree(131, 199), ReservationBitVector::NOT_FOUND);
+}
+
+/**
+ * Tests finding an index free in at least one of several tables.
+ */
+void
+ReservationBitVectorTest::testFreeInAny() {
+    ReservationBitVector bus1;
+    ReservationBitVector bus2;
+    for (int i = 0; i < 100; i++) {
+        bus1.reserve(i);
+        if (i != 77) {
+            bus2.reserve(i);
+        }
+    }
+    bus2.reserve(100);
+
+    std::vector<const ReservationBitVector*> tables;
+    TS_ASSERT_EQUALS(
+        ReservationBitVector::firstFreeInAny(tables, 0, 10),
+        ReservationBitVector::NOT_FOUND);
+    tables.push_back(&bus1);
+    tables.push_back(&bus2);
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeInAny(tables, 0, 99), 77);
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeInAny(tables, 78, 200), 100);
+    TS_ASSERT_EQUALS(ReservationBitVector::lastFreeInAny(tables, 99, 0), 77);
+    TS_ASSERT_EQUALS(
+        ReservationBitVector::lastFreeInAny(tables, 76, 0),
+        ReservationBitVector::NOT_FOUND);
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeCycle(tables, 0, 0), 77);
+    TS_ASSERT_EQUALS(ReservationBitVector::lastFreeCycle(tables, 500, 0), 500);
+}
+
+/**
+ * Tests the cycle searches wrapping around the initiation interval.
+ */
+void
+ReservationBitVectorTest::testModuloCycles() {
+    ReservationBitVector bus;
+    const unsigned int ii = 5;
+    bus.reserve(0);
+    bus.reserve(1);
+    bus.reserve(3);
+    bus.reserve(4);
+    std::vector<const ReservationBitVector*> tables(1, &bus);
+
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeCycle(tables, 0, ii), 2);
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeCycle(tables, 3, ii), 7);
+    TS_ASSERT_EQUALS(ReservationBitVector::firstFreeCycle(tables, 12, ii), 12);
+    TS_ASSERT_EQUALS(ReservationBitVector::lastFreeCycle(tables, 6, ii), 2);
+    TS_ASSERT_EQUALS(ReservationBitVector::lastFreeCycle(tables, 9, ii), 7);
+    TS_ASSERT_EQUALS(
+        ReservationBitVector::lastFreeCycle(tables, 1, ii),
+        ReservationBitVector::NOT_FOUND);
+
+    bus.reserve(2);
+    TS_ASSERT_EQUALS(
+        ReservationBitVector::firstFreeCycle(tables, 3, ii),
+        ReservationBitVector::NOT_FOUND);
+}
+
+#endif
@@ -62,6 +62,10 @@
 #include "OperationPool.hh"
 #include "ExecutableMove.hh"
 #include "BuslessExecutableMove.hh"
+#include "ExecutableInstruction.hh"
+#include "RegisterState.hh"
+#include "BusState.hh"
+#include "GuardState.hh"
 #include "AssocTools.hh"
 #include "StringTools.hh"
 
@@ -87,6 +91,7 @@ public:
     void testOneCycleOperationExecutor();
     void testSimpleOperationExecutor();
     void testMemoryAccessingFUState();
+    void testPredecodedInstruction();
 
     void testConflictDetectionModelBenchmark();
 
@@ -428,6 +433,94 @@ FUStateTest::testMemoryAccessingFUState() {
     TS_ASSERT_EQUALS(output.value().intValue(), 10);
 }
 
+/**
+ * Tests that a predecoded instruction executes its moves like the moves
+ * themselves: the sources are read before any destination is written,
+ * the guards squash the moves and the counters are updated.
+ */
+void
+FUStateTest::testPredecodedInstruction() {
+
+    OperationPool pool;
+    Operation& add = pool.operation("TESTADD");
+    TS_ASSERT_DIFFERS(&add, &NullOperation::instance());
+
+    FUState fu;
+    OneCycleOperationExecutor executor(fu);
+
+    InputPortState port1(fu, 32);
+    TriggeringInputPortState port2(fu, 32);
+    OpcodeSettingVirtualInputPortState virtual1(add, fu, port2);
+    OutputPortState port3(fu, 32);
+
+    TS_ASSERT_THROWS_NOTHING(executor.addBinding(1, port1));
+    TS_ASSERT_THROWS_NOTHING(executor.addBinding(2, port2));
+    TS_ASSERT_THROWS_NOTHING(executor.addBinding(3, port3));
+    fu.addOperationExecutor(executor, add);
+    fu.addInputPortState(port1);
+    fu.addInputPortState(port2);
+    fu.addInputPortState(virtual1);
+    fu.addOutputPortState(port3);
+
+    RegisterState r1(32);
+    RegisterState r2(32);
+    RegisterState guardRegister(1);
+    DirectGuardState guard(guardRegister);
+    BusState bus1(32);
+    BusState bus2(32);
+    BusState bus3(32);
+
+    InlineImmediateValue* immediate = new InlineImmediateValue(32);
+    SimValue value(32);
+    value = 7;
+    immediate->setValue(value);
+
+    ExecutableInstruction instruction;
+    instruction.addExecutableMove(new ExecutableMove(r1, bus1, port1));
+    instruction.addExecutableMove(new ExecutableMove(r2, bus2, virtual1));
+    instruction.addExecutableMove(
+        new ExecutableMove(port3, bus3, r2, guard, true));
+    instruction.addExecutableMove(new BuslessExecutableMove(immediate, r1));
+    TS_ASSERT(instruction.predecode());
+
+    // cycle 1: r1 + r2 is computed from the values before the writes
+    value = 2;
+    r1.setValue(value);
+    value = 3;
+    r2.setValue(value);
+    value = 0;
+    guardRegister.setValue(value);
+
+    instruction.execute();
+    fu.endClock();
+    fu.advanceClock();
+
+    TS_ASSERT_EQUALS(port3.value(), 5);
+    TS_ASSERT_EQUALS(r1.value(), 7);
+    TS_ASSERT_EQUALS(r2.value(), 0);
+    TS_ASSERT_EQUALS(bus2.value(), 3);
+    TS_ASSERT(!instruction.moveSquashed(2));
+    TS_ASSERT(!bus3.isSquashed());
+
+    // cycle 2: the inverted guard squashes the write of r2
+    value = 1;
+    guardRegister.setValue(value);
+
+    instruction.execute();
+    fu.endClock();
+    fu.advanceClock();
+
+    TS_ASSERT_EQUALS(port3.value(), 7);
+    TS_ASSERT_EQUALS(r2.value(), 0);
+    TS_ASSERT(instruction.moveSquashed(2));
+    TS_ASSERT(bus3.isSquashed());
+
+    TS_ASSERT_EQUALS(instruction.executionCount(), 2u);
+    TS_ASSERT_EQUALS(instruction.moveExecutionCount(0), 2u);
+    TS_ASSERT_EQUALS(instruction.moveExecutionCount(2), 1u);
+    TS_ASSERT_EQUALS(instruction.moveExecutionCount(3), 2u);
+}
+
 #ifdef CONFLICT_DETECTOR_BENCHMARK 
 
 #include <boost/timer.hpp>
@@ -0,0 +1,146 @@
+/*
+    Copyright (c) 2002-2009 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/** 
+ * @file BinaryBusTraceTest.hh 
+ *
+ * A test suite for the binary bus trace.
+ */
+
+#ifndef TTA_BINARY_BUS_TRACE_TEST_HH
+#define TTA_BINARY_BUS_TRACE_TEST_HH
+
+#include <TestSuite.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include "Exception.hh"
+#include "BinaryBusTraceReader.hh"
+#include "BinaryBusTraceWriter.hh"
+
+using std::string;
+
+/**
+ * Class that tests BinaryBusTraceWriter and BinaryBusTraceReader classes.
+ */
+class BinaryBusTraceTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testTextFormat();
+    void testLongTrace();
+};
+
+const string busTraceFile = "data/new.bustrace.bin";
+
+/**
+ * Called before each test.
+ */
+void
+BinaryBusTraceTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+BinaryBusTraceTest::tearDown() {
+    std::remove(busTraceFile.c_str());
+}
+
+/**
+ * Tests that the records are printed like the text bus trace prints them.
+ */
+void
+BinaryBusTraceTest::testTextFormat() {
+
+    std::vector<std::string> names;
+    names.push_back("B1");
+    names.push_back("B2");
+    names.push_back("B3");
+    std::vector<int> widths;
+    widths.push_back(32);
+    widths.push_back(1);
+    widths.push_back(37);
+
+    BinaryBusTraceWriter* writer = NULL;
+    TS_ASSERT_THROWS_NOTHING(
+        writer = new BinaryBusTraceWriter(busTraceFile, names, widths));
+    TS_ASSERT_EQUALS(writer->recordSize(), 8u + 4u + 1u + 5u);
+
+    unsigned char* record = writer->nextRecord();
+    const unsigned char first[] = {
+        0x78, 0x56, 0x34, 0x12, 0x01, 0xff, 0xee, 0xdd, 0xcc, 0x1f};
+    BinaryBusTrace::writeCycle(record, 0);
+    std::copy(first, first + sizeof(first), record + 8);
+
+    record = writer->nextRecord();
+    BinaryBusTrace::writeCycle(record, 12345678901ull);
+    std::fill(record + 8, record + writer->recordSize(), 0);
+    delete writer;
+    writer = NULL;
+
+    BinaryBusTraceReader trace(busTraceFile);
+    TS_ASSERT_EQUALS(trace.busCount(), 3u);
+    TS_ASSERT_EQUALS(trace.busName(2), "B3");
+    TS_ASSERT_EQUALS(trace.busWidth(2), 37);
+    TS_ASSERT_THROWS(trace.busName(3), OutOfRange);
+    TS_ASSERT_EQUALS(trace.recordCount(), 2u);
+    TS_ASSERT_EQUALS(trace.text(0), "0,12345678,1,1fccddeeff");
+    TS_ASSERT_EQUALS(trace.cycle(1), 12345678901ull);
+    TS_ASSERT_EQUALS(trace.text(1), "12345678901,00000000,0,0000000000");
+    TS_ASSERT_EQUALS(*trace.value(0, 1), 0x01);
+    TS_ASSERT_THROWS(trace.record(2), OutOfRange);
+}
+
+/**
+ * Tests a trace that spans several blocks of the writer.
+ */
+void
+BinaryBusTraceTest::testLongTrace() {
+
+    const uint64_t cycles = 200000;
+    std::vector<std::string> names(1, "B1");
+    std::vector<int> widths(1, 64);
+    {
+        BinaryBusTraceWriter writer(busTraceFile, names, widths);
+        for (uint64_t cycle = 0; cycle < cycles; ++cycle) {
+            unsigned char* record = writer.nextRecord();
+            BinaryBusTrace::writeCycle(record, cycle);
+            BinaryBusTrace::writeCycle(record + 8, cycle * 3);
+        }
+    }
+
+    BinaryBusTraceReader trace(busTraceFile);
+    TS_ASSERT_EQUALS(trace.recordCount(), cycles);
+    TS_ASSERT_EQUALS(trace.cycle(cycles - 1), cycles - 1);
+    TS_ASSERT_EQUALS(
+        BinaryBusTrace::readCycle(trace.value(cycles - 1, 0)),
+        (cycles - 1) * 3);
+    TS_ASSERT_EQUALS(trace.text(1000), "1000,0000000000000bb8");
+}
+
+#endif
@@ -34,10 +34,12 @@
 
 #include <TestSuite.h>
 #include <string>
+#include <fstream>
 
 #include "Exception.hh"
 #include "ExecutionTrace.hh"
 #include "InstructionExecution.hh"
+#include "BinaryTrace.hh"
 
 using std::string;
 
@@ -54,11 +56,16 @@ public:
     void testInitialize();    
     void testAddInstructionExecution();
     void testInstructionExecution();
+    void testStatistics();
+    void testLongTrace();
+    void testCorruptedColumn();
 private:    
     ExecutionTrace* execTrace_;
 };
 
 const string nonexistingWritableDBFile = "data/new.tdb";
+const string longTraceFile = "data/new.tdb.long";
+const string corruptedTraceFile = "data/corrupted.tdb";
 
 /**
  * Constructor.
@@ -159,4 +166,110 @@ ExecutionTraceTest::testInstructionExecution() {
 }
 
 
+/**
+ * Tests that the statistics are stored to the file and read back.
+ */
+void
+ExecutionTraceTest::testStatistics() {
+
+    TS_ASSERT_THROWS_NOTHING(
+        execTrace_ = ExecutionTrace::open(nonexistingWritableDBFile));
+    TS_ASSERT_THROWS(execTrace_->simulatedCycleCount(), IOException);
+
+    execTrace_->addConcurrentRegisterFileAccessCount("RF", 1, 0, 10);
+    execTrace_->addConcurrentRegisterFileAccessCount("RF", 2, 1, 5);
+    execTrace_->addFunctionUnitOperationTriggerCount("ALU", "add", 7);
+    execTrace_->addSocketWriteCount("socket1", 3);
+    execTrace_->addBusWriteCount("B1", 4);
+    execTrace_->setSimulatedCycleCount(20);
+    delete execTrace_;
+    execTrace_ = NULL;
+
+    TS_ASSERT_THROWS_NOTHING(
+        execTrace_ = ExecutionTrace::open(nonexistingWritableDBFile));
+
+    ExecutionTrace::ConcurrentRFAccessCountList* rfAccesses =
+        execTrace_->registerFileAccessCounts("RF");
+    TS_ASSERT_EQUALS(rfAccesses->size(), 2u);
+    TS_ASSERT_EQUALS(rfAccesses->back().get<0>(), 2u);
+    TS_ASSERT_EQUALS(rfAccesses->back().get<1>(), 1u);
+    TS_ASSERT_EQUALS(rfAccesses->back().get<2>(), 5);
+    delete rfAccesses;
+
+    ExecutionTrace::FUOperationTriggerCountList* triggers =
+        execTrace_->functionUnitOperationTriggerCounts("ALU");
+    TS_ASSERT_EQUALS(triggers->size(), 1u);
+    TS_ASSERT_EQUALS(triggers->front().get<0>(), "add");
+    TS_ASSERT_EQUALS(triggers->front().get<1>(), 7);
+    delete triggers;
+
+    TS_ASSERT_EQUALS(execTrace_->socketWriteCount("socket1"), 3);
+    TS_ASSERT_EQUALS(execTrace_->socketWriteCount("socket2"), 0);
+    TS_ASSERT_EQUALS(execTrace_->busWriteCount("B1"), 4);
+    TS_ASSERT_EQUALS(execTrace_->simulatedCycleCount(), 20);
+
+    // the instruction executions of the earlier tests are still there
+    InstructionExecution& ie = execTrace_->instructionExecutions();
+    TS_ASSERT_EQUALS(ie.cycle(), 0);
+    TS_ASSERT_THROWS(execTrace_->addInstructionExecution(3, 1), IOException);
+    TS_ASSERT_THROWS_NOTHING(execTrace_->addInstructionExecution(4, 2));
+
+    delete execTrace_;
+    execTrace_ = NULL;
+}
+
+/**
+ * Tests a trace that spans several chunks of the file.
+ */
+void
+ExecutionTraceTest::testLongTrace() {
+
+    const ClockCycleCount cycles = 200000;
+    TS_ASSERT_THROWS_NOTHING(
+        execTrace_ = ExecutionTrace::open(longTraceFile));
+    for (ClockCycleCount cycle = 0; cycle < cycles; ++cycle) {
+        execTrace_->addInstructionExecution(cycle, cycle % 1000);
+    }
+
+    InstructionExecution& ie = execTrace_->instructionExecutions();
+    ClockCycleCount count = 1;
+    bool inOrder = true;
+    while (ie.hasNext()) {
+        ie.next();
+        inOrder = inOrder && ie.cycle() == count &&
+            ie.address() == static_cast<InstructionAddress>(count % 1000);
+        ++count;
+    }
+    TS_ASSERT(inOrder);
+    TS_ASSERT_EQUALS(count, cycles);
+
+    delete execTrace_;
+    execTrace_ = NULL;
+}
+
+/**
+ * Tests that a chunk of an unknown column makes the trace unreadable.
+ */
+void
+ExecutionTraceTest::testCorruptedColumn() {
+
+    TS_ASSERT_THROWS_NOTHING(
+        execTrace_ = ExecutionTrace::open(corruptedTraceFile));
+    execTrace_->addInstructionExecution(0, 1);
+    delete execTrace_;
+    execTrace_ = NULL;
+
+    // the column id of the first chunk follows the file header
+    std::fstream file(
+        corruptedTraceFile.c_str(),
+        std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(BinaryTrace::HEADER_SIZE);
+    const char column[] = { '\xf0', '\xff', '\xff', '\xff' };
+    file.write(column, sizeof(column));
+    file.close();
+
+    TS_ASSERT_THROWS(
+        execTrace_ = ExecutionTrace::open(corruptedTraceFile), IOException);
+}
+
 #endif
@@ -69,6 +69,7 @@ public:
                                double energyActive, double energyIdle);
     void testExactMatchTest();
     void testRFExactMatchTest();
+    void testIndexedSearch();
     
 private:
     CostDatabaseRegistry* costDatabaseRegistry_;
@@ -378,5 +379,57 @@ void CostDBExactMatchTest::testRFExactMatchTest() {
     TS_ASSERT(results[1]->isEqualKey(*rf2));
 }
 
+/**
+ * Test that searches find the entries inserted both before and after
+ * the exact match field has been indexed by a search.
+ */
+void CostDBExactMatchTest::testIndexedSearch() {
+
+    costDB_->setSearchStrategy(strategy_);
+    for (int i = 0; i < 50; i++) {
+        createBusEntry(1000 + i % 5, i, i, 1.0, 1.0, 1.0, 1.0);
+    }
+
+    CostDBEntryKey searchKey(mbus_property);
+    searchKey.addField(
+        new EntryKeyField(
+            new EntryKeyDataInt(1002),
+            mbus_property->fieldProperty(CostDBTypes::EKF_BIT_WIDTH)));
+    CostDBTypes::MatchTypeTable match;
+    match.push_back(
+        new MatchType(
+            mbus_property->fieldProperty(CostDBTypes::EKF_BIT_WIDTH),
+            CostDBTypes::MATCH_EXACT));
+
+    CostDBTypes::EntryTable results = costDB_->search(searchKey, match);
+    TS_ASSERT_EQUALS(results.size(), 10u);
+    for (size_t i = 0; i < results.size(); i++) {
+        // in the order of insertion
+        TS_ASSERT(
+            results[i]->keyFieldOfType(
+                *mbus_property->fieldProperty(CostDBTypes::EKF_BUS_FANIN)).
+            isEqual(
+                EntryKeyField(
+                    new EntryKeyDataInt(2 + 5 * i),
+                    mbus_property->fieldProperty(
+                        CostDBTypes::EKF_BUS_FANIN))));
+    }
+
+    // entries inserted after the index was built
+    CostDBEntry* bus1 = createBusEntry(1005, 1, 1, 1.0, 1.0, 1.0, 1.0);
+    CostDBEntry* bus2 = createBusEntry(1005, 2, 2, 1.0, 1.0, 1.0, 1.0);
+    CostDBEntryKey searchKey2(mbus_property);
+    searchKey2.addField(
+        new EntryKeyField(
+            new EntryKeyDataInt(1005),
+            mbus_property->fieldProperty(CostDBTypes::EKF_BIT_WIDTH)));
+    results = costDB_->search(searchKey2, match);
+    TS_ASSERT_EQUALS(results.size(), 2u);
+    TS_ASSERT(results[0]->isEqualKey(*bus1));
+    TS_ASSERT(results[1]->isEqualKey(*bus2));
+
+    delete match.at(0);
+}
+
 
 #endif
@@ -36,6 +36,7 @@
 #include <TestSuite.h>
 #include "MachineConnectivityCheck.hh"
 #include "FUPort.hh"
+#include "Socket.hh"
 #include "Machine.hh"
 #include "OperationBindingCheck.hh"
 #include "RegisterQuantityCheck.hh"
@@ -125,6 +126,21 @@ MachineCheckTest::testMachineConnectivityCheck() {
         !MachineConnectivityCheck::isConnected(
             findFUPort(*targetMachine, "fu15", "r0"),
             findRFPort(*targetMachine, "integer0", "wr0")));
+
+    // the results must follow the modifications of the machine
+    TTAMachine::Port* trigger =
+        targetMachine->functionUnitNavigator().item("fu16")->port("trigger");
+    TTAMachine::Socket* socket = trigger->inputSocket();
+    trigger->detachSocket(*socket);
+    TS_ASSERT(
+        !MachineConnectivityCheck::isConnected(
+            findFUPort(*targetMachine, "fu16", "r0"), *trigger));
+    trigger->attachSocket(*socket);
+    TS_ASSERT(
+        MachineConnectivityCheck::isConnected(
+            findFUPort(*targetMachine, "fu16", "r0"), *trigger));
+
+    delete targetMachine;
 }
 
 void
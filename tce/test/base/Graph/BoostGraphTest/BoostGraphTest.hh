@@ -51,6 +51,7 @@ public:
     
     void testRootNodeFinding();
     void testEdgeMoving();
+    void testPathLengthsAfterRemoval();
 
 private:
     typedef BoostGraph<GraphNode, GraphEdge> TestGraph;
@@ -167,4 +168,53 @@ BoostGraphTest::testEdgeMoving() {
     TS_ASSERT_EQUALS(testGraph_.outDegree(*node0_), 3);
 }
 
+/**
+ * Test that the cached path lengths follow the nodes when a node is
+ * removed and the last node of the graph takes its place.
+ */
+void
+BoostGraphTest::testPathLengthsAfterRemoval() {
+
+    TestGraph graph;
+    GraphNode a(0), b(1), c(2), d(3), e(4);
+    // the graph owns and deletes the edges
+    GraphEdge* ab = new GraphEdge;
+    GraphEdge* bc = new GraphEdge;
+    GraphEdge* cd = new GraphEdge;
+    GraphEdge* ae = new GraphEdge;
+
+    graph.addNode(a);
+    graph.addNode(b);
+    graph.addNode(c);
+    graph.addNode(d);
+    graph.addNode(e);
+    graph.connectNodes(a, b, *ab);
+    graph.connectNodes(b, c, *bc);
+    graph.connectNodes(c, d, *cd);
+    graph.connectNodes(a, e, *ae);
+
+    TS_ASSERT_EQUALS(graph.height(), 3);
+    TS_ASSERT_EQUALS(graph.maxSourceDistance(d), 3);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(a), 3);
+    TS_ASSERT_EQUALS(graph.maxSourceDistance(e), 1);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(e), 0);
+
+    // e is the last node and gets the descriptor of b
+    graph.removeNode(b);
+
+    TS_ASSERT_EQUALS(graph.nodeCount(), 4);
+    TS_ASSERT_EQUALS(graph.maxSourceDistance(e), 1);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(e), 0);
+    TS_ASSERT_EQUALS(graph.maxSourceDistance(d), 1);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(a), 1);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(c), 1);
+
+    // the last node itself removed
+    graph.removeNode(d);
+
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(c), 0);
+    TS_ASSERT_EQUALS(graph.maxSourceDistance(c), 0);
+    TS_ASSERT_EQUALS(graph.maxSinkDistance(a), 1);
+}
+
 #endif
@@ -51,6 +51,9 @@
 #include "InstructionTemplate.hh"
 #include "Exception.hh"
 #include "ObjectState.hh"
+#include "HWOperation.hh"
+#include "ExecutionPipeline.hh"
+#include "RFPort.hh"
 
 using std::string;
 using namespace TTAMachine;
@@ -70,8 +73,11 @@ public:
     void testAddAndDeleteAddressSpace();
     void testAddingFUAndGCUOfSameName();
     void testSaveAndLoadState();
+    void testHash();
 
 private:
+    static void addHashTestComponents(Machine& mach, bool reversed);
+
     Machine* mach_;
 };
 
@@ -501,4 +507,103 @@ MachineTest::testSaveAndLoadState() {
     delete loadedMach;
 }
 
+/**
+ * Adds the components used by testHash to the given machine.
+ *
+ * @param mach The machine.
+ * @param reversed Adds the components in the reverse order if true.
+ */
+void
+MachineTest::addHashTestComponents(Machine& mach, bool reversed) {
+
+    Bus* bus1 = new Bus("bus1", 32, 16, Machine::SIGN);
+    Bus* bus2 = new Bus("bus2", 32, 8, Machine::ZERO);
+    new Segment("seg1", *bus1);
+    new Segment("seg1", *bus2);
+    Socket* socket1 = new Socket("socket1");
+    Socket* socket2 = new Socket("socket2");
+    RegisterFile* rf = new RegisterFile(
+        "rf", 16, 32, 1, 1, 0, RegisterFile::NORMAL);
+    new RFPort("rfPort", *rf);
+    FunctionUnit* fu = new FunctionUnit("fu");
+    FUPort* trigger = new FUPort("trigger", 32, *fu, true, true);
+    HWOperation* add = new HWOperation("add", *fu);
+    add->bindPort(1, *trigger);
+    add->pipeline()->addPortRead(1, 0, 1);
+
+    if (reversed) {
+        mach.addFunctionUnit(*fu);
+        mach.addRegisterFile(*rf);
+        mach.addSocket(*socket2);
+        mach.addSocket(*socket1);
+        mach.addBus(*bus2);
+        mach.addBus(*bus1);
+    } else {
+        mach.addBus(*bus1);
+        mach.addBus(*bus2);
+        mach.addSocket(*socket1);
+        mach.addSocket(*socket2);
+        mach.addRegisterFile(*rf);
+        mach.addFunctionUnit(*fu);
+    }
+
+    socket1->attachBus(*bus1->segment(0));
+    socket2->attachBus(*bus2->segment(0));
+    rf->port(0)->attachSocket(*socket1);
+    trigger->attachSocket(*socket2);
+}
+
+/**
+ * Tests that the hash does not depend on the order of the components and
+ * that it is updated when the components are modified.
+ */
+void
+MachineTest::testHash() {
+
+    addHashTestComponents(*mach_, false);
+    Machine reversed;
+    addHashTestComponents(reversed, true);
+    TS_ASSERT_EQUALS(mach_->hash(), reversed.hash());
+
+    // the state of a bus
+    Bus* bus = mach_->busNavigator().item("bus1");
+    string original = mach_->hash();
+    bus->setImmediateWidth(8);
+    TS_ASSERT_DIFFERS(mach_->hash(), original);
+    bus->setImmediateWidth(16);
+    TS_ASSERT_EQUALS(mach_->hash(), original);
+
+    // connections
+    Socket* socket = mach_->socketNavigator().item("socket2");
+    socket->attachBus(*bus->segment(0));
+    TS_ASSERT_DIFFERS(mach_->hash(), original);
+    socket->detachBus(*bus->segment(0));
+    TS_ASSERT_EQUALS(mach_->hash(), original);
+
+    // subcomponents of a function unit
+    FunctionUnit* fu = mach_->functionUnitNavigator().item("fu");
+    fu->operation("add")->pipeline()->addPortRead(1, 1, 1);
+    TS_ASSERT_DIFFERS(mach_->hash(), original);
+    fu->operation("add")->pipeline()->removeOperandUse(1, 1);
+    TS_ASSERT_EQUALS(mach_->hash(), original);
+
+    // renaming a socket changes the state of the ports connected to it
+    mach_->socketNavigator().item("socket1")->setName("socket3");
+    reversed.socketNavigator().item("socket1")->setName("socket3");
+    TS_ASSERT_DIFFERS(mach_->hash(), original);
+    TS_ASSERT_EQUALS(mach_->hash(), reversed.hash());
+
+    // the hash is the same as the one of a loaded copy
+    ObjectState* state = mach_->saveState();
+    Machine loaded;
+    loaded.loadState(state);
+    delete state;
+    TS_ASSERT_EQUALS(loaded.hash(), mach_->hash());
+
+    Machine copy(*mach_);
+    TS_ASSERT_EQUALS(copy.hash(), mach_->hash());
+    copy.busNavigator().item("bus2")->setWidth(16);
+    TS_ASSERT_DIFFERS(copy.hash(), mach_->hash());
+}
+
 #endif
@@ -46,6 +46,7 @@ public:
     void tearDown();
 
     void testBasicInterface();
+    void testWriteWatches();
 
 private:
     /// Starting point of the memory.
@@ -126,5 +127,34 @@ IdealSRAMTest::testBasicInterface() {
     TS_ASSERT_DELTA(d, 123.123, 0.1);
 }
 
+/**
+ * Tests that the write watches are raised by the writes to their ranges
+ * when the writes are commited.
+ */
+void
+IdealSRAMTest::testWriteWatches() {
+
+    IdealSRAM memory(START, END, MAUSIZE, false);
+
+    bool written = false;
+    memory.addWriteWatch(200, 203, written);
+
+    memory.write(196, 4, 1);
+    memory.write(204, 2, 1);
+    memory.advanceClock();
+    TS_ASSERT(!written);
+
+    memory.write(202, 4, 1);
+    TS_ASSERT(!written);
+    memory.advanceClock();
+    TS_ASSERT(written);
+
+    written = false;
+    memory.removeWriteWatch(written);
+    memory.write(200, 1, 1);
+    memory.advanceClock();
+    TS_ASSERT(!written);
+}
+
 
 #endif
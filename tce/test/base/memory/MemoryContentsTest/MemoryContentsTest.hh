@@ -46,6 +46,10 @@ public:
     void tearDown();
 
     void testStressTest();
+    void testEndianAccesses();
+    void testWideMAUs();
+    void testLargeAddressSpace();
+    void testClear();
 };
 
 /**
@@ -74,25 +78,99 @@ MemoryContentsTest::testStressTest() {
     const size_t accessCount = 1000;    
     const size_t addressSpaceSize = 0xFFFFFFFF;
     Memory::MAU data = 0xFEFEFEFE;
-    Memory::MAU data2 = 0x00000000;
-    Memory::MAUTable dataIn = &data;
-    Memory::MAUTable dataOut = &data2;
 
-    MemoryContents mem(addressSpaceSize);
+    MemoryContents mem(addressSpaceSize, 32);
     /// A geeky hack to produce a somewhat random seed ;)
     std::srand(time(NULL));
     
     for (size_t i = 0; i < accessCount; ++i) {
         const size_t address = 
-            static_cast<size_t>(addressSpaceSize*(rand()*1.0/RAND_MAX));
+            static_cast<size_t>(
+                (addressSpaceSize - 1)*(rand()*1.0/RAND_MAX));
 
-        mem.write(address, dataIn, 1);
-        mem.read(address, dataOut, 1);
-        TS_ASSERT_EQUALS(data, dataOut[0]);
+        mem.writeData(address, data);
+        TS_ASSERT_EQUALS(data, mem.readData(address));
     }
+}
+
+/**
+ * Tests the multi-MAU accesses of 8-bit MAUs in both byte orders.
+ */
+void
+MemoryContentsTest::testEndianAccesses() {
+
+    MemoryContents mem(64, 8);
+
+    TS_ASSERT_EQUALS(mem.readBE<4>(0), 0u);
+
+    mem.writeBE<4>(0, 0x11223344);
+    TS_ASSERT_EQUALS(mem.readData(0), 0x11u);
+    TS_ASSERT_EQUALS(mem.readData(3), 0x44u);
+    TS_ASSERT_EQUALS(mem.readBE<4>(0), 0x11223344u);
+    TS_ASSERT_EQUALS(mem.readLE<4>(0), 0x44332211u);
+    TS_ASSERT_EQUALS(mem.readBE<2>(1), 0x2233u);
+    TS_ASSERT_EQUALS(mem.readLE<1>(2), 0x33u);
+
+    mem.writeLE<8>(9, 0x0102030405060708ull);
+    TS_ASSERT_EQUALS(mem.readData(9), 0x08u);
+    TS_ASSERT_EQUALS(mem.readData(16), 0x01u);
+    TS_ASSERT_EQUALS(mem.readLE<8>(9), 0x0102030405060708ull);
+    TS_ASSERT_EQUALS(mem.readBE<8>(9), 0x0807060504030201ull);
+
+    // only the MAUs of the access are written
+    mem.writeBE(20, 2, 0xAABBCCDD);
+    TS_ASSERT_EQUALS(mem.readBE(19, 4), 0x00CCDD00u);
+    mem.writeLE(30, 3, 0x112233);
+    TS_ASSERT_EQUALS(mem.readLE(30, 3), 0x112233u);
+    TS_ASSERT_EQUALS(mem.readBE(30, 3), 0x332211u);
+}
+
+/**
+ * Tests the multi-MAU accesses of MAUs wider than a byte.
+ */
+void
+MemoryContentsTest::testWideMAUs() {
+
+    MemoryContents mem(16, 16);
+
+    mem.writeBE<2>(0, 0x1234ABCD);
+    TS_ASSERT_EQUALS(mem.readData(0), 0x1234u);
+    TS_ASSERT_EQUALS(mem.readData(1), 0xABCDu);
+    TS_ASSERT_EQUALS(mem.readLE<2>(0), 0xABCD1234u);
 
-    TS_ASSERT_LESS_THAN(mem.allocatedMemory(), accessCount*MEM_CHUNK_SIZE);
+    mem.writeLE<4>(4, 0x1111222233334444ull);
+    TS_ASSERT_EQUALS(mem.readData(4), 0x4444u);
+    TS_ASSERT_EQUALS(mem.readBE(4, 4), 0x4444333322221111ull);
 }
 
+/**
+ * Tests that addresses above 32 bits are distinct.
+ */
+void
+MemoryContentsTest::testLargeAddressSpace() {
+
+    const ULongWord size = 0x200000000ull;
+    MemoryContents mem(size, 8);
+
+    mem.writeBE<4>(0x100000000ull, 0xCAFEBABE);
+    mem.writeData(0, 0x5A);
+    TS_ASSERT_EQUALS(mem.readBE<4>(0x100000000ull), 0xCAFEBABEu);
+    TS_ASSERT_EQUALS(mem.readData(0), 0x5Au);
+    TS_ASSERT_EQUALS(mem.readLE<2>(size - 2), 0u);
+}
+
+/**
+ * Tests that clear() zeroes the contents.
+ */
+void
+MemoryContentsTest::testClear() {
+
+    MemoryContents mem(4096 * 4, 8);
+    mem.writeLE<4>(100, 0xFFFFFFFF);
+    mem.writeData(4096 * 3, 7);
+    mem.clear();
+    TS_ASSERT_EQUALS(mem.readLE<4>(100), 0u);
+    TS_ASSERT_EQUALS(mem.readData(4096 * 3), 0u);
+}
 
 #endif
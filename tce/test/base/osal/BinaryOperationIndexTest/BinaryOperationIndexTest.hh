@@ -0,0 +1,179 @@
+/*
+    Copyright (c) 2002-2021 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file BinaryOperationIndexTest.hh
+ *
+ * A test suite for BinaryOperationIndex.
+ *
+ * @note rating: red
+ */
+
+#ifndef BINARY_OPERATION_INDEX_TEST_HH
+#define BINARY_OPERATION_INDEX_TEST_HH
+
+#include <TestSuite.h>
+#include <string>
+#include <fstream>
+
+#include "BinaryOperationIndex.hh"
+#include "OperationIndex.hh"
+#include "OperationModule.hh"
+#include "ObjectState.hh"
+#include "FileSystem.hh"
+#include "Exception.hh"
+
+using std::string;
+
+/**
+ * Tests the compiled operation property files.
+ */
+class BinaryOperationIndexTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testWriteAndRead();
+    void testCompileAndLoad();
+    void testCorruptedCounts();
+
+private:
+    /// Path of the test module.
+    static const string DATA_PATH;
+};
+
+const string BinaryOperationIndexTest::DATA_PATH =
+    FileSystem::currentWorkingDir() + FileSystem::DIRECTORY_SEPARATOR +
+    "data";
+
+/**
+ * Called before each test.
+ */
+void
+BinaryOperationIndexTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+BinaryOperationIndexTest::tearDown() {
+    FileSystem::removeFileOrDirectory(
+        DATA_PATH + FileSystem::DIRECTORY_SEPARATOR + "correct.oppc");
+    FileSystem::removeFileOrDirectory(
+        DATA_PATH + FileSystem::DIRECTORY_SEPARATOR + "tree.oppc");
+}
+
+/**
+ * Tests that a written tree is read back as it was.
+ */
+void
+BinaryOperationIndexTest::testWriteAndRead() {
+    const string file =
+        DATA_PATH + FileSystem::DIRECTORY_SEPARATOR + "tree.oppc";
+
+    ObjectState root("osal");
+    root.setAttribute("version", string("0.1"));
+    ObjectState* operation = new ObjectState("operation", &root);
+    ObjectState* name = new ObjectState("name", operation);
+    name->setValue(string("oper1"));
+    ObjectState* input = new ObjectState("in", operation);
+    input->setAttribute("id", 1);
+    new ObjectState("mem-address", input);
+
+    BinaryOperationIndex::write(root, "tree.opb", 42, file);
+
+    string behaviorModule;
+    uint64_t sourceSize = 0;
+    ObjectState* read =
+        BinaryOperationIndex::read(file, behaviorModule, sourceSize);
+    TS_ASSERT_EQUALS(behaviorModule, "tree.opb");
+    TS_ASSERT_EQUALS(sourceSize, 42u);
+    TS_ASSERT_EQUALS(read->name(), "osal");
+    TS_ASSERT_EQUALS(read->stringAttribute("version"), "0.1");
+    TS_ASSERT_EQUALS(read->childCount(), 1);
+    const ObjectState* readOperation = read->child(0);
+    TS_ASSERT_EQUALS(readOperation->childCount(), 2);
+    TS_ASSERT_EQUALS(readOperation->child(0)->stringValue(), "oper1");
+    TS_ASSERT_EQUALS(readOperation->child(1)->intAttribute("id"), 1);
+    TS_ASSERT(readOperation->child(1)->hasChild("mem-address"));
+    delete read;
+}
+
+/**
+ * Tests that the index uses the compiled module.
+ */
+void
+BinaryOperationIndexTest::testCompileAndLoad() {
+    const string opp =
+        DATA_PATH + FileSystem::DIRECTORY_SEPARATOR + "correct.opp";
+
+    TS_ASSERT(BinaryOperationIndex::load(opp) == NULL);
+    TS_ASSERT_THROWS_NOTHING(BinaryOperationIndex::compile(opp));
+    TS_ASSERT(FileSystem::fileExists(BinaryOperationIndex::fileName(opp)));
+
+    ObjectState* operations = BinaryOperationIndex::load(opp);
+    TS_ASSERT(operations != NULL);
+    TS_ASSERT_EQUALS(operations->childCount(), 1);
+    delete operations;
+
+    OperationIndex index;
+    index.addPath(DATA_PATH);
+    OperationModule& module = index.moduleOf("oper1");
+    TS_ASSERT_EQUALS(module.name(), "correct");
+    TS_ASSERT_EQUALS(index.operationCount(module), 1);
+    TS_ASSERT_EQUALS(index.operationName(0, module), "oper1");
+}
+
+/**
+ * Tests that string and node counts too large for the file are rejected.
+ */
+void
+BinaryOperationIndexTest::testCorruptedCounts() {
+    const string file =
+        DATA_PATH + FileSystem::DIRECTORY_SEPARATOR + "tree.oppc";
+    ObjectState root("osal");
+    new ObjectState("operation", &root);
+
+    // the string count follows the magic, the version, the source size
+    // and the behavior module index, the node count follows it
+    const std::streamoff stringCountOffset =
+        BinaryOperationIndex::MAGIC.size() + 16;
+    const char huge[] = { '\xff', '\xff', '\xff', '\x7f' };
+    for (int field = 0; field < 2; ++field) {
+        BinaryOperationIndex::write(root, "tree.opb", 42, file);
+        std::fstream out(
+            file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        out.seekp(stringCountOffset + field * 4);
+        out.write(huge, sizeof(huge));
+        out.close();
+
+        string behaviorModule;
+        uint64_t sourceSize = 0;
+        TS_ASSERT_THROWS(
+            BinaryOperationIndex::read(file, behaviorModule, sourceSize),
+            IOException&);
+    }
+}
+
+#endif
@@ -55,6 +55,7 @@ public:
 
     void testOperation();
     void testDAGOperation();
+    void testOperationID();
 
 private:
 };
@@ -152,4 +153,33 @@ OperationPoolTest::testDAGOperation() {
     OperationPool::cleanupCache();
 }
 
+/**
+ * Test that the interned operation handles work.
+ */
+void
+OperationPoolTest::testOperationID() {
+
+    OperationPool pool;
+
+    OperationPool::OpId callID = pool.operationID("call");
+    TS_ASSERT_EQUALS(pool.operationID("CALL"), callID);
+    TS_ASSERT_EQUALS(pool.operationID("Call"), callID);
+    TS_ASSERT_EQUALS(&pool.operation(callID), &pool.operation("call"));
+    TS_ASSERT(pool.operation(callID).isCall());
+
+    OperationPool::OpId jumpID = pool.operationID("jump");
+    TS_ASSERT_DIFFERS(jumpID, callID);
+    TS_ASSERT(pool.operation(jumpID).isBranch());
+
+    OperationPool::OpId missingID = pool.operationID("foobariehbfa");
+    TS_ASSERT_EQUALS(&pool.operation(missingID), &NullOperation::instance());
+
+    // the handles survive the cleanup, the operations are reloaded
+    OperationPool::cleanupCache();
+    OperationPool pool2;
+    TS_ASSERT_EQUALS(pool2.operationID("call"), callID);
+    TS_ASSERT(pool2.operation(callID).isCall());
+    OperationPool::cleanupCache();
+}
+
 #endif
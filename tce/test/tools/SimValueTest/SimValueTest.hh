@@ -51,6 +51,7 @@ public:
     void testEqualities();
 
     void testMisc();
+    void testWideValues();
     
     
 private:
@@ -412,4 +413,40 @@ SimValueTest::testMisc() {
     TS_ASSERT_EQUALS(simValue.hexValue(), "0x0000");
 }
 
+/**
+ * Tests values wider than the inline storage.
+ */
+void
+SimValueTest::testWideValues() {
+    SimValue wide(512);
+    wide.setWordElement(0, 0x01234567);
+    wide.setWordElement(15, 0x89abcdef);
+    TS_ASSERT_EQUALS(wide.wordElement(0), 0x01234567u);
+    TS_ASSERT_EQUALS(wide.wordElement(15), 0x89abcdefu);
+
+    // Copies get their own storage.
+    SimValue copy(wide);
+    wide.setWordElement(15, 0);
+    TS_ASSERT_EQUALS(copy.wordElement(15), 0x89abcdefu);
+    TS_ASSERT_EQUALS(copy.width(), 512);
+
+    // Narrowing assignment keeps only the destination width.
+    SimValue narrow(32);
+    narrow = copy;
+    TS_ASSERT_EQUALS(narrow.uIntWordValue(), 0x01234567u);
+    TS_ASSERT_EQUALS(narrow.wordElement(15), 0u);
+
+    // Widening a scalar value keeps the lanes zero.
+    SimValue grown(32);
+    grown = 5u;
+    grown.setBitWidth(256);
+    grown.setWordElement(7, 7);
+    TS_ASSERT_EQUALS(grown.wordElement(0), 0u);
+    TS_ASSERT_EQUALS(grown.wordElement(7), 7u);
+    TS_ASSERT_EQUALS(
+        grown.hexValue(), "0x00000007" + std::string(56, '0'));
+
+    TS_ASSERT(sizeof(SimValue) < SIMVALUE_MAX_BYTE_SIZE);
+}
+
 #endif
@@ -0,0 +1,115 @@
+#!/bin/bash
+# Copyright (c) 2002-2021 Tampere University.
+#
+# This file is part of TTA-Based Codesign Environment (TCE).
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#
+#
+# Measures the compilation time of tcecc -O3 with the CHStone programs of
+# the long system test suite.
+#
+# For each program the script prints the wall clock time of the compilation
+# and, when perf is used, the share of the samples spent in the functions
+# of interest, by default the OSAL operation lookups (OperationPool and
+# OperationIndex). Run it with two builds of TCE to compare them.
+#
+# Usage: chstone_compile_benchmark.sh [-a adf] [-c tcecc] [-t testsuite root]
+#                                     [-p] [-s symbol regex]
+#                                     [-u unroll threshold] [program ...]
+#
+# -p records the compilations with 'perf record' to get the share.
+# -s sets the regular expression matching the symbols of interest.
+# -u passes an unroll threshold to tcecc. A huge threshold unrolls the
+#    loops of the kernels fully, which stresses the DDG construction, e.g.
+#    chstone_compile_benchmark.sh -p -u 100000 \
+#        -s 'DataDependenceGraphBuilder|AliasAnalyzer' aes
+# Without program arguments all the CHStone programs are benchmarked.
+
+tceRoot=$(cd $(dirname $0)/../..; pwd)
+testsuiteRoot=$tceRoot/../testsuite
+adf=$tceRoot/scheduler/testbench/ADF/3_bus_short_immediate_fields_and_reduced_connectivity.adf
+tcecc=tcecc
+usePerf=0
+symbols="OperationPool|OperationIndex"
+unrollOption=""
+
+while getopts "a:c:t:ps:u:" opt; do
+    case $opt in
+        a) adf=$(readlink -f $OPTARG);;
+        c) tcecc=$OPTARG;;
+        t) testsuiteRoot=$(readlink -f $OPTARG);;
+        p) usePerf=1;;
+        s) symbols=$OPTARG;;
+        u) unrollOption="--unroll-threshold=$OPTARG";;
+        *) echo "Usage: $0 [-a adf] [-c tcecc] [-t testsuite] [-p]" \
+               "[-s symbol regex] [-u unroll threshold] [program ...]"
+           exit 1;;
+    esac
+done
+shift $((OPTIND - 1))
+
+chstoneRoot=$testsuiteRoot/systemtest_long/bintools/Scheduler/tests/CHStone
+programs=$*
+if [ -z "$programs" ]; then
+    programs=$(cd $chstoneRoot; ls -d */ | tr -d /)
+fi
+
+workDir=$(mktemp -d)
+trap "rm -rf $workDir" EXIT
+
+echo "adf: $adf"
+echo "compiler: $(which $tcecc)"
+printf "%-10s %10s %14s\n" program seconds symbol_share_%
+
+for program in $programs; do
+    srcDir=$chstoneRoot/$program/src
+    tpef=$workDir/$program.tpef
+
+    # Use the source list of the test case Makefile, all .c files if
+    # it does not define one.
+    sources=$(sed -n 's/^SOURCE_FILES *= *//p' $srcDir/Makefile)
+    if [ -z "$sources" ]; then
+        sources=$(cd $srcDir; ls *.c)
+    fi
+
+    compile="$tcecc -O3 $unrollOption -a $adf -o $tpef $sources"
+    if [ $usePerf -eq 1 ]; then
+        compile="perf record -q -o $workDir/$program.perf $compile"
+    fi
+
+    if ! (cd $srcDir; /usr/bin/time -f "%e" -o $workDir/$program.time \
+        $compile) > $workDir/$program.compile.log 2>&1; then
+        echo "$program: compilation failed, see the log below"
+        cat $workDir/$program.compile.log
+        continue
+    fi
+
+    seconds=$(tail -n 1 $workDir/$program.time)
+    share="-"
+    if [ $usePerf -eq 1 ]; then
+        share=$(perf report -q -i $workDir/$program.perf \
+            --sort symbol 2> /dev/null | \
+            awk -v symbols="$symbols" \
+                '$0 ~ symbols { sub("%", "", $1); s += $1 }
+                 END { printf "%.2f", s }')
+    fi
+
+    printf "%-10s %10s %14s\n" $program $seconds $share
+done
@@ -0,0 +1,98 @@
+#!/bin/bash
+# Copyright (c) 2002-2021 Tampere University.
+#
+# This file is part of TTA-Based Codesign Environment (TCE).
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#
+# Measures the interpretive simulation speed and the memory footprint of
+# ttasim with the CHStone programs of the long system test suite.
+#
+# For each program the script compiles the sources once with tcecc and then
+# runs the simulation, printing the simulated cycle count, the wall clock
+# time, the time per simulated cycle and the peak resident set size of the
+# ttasim process. Run it with two builds of TCE to compare them.
+#
+# Usage: chstone_sim_benchmark.sh [-a adf] [-s ttasim] [-c tcecc]
+#                                 [-t testsuite root] [program ...]
+#
+# Without program arguments all the CHStone programs are benchmarked.
+
+tceRoot=$(cd $(dirname $0)/../..; pwd)
+testsuiteRoot=$tceRoot/../testsuite
+adf=$tceRoot/scheduler/testbench/ADF/3_bus_short_immediate_fields_and_reduced_connectivity.adf
+sim=ttasim
+tcecc=tcecc
+
+while getopts "a:s:c:t:" opt; do
+    case $opt in
+        a) adf=$(readlink -f $OPTARG);;
+        s) sim=$OPTARG;;
+        c) tcecc=$OPTARG;;
+        t) testsuiteRoot=$(readlink -f $OPTARG);;
+        *) echo "Usage: $0 [-a adf] [-s ttasim] [-c tcecc] [-t testsuite]" \
+               "[program ...]"; exit 1;;
+    esac
+done
+shift $((OPTIND - 1))
+
+chstoneRoot=$testsuiteRoot/systemtest_long/bintools/Scheduler/tests/CHStone
+programs=$*
+if [ -z "$programs" ]; then
+    programs=$(cd $chstoneRoot; ls -d */ | tr -d /)
+fi
+
+workDir=$(mktemp -d)
+trap "rm -rf $workDir" EXIT
+
+echo "adf: $adf"
+echo "simulator: $(which $sim)"
+printf "%-10s %14s %10s %12s %12s\n" \
+    program cycles seconds ns/cycle max_rss_kB
+
+for program in $programs; do
+    srcDir=$chstoneRoot/$program/src
+    tpef=$workDir/$program.tpef
+
+    # Use the source list of the test case Makefile, all .c files if
+    # it does not define one.
+    sources=$(sed -n 's/^SOURCE_FILES *= *//p' $srcDir/Makefile)
+    if [ -z "$sources" ]; then
+        sources=$(cd $srcDir; ls *.c)
+    fi
+
+    if ! (cd $srcDir; $tcecc -O3 -a $adf -o $tpef $sources) \
+        > $workDir/$program.compile.log 2>&1; then
+        echo "$program: compilation failed, see the log below"
+        cat $workDir/$program.compile.log
+        continue
+    fi
+
+    /usr/bin/time -f "%e %M" -o $workDir/$program.time \
+        $sim -a $adf -p $tpef \
+        -e "run; puts [info proc cycles]; quit" \
+        > $workDir/$program.out 2>&1
+
+    cycles=$(tail -n 1 $workDir/$program.out)
+    read seconds maxRss < $workDir/$program.time
+    nsPerCycle=$(echo "scale=2; $seconds * 1000000000 / $cycles" | bc)
+
+    printf "%-10s %14s %10s %12s %12s\n" \
+        $program $cycles $seconds $nsPerCycle $maxRss
+done
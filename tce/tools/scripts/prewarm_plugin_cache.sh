@@ -0,0 +1,82 @@
+#!/bin/bash
+# Copyright (c) 2002-2021 Tampere University.
+#
+# This file is part of TTA-Based Codesign Environment (TCE).
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#
+# Builds the LLVM backend plugins of all the ADFs found in the given
+# directories to the plugin cache, so later compilations for the machines
+# do not need to build them.
+#
+# Machines that get the same backend share the cached plugin, thus the
+# number of plugins built can be smaller than the number of ADFs. The
+# builds can run in parallel; two builds of the same plugin wait for each
+# other instead of building it twice.
+#
+# Usage: prewarm_plugin_cache.sh [-j jobs] [-l llvm-tce] [-d cache dir]
+#                                directory ...
+
+jobs=1
+llvmtce=llvm-tce
+cacheDir=
+
+while getopts "j:l:d:" opt; do
+    case $opt in
+        j) jobs=$OPTARG;;
+        l) llvmtce=$OPTARG;;
+        d) cacheDir=$(readlink -f $OPTARG);;
+        *) echo "Usage: $0 [-j jobs] [-l llvm-tce] [-d cache dir]" \
+               "directory ..."; exit 1;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -eq 0 ]; then
+    echo "Usage: $0 [-j jobs] [-l llvm-tce] [-d cache dir] directory ..."
+    exit 1
+fi
+
+cacheOption=
+if [ -n "$cacheDir" ]; then
+    cacheOption="--backend-cache-dir=$cacheDir"
+fi
+
+workDir=$(mktemp -d)
+trap "rm -rf $workDir" EXIT
+
+# Builds the plugin of one ADF. Each build gets its own temp dir for the
+# generated backend sources.
+buildPlugin() {
+    adf=$1
+    tempDir=$(mktemp -d -p $workDir)
+    if output=$($llvmtce --gen-plugin-only --temp-dir=$tempDir \
+        $cacheOption -a $adf 2>&1); then
+        echo "$adf: $(echo "$output" | sed -n 's/^Generated TCE LLVM Backend plugin: //p')"
+    else
+        echo "$adf: FAILED"
+        echo "$output"
+    fi
+    rm -rf $tempDir
+}
+export -f buildPlugin
+export llvmtce cacheOption workDir
+
+find "$@" -name "*.adf" -type f -print0 | \
+    xargs -0 -n 1 -P $jobs bash -c 'buildPlugin "$0"'
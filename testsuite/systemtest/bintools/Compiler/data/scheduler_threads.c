@@ -0,0 +1,57 @@
+#include <lwpr.h>
+
+#define N 16
+
+volatile int input[N];
+int output[N];
+
+__attribute__((noinline))
+int sum(const int* data, int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s += data[i];
+    }
+    return s;
+}
+
+__attribute__((noinline))
+void scale(int* data, int n, int factor) {
+    for (int i = 0; i < n; ++i) {
+        data[i] = input[i] * factor;
+    }
+}
+
+__attribute__((noinline))
+int maximum(const int* data, int n) {
+    int m = data[0];
+    for (int i = 1; i < n; ++i) {
+        if (data[i] > m) {
+            m = data[i];
+        }
+    }
+    return m;
+}
+
+__attribute__((noinline))
+int select(int x) {
+    switch (x & 3) {
+    case 0: return x + 7;
+    case 1: return x * 3;
+    case 2: return x - 5;
+    default: return x ^ 0x55;
+    }
+}
+
+int main() {
+    for (int i = 0; i < N; ++i) {
+        input[i] = i * 5 - 20;
+    }
+    scale(output, N, 3);
+    lwpr_print_int(sum(output, N));
+    lwpr_newline();
+    lwpr_print_int(maximum(output, N));
+    lwpr_newline();
+    lwpr_print_int(select(sum(output, N)));
+    lwpr_newline();
+    return 0;
+}
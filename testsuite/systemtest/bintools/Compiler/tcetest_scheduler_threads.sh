@@ -0,0 +1,22 @@
+#!/bin/sh
+### TCE TESTCASE
+### title: Scheduling the procedures in multiple threads
+### xstdout: 840\n165\n847\n840\n165\n847\n
+
+mach=data/minimal_with_stdout.adf
+src=data/scheduler_threads.c
+program=$(mktemp tmpXXXXXX)
+threadedProgram=$(mktemp tmpXXXXXX)
+
+tcecc $src -llwpr -O3 -a $mach -o $program --scheduler-threads=1 &&
+ttasim -a $mach -p $program --no-debugmode
+
+tcecc $src -llwpr -O3 -a $mach -o $threadedProgram --scheduler-threads=4 &&
+ttasim -a $mach -p $threadedProgram --no-debugmode
+
+# The scheduled program must not depend on the thread count.
+tcedisasm -s $mach $program > $program.dis
+tcedisasm -s $mach $threadedProgram > $threadedProgram.dis
+cmp -s $program.dis $threadedProgram.dis || echo "Thread count changed the program."
+
+rm -f $program $threadedProgram $program.dis $threadedProgram.dis
@@ -2,9 +2,9 @@
 # Purpose of this test is to verify that the compressor plugins work. If ghdl
 # is not installed, this test will only check that the plugins can create
 # compressed images without crashing. When ghdl is present this test will run
-# three vhdl simulations: without compression, with SimpleDictionary
-# compressor and with MoveSlotDictionary compression. Finally the bus dumps
-# are compared for verification.
+# four vhdl simulations: without compression, with SimpleDictionary
+# compressor, with MoveSlotDictionary and with SlotPatternDictionary
+# compression. Finally the bus dumps are compared for verification.
 # The reason why this test starts from C compilation is simple, this way we
 # can assure that the compressors will work with up-to-date tce tools.
 # There is no point compressing pre-generated, age old tpefs.
@@ -25,9 +25,11 @@ TPEF=app.tpef
 DIR0=proge-output-no-compression
 DIR1=proge-output-InstructionDictionary
 DIR2=proge-output-MoveSlotDictionary
+DIR3=proge-output-SlotPatternDictionary
 
 COMP1=../../../../../tce/compressors/InstructionDictionary.so
 COMP2=../../../../../tce/compressors/MoveSlotDictionary.so
+COMP3=../../../../../tce/compressors/SlotPatternDictionary.so
 
 IMEM=app.img
 DMEM=app_data.img
@@ -58,6 +60,9 @@ $PROGE -t -b $BEM -i $IDF -o $DIR1 $ADF || eexit "ProGe failed! Check that data/
 # generate processor for move slot dictionary (2)
 $PROGE -t -b $BEM -i $IDF -o $DIR2 $ADF || eexit "ProGe failed! Check that data/minimal.idf is up to date!"
 
+# generate processor for slot pattern dictionary (3)
+$PROGE -t -b $BEM -i $IDF -o $DIR3 $ADF || eexit "ProGe failed! Check that data/minimal.idf is up to date!"
+
 # generate images for processor 0
 $PIG -b $BEM -d -w 4 -p $TPEF -x $DIR0 $ADF || eexit "PIG failed (without compression)!"
 
@@ -67,6 +72,11 @@ $PIG -b $BEM -d -w 4 -p $TPEF -c $COMP1 -g -x $DIR1 $ADF || eexit "PIG failed wi
 # generate images for processor 2
 $PIG -b $BEM -d -w 4 -p $TPEF -c $COMP2 -g -x $DIR2 $ADF || eexit "PIG failed with MoveSlotDictionary"
 
+# generate images for processor 3, checking that they decompress to the
+# original program
+$PIG -b $BEM -d -w 4 -p $TPEF -c $COMP3 -u verify=yes -g -x $DIR3 $ADF \
+    > pattern_verify.txt || eexit "PIG failed with SlotPatternDictionary"
+
 GHDL=$(which ghdl 2> /dev/null)
 
 if [ x$GHDL = "x" ]
@@ -94,10 +104,18 @@ $COMPILE >& compile.log || eexit "Failed to compile testbench with MoveSlotDicti
 $SIMULATE >& sim.log || eexit "Failed to simulate testbench with MoveSlotDictionary. See $DIR2/sim.log"
 cd ..
 
+cd $DIR3
+$COMPILE >& compile.log || eexit "Failed to compile testbench with SlotPatternDictionary. See $DIR3/compile.log"
+$SIMULATE >& sim.log || eexit "Failed to simulate testbench with SlotPatternDictionary. See $DIR3/sim.log"
+cd ..
+
 DIFF1=simple_diff.txt
 diff $DIR0/bus.dump $DIR1/bus.dump >& $DIFF1 || echo "Simple dictionary compressor is broken! Difference in $DIFF1"
 
 DIFF2=move_slot_diff.txt
 diff $DIR0/bus.dump $DIR2/bus.dump >& $DIFF2|| echo "Move slot dictionary compressor is broken! Difference in $DIFF2"
 
+DIFF3=slot_pattern_diff.txt
+diff $DIR0/bus.dump $DIR3/bus.dump >& $DIFF3 || echo "Slot pattern dictionary compressor is broken! Difference in $DIFF3"
+
 